@@ -101,6 +101,10 @@
         'src/jsrtcontextcachedobj.inc',
         'src/jsrtcontextshim.cc',
         'src/jsrtcontextshim.h',
+        'src/jsrtcpuprofiler.cc',
+        'src/jsrtcpuprofiler.h',
+        'src/jsrtheapprofiler.cc',
+        'src/jsrtheapprofiler.h',
         'src/jsrtinspector.cc',
         'src/jsrtinspector.h',
         'src/jsrtinspectorhelpers.cc',
@@ -121,12 +125,14 @@
         'src/v8chakra.cc',
         'src/v8chakra.h',
         'src/v8context.cc',
+        'src/v8cpuprofiler.cc',
         'src/v8date.cc',
         'src/v8debug.cc',
         'src/v8exception.cc',
         'src/v8external.cc',
         'src/v8function.cc',
         'src/v8functiontemplate.cc',
+        'src/v8heapprofiler.cc',
         'src/v8global.cc',
         'src/v8handlescope.cc',
         'src/v8int32.cc',
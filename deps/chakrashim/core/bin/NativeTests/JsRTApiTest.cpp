@@ -133,6 +133,812 @@ namespace JsRTApiTest
         JsRTApiTest::RunWithAttributes(JsRTApiTest::WeakReferenceTest);
     }
 
+    void CALLBACK ExternalStringFinalizeCallback(void *data)
+    {
+        (*static_cast<int*>(data))++;
+    }
+
+    void ExternalStringTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        static const uint16_t utf16Content[] = { 'e', 'x', 't', 0x20AC, 'X' };
+        static const char latin1Content[] = { 'e', 'x', 't', '\xE9', 'X' };
+        int finalizeCount = 0;
+
+        // The content isn't null terminated, only the first 4 characters are used
+        JsValueRef utf16String = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalStringUtf16(utf16Content, 4, ExternalStringFinalizeCallback, &finalizeCount, &utf16String) == JsNoError);
+
+        JsValueRef latin1String = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalStringLatin1(latin1Content, 4, ExternalStringFinalizeCallback, &finalizeCount, &latin1String) == JsNoError);
+
+        int length = 0;
+        REQUIRE(JsGetStringLength(utf16String, &length) == JsNoError);
+        CHECK(length == 4);
+        REQUIRE(JsGetStringLength(latin1String, &length) == JsNoError);
+        CHECK(length == 4);
+
+        uint16_t buffer[8] = { 0 };
+        size_t written = 0;
+        REQUIRE(JsCopyStringUtf16(utf16String, 0, 8, buffer, &written) == JsNoError);
+        CHECK(written == 4);
+        CHECK(memcmp(buffer, utf16Content, 4 * sizeof(uint16_t)) == 0);
+
+        REQUIRE(JsCopyStringUtf16(latin1String, 0, 8, buffer, &written) == JsNoError);
+        CHECK(written == 4);
+        CHECK(buffer[3] == 0xE9);
+
+        char utf8[8] = { 0 };
+        REQUIRE(JsCopyString(latin1String, utf8, sizeof(utf8), &written) == JsNoError);
+        CHECK(written == 5);
+        CHECK(memcmp(utf8, "ext\xC3\xA9", 5) == 0);
+
+        // Flattening must see the same content
+        const WCHAR* str = nullptr;
+        size_t strLength = 0;
+        REQUIRE(JsStringToPointer(latin1String, &str, &strLength) == JsNoError);
+        CHECK(strLength == 4);
+        CHECK(!wcscmp(str, _u("ext\u00E9")));
+
+        // Empty strings don't reference the content, it is released right away
+        JsValueRef emptyString = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalStringLatin1(latin1Content, 0, ExternalStringFinalizeCallback, &finalizeCount, &emptyString) == JsNoError);
+        CHECK(finalizeCount == 1);
+
+        utf16String = JS_INVALID_REFERENCE;
+        latin1String = JS_INVALID_REFERENCE;
+        str = nullptr;
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(finalizeCount == 3);
+    }
+
+    TEST_CASE("ApiTest_ExternalStringTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ExternalStringTest);
+    }
+
+    static int externalStringFreeCount = 0;
+
+    void CALLBACK ExternalStringFreeCallback(void *data)
+    {
+        free(data);
+        externalStringFreeCount++;
+    }
+
+    void ExternalSubStringTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        static const uint16_t content[] = { 'e', 'x', 't', 'e', 'r', 'n', 'a', 'l' };
+        uint16_t *buffer = static_cast<uint16_t *>(malloc(sizeof(content)));
+        REQUIRE(buffer != nullptr);
+        memcpy(buffer, content, sizeof(content));
+        externalStringFreeCount = 0;
+
+        JsValueRef string = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalStringUtf16(buffer, _countof(content), ExternalStringFreeCallback, buffer, &string) == JsNoError);
+
+        JsValueRef global = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        JsPropertyIdRef ext = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetPropertyIdFromName(_u("ext"), &ext) == JsNoError);
+        REQUIRE(JsSetProperty(global, ext, string, true) == JsNoError);
+        string = JS_INVALID_REFERENCE;
+
+        // The substring shares the host buffer, so it has to keep the external string alive
+        JsValueRef subString = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var sub = ext.substring(2, 7); ext = undefined; sub"), JS_SOURCE_CONTEXT_NONE, _u(""), &subString) == JsNoError);
+
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(externalStringFreeCount == 0);
+
+        uint16_t copy[8] = { 0 };
+        size_t written = 0;
+        REQUIRE(JsCopyStringUtf16(subString, 0, 8, copy, &written) == JsNoError);
+        CHECK(written == 5);
+        CHECK(memcmp(copy, content + 2, 5 * sizeof(uint16_t)) == 0);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("sub = undefined"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        subString = JS_INVALID_REFERENCE;
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(externalStringFreeCount == 1);
+    }
+
+    TEST_CASE("ApiTest_ExternalSubStringTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ExternalSubStringTest);
+    }
+
+    void Latin1StringTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // Long enough to go through the vectorized widen/narrow loops and their tails
+        char latin1[40];
+        for (int i = 0; i < _countof(latin1); i++)
+        {
+            latin1[i] = static_cast<char>(0xC0 + i);
+        }
+
+        JsValueRef string = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateStringLatin1(latin1, _countof(latin1), &string) == JsNoError);
+
+        uint16_t utf16[_countof(latin1)] = { 0 };
+        size_t written = 0;
+        REQUIRE(JsCopyStringUtf16(string, 0, _countof(utf16), utf16, &written) == JsNoError);
+        CHECK(written == _countof(latin1));
+        for (int i = 0; i < _countof(latin1); i++)
+        {
+            CHECK(utf16[i] == static_cast<uint16_t>(0xC0 + i));
+        }
+
+        char roundTrip[_countof(latin1)] = { 0 };
+        REQUIRE(JsCopyStringOneByte(string, 0, -1, nullptr, &written) == JsNoError);
+        CHECK(written == _countof(latin1));
+        REQUIRE(JsCopyStringOneByte(string, 0, -1, roundTrip, &written) == JsNoError);
+        CHECK(written == _countof(latin1));
+        CHECK(memcmp(roundTrip, latin1, sizeof(latin1)) == 0);
+
+        REQUIRE(JsCopyStringOneByte(string, 30, 5, roundTrip, &written) == JsNoError);
+        CHECK(written == 5);
+        CHECK(memcmp(roundTrip, latin1 + 30, 5) == 0);
+        CHECK(JsCopyStringOneByte(string, 41, 5, roundTrip, &written) == JsErrorInvalidArgument);
+
+        // Characters above U+00FF are truncated to their low byte
+        JsValueRef wide = JS_INVALID_REFERENCE;
+        REQUIRE(JsPointerToString(_u("a\u20ACb"), 3, &wide) == JsNoError);
+        REQUIRE(JsCopyStringOneByte(wide, 0, -1, roundTrip, &written) == JsNoError);
+        CHECK(written == 3);
+        CHECK(memcmp(roundTrip, "a\xACb", 3) == 0);
+    }
+
+    TEST_CASE("ApiTest_Latin1StringTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::Latin1StringTest);
+    }
+
+    void StringUtf8LengthTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // ASCII run long enough for the vectorized skip, then 2, 3 and 4 byte sequences and a lone surrogate
+        WCHAR content[22];
+        for (int i = 0; i < 16; i++)
+        {
+            content[i] = static_cast<WCHAR>(_u('a') + i);
+        }
+        content[16] = 0xE9;
+        content[17] = 0x20AC;
+        content[18] = 0xD83D;
+        content[19] = 0xDE00;
+        content[20] = 0xD83D;
+        content[21] = _u('x');
+
+        JsValueRef string = JS_INVALID_REFERENCE;
+        REQUIRE(JsPointerToString(content, _countof(content), &string) == JsNoError);
+
+        size_t length = 0;
+        REQUIRE(JsGetStringUtf8Length(string, &length) == JsNoError);
+        CHECK(length == 16 + 2 + 3 + 4 + 3 + 1);
+
+        // Must agree with what JsCopyString produces, also once the length is cached
+        size_t copyLength = 0;
+        REQUIRE(JsCopyString(string, nullptr, 0, &copyLength) == JsNoError);
+        CHECK(copyLength == length);
+
+        char buffer[64];
+        REQUIRE(JsCopyString(string, buffer, sizeof(buffer), &copyLength) == JsNoError);
+        CHECK(copyLength == length);
+
+        REQUIRE(JsGetStringUtf8Length(string, &length) == JsNoError);
+        CHECK(length == copyLength);
+
+        const char latin1[] = "caf\xE9";
+        REQUIRE(JsCreateExternalStringLatin1(latin1, 4, nullptr, nullptr, &string) == JsNoError);
+        REQUIRE(JsGetStringUtf8Length(string, &length) == JsNoError);
+        CHECK(length == 5);
+
+        JsValueRef number = JS_INVALID_REFERENCE;
+        REQUIRE(JsIntToNumber(1, &number) == JsNoError);
+        CHECK(JsGetStringUtf8Length(number, &length) == JsErrorInvalidArgument);
+    }
+
+    TEST_CASE("ApiTest_StringUtf8LengthTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::StringUtf8LengthTest);
+    }
+
+    void CopyStringUtf8PartialTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // ASCII run for the vectorized path, then a 3 byte character, a surrogate pair and a lone surrogate
+        WCHAR content[13];
+        for (int i = 0; i < 9; i++)
+        {
+            content[i] = static_cast<WCHAR>(_u('a') + i);
+        }
+        content[9] = 0x20AC;
+        content[10] = 0xD83D;
+        content[11] = 0xDE00;
+        content[12] = 0xDC00;
+
+        JsValueRef string = JS_INVALID_REFERENCE;
+        REQUIRE(JsPointerToString(content, _countof(content), &string) == JsNoError);
+
+        char buffer[32];
+        size_t written = 0;
+        size_t charsRead = 0;
+        REQUIRE(JsCopyStringUtf8Partial(string, buffer, sizeof(buffer), JsCopyStringUtf8Flags_ReplaceInvalid, &written, &charsRead) == JsNoError);
+        CHECK(written == 9 + 3 + 4 + 3);
+        CHECK(charsRead == _countof(content));
+        CHECK(memcmp(buffer, "abcdefghi\xE2\x82\xAC\xF0\x9F\x98\x80\xEF\xBF\xBD", written) == 0);
+
+        // Without replacement the lone surrogate keeps its own encoding
+        REQUIRE(JsCopyStringUtf8Partial(string, buffer, sizeof(buffer), JsCopyStringUtf8Flags_None, &written, &charsRead) == JsNoError);
+        CHECK(written == 19);
+        CHECK(memcmp(buffer + 16, "\xED\xB0\x80", 3) == 0);
+
+        // Characters that don't fit entirely are not written
+        REQUIRE(JsCopyStringUtf8Partial(string, buffer, 11, JsCopyStringUtf8Flags_ReplaceInvalid, &written, &charsRead) == JsNoError);
+        CHECK(written == 9);
+        CHECK(charsRead == 9);
+        REQUIRE(JsCopyStringUtf8Partial(string, buffer, 15, JsCopyStringUtf8Flags_ReplaceInvalid, &written, &charsRead) == JsNoError);
+        CHECK(written == 12);
+        CHECK(charsRead == 10);
+
+        REQUIRE(JsCopyStringUtf8Partial(string, nullptr, 0, JsCopyStringUtf8Flags_None, &written, &charsRead) == JsNoError);
+        CHECK(written == 0);
+        CHECK(charsRead == 0);
+    }
+
+    TEST_CASE("ApiTest_CopyStringUtf8PartialTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::CopyStringUtf8PartialTest);
+    }
+
+    void RootBlockTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef* block = nullptr;
+        REQUIRE(JsAllocRootBlock(runtime, 16, &block) == JsNoError);
+        REQUIRE(block != nullptr);
+        for (int i = 0; i < 16; i++)
+        {
+            CHECK(block[i] == JS_INVALID_REFERENCE);
+        }
+        CHECK(JsAllocRootBlock(runtime, 0, &block) == JsErrorInvalidArgument);
+        REQUIRE(JsAllocRootBlock(runtime, 16, &block) == JsNoError);
+
+        // Values referenced only from the block stay alive until their slot is cleared
+        static const uint16_t content[] = { 'r', 'o', 'o', 't' };
+        int finalizeCount = 0;
+        REQUIRE(JsCreateExternalStringUtf16(content, _countof(content), ExternalStringFinalizeCallback, &finalizeCount, &block[3]) == JsNoError);
+
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(finalizeCount == 0);
+        int length = 0;
+        REQUIRE(JsGetStringLength(block[3], &length) == JsNoError);
+        CHECK(length == 4);
+
+        block[3] = JS_INVALID_REFERENCE;
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(finalizeCount == 1);
+
+        REQUIRE(JsFreeRootBlock(runtime, block) == JsNoError);
+        CHECK(JsFreeRootBlock(runtime, block) == JsErrorInvalidArgument);
+    }
+
+    TEST_CASE("ApiTest_RootBlockTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::RootBlockTest);
+    }
+
+    void ExternalMemoryUsageTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // Values that are still referenced survive the collections the reports start
+        JsValueRef object = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateObject(&object) == JsNoError);
+        for (int i = 0; i < 64; i++)
+        {
+            CHECK(JsAddExternalMemoryUsage(runtime, 4 * 1024 * 1024) == JsNoError);
+        }
+        CHECK(JsAddExternalMemoryUsage(runtime, 0) == JsNoError);
+
+        bool isExtensible = false;
+        REQUIRE(JsGetExtensionAllowed(object, &isExtensible) == JsNoError);
+        CHECK(isExtensible);
+
+        CHECK(JsAddExternalMemoryUsage(JS_INVALID_RUNTIME_HANDLE, 1) == JsErrorInvalidArgument);
+    }
+
+    TEST_CASE("ApiTest_ExternalMemoryUsageTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ExternalMemoryUsageTest);
+    }
+
+    void HeapSpaceStatisticsTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef array = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("new Array(1024 * 1024).fill(1)"), JS_SOURCE_CONTEXT_NONE, _u(""), &array) == JsNoError);
+
+        JsHeapSpaceStatistics statistics;
+        REQUIRE(JsGetRuntimeHeapSpaceStatistics(runtime, JsHeapSpace_Object, &statistics) == JsNoError);
+        CHECK(statistics.usedBytes > 0);
+        CHECK(statistics.committedBytes == statistics.usedBytes + statistics.availableBytes);
+
+        // The array's segment is a large object
+        REQUIRE(JsGetRuntimeHeapSpaceStatistics(runtime, JsHeapSpace_LargeObject, &statistics) == JsNoError);
+        CHECK(statistics.usedBytes >= 1024 * 1024 * sizeof(int));
+
+        REQUIRE(JsGetRuntimeHeapSpaceStatistics(runtime, JsHeapSpace_Leaf, &statistics) == JsNoError);
+        REQUIRE(JsGetRuntimeHeapSpaceStatistics(runtime, JsHeapSpace_Code, &statistics) == JsNoError);
+        CHECK(statistics.committedBytes >= statistics.usedBytes);
+
+        CHECK(JsGetRuntimeHeapSpaceStatistics(runtime, (JsHeapSpace)4, &statistics) == JsErrorInvalidArgument);
+        CHECK(JsGetRuntimeHeapSpaceStatistics(runtime, JsHeapSpace_Object, nullptr) == JsErrorNullArgument);
+    }
+
+    TEST_CASE("ApiTest_HeapSpaceStatisticsTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::HeapSpaceStatisticsTest);
+    }
+
+    struct GarbageCollectionEvents
+    {
+        int beginCount;
+        int endCount;
+        JsGarbageCollectionInfo lastInfo;
+    };
+
+    void CHAKRA_CALLBACK GarbageCollectionCallback(JsGarbageCollectionEvent event, const JsGarbageCollectionInfo *info, void *callbackState)
+    {
+        GarbageCollectionEvents * events = static_cast<GarbageCollectionEvents *>(callbackState);
+        if (event == JsGarbageCollectionEvent_Begin)
+        {
+            events->beginCount++;
+        }
+        else
+        {
+            events->endCount++;
+        }
+        events->lastInfo = *info;
+    }
+
+    void GarbageCollectionCallbackTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        GarbageCollectionEvents events = {};
+        REQUIRE(JsSetRuntimeGarbageCollectionCallback(runtime, &events, GarbageCollectionCallback) == JsNoError);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+
+        // An exhaustive collection can take more than one pass, each one is reported
+        CHECK(events.beginCount >= 1);
+        CHECK(events.endCount == events.beginCount);
+        CHECK((events.lastInfo.flags & JsGarbageCollectionFlags_Exhaustive) == JsGarbageCollectionFlags_Exhaustive);
+        CHECK((events.lastInfo.flags & JsGarbageCollectionFlags_Partial) == 0);
+        CHECK(events.lastInfo.usedBytesBefore - events.lastInfo.freedBytes <= events.lastInfo.usedBytesAfter);
+
+        // Nothing is reported once the callback is removed
+        int count = events.beginCount;
+        REQUIRE(JsSetRuntimeGarbageCollectionCallback(runtime, nullptr, nullptr) == JsNoError);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(events.beginCount == count);
+        CHECK(events.endCount == count);
+
+        CHECK(JsSetRuntimeGarbageCollectionCallback(JS_INVALID_RUNTIME_HANDLE, nullptr, nullptr) == JsErrorInvalidArgument);
+    }
+
+    TEST_CASE("ApiTest_GarbageCollectionCallbackTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::GarbageCollectionCallbackTest);
+    }
+
+    struct ProfileSamplerArgs
+    {
+        JsRuntimeHandle runtime;
+        volatile LONG requestCount;
+    };
+
+    unsigned int CALLBACK ProfileSamplerThreadProc(void* arg)
+    {
+        ProfileSamplerArgs * args = static_cast<ProfileSamplerArgs *>(arg);
+        while (args->requestCount < 50)
+        {
+            JsRequestProfileSample(args->runtime, false);
+            InterlockedIncrement(&args->requestCount);
+            Sleep(1);
+        }
+        return 0;
+    }
+
+    JsValueRef CALLBACK ProfileSamplerDoneCallback(JsValueRef callee, bool isConstructCall, JsValueRef *arguments, unsigned short argumentCount, void *callbackState)
+    {
+        ProfileSamplerArgs * args = static_cast<ProfileSamplerArgs *>(callbackState);
+        JsValueRef result = JS_INVALID_REFERENCE;
+        JsBoolToBoolean(args->requestCount >= 50, &result);
+        return result;
+    }
+
+    const JsProfileNode * FindProfileNode(const JsProfile * profile, const char * functionName)
+    {
+        for (size_t i = 0; i < profile->nodeCount; i++)
+        {
+            if (strcmp(profile->nodes[i].functionName, functionName) == 0)
+            {
+                return &profile->nodes[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void ProfilerTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        REQUIRE(JsStartProfiling(runtime) == JsNoError);
+        CHECK(JsStartProfiling(runtime) == JsErrorAlreadyProfilingContext);
+
+        // Outside of script samples are recorded right away
+        REQUIRE(JsRequestProfileSample(runtime, true) == JsNoError);
+        REQUIRE(JsRequestProfileSample(runtime, false) == JsNoError);
+
+        // Script samples are taken at the stack probes of the function calls
+        ProfileSamplerArgs args = { runtime, 0 };
+        JsValueRef done = JS_INVALID_REFERENCE;
+        JsValueRef global = JS_INVALID_REFERENCE;
+        JsPropertyIdRef doneId = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateFunction(ProfileSamplerDoneCallback, &args, &done) == JsNoError);
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(_u("done"), &doneId) == JsNoError);
+        REQUIRE(JsSetProperty(global, doneId, done, true) == JsNoError);
+
+        HANDLE threadHandle = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &ProfileSamplerThreadProc, &args, 0, nullptr));
+        REQUIRE(threadHandle != nullptr);
+        if (threadHandle == nullptr)
+        {
+            // This is to satisfy preFAST, above REQUIRE call ensuring that it will report exception when threadHandle is null.
+            return;
+        }
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("function leaf(i) { return i * 2; } function inner() { var n = 0; for (var i = 0; i < 1000; i++) { n += leaf(i); } return n; } while (!done()) { inner(); }"), JS_SOURCE_CONTEXT_NONE, _u("profile.js"), &result) == JsNoError);
+        WaitForSingleObject(threadHandle, INFINITE);
+        CloseHandle(threadHandle);
+
+        JsProfile * profile = nullptr;
+        REQUIRE(JsStopProfiling(runtime, &profile) == JsNoError);
+        REQUIRE(profile != nullptr);
+        CHECK(profile->endTime >= profile->startTime);
+        REQUIRE(profile->nodeCount >= 3);
+        CHECK(strcmp(profile->nodes[0].functionName, "(root)") == 0);
+        CHECK(profile->nodes[0].parentId == 0);
+
+        const JsProfileNode * idle = FindProfileNode(profile, "(idle)");
+        REQUIRE(idle != nullptr);
+        CHECK(idle->parentId == 0);
+        CHECK(idle->hitCount >= 1);
+        CHECK(FindProfileNode(profile, "(program)") != nullptr);
+
+        const JsProfileNode * inner = FindProfileNode(profile, "inner");
+        REQUIRE(inner != nullptr);
+        CHECK(strcmp(inner->url, "profile.js") == 0);
+        CHECK(inner->lineNumber == 0);
+        CHECK(inner->scriptId != 0);
+        CHECK(inner->parentId != 0);
+
+        // Samples point at nodes, in the order they were taken
+        size_t hitCount = 0;
+        for (size_t i = 0; i < profile->nodeCount; i++)
+        {
+            CHECK(profile->nodes[i].id == i);
+            CHECK(profile->nodes[i].parentId <= i);
+            hitCount += profile->nodes[i].hitCount;
+        }
+        CHECK(hitCount == profile->sampleCount);
+        for (size_t i = 0; i < profile->sampleCount; i++)
+        {
+            CHECK(profile->samples[i] < profile->nodeCount);
+            CHECK(i == 0 || profile->timestamps[i] >= profile->timestamps[i - 1]);
+        }
+
+        REQUIRE(JsReleaseProfile(profile) == JsNoError);
+        CHECK(JsStopProfiling(runtime, &profile) == JsErrorInvalidArgument);
+        CHECK(JsRequestProfileSample(runtime, false) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_ProfilerTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ProfilerTest);
+    }
+
+    size_t FindHeapSnapshotEdge(const JsHeapSnapshot * snapshot, size_t fromNode, const char * name)
+    {
+        size_t edge = 0;
+        for (size_t i = 0; i < fromNode; i++)
+        {
+            edge += snapshot->nodes[i].edgeCount;
+        }
+        for (size_t i = 0; i < snapshot->nodes[fromNode].edgeCount; i++, edge++)
+        {
+            const JsHeapSnapshotEdge * current = &snapshot->edges[edge];
+            if ((current->type == JsHeapSnapshotEdgeType_Property || current->type == JsHeapSnapshotEdgeType_Context) &&
+                strcmp(snapshot->strings[current->nameOrIndex], name) == 0)
+            {
+                return current->toNode;
+            }
+        }
+        return (size_t)-1;
+    }
+
+    void HeapSnapshotTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("class Leaky { constructor() { this.payload = 'snapshot payload'; } } var kept = [new Leaky()]; function outer() { var captured = new Leaky(); return function inner() { return captured; }; } var closure = outer();"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+
+        JsValueRef pinned = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateObject(&pinned) == JsNoError);
+        REQUIRE(JsAddRef(pinned, nullptr) == JsNoError);
+
+        JsHeapSnapshot * snapshot = nullptr;
+        REQUIRE(JsTakeHeapSnapshot(runtime, &snapshot) == JsNoError);
+        REQUIRE(snapshot != nullptr);
+        REQUIRE(snapshot->nodeCount > 4);
+        CHECK(snapshot->nodes[0].type == JsHeapSnapshotNodeType_Synthetic);
+        CHECK(strcmp(snapshot->strings[snapshot->nodes[1].name], "(GC roots)") == 0);
+
+        // Edges follow the nodes in order and point at nodes of the snapshot
+        size_t edgeCount = 0;
+        size_t globalNode = (size_t)-1;
+        for (size_t i = 0; i < snapshot->nodeCount; i++)
+        {
+            CHECK(snapshot->nodes[i].name < snapshot->stringCount);
+            CHECK(snapshot->nodes[i].id == i * 2 + 1);
+            edgeCount += snapshot->nodes[i].edgeCount;
+        }
+        REQUIRE(edgeCount == snapshot->edgeCount);
+        for (size_t i = 0; i < snapshot->edgeCount; i++)
+        {
+            CHECK(snapshot->edges[i].toNode < snapshot->nodeCount);
+            if (i < snapshot->nodes[0].edgeCount && snapshot->edges[i].type == JsHeapSnapshotEdgeType_Shortcut)
+            {
+                globalNode = snapshot->edges[i].toNode;
+            }
+        }
+        REQUIRE(globalNode != (size_t)-1);
+
+        // Instances are named by their constructor, closures reach their captured variables
+        size_t kept = FindHeapSnapshotEdge(snapshot, globalNode, "kept");
+        REQUIRE(kept != (size_t)-1);
+        CHECK(snapshot->nodes[kept].edgeCount > 0);
+
+        size_t closure = FindHeapSnapshotEdge(snapshot, globalNode, "closure");
+        REQUIRE(closure != (size_t)-1);
+        CHECK(snapshot->nodes[closure].type == JsHeapSnapshotNodeType_Closure);
+        CHECK(strcmp(snapshot->strings[snapshot->nodes[closure].name], "inner") == 0);
+
+        bool foundLeaky = false;
+        bool foundPayload = false;
+        for (size_t i = 0; i < snapshot->nodeCount; i++)
+        {
+            const char * name = snapshot->strings[snapshot->nodes[i].name];
+            foundLeaky |= snapshot->nodes[i].type == JsHeapSnapshotNodeType_Object && strcmp(name, "Leaky") == 0;
+            foundPayload |= snapshot->nodes[i].type == JsHeapSnapshotNodeType_String && strcmp(name, "snapshot payload") == 0;
+        }
+        CHECK(foundLeaky);
+        CHECK(foundPayload);
+
+        REQUIRE(JsReleaseHeapSnapshot(snapshot) == JsNoError);
+        REQUIRE(JsRelease(pinned, nullptr) == JsNoError);
+        CHECK(JsTakeHeapSnapshot(runtime, nullptr) == JsErrorNullArgument);
+    }
+
+    TEST_CASE("ApiTest_HeapSnapshotTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::HeapSnapshotTest);
+    }
+
+    JsValueRef CALLBACK CaptureStackTraceCallback(JsValueRef callee, bool isConstructCall, JsValueRef *arguments, unsigned short argumentCount, void *callbackState)
+    {
+        JsValueRef stackTrace = JS_INVALID_REFERENCE;
+        JsValueRef skipUntil = argumentCount > 1 ? arguments[1] : JS_INVALID_REFERENCE;
+        JsValueRef frames = JS_INVALID_REFERENCE;
+        if (JsCaptureStackTrace(skipUntil, 10, &stackTrace) != JsNoError ||
+            JsGetStackTraceFrames(stackTrace, &frames) != JsNoError)
+        {
+            return JS_INVALID_REFERENCE;
+        }
+        return frames;
+    }
+
+    JsValueRef GetStackTraceFrameProperty(JsValueRef frames, int index, LPCWSTR name)
+    {
+        JsValueRef indexRef = JS_INVALID_REFERENCE;
+        JsValueRef frame = JS_INVALID_REFERENCE;
+        JsPropertyIdRef propertyId = JS_INVALID_REFERENCE;
+        JsValueRef value = JS_INVALID_REFERENCE;
+        REQUIRE(JsIntToNumber(index, &indexRef) == JsNoError);
+        REQUIRE(JsGetIndexedProperty(frames, indexRef, &frame) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(name, &propertyId) == JsNoError);
+        REQUIRE(JsGetProperty(frame, propertyId, &value) == JsNoError);
+        return value;
+    }
+
+    int GetStackTraceFrameCount(JsValueRef frames)
+    {
+        JsPropertyIdRef lengthId = JS_INVALID_REFERENCE;
+        JsValueRef lengthRef = JS_INVALID_REFERENCE;
+        int length = 0;
+        REQUIRE(JsGetPropertyIdFromName(_u("length"), &lengthId) == JsNoError);
+        REQUIRE(JsGetProperty(frames, lengthId, &lengthRef) == JsNoError);
+        REQUIRE(JsNumberToInt(lengthRef, &length) == JsNoError);
+        return length;
+    }
+
+    void StackTraceTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef capture = JS_INVALID_REFERENCE;
+        JsValueRef global = JS_INVALID_REFERENCE;
+        JsPropertyIdRef captureId = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateFunction(CaptureStackTraceCallback, nullptr, &capture) == JsNoError);
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(_u("capture"), &captureId) == JsNoError);
+        REQUIRE(JsSetProperty(global, captureId, capture, true) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("function inner() {\n  return capture();\n}\nfunction outer() {\n  return inner();\n}\nfunction skipped() {\n  return capture(skipped);\n}\nfunction callsSkipped() {\n  return skipped();\n}"), JS_SOURCE_CONTEXT_NONE, _u("stack.js"), &result) == JsNoError);
+
+        // Frames start at the most recent call, with 1-based positions
+        JsValueRef frames = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("outer()"), JS_SOURCE_CONTEXT_NONE, _u(""), &frames) == JsNoError);
+        REQUIRE(GetStackTraceFrameCount(frames) >= 2);
+
+        const WCHAR * str = nullptr;
+        size_t strLength = 0;
+        int value = 0;
+        REQUIRE(JsStringToPointer(GetStackTraceFrameProperty(frames, 0, _u("name")), &str, &strLength) == JsNoError);
+        CHECK(wcscmp(str, _u("inner")) == 0);
+        REQUIRE(JsStringToPointer(GetStackTraceFrameProperty(frames, 0, _u("url")), &str, &strLength) == JsNoError);
+        CHECK(wcscmp(str, _u("stack.js")) == 0);
+        REQUIRE(JsNumberToInt(GetStackTraceFrameProperty(frames, 0, _u("line")), &value) == JsNoError);
+        CHECK(value == 2);
+        REQUIRE(JsNumberToInt(GetStackTraceFrameProperty(frames, 0, _u("column")), &value) == JsNoError);
+        CHECK(value > 0);
+        REQUIRE(JsStringToPointer(GetStackTraceFrameProperty(frames, 1, _u("name")), &str, &strLength) == JsNoError);
+        CHECK(wcscmp(str, _u("outer")) == 0);
+        REQUIRE(JsNumberToInt(GetStackTraceFrameProperty(frames, 1, _u("line")), &value) == JsNoError);
+        CHECK(value == 5);
+
+        // The frames of the function to skip and above it are left out
+        REQUIRE(JsRunScript(_u("callsSkipped()"), JS_SOURCE_CONTEXT_NONE, _u(""), &frames) == JsNoError);
+        REQUIRE(JsStringToPointer(GetStackTraceFrameProperty(frames, 0, _u("name")), &str, &strLength) == JsNoError);
+        CHECK(wcscmp(str, _u("callsSkipped")) == 0);
+
+        // Nothing is captured if the function to skip isn't on the stack
+        REQUIRE(JsRunScript(_u("capture(function notOnStack() {})"), JS_SOURCE_CONTEXT_NONE, _u(""), &frames) == JsNoError);
+        CHECK(GetStackTraceFrameCount(frames) == 0);
+
+        JsValueRef object = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateObject(&object) == JsNoError);
+        CHECK(JsGetStackTraceFrames(object, &frames) == JsErrorInvalidArgument);
+    }
+
+    TEST_CASE("ApiTest_StackTraceTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::StackTraceTest);
+    }
+
+    void IdleNotificationTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var garbage = [];\nfor (var i = 0; i < 10000; i++) { garbage.push({ i: i }); }\ngarbage = null;"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+
+        bool done = false;
+        if (!(attributes & JsRuntimeAttributeEnableIdleProcessing))
+        {
+            CHECK(JsIdleNotification(100, &done) == JsErrorIdleNotEnabled);
+            CHECK(!done);
+        }
+        else
+        {
+            // Keep telling the runtime it is idle until it has collected and decommitted
+            for (int i = 0; i < 1000 && !done; i++)
+            {
+                REQUIRE(JsIdleNotification(100, &done) == JsNoError);
+                if (!done)
+                {
+                    Sleep(1);
+                }
+            }
+            CHECK(done);
+
+            // Nothing is left to do until script runs again
+            REQUIRE(JsIdleNotification(100, &done) == JsNoError);
+            CHECK(done);
+        }
+
+        CHECK(JsIdleNotification(100, nullptr) == JsErrorNullArgument);
+
+        JsValueRef valueRef = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateObject(&valueRef) == JsNoError);
+        JsWeakRef weakRef = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateWeakReference(valueRef, &weakRef) == JsNoError);
+        valueRef = JS_INVALID_REFERENCE;
+
+        CHECK(JsLowMemoryNotification(runtime) == JsNoError);
+
+        CHECK(JsGetWeakReferenceValue(weakRef, &valueRef) == JsNoError);
+        CHECK(valueRef == JS_INVALID_REFERENCE);
+    }
+
+    TEST_CASE("ApiTest_IdleNotificationTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::IdleNotificationTest);
+    }
+
+    void * CHAKRA_CALLBACK ReallocateSerializerBuffer(void * buffer, size_t size, size_t * allocatedSize, void * callbackState)
+    {
+        void * result = realloc(buffer, size);
+        *allocatedSize = result != nullptr ? size : 0;
+        return result;
+    }
+
+    void CHAKRA_CALLBACK FreeSerializerBuffer(void * buffer, void * callbackState)
+    {
+        free(buffer);
+    }
+
+    void ValueSerializerTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueSerializerCallbacks callbacks = {};
+        callbacks.reallocateBuffer = ReallocateSerializerBuffer;
+        callbacks.freeBuffer = FreeSerializerBuffer;
+
+        JsValueRef object = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("var o = {}; o.foo = o; o"), JS_SOURCE_CONTEXT_NONE, _u(""), &object) == JsNoError);
+
+        // The bytes are the same as V8 writes, including the back reference to the object itself
+        JsValueSerializerHandle serializer = nullptr;
+        REQUIRE(JsCreateValueSerializer(&callbacks, nullptr, &serializer) == JsNoError);
+        REQUIRE(JsValueSerializerWriteHeader(serializer) == JsNoError);
+        REQUIRE(JsValueSerializerWriteValue(serializer, object) == JsNoError);
+
+        void * buffer = nullptr;
+        size_t size = 0;
+        REQUIRE(JsValueSerializerReleaseBuffer(serializer, &buffer, &size) == JsNoError);
+        REQUIRE(JsDisposeValueSerializer(serializer) == JsNoError);
+
+        const unsigned char expected[] = { 0xFF, 0x0D, 'o', '"', 0x03, 'f', 'o', 'o', '^', 0x00, '{', 0x01 };
+        REQUIRE(size == sizeof(expected));
+        CHECK(memcmp(buffer, expected, size) == 0);
+
+        JsValueDeserializerHandle deserializer = nullptr;
+        REQUIRE(JsCreateValueDeserializer(buffer, size, nullptr, nullptr, &deserializer) == JsNoError);
+        REQUIRE(JsValueDeserializerReadHeader(deserializer) == JsNoError);
+
+        unsigned int version = 0;
+        REQUIRE(JsValueDeserializerGetWireFormatVersion(deserializer, &version) == JsNoError);
+        CHECK(version == 13);
+
+        JsValueRef copy = JS_INVALID_REFERENCE;
+        REQUIRE(JsValueDeserializerReadValue(deserializer, &copy) == JsNoError);
+        REQUIRE(JsDisposeValueDeserializer(deserializer) == JsNoError);
+        free(buffer);
+
+        JsPropertyIdRef foo = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetPropertyIdFromName(_u("foo"), &foo) == JsNoError);
+        JsValueRef fooValue = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetProperty(copy, foo, &fooValue) == JsNoError);
+        bool equal = false;
+        REQUIRE(JsStrictEquals(copy, fooValue, &equal) == JsNoError);
+        CHECK(equal);
+        REQUIRE(JsStrictEquals(copy, object, &equal) == JsNoError);
+        CHECK(!equal);
+
+        // Functions can't be cloned
+        JsValueRef function = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("(function () {})"), JS_SOURCE_CONTEXT_NONE, _u(""), &function) == JsNoError);
+        REQUIRE(JsCreateValueSerializer(&callbacks, nullptr, &serializer) == JsNoError);
+        CHECK(JsValueSerializerWriteValue(serializer, function) == JsErrorScriptException);
+        REQUIRE(JsDisposeValueSerializer(serializer) == JsNoError);
+
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+    }
+
+    TEST_CASE("ApiTest_ValueSerializerTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ValueSerializerTest);
+    }
+
     void ObjectsAndPropertiesTest1(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
     {
         JsValueRef object = JS_INVALID_REFERENCE;
@@ -359,6 +1165,376 @@ namespace JsRTApiTest
         JsRTApiTest::RunWithAttributes(JsRTApiTest::ExternalDataOnJsrtContextTest);
     }
 
+    void ExternalObjectFieldsTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        int data = 5;
+        JsValueRef object = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalObjectWithFields(&data, nullptr, 3, &object) == JsNoError);
+
+        void *externalData = nullptr;
+        REQUIRE(JsGetExternalData(object, &externalData) == JsNoError);
+        CHECK(externalData == &data);
+
+        void *field = &data;
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            REQUIRE(JsGetExternalObjectField(object, i, &field) == JsNoError);
+            CHECK(field == nullptr);
+        }
+
+        REQUIRE(JsSetExternalObjectField(object, 1, &data) == JsNoError);
+        REQUIRE(JsGetExternalObjectField(object, 1, &field) == JsNoError);
+        CHECK(field == &data);
+        CHECK(JsGetExternalObjectField(object, 3, &field) == JsErrorInvalidArgument);
+        CHECK(JsSetExternalObjectField(object, 3, &data) == JsErrorInvalidArgument);
+
+        // Objects without fields and plain objects have no fields to access
+        JsValueRef other = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalObject(&data, nullptr, &other) == JsNoError);
+        CHECK(JsGetExternalObjectField(other, 0, &field) == JsErrorInvalidArgument);
+        REQUIRE(JsCreateObject(&other) == JsNoError);
+        CHECK(JsSetExternalObjectField(other, 0, &data) == JsErrorInvalidArgument);
+
+        // A value stored in a field is kept alive by the object
+        static const uint16_t content[] = { 'f', 'i', 'e', 'l', 'd' };
+        int finalizeCount = 0;
+        JsValueRef value = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalStringUtf16(content, _countof(content), ExternalStringFinalizeCallback, &finalizeCount, &value) == JsNoError);
+        REQUIRE(JsSetExternalObjectField(object, 2, value) == JsNoError);
+        value = JS_INVALID_REFERENCE;
+
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(finalizeCount == 0);
+        REQUIRE(JsGetExternalObjectField(object, 2, &field) == JsNoError);
+        int length = 0;
+        REQUIRE(JsGetStringLength(static_cast<JsValueRef>(field), &length) == JsNoError);
+        CHECK(length == 5);
+    }
+
+    TEST_CASE("ApiTest_ExternalObjectFieldsTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ExternalObjectFieldsTest);
+    }
+
+    void CHAKRA_CALLBACK ExternalObjectWeakCallback(JsValueRef object, void *callbackState, void *callbackData)
+    {
+        CHECK(callbackData == callbackState);
+        (*static_cast<int*>(callbackState))++;
+    }
+
+    void CHAKRA_CALLBACK ReviveExternalObjectWeakCallback(JsValueRef object, void *callbackState, void *callbackData)
+    {
+        (*static_cast<int*>(callbackState))++;
+        // Setting a new callback keeps the object alive until the next collection
+        REQUIRE(JsSetExternalObjectWeakCallback(object, ExternalObjectWeakCallback, callbackState, callbackState) == JsNoError);
+    }
+
+    void ExternalObjectWeakCallbackTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        int callCount = 0;
+        JsValueRef object = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalObject(nullptr, nullptr, &object) == JsNoError);
+        REQUIRE(JsSetExternalObjectWeakCallback(object, ExternalObjectWeakCallback, &callCount, &callCount) == JsNoError);
+        REQUIRE(JsSetExternalObjectWeakCallback(object, nullptr, nullptr, nullptr) == JsNoError);
+
+        // Only external objects can hold a weak callback
+        JsValueRef other = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateObject(&other) == JsNoError);
+        CHECK(JsSetExternalObjectWeakCallback(other, ExternalObjectWeakCallback, &callCount, &callCount) == JsErrorInvalidArgument);
+        other = JS_INVALID_REFERENCE;
+
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(callCount == 0);
+
+        REQUIRE(JsSetExternalObjectWeakCallback(object, ReviveExternalObjectWeakCallback, &callCount, nullptr) == JsNoError);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(callCount == 0);
+
+        // Clear the reference on the stack, so that the object will be GC'd.
+        object = JS_INVALID_REFERENCE;
+
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(callCount == 1);
+        REQUIRE(JsCollectGarbage(runtime) == JsNoError);
+        CHECK(callCount == 2);
+    }
+
+    TEST_CASE("ApiTest_ExternalObjectWeakCallbackTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ExternalObjectWeakCallbackTest);
+    }
+
+    static int interceptedGetCount = 0;
+    static int interceptedSetCount = 0;
+
+    bool IsInterceptedName(JsValueRef name)
+    {
+        static const uint16_t answer[] = { 'a', 'n', 's', 'w', 'e', 'r' };
+        uint16_t buffer[8];
+        size_t written = 0;
+        JsValueType type;
+        return JsGetValueType(name, &type) == JsNoError && type == JsString &&
+            JsCopyStringUtf16(name, 0, _countof(buffer), buffer, &written) == JsNoError &&
+            written == _countof(answer) && memcmp(buffer, answer, sizeof(answer)) == 0;
+    }
+
+    bool CALLBACK InterceptorNamedGetter(JsValueRef /* object */, JsValueRef name, JsValueRef *value)
+    {
+        if (!IsInterceptedName(name))
+        {
+            return false;
+        }
+        interceptedGetCount++;
+        return JsIntToNumber(42, value) == JsNoError;
+    }
+
+    bool CALLBACK InterceptorNamedSetter(JsValueRef /* object */, JsValueRef name, JsValueRef /* value */)
+    {
+        if (!IsInterceptedName(name))
+        {
+            return false;
+        }
+        interceptedSetCount++;
+        return true;
+    }
+
+    void InterceptorObjectTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsPropertyInterceptors interceptors = {};
+        interceptors.namedGetter = InterceptorNamedGetter;
+        interceptors.namedSetter = InterceptorNamedSetter;
+
+        int data = 5;
+        JsValueRef object = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalObjectWithInterceptors(&data, nullptr, 1, &interceptors, &object) == JsNoError);
+
+        void *externalData = nullptr;
+        REQUIRE(JsGetExternalData(object, &externalData) == JsNoError);
+        CHECK(externalData == &data);
+        REQUIRE(JsSetExternalObjectField(object, 0, &data) == JsNoError);
+
+        JsValueRef global = JS_INVALID_REFERENCE;
+        JsPropertyIdRef propertyId = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(_u("o"), &propertyId) == JsNoError);
+        REQUIRE(JsSetProperty(global, propertyId, object, true) == JsNoError);
+
+        // Declined lookups land on ordinary properties, intercepted ones call the host every time
+        interceptedGetCount = 0;
+        interceptedSetCount = 0;
+        JsValueRef result = JS_INVALID_REFERENCE;
+        int value = 0;
+        REQUIRE(JsRunScript(_u("o.plain = 1; var r = 0; for (var i = 0; i < 10; i++) { r += o.answer + o.plain; } r"),
+            JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        REQUIRE(JsNumberToInt(result, &value) == JsNoError);
+        CHECK(value == 430);
+        CHECK(interceptedGetCount == 10);
+
+        REQUIRE(JsRunScript(_u("o.answer = 1; var p = Object.create(o); [o.answer, p.answer, 'answer' in o, o.hasOwnProperty('plain')].join()"),
+            JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        const WCHAR *str = nullptr;
+        size_t length = 0;
+        REQUIRE(JsStringToPointer(result, &str, &length) == JsNoError);
+        CHECK(wcscmp(str, _u("42,42,true,true")) == 0);
+        CHECK(interceptedSetCount == 1);
+
+        void *field = nullptr;
+        REQUIRE(JsGetExternalObjectField(object, 0, &field) == JsNoError);
+        CHECK(field == &data);
+    }
+
+    TEST_CASE("ApiTest_InterceptorObjectTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::InterceptorObjectTest);
+    }
+
+    void ObjectWithPropertiesTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // Properties are defined, a setter on the prototype chain must not run
+        REQUIRE(JsRunScript(_u("Object.defineProperty(Object.prototype, 'c', { set: function () { throw new Error(); }, configurable: true })"),
+            JS_SOURCE_CONTEXT_NONE, _u(""), nullptr) == JsNoError);
+
+        JsPropertyIdRef propertyIds[3] = { JS_INVALID_REFERENCE, JS_INVALID_REFERENCE, JS_INVALID_REFERENCE };
+        JsValueRef values[3] = { JS_INVALID_REFERENCE, JS_INVALID_REFERENCE, JS_INVALID_REFERENCE };
+        REQUIRE(JsGetPropertyIdFromName(_u("a"), &propertyIds[0]) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(_u("b"), &propertyIds[1]) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(_u("c"), &propertyIds[2]) == JsNoError);
+        REQUIRE(JsIntToNumber(1, &values[0]) == JsNoError);
+        REQUIRE(JsIntToNumber(2, &values[1]) == JsNoError);
+        REQUIRE(JsIntToNumber(3, &values[2]) == JsNoError);
+
+        JsValueRef object = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateObjectWithProperties(propertyIds, values, 3, &object) == JsNoError);
+
+        for (int i = 0; i < 3; i++)
+        {
+            JsValueRef value = JS_INVALID_REFERENCE;
+            int intValue = 0;
+            REQUIRE(JsGetProperty(object, propertyIds[i], &value) == JsNoError);
+            REQUIRE(JsNumberToInt(value, &intValue) == JsNoError);
+            CHECK(intValue == i + 1);
+        }
+
+        JsValueRef global = JS_INVALID_REFERENCE;
+        JsPropertyIdRef objectId = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetGlobalObject(&global) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromName(_u("o"), &objectId) == JsNoError);
+        REQUIRE(JsSetProperty(global, objectId, object, true) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("JSON.stringify(o) + Object.getOwnPropertyDescriptor(o, 'c').enumerable"),
+            JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        const WCHAR *str = nullptr;
+        size_t length = 0;
+        REQUIRE(JsStringToPointer(result, &str, &length) == JsNoError);
+        CHECK(wcscmp(str, _u("{\"a\":1,\"b\":2,\"c\":3}true")) == 0);
+
+        // An empty object and invalid arguments
+        REQUIRE(JsCreateObjectWithProperties(nullptr, nullptr, 0, &object) == JsNoError);
+        propertyIds[1] = JS_INVALID_REFERENCE;
+        CHECK(JsCreateObjectWithProperties(propertyIds, values, 3, &object) == JsErrorInvalidArgument);
+        CHECK(JsCreateObjectWithProperties(nullptr, values, 3, &object) == JsErrorNullArgument);
+    }
+
+    TEST_CASE("ApiTest_ObjectWithPropertiesTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ObjectWithPropertiesTest);
+    }
+
+    void PropertyIdFromStringTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsPropertyIdRef propertyId = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetPropertyIdFromName(_u("foo"), &propertyId) == JsNoError);
+
+        // A flat string and a concatenated one both resolve to the same property ID
+        JsValueRef string = JS_INVALID_REFERENCE;
+        JsPropertyIdRef stringPropertyId = JS_INVALID_REFERENCE;
+        REQUIRE(JsPointerToString(_u("foo"), 3, &string) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromString(string, &stringPropertyId) == JsNoError);
+        CHECK(stringPropertyId == propertyId);
+
+        REQUIRE(JsRunScript(_u("'f' + 'oo'.repeat(1)"), JS_SOURCE_CONTEXT_NONE, _u(""), &string) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromString(string, &stringPropertyId) == JsNoError);
+        CHECK(stringPropertyId == propertyId);
+
+        // The interned string is cached and round-trips to the same property ID
+        JsValueRef internedString = JS_INVALID_REFERENCE;
+        JsValueRef internedString2 = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetPropertyIdString(propertyId, &internedString) == JsNoError);
+        REQUIRE(JsGetPropertyIdString(propertyId, &internedString2) == JsNoError);
+        CHECK(internedString == internedString2);
+        REQUIRE(JsGetPropertyIdFromString(internedString, &stringPropertyId) == JsNoError);
+        CHECK(stringPropertyId == propertyId);
+
+        const WCHAR *str = nullptr;
+        size_t length = 0;
+        REQUIRE(JsStringToPointer(internedString, &str, &length) == JsNoError);
+        CHECK(length == 3);
+        CHECK(wcscmp(str, _u("foo")) == 0);
+
+        // Symbols and non-strings are rejected
+        JsValueRef number = JS_INVALID_REFERENCE;
+        REQUIRE(JsIntToNumber(1, &number) == JsNoError);
+        CHECK(JsGetPropertyIdFromString(number, &stringPropertyId) == JsErrorPropertyNotString);
+
+        JsValueRef symbol = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateSymbol(string, &symbol) == JsNoError);
+        REQUIRE(JsGetPropertyIdFromSymbol(symbol, &propertyId) == JsNoError);
+        CHECK(JsGetPropertyIdString(propertyId, &internedString) == JsErrorPropertyNotString);
+    }
+
+    TEST_CASE("ApiTest_PropertyIdFromStringTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::PropertyIdFromStringTest);
+    }
+
+    void CallFunctionsTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        JsValueRef functions[3] = { JS_INVALID_REFERENCE, JS_INVALID_REFERENCE, JS_INVALID_REFERENCE };
+        REQUIRE(JsRunScript(_u("var calls = ''; (function () { calls += 'a'; })"), JS_SOURCE_CONTEXT_NONE, _u(""), &functions[0]) == JsNoError);
+        REQUIRE(JsRunScript(_u("(function () { calls += 'b'; throw new Error(); })"), JS_SOURCE_CONTEXT_NONE, _u(""), &functions[1]) == JsNoError);
+        REQUIRE(JsRunScript(_u("(function () { calls += 'c'; })"), JS_SOURCE_CONTEXT_NONE, _u(""), &functions[2]) == JsNoError);
+
+        // Calling stops at the function that threw, and resumes after it
+        unsigned int callCount = 0;
+        CHECK(JsCallFunctions(functions, 3, &callCount) == JsErrorScriptException);
+        CHECK(callCount == 2);
+
+        JsValueRef exception = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetAndClearException(&exception) == JsNoError);
+        REQUIRE(JsCallFunctions(functions + callCount, 3 - callCount, &callCount) == JsNoError);
+        CHECK(callCount == 1);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunScript(_u("calls"), JS_SOURCE_CONTEXT_NONE, _u(""), &result) == JsNoError);
+        const WCHAR *str = nullptr;
+        size_t length = 0;
+        REQUIRE(JsStringToPointer(result, &str, &length) == JsNoError);
+        CHECK(wcscmp(str, _u("abc")) == 0);
+
+        // Non-functions are rejected without being counted
+        REQUIRE(JsGetUndefinedValue(&functions[1]) == JsNoError);
+        CHECK(JsCallFunctions(functions, 3, &callCount) == JsErrorInvalidArgument);
+        CHECK(callCount == 1);
+        CHECK(JsCallFunctions(nullptr, 0, &callCount) == JsNoError);
+        CHECK(callCount == 0);
+    }
+
+    TEST_CASE("ApiTest_CallFunctionsTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::CallFunctionsTest);
+    }
+
+    void SerializedScriptVersionTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        unsigned int version = 0;
+        unsigned int sameVersion = 0;
+        REQUIRE(JsGetSerializedScriptVersion(&version) == JsNoError);
+        REQUIRE(JsGetSerializedScriptVersion(&sameVersion) == JsNoError);
+        CHECK(version == sameVersion);
+        CHECK(JsGetSerializedScriptVersion(nullptr) == JsErrorNullArgument);
+
+        // String sources are serialized as Utf16, and loaded back from the same string
+        const WCHAR *source = _u("(function () { return 'caf\u00e9'; }).toString()");
+        JsValueRef sourceRef = JS_INVALID_REFERENCE;
+        REQUIRE(JsPointerToString(source, wcslen(source), &sourceRef) == JsNoError);
+
+        JsValueRef serialized = JS_INVALID_REFERENCE;
+        REQUIRE(JsSerialize(sourceRef, &serialized, JsParseScriptAttributeNone) == JsNoError);
+
+        BYTE *serializedBytes = nullptr;
+        unsigned int serializedLength = 0;
+        REQUIRE(JsGetArrayBufferStorage(serialized, &serializedBytes, &serializedLength) == JsNoError);
+
+        BYTE *buffer = new BYTE[serializedLength];
+        memcpy(buffer, serializedBytes, serializedLength);
+        JsValueRef bufferRef = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateExternalArrayBuffer(buffer, serializedLength,
+            [](void *data) { delete[] (BYTE *)data; }, buffer, &bufferRef) == JsNoError);
+
+        JsValueRef url = JS_INVALID_REFERENCE;
+        REQUIRE(JsCreateString("", 0, &url) == JsNoError);
+
+        JsValueRef result = JS_INVALID_REFERENCE;
+        REQUIRE(JsRunSerialized(bufferRef,
+            [](JsSourceContext sourceContext, JsValueRef *value, JsParseScriptAttributes *parseAttributes)
+        {
+            *value = *(JsValueRef *)sourceContext;
+            *parseAttributes = JsParseScriptAttributeNone;
+            return true;
+        }, (JsSourceContext)&sourceRef, url, &result) == JsNoError);
+
+        const WCHAR *str = nullptr;
+        size_t length = 0;
+        REQUIRE(JsStringToPointer(result, &str, &length) == JsNoError);
+        CHECK(wcscmp(str, _u("function () { return 'caf\u00e9'; }")) == 0);
+    }
+
+    TEST_CASE("ApiTest_SerializedScriptVersionTest", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::SerializedScriptVersionTest);
+    }
+
     void ArrayAndItemTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
     {
         // Create some arrays
@@ -5842,8 +5842,9 @@ Lowerer::DoLoopProbeAndNumber(IR::BranchInstr *branchInstr)
 void
 Lowerer::InsertOneLoopProbe(IR::Instr *insertInstr, IR::LabelInstr *loopLabel)
 {
-    // Insert one interrupt probe at the given instruction. Probe the stack and call the abort helper
-    // directly if the probe fails.
+    // Insert one interrupt probe at the given instruction. Probe the stack and call the interrupt
+    // helper if the probe fails. The helper aborts the script if execution was disabled, otherwise
+    // (a stack sample was requested) it returns and the loop carries on.
 
     IR::Opnd *memRefOpnd = IR::MemRefOpnd::New(
         m_func->GetThreadContextInfo()->GetThreadStackLimitAddr(),
@@ -5857,27 +5858,13 @@ Lowerer::InsertOneLoopProbe(IR::Instr *insertInstr, IR::LabelInstr *loopLabel)
     IR::LabelInstr *helperLabel = IR::LabelInstr::New(Js::OpCode::Label, this->m_func, true);
     insertInstr->InsertBefore(helperLabel);
 
-    IR::HelperCallOpnd *helperOpnd = IR::HelperCallOpnd::New(IR::HelperScriptAbort, this->m_func);
+    IR::HelperCallOpnd *helperOpnd = IR::HelperCallOpnd::New(IR::HelperLoopInterruptProbe, this->m_func);
     IR::Instr *instr = IR::Instr::New(Js::OpCode::Call, this->m_func);
     instr->SetSrc1(helperOpnd);
     insertInstr->InsertBefore(instr);
     this->m_lowererMD.LowerCall(instr, 0);
 
-    // Jump to the exit after the helper call. This instruction will never be reached, but the jump
-    // indicates that nothing is live after the call (to avoid useless spills in code that will
-    // be executed).
-    instr = this->m_func->m_exitInstr->GetPrevRealInstrOrLabel();
-    if (instr->IsLabelInstr())
-    {
-        helperLabel = instr->AsLabelInstr();
-    }
-    else
-    {
-        helperLabel = IR::LabelInstr::New(Js::OpCode::Label, this->m_func);
-        this->m_func->m_exitInstr->InsertBefore(helperLabel);
-    }
-
-    instr = IR::BranchInstr::New(LowererMD::MDUncondBranchOpcode, helperLabel, this->m_func);
+    instr = IR::BranchInstr::New(LowererMD::MDUncondBranchOpcode, loopLabel, this->m_func);
     insertInstr->InsertBefore(instr);
 }
 
@@ -22465,6 +22452,9 @@ Lowerer::LowerNewConcatStrMulti(IR::Instr * instr)
         this->LoadLibraryValueOpnd(instr, LibraryValue::ValueStringTypeStatic), instr);
     GenerateRecyclerMemInitNull(dstOpnd, Js::ConcatStringMulti::GetOffsetOfpszValue(), instr);
     GenerateRecyclerMemInit(dstOpnd, Js::ConcatStringMulti::GetOffsetOfcharLength(), 0, instr);
+#if TARGET_64
+    GenerateRecyclerMemInit(dstOpnd, Js::ConcatStringMulti::GetOffsetOfUtf8LengthCache(), 0, instr);
+#endif
     GenerateRecyclerMemInit(dstOpnd, Js::ConcatStringMulti::GetOffsetOfSlotCount(), countOpnd->AsUint32(), instr);
 
     instr->Remove();
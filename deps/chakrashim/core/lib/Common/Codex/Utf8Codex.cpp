@@ -9,6 +9,11 @@
 #define _Analysis_assume_(expr)
 #endif
 
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#define CODEX_USE_SSE2 1
+#endif
+
 #ifdef _MSC_VER
 //=============================
 // Disabled Warnings
@@ -519,6 +524,230 @@ LSlowPath:
         return result;
     }
 
+    __range(0, cbBuffer)
+    size_t EncodeTrueUtf8IntoBounded(__out_ecount(cbBuffer) LPUTF8 buffer, size_t cbBuffer, __in_ecount(cch) const char16 *source, charcount_t cch, __out charcount_t *cchConsumed, bool replaceInvalid)
+    {
+        LPUTF8 dest = buffer;
+        size_t cbRemaining = cbBuffer;
+        charcount_t cchRemaining = cch;
+#if CODEX_USE_SSE2
+        const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const __m128i zero = _mm_setzero_si128();
+        bool tryVector = true;
+#endif
+
+        while (cchRemaining > 0)
+        {
+#if CODEX_USE_SSE2
+            // Narrow runs of 8 ASCII characters at once. Only retried once the scalar loop has
+            // seen ASCII again so mostly non-ASCII text doesn't pay for a failed check per character.
+            while (tryVector && cchRemaining >= 8 && cbRemaining >= 8)
+            {
+                __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, nonAsciiMask), zero)) != 0xFFFF)
+                {
+                    break;
+                }
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dest), _mm_packus_epi16(chars, chars));
+                dest += 8;
+                cbRemaining -= 8;
+                source += 8;
+                cchRemaining -= 8;
+            }
+            if (cchRemaining == 0)
+            {
+                break;
+            }
+#endif
+
+            char16 ch = *source;
+            size_t cbNeeded = 3;
+            charcount_t cchNeeded = 1;
+            if (ch < 0x80)
+            {
+                cbNeeded = 1;
+            }
+            else if (ch < 0x800)
+            {
+                cbNeeded = 2;
+            }
+            else if (ch >= 0xD800 && ch <= 0xDBFF && cchRemaining > 1 && source[1] >= 0xDC00 && source[1] <= 0xDFFF)
+            {
+                cbNeeded = 4;
+                cchNeeded = 2;
+            }
+
+            if (cbNeeded > cbRemaining)
+            {
+                break;
+            }
+
+            if (cchNeeded == 2)
+            {
+                dest = EncodeSurrogatePair(ch, source[1], dest);
+            }
+            else if (replaceInvalid && ch >= 0xD800 && ch <= 0xDFFF)
+            {
+                dest[0] = 0xEF;
+                dest[1] = 0xBF;
+                dest[2] = 0xBD;
+                dest += 3;
+            }
+            else
+            {
+                dest = Encode(ch, dest);
+            }
+
+            source += cchNeeded;
+            cchRemaining -= cchNeeded;
+            cbRemaining -= cbNeeded;
+#if CODEX_USE_SSE2
+            tryVector = ch < 0x80;
+#endif
+        }
+
+        *cchConsumed = cch - cchRemaining;
+        return dest - buffer;
+    }
+
+    // Counts the UTF8 bytes for the code unit at source, consuming the low surrogate of a valid pair.
+    // Must agree with EncodeTrueUtf8.
+    inline size_t CountTrueUtf8Unit(const char16 *&source, charcount_t &cch)
+    {
+        char16 ch = *source++;
+        cch--;
+
+        if (ch < 0x80)
+        {
+            return 1;
+        }
+        else if (ch < 0x800)
+        {
+            return 2;
+        }
+        else if (ch >= 0xD800 && ch <= 0xDBFF && cch > 0 && *source >= 0xDC00 && *source <= 0xDFFF)
+        {
+            source++;
+            cch--;
+            return 4;
+        }
+
+        // Everything else, including lone surrogates (encoded as U+FFFD), takes three bytes
+        return 3;
+    }
+
+    size_t CountTrueUtf8(__in_ecount(cch) const char16 *source, charcount_t cch)
+    {
+        size_t count = 0;
+
+#if CODEX_USE_SSE2
+        const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const __m128i zero = _mm_setzero_si128();
+        while (cch >= 8)
+        {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chars, nonAsciiMask), zero)) == 0xFFFF)
+            {
+                count += 8;
+                source += 8;
+                cch -= 8;
+                continue;
+            }
+
+            // Not all ASCII, count this block one unit at a time. A surrogate pair straddling the end
+            // of the block is consumed whole, so the next block may start up to one unit later.
+            const char16 *blockEnd = source + 8;
+            while (source < blockEnd)
+            {
+                count += CountTrueUtf8Unit(source, cch);
+            }
+        }
+#endif
+        while (cch > 0)
+        {
+            count += CountTrueUtf8Unit(source, cch);
+        }
+
+        return count;
+    }
+
+    size_t CountLatin1AsUtf8(__in_ecount(cch) const BYTE *source, size_t cch)
+    {
+        // Every byte at or above 0x80 takes two bytes in UTF8
+        size_t count = cch;
+
+#if CODEX_USE_SSE2
+        const __m128i lowBit = _mm_set1_epi8(1);
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sums = zero;
+        size_t blocks = 0;
+        while (cch >= 16)
+        {
+            // Move each byte's high bit down to bit 0 and add the bytes up horizontally
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+            __m128i highBits = _mm_and_si128(_mm_srli_epi16(bytes, 7), lowBit);
+            sums = _mm_add_epi64(sums, _mm_sad_epu8(highBits, zero));
+            source += 16;
+            cch -= 16;
+            blocks++;
+        }
+
+        if (blocks > 0)
+        {
+            uint64_t partial[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(partial), sums);
+            count += static_cast<size_t>(partial[0] + partial[1]);
+        }
+#endif
+        while (cch-- > 0)
+        {
+            count += *source++ >> 7;
+        }
+
+        return count;
+    }
+
+    void DecodeLatin1Into(__out_ecount(cch) char16 *buffer, __in_ecount(cch) const BYTE *source, size_t cch)
+    {
+#if CODEX_USE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        while (cch >= 16)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + 8), _mm_unpackhi_epi8(bytes, zero));
+            buffer += 16;
+            source += 16;
+            cch -= 16;
+        }
+#endif
+        while (cch-- > 0)
+        {
+            *buffer++ = static_cast<char16>(*source++);
+        }
+    }
+
+    void EncodeLatin1Into(__out_ecount(cch) BYTE *buffer, __in_ecount(cch) const char16 *source, size_t cch)
+    {
+#if CODEX_USE_SSE2
+        // Mask to the low byte first so the saturating pack doesn't clamp characters above U+00FF
+        const __m128i lowByteMask = _mm_set1_epi16(0x00FF);
+        while (cch >= 16)
+        {
+            __m128i low = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source)), lowByteMask);
+            __m128i high = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(source + 8)), lowByteMask);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer), _mm_packus_epi16(low, high));
+            buffer += 16;
+            source += 16;
+            cch -= 16;
+        }
+#endif
+        while (cch-- > 0)
+        {
+            *buffer++ = static_cast<BYTE>(*source++);
+        }
+    }
+
     // Convert the character index into a byte index.
     size_t CharacterIndexToByteIndex(__in_ecount(cbLength) LPCUTF8 pch, size_t cbLength, charcount_t cchIndex, DecodeOptions options)
     {
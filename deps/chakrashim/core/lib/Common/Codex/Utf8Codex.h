@@ -314,4 +314,25 @@ namespace utf8
 
     // Convert byte index into character index
     charcount_t ByteIndexIntoCharacterIndex(__in_ecount(cbIndex) LPCUTF8 pch, size_t cbIndex, DecodeOptions options = doDefault);
+
+    // Encode as many whole characters of source as fit into cbBuffer bytes. Unpaired surrogates are
+    // written as the unicode replacement character if replaceInvalid is set, otherwise as their three
+    // byte (CESU-8) sequence. Returns the number of bytes written and sets *cchConsumed to the number
+    // of code units encoded (a surrogate pair counts as two).
+    __range(0, cbBuffer)
+    size_t EncodeTrueUtf8IntoBounded(__out_ecount(cbBuffer) LPUTF8 buffer, size_t cbBuffer, __in_ecount(cch) const char16 *source, charcount_t cch, __out charcount_t *cchConsumed, bool replaceInvalid);
+
+    // Returns the number of bytes EncodeTrueUtf8IntoAndNullTerminate would write for source, not
+    // counting the null terminator, without encoding anything.
+    size_t CountTrueUtf8(__in_ecount(cch) const char16 *source, charcount_t cch);
+
+    // Returns the number of bytes needed to encode a Latin1 sequence of cch bytes as UTF8.
+    size_t CountLatin1AsUtf8(__in_ecount(cch) const BYTE *source, size_t cch);
+
+    // Widen a Latin1 sequence (one byte per character, U+0000 to U+00FF) of cch bytes into UTF16-LE.
+    void DecodeLatin1Into(__out_ecount(cch) char16 *buffer, __in_ecount(cch) const BYTE *source, size_t cch);
+
+    // Narrow a UTF16-LE sequence of cch words into Latin1 by keeping the low byte of each word.
+    // Characters above U+00FF are not representable and get truncated.
+    void EncodeLatin1Into(__out_ecount(cch) BYTE *buffer, __in_ecount(cch) const char16 *source, size_t cch);
 }
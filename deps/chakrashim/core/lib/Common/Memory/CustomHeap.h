@@ -165,6 +165,21 @@ public:
         return reinterpret_cast<SegmentBaseCommon*>(segment)->IsInPreReservedHeapPageAllocator();
     }
 
+    size_t GetUsedBytes() const
+    {
+        return this->pageAllocator.GetUsedBytes() + this->preReservedHeapAllocator.GetUsedBytes();
+    }
+
+    size_t GetCommittedBytes() const
+    {
+        return this->pageAllocator.GetCommittedBytes() + this->preReservedHeapAllocator.GetCommittedBytes();
+    }
+
+    size_t GetReservedBytes() const
+    {
+        return this->pageAllocator.GetReservedBytes() + this->preReservedHeapAllocator.GetReservedBytes();
+    }
+
     bool IsInNonPreReservedPageAllocator(__in void *address)
     {
         Assert(this->cs.IsLocked());
@@ -675,6 +675,11 @@ public:
 
     AllocationPolicyManager * GetAllocationPolicyManager() { return policyManager; }
 
+    // Pages handed out, pages committed (including free ones) and address space reserved, in bytes
+    size_t GetUsedBytes() const { return usedBytes; }
+    size_t GetCommittedBytes() const { return committedBytes; }
+    size_t GetReservedBytes() const { return reservedBytes; }
+
     uint GetMaxAllocPageCount();
 
     //VirtualAllocator APIs
@@ -186,6 +186,7 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     inPartialCollectMode(false),
     scanPinnedObjectMap(false),
     partialUncollectedAllocBytes(0),
+    partialUncollectedExternalBytes(0),
     uncollectedNewPageCountPartialCollect((size_t)-1),
 #if ENABLE_CONCURRENT_GC
     partialConcurrentNextCollection(false),
@@ -256,6 +257,9 @@ Recycler::Recycler(AllocationPolicyManager * policyManager, IdleDecommitPageAllo
     , pendingWriteBarrierBlockMap(&HeapAllocator::Instance)
 #endif
 {
+    objectWeakCallbackList.prev = &objectWeakCallbackList;
+    objectWeakCallbackList.next = &objectWeakCallbackList;
+
 #ifdef RECYCLER_MARK_TRACK
     this->markMap = NoCheckHeapNew(MarkMap, &NoCheckHeapAllocator::Instance, 163, &markMapCriticalSection);
     markContext.SetMarkMap(markMap);
@@ -1095,6 +1099,22 @@ Recycler::AddExternalMemoryUsage(size_t size)
 {
     this->autoHeap.uncollectedAllocBytes += size;
     this->autoHeap.uncollectedExternalBytes += size;
+
+#if ENABLE_PARTIAL_GC
+    // A partial GC doesn't sweep the old objects that hold most of the external memory, so the
+    // uncollected bytes it resets don't account for it. Track it until the next full GC, and
+    // force one if too much has been reported in the meantime.
+    if (this->inPartialCollectMode)
+    {
+        this->partialUncollectedExternalBytes += size;
+        if (this->partialUncollectedExternalBytes >= RecyclerHeuristic::Instance.MaxUncollectedExternalBytesPartialCollect)
+        {
+            CollectNow<CollectOnExternalMemoryPressure>();
+            return;
+        }
+    }
+#endif
+
     // Generally normal GC can cleanup the uncollectedAllocBytes. But if external components
     // do fast large allocations in a row, normal GC might not kick in. Let's force the GC
     // here if we need to collect anyhow.
@@ -3448,6 +3468,7 @@ template BOOL Recycler::CollectNow<CollectOnScriptIdle>();
 template BOOL Recycler::CollectNow<CollectOnScriptExit>();
 template BOOL Recycler::CollectNow<CollectOnAllocation>();
 template BOOL Recycler::CollectNow<CollectOnTypedArrayAllocation>();
+template BOOL Recycler::CollectNow<CollectOnExternalMemoryPressure>();
 template BOOL Recycler::CollectNow<CollectOnScriptCloseNonPrimary>();
 template BOOL Recycler::CollectNow<CollectExhaustiveCandidate>();
 template BOOL Recycler::CollectNow<CollectNowConcurrent>();
@@ -3461,6 +3482,7 @@ template BOOL Recycler::CollectNow<CollectNowForceInThreadExternalNoStack>();
 template BOOL Recycler::CollectNow<CollectOnRecoverFromOutOfMemory>();
 template BOOL Recycler::CollectNow<CollectNowDefault>();
 template BOOL Recycler::CollectNow<CollectOnSuspendCleanup>();
+template BOOL Recycler::CollectNow<CollectOnLowMemory>();
 template BOOL Recycler::CollectNow<CollectNowDefaultLSCleanup>();
 
 #if defined(CHECK_MEMORY_LEAK) || defined(LEAK_REPORT)
@@ -4108,6 +4130,7 @@ Recycler::ClearPartialCollect()
 #endif
     this->autoHeap.unusedPartialCollectFreeBytes = 0;
     this->partialUncollectedAllocBytes = 0;
+    this->partialUncollectedExternalBytes = 0;
     this->clientTrackedObjectList.Clear(&this->clientTrackedObjectAllocator);
     this->uncollectedNewPageCountPartialCollect = (size_t)-1;
 }
@@ -8386,9 +8409,96 @@ void Recycler::SetObjectBeforeCollectCallback(void* object,
     }
 }
 
+void Recycler::RegisterObjectWeakCallback(ObjectWeakCallbackNode* node, void* object, ObjectWeakCallbackNode::Callback callback)
+{
+    Assert(object != nullptr && callback != nullptr);
+    if (objectBeforeCollectCallbackState == ObjectBeforeCollectCallback_Shutdown)
+    {
+        return; // NOP at shutdown
+    }
+
+    if (node->IsRegistered())
+    {
+        // May still be in the list being processed, move it back to ours
+        UnlinkObjectWeakCallback(node);
+    }
+
+    node->object = object;
+    node->callback = callback;
+    LinkObjectWeakCallback(node);
+
+    if (this->IsInObjectBeforeCollectCallback()) // revive
+    {
+        this->ScanMemory<false>(&object, sizeof(object));
+        this->ProcessMark(/*background*/false);
+    }
+}
+
+void Recycler::UnregisterObjectWeakCallback(ObjectWeakCallbackNode* node)
+{
+    if (node->IsRegistered())
+    {
+        UnlinkObjectWeakCallback(node);
+    }
+    node->object = nullptr;
+    node->callback = nullptr;
+}
+
+void Recycler::LinkObjectWeakCallback(ObjectWeakCallbackNode* node)
+{
+    Assert(!node->IsRegistered());
+    node->prev = objectWeakCallbackList.prev;
+    node->next = &objectWeakCallbackList;
+    objectWeakCallbackList.prev->next = node;
+    objectWeakCallbackList.prev = node;
+}
+
+void Recycler::UnlinkObjectWeakCallback(ObjectWeakCallbackNode* node)
+{
+    Assert(node->IsRegistered());
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = nullptr;
+    node->next = nullptr;
+}
+
+void Recycler::ProcessObjectWeakCallbacks(bool atShutdown)
+{
+    Assert(this->IsInObjectBeforeCollectCallback());
+
+    // Move the registered nodes to a local list. Callbacks may unregister any node, including the
+    // ones we haven't got to yet, and new registrations go back to the recycler's list.
+    ObjectWeakCallbackNode pending;
+    pending.prev = objectWeakCallbackList.prev;
+    pending.next = objectWeakCallbackList.next;
+    pending.prev->next = &pending;
+    pending.next->prev = &pending;
+    objectWeakCallbackList.prev = &objectWeakCallbackList;
+    objectWeakCallbackList.next = &objectWeakCallbackList;
+
+    while (pending.next != &pending)
+    {
+        ObjectWeakCallbackNode* node = pending.next;
+        UnlinkObjectWeakCallback(node);
+
+        if (!atShutdown && this->IsObjectMarked(node->object))
+        {
+            LinkObjectWeakCallback(node); // remaining callback for future
+            continue;
+        }
+
+        void* object = node->object;
+        ObjectWeakCallbackNode::Callback callback = node->callback;
+        node->object = nullptr;
+        node->callback = nullptr;
+        callback(object);
+    }
+}
+
 bool Recycler::ProcessObjectBeforeCollectCallbacks(bool atShutdown/*= false*/)
 {
-    if (this->objectBeforeCollectCallbackMap == nullptr)
+    bool hasObjectWeakCallbacks = objectWeakCallbackList.next != &objectWeakCallbackList;
+    if (this->objectBeforeCollectCallbackMap == nullptr && !hasObjectWeakCallbacks)
     {
         return false; // no callbacks
     }
@@ -8404,6 +8514,16 @@ bool Recycler::ProcessObjectBeforeCollectCallbacks(bool atShutdown/*= false*/)
         this->objectBeforeCollectCallbackMap, &HeapAllocator::Instance);
     this->objectBeforeCollectCallbackMap = nullptr;
 
+    if (hasObjectWeakCallbacks)
+    {
+        ProcessObjectWeakCallbacks(atShutdown);
+    }
+
+    if (oldCallbackMap == nullptr)
+    {
+        return true; // called weak callbacks
+    }
+
     bool hasRemainingCallbacks = false;
     oldCallbackMap->MapAndRemoveIf([&](const ObjectBeforeCollectCallbackMap::EntryType& entry)
     {
@@ -8464,6 +8584,7 @@ void Recycler::ClearObjectBeforeCollectCallbacks()
     // This is called at shutting down. All objects will be gone. Invoke each registered callback if any.
     ProcessObjectBeforeCollectCallbacks(/*atShutdown*/true);
     Assert(objectBeforeCollectCallbackMap == nullptr);
+    Assert(objectWeakCallbackList.next == &objectWeakCallbackList);
 }
 
 #ifdef RECYCLER_TEST_SUPPORT
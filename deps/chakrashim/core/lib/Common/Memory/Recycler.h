@@ -290,12 +290,14 @@ enum CollectionFlags
 
     CollectOnAllocation             = CollectHeuristic_AllocSize | CollectHeuristic_Time | CollectMode_Concurrent | CollectMode_Partial | CollectOverride_FinishConcurrent | CollectOverride_AllowReentrant | CollectOverride_FinishConcurrentTimeout,
     CollectOnTypedArrayAllocation   = CollectHeuristic_AllocSize | CollectHeuristic_Time | CollectMode_Concurrent | CollectMode_Partial | CollectOverride_FinishConcurrent | CollectOverride_AllowReentrant | CollectOverride_FinishConcurrentTimeout | CollectOverride_AllowDispose,
+    CollectOnExternalMemoryPressure = CollectMode_Concurrent | CollectOverride_FinishConcurrent | CollectOverride_AllowReentrant | CollectOverride_FinishConcurrentTimeout,
     CollectOnScriptIdle             = CollectOverride_CheckScriptContextClose | CollectOverride_FinishConcurrent | CollectMode_Concurrent | CollectMode_CacheCleanup | CollectOverride_SkipStack,
     CollectOnScriptExit             = CollectOverride_CheckScriptContextClose | CollectHeuristic_AllocSize | CollectOverride_FinishConcurrent | CollectMode_Concurrent | CollectMode_CacheCleanup,
     CollectExhaustiveCandidate      = CollectHeuristic_Never | CollectOverride_ExhaustiveCandidate,
     CollectOnScriptCloseNonPrimary  = CollectNowConcurrent | CollectOverride_ExhaustiveCandidate | CollectOverride_AllowDispose,
     CollectOnRecoverFromOutOfMemory = CollectOverride_ForceInThread | CollectMode_DecommitNow,
     CollectOnSuspendCleanup         = CollectNowConcurrent | CollectMode_Exhaustive | CollectMode_DecommitNow | CollectOverride_DisableIdleFinish,
+    CollectOnLowMemory              = CollectNowExhaustive | CollectMode_DecommitNow | CollectMode_CacheCleanup,
 
     FinishConcurrentOnIdle          = CollectMode_Concurrent | CollectOverride_DisableIdleFinish,
     FinishConcurrentOnIdleAtRoot    = CollectMode_Concurrent | CollectOverride_DisableIdleFinish | CollectOverride_SkipStack,
@@ -993,6 +995,7 @@ private:
     ArenaAllocator clientTrackedObjectAllocator;
 
     size_t partialUncollectedAllocBytes;
+    size_t partialUncollectedExternalBytes;
 
     // Dynamic Heuristics for partial GC
     size_t uncollectedNewPageCountPartialCollect;
@@ -1143,6 +1146,7 @@ public:
     void TryMarkInterior(void *candidate, void* parentReference = nullptr);
 
     bool InCacheCleanupCollection() { return inCacheCleanupCollection; }
+    bool InExhaustiveCollection() const { return inExhaustiveCollection; }
     void ClearCacheCleanupCollection() { Assert(inCacheCleanupCollection); inCacheCleanupCollection = false; }
 
     // Finalizer support
@@ -1346,6 +1350,19 @@ public:
     void RootAddRef(void* obj, uint *count = nullptr);
     void RootRelease(void* obj, uint *count = nullptr);
 
+    // Calls fn with each object currently pinned by RootAddRef
+    template <class Fn>
+    void MapPinnedObjects(Fn fn)
+    {
+        pinnedObjectMap.Map([&fn](void * obj, PinRecord const& refCount)
+        {
+            if (refCount != 0)
+            {
+                fn(obj);
+            }
+        });
+    }
+
     template <ObjectInfoBits attributes, bool nothrow>
     inline char* RealAlloc(HeapInfo* heap, DECLSPEC_GUARD_OVERFLOW size_t size);
 
@@ -1925,7 +1942,31 @@ public:
         void* threadContext);
     void ClearObjectBeforeCollectCallbacks();
     bool IsInObjectBeforeCollectCallback() const { return objectBeforeCollectCallbackState != ObjectBeforeCollectCallback_None; }
+
+    // Intrusive alternative to SetObjectBeforeCollectCallback for objects that embed the node, so
+    // registering a callback doesn't touch the callback map. The links are not traced and do not
+    // keep the other objects alive; the node must be unregistered before its object is finalized.
+    struct ObjectWeakCallbackNode
+    {
+        typedef void (CALLBACK *Callback)(void* object);
+
+        ObjectWeakCallbackNode* prev;
+        ObjectWeakCallbackNode* next;
+        void* object;
+        Callback callback;
+
+        ObjectWeakCallbackNode() : prev(nullptr), next(nullptr), object(nullptr), callback(nullptr) {}
+        bool IsRegistered() const { return next != nullptr; }
+    };
+    void RegisterObjectWeakCallback(ObjectWeakCallbackNode* node, void* object, ObjectWeakCallbackNode::Callback callback);
+    void UnregisterObjectWeakCallback(ObjectWeakCallbackNode* node);
 private:
+    void LinkObjectWeakCallback(ObjectWeakCallbackNode* node);
+    static void UnlinkObjectWeakCallback(ObjectWeakCallbackNode* node);
+    void ProcessObjectWeakCallbacks(bool atShutdown);
+    // Sentinel of the circular list of registered nodes
+    ObjectWeakCallbackNode objectWeakCallbackList;
+
     struct ObjectBeforeCollectCallbackData
     {
         ObjectBeforeCollectCallback callback;
@@ -70,6 +70,7 @@ RecyclerHeuristic::ConfigureBaseFactor(uint baseFactor)
     this->MaxUncollectedAllocBytesOnExit = (baseFactor / 2) MEGABYTES;
 
     this->MaxUncollectedAllocBytesPartialCollect = this->MaxUncollectedAllocBytes - 1 MEGABYTES;
+    this->MaxUncollectedExternalBytesPartialCollect = (baseFactor / 4) MEGABYTES;
 }
 
 uint
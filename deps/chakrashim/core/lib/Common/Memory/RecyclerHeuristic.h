@@ -27,6 +27,10 @@ public:
     // If we are getting close to the full GC limit, let's just get out of partial GC mode.
     uint   MaxUncollectedAllocBytesPartialCollect;
 
+    // External memory is only released when the objects holding it are swept, which a partial GC may not do.
+    // Get out of partial GC mode once this much has been reported since the last full GC.
+    uint   MaxUncollectedExternalBytesPartialCollect;
+
     // Defines the PageSegment size for recycler small block page allocator.
     uint DefaultMaxAllocPageCount;
 
@@ -44,6 +44,7 @@ typedef BYTE* ChakraBytePtr;
 #define _Out_
 #define _Out_opt_
 #define _In_reads_(x)
+#define _In_reads_bytes_(x)
 #define _Pre_maybenull_
 #define _Pre_writable_byte_size_(byteLength)
 #define _Outptr_result_buffer_(byteLength)
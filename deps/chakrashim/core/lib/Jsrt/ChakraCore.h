@@ -249,62 +249,1503 @@ CHAKRA_API
         _In_ size_t length,
         _Out_ JsValueRef *value);
 
+/// <summary>
+///     Create JavascriptString variable from Latin1 string
+/// </summary>
+/// <remarks>
+///     <para>
+///         Each byte of the content is one character (U+0000 to U+00FF)
+///     </para>
+/// </remarks>
+/// <param name="content">Pointer to string memory.</param>
+/// <param name="length">Number of bytes within the string</param>
+/// <param name="value">JsValueRef representing the JavascriptString</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateStringLatin1(
+        _In_ const char *content,
+        _In_ size_t length,
+        _Out_ JsValueRef *value);
+
+/// <summary>
+///     Create JavascriptString variable that references external Utf16 string memory
+/// </summary>
+/// <remarks>
+///     <para>
+///         The string content is not copied. The memory must stay valid and unchanged
+///         until `finalizeCallback` is called, which happens when the string is
+///         garbage collected. The content doesn't need to be null terminated.
+///     </para>
+///     <para>
+///         If the string can't reference the memory (e.g. `length` is 0), the
+///         content is copied and `finalizeCallback` is called before returning.
+///     </para>
+/// </remarks>
+/// <param name="content">Pointer to string memory.</param>
+/// <param name="length">Number of characters within the string</param>
+/// <param name="finalizeCallback">Callback called when the string memory is no longer referenced</param>
+/// <param name="callbackState">User provided state that will be passed back to finalizeCallback</param>
+/// <param name="value">JsValueRef representing the JavascriptString</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateExternalStringUtf16(
+        _In_ const uint16_t *content,
+        _In_ size_t length,
+        _In_opt_ JsFinalizeCallback finalizeCallback,
+        _In_opt_ void *callbackState,
+        _Out_ JsValueRef *value);
+
+/// <summary>
+///     Create JavascriptString variable that references external Latin1 string memory
+/// </summary>
+/// <remarks>
+///     <para>
+///         Each byte of the content is one character (U+0000 to U+00FF).
+///         The string content is not copied. The memory must stay valid and unchanged
+///         until `finalizeCallback` is called, which happens when the string is
+///         garbage collected. The content doesn't need to be null terminated.
+///     </para>
+///     <para>
+///         If the string can't reference the memory (e.g. `length` is 0), the
+///         content is copied and `finalizeCallback` is called before returning.
+///     </para>
+/// </remarks>
+/// <param name="content">Pointer to string memory.</param>
+/// <param name="length">Number of bytes within the string</param>
+/// <param name="finalizeCallback">Callback called when the string memory is no longer referenced</param>
+/// <param name="callbackState">User provided state that will be passed back to finalizeCallback</param>
+/// <param name="value">JsValueRef representing the JavascriptString</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateExternalStringLatin1(
+        _In_ const char *content,
+        _In_ size_t length,
+        _In_opt_ JsFinalizeCallback finalizeCallback,
+        _In_opt_ void *callbackState,
+        _Out_ JsValueRef *value);
+
 /// <summary>
 ///     Write JavascriptString value into C string buffer (Utf8)
 /// </summary>
 /// <remarks>
 ///     <para>
-///         When size of the `buffer` is unknown,
-///         `buffer` argument can be nullptr.
-///         In that case, `written` argument will return the length needed.
+///         When size of the `buffer` is unknown,
+///         `buffer` argument can be nullptr.
+///         In that case, `written` argument will return the length needed.
+///     </para>
+/// </remarks>
+/// <param name="value">JavascriptString value</param>
+/// <param name="buffer">Pointer to buffer</param>
+/// <param name="bufferSize">Buffer size</param>
+/// <param name="written">Total number of characters written</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCopyString(
+        _In_ JsValueRef value,
+        _Out_opt_ char* buffer,
+        _In_ size_t bufferSize,
+        _Out_opt_ size_t* written);
+
+/// <summary>
+///     Flags for JsCopyStringUtf8Partial
+/// </summary>
+typedef enum JsCopyStringUtf8Flags
+{
+    JsCopyStringUtf8Flags_None = 0x00000000,
+    /// <summary>
+    ///     Write unpaired surrogates as the unicode replacement character (U+FFFD) instead of
+    ///     their three byte encoding.
+    /// </summary>
+    JsCopyStringUtf8Flags_ReplaceInvalid = 0x00000001
+} JsCopyStringUtf8Flags;
+
+/// <summary>
+///     Write as much of a string value as fits into a Utf8 string buffer in a single pass
+/// </summary>
+/// <remarks>
+///     <para>
+///         Only whole characters are written; a character that doesn't fit in the remaining
+///         space ends the copy. `charsRead` tells how many Utf16 code units were written, which
+///         equals the string length if the whole string fit.
+///     </para>
+///     <para>
+///         No null terminator is written.
+///     </para>
+/// </remarks>
+/// <param name="value">JavascriptString value</param>
+/// <param name="buffer">Pointer to buffer</param>
+/// <param name="bufferSize">Buffer size</param>
+/// <param name="flags">Encoding flags</param>
+/// <param name="written">Total number of bytes written</param>
+/// <param name="charsRead">Total number of Utf16 code units written</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCopyStringUtf8Partial(
+        _In_ JsValueRef value,
+        _Out_writes_(bufferSize) char* buffer,
+        _In_ size_t bufferSize,
+        _In_ JsCopyStringUtf8Flags flags,
+        _Out_opt_ size_t* written,
+        _Out_opt_ size_t* charsRead);
+
+/// <summary>
+///     Write string value into Utf16 string buffer
+/// </summary>
+/// <remarks>
+///     <para>
+///         When size of the `buffer` is unknown,
+///         `buffer` argument can be nullptr.
+///         In that case, `written` argument will return the length needed.
+///     </para>
+///     <para>
+///         when start is out of range or &lt; 0, returns JsErrorInvalidArgument
+///         and `written` will be equal to 0.
+///         If calculated length is 0 (It can be due to string length or `start`
+///         and length combination), then `written` will be equal to 0 and call
+///         returns JsNoError
+///     </para>
+/// </remarks>
+/// <param name="value">JavascriptString value</param>
+/// <param name="start">start offset of buffer</param>
+/// <param name="length">length to be written</param>
+/// <param name="buffer">Pointer to buffer</param>
+/// <param name="written">Total number of characters written</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCopyStringUtf16(
+        _In_ JsValueRef value,
+        _In_ int start,
+        _In_ int length,
+        _Out_opt_ uint16_t* buffer,
+        _Out_opt_ size_t* written);
+
+/// <summary>
+///     Write string value into Latin1 string buffer
+/// </summary>
+/// <remarks>
+///     <para>
+///         Each character is written as its low byte. Characters above U+00FF
+///         can't be represented and get truncated.
+///     </para>
+///     <para>
+///         When size of the `buffer` is unknown,
+///         `buffer` argument can be nullptr.
+///         In that case, `written` argument will return the length needed.
+///     </para>
+///     <para>
+///         when start is out of range or &lt; 0, returns JsErrorInvalidArgument
+///         and `written` will be equal to 0.
+///         If calculated length is 0 (It can be due to string length or `start`
+///         and length combination), then `written` will be equal to 0 and call
+///         returns JsNoError
+///     </para>
+/// </remarks>
+/// <param name="value">JavascriptString value</param>
+/// <param name="start">start offset of buffer</param>
+/// <param name="length">length to be written</param>
+/// <param name="buffer">Pointer to buffer</param>
+/// <param name="written">Total number of characters written</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCopyStringOneByte(
+        _In_ JsValueRef value,
+        _In_ int start,
+        _In_ int length,
+        _Out_opt_ char* buffer,
+        _Out_opt_ size_t* written);
+
+/// <summary>
+///     Allocates a block of reference slots that the garbage collector treats as roots.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The block is zero initialized and owned by the runtime. The host can store references into
+///     it directly, without calling into the runtime; values referenced from the block are kept
+///     alive like values referenced from the stack. Clear slots that are no longer in use so the
+///     values they referred to can be collected.
+///     </para>
+///     <para>
+///     The block must only be accessed from the thread the runtime is active on. It is freed by
+///     <c>JsFreeRootBlock</c> or when the runtime is disposed.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime the references in the block belong to.</param>
+/// <param name="count">The number of reference slots in the block.</param>
+/// <param name="block">The allocated block.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsAllocRootBlock(
+        _In_ JsRuntimeHandle runtime,
+        _In_ size_t count,
+        _Outptr_result_buffer_(count) JsValueRef **block);
+
+/// <summary>
+///     Frees a block allocated by <c>JsAllocRootBlock</c>.
+/// </summary>
+/// <param name="runtime">The runtime the block was allocated from.</param>
+/// <param name="block">The block to free.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsFreeRootBlock(
+        _In_ JsRuntimeHandle runtime,
+        _In_ JsValueRef *block);
+
+/// <summary>
+///     Reports memory allocated by the host that is kept alive by objects in the runtime.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The garbage collector counts the memory as if it had been allocated in the runtime, so
+///     small objects that hold on to large native buffers still cause collections. This call
+///     may start a collection.
+///     </para>
+///     <para>
+///     Memory that is freed again doesn't need to be reported, it stops counting at the next
+///     collection.
+///     </para>
+///     <para>
+///     Must be called from the thread the runtime is active on, and not from a finalizer or
+///     other garbage collector callback.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime the memory is kept alive by.</param>
+/// <param name="size">The number of bytes allocated.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsAddExternalMemoryUsage(
+        _In_ JsRuntimeHandle runtime,
+        _In_ size_t size);
+
+/// <summary>
+///     The spaces the memory of a runtime is allocated from.
+/// </summary>
+/// <remarks>
+///     Objects of the same kind share pages whatever their size, except for large objects that
+///     get pages of their own. Finalizable objects are part of <c>JsHeapSpace_Object</c>.
+/// </remarks>
+typedef enum JsHeapSpace
+{
+    /// <summary>
+    ///     Small and medium objects that reference other objects.
+    /// </summary>
+    JsHeapSpace_Object = 0,
+    /// <summary>
+    ///     Small and medium objects without references, such as strings. The engine's own
+    ///     arenas also allocate from this space.
+    /// </summary>
+    JsHeapSpace_Leaf = 1,
+    /// <summary>
+    ///     Large objects.
+    /// </summary>
+    JsHeapSpace_LargeObject = 2,
+    /// <summary>
+    ///     Native code generated by the JIT compiler, and its thunks.
+    /// </summary>
+    JsHeapSpace_Code = 3
+} JsHeapSpace;
+
+/// <summary>
+///     Memory usage of a heap space.
+/// </summary>
+typedef struct JsHeapSpaceStatistics
+{
+    /// <summary>The bytes of the pages in use.</summary>
+    size_t usedBytes;
+    /// <summary>The bytes of the pages committed, whether they are in use or not.</summary>
+    size_t committedBytes;
+    /// <summary>The bytes of the pages committed but not in use.</summary>
+    size_t availableBytes;
+    /// <summary>The bytes of address space reserved but not committed.</summary>
+    size_t decommittedBytes;
+} JsHeapSpaceStatistics;
+
+/// <summary>
+///     Gets the memory usage of one of the heap spaces of a runtime.
+/// </summary>
+/// <remarks>
+///     The sizes are counted in whole pages, a page counts as used as long as it holds an
+///     object. The sizes can be read from any thread, and are a snapshot that may be slightly
+///     out of date while a concurrent collection is running.
+/// </remarks>
+/// <param name="runtime">The runtime to get the memory usage of.</param>
+/// <param name="space">The heap space.</param>
+/// <param name="statistics">The memory usage of the heap space.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetRuntimeHeapSpaceStatistics(
+        _In_ JsRuntimeHandle runtime,
+        _In_ JsHeapSpace space,
+        _Out_ JsHeapSpaceStatistics *statistics);
+
+/// <summary>
+///     The kind of a garbage collection.
+/// </summary>
+typedef enum JsGarbageCollectionFlags
+{
+    JsGarbageCollectionFlags_None = 0x00000000,
+    JsGarbageCollectionFlags_Partial = 0x00000001,
+    JsGarbageCollectionFlags_Concurrent = 0x00000002,
+    JsGarbageCollectionFlags_Exhaustive = 0x00000004
+} JsGarbageCollectionFlags;
+
+/// <summary>
+///     Whether a garbage collection is starting or has finished.
+/// </summary>
+typedef enum JsGarbageCollectionEvent
+{
+    JsGarbageCollectionEvent_Begin = 0,
+    JsGarbageCollectionEvent_End = 1
+} JsGarbageCollectionEvent;
+
+/// <summary>
+///     Statistics of a garbage collection.
+/// </summary>
+/// <remarks>
+///     A collection without <c>JsGarbageCollectionFlags_Partial</c> is a full collection, and one
+///     without <c>JsGarbageCollectionFlags_Concurrent</c> ran entirely on the runtime's thread.
+///     The duration and the sizes after the collection are only set when it has finished.
+/// </remarks>
+typedef struct JsGarbageCollectionInfo
+{
+    /// <summary>The kind of the collection.</summary>
+    JsGarbageCollectionFlags flags;
+    /// <summary>
+    ///     The time from the start to the end of the collection, in microseconds. This is
+    ///     the pause for a collection that wasn't concurrent.
+    /// </summary>
+    unsigned long long duration;
+    /// <summary>The bytes of the garbage collected heap in use before the collection.</summary>
+    size_t usedBytesBefore;
+    /// <summary>The bytes of the garbage collected heap in use after the collection.</summary>
+    size_t usedBytesAfter;
+    /// <summary>The bytes released by the collection.</summary>
+    size_t freedBytes;
+} JsGarbageCollectionInfo;
+
+/// <summary>
+///     A callback called when a garbage collection starts and when it finishes.
+/// </summary>
+/// <remarks>
+///     The callback is called on the runtime's thread while the collection is in progress, and
+///     must not call back into the runtime.
+/// </remarks>
+/// <param name="event">Whether the collection is starting or has finished.</param>
+/// <param name="info">The statistics of the collection.</param>
+/// <param name="callbackState">The state passed to <c>JsSetRuntimeGarbageCollectionCallback</c>.</param>
+typedef void (CHAKRA_CALLBACK *JsGarbageCollectionCallback)(_In_ JsGarbageCollectionEvent event, _In_ const JsGarbageCollectionInfo *info, _In_opt_ void *callbackState);
+
+/// <summary>
+///     Sets a callback that is called when a garbage collection starts and when it finishes.
+/// </summary>
+/// <remarks>
+///     <para>
+///     A runtime has a single garbage collection callback, setting one replaces the previous
+///     one. Passing null removes it.
+///     </para>
+///     <para>
+///     Unlike the callback set by <c>JsSetRuntimeBeforeCollectCallback</c>, this one is also
+///     called when the collection has finished, with the statistics of the collection.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime to set the callback on.</param>
+/// <param name="callbackState">User provided state that will be passed back to the callback.</param>
+/// <param name="callback">The callback, or null to remove it.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsSetRuntimeGarbageCollectionCallback(
+        _In_ JsRuntimeHandle runtime,
+        _In_opt_ void *callbackState,
+        _In_opt_ JsGarbageCollectionCallback callback);
+
+/// <summary>
+///     A node of the call tree of a CPU profile.
+/// </summary>
+typedef struct JsProfileNode
+{
+    /// <summary>The id of the node, its index in the nodes of the profile.</summary>
+    unsigned int id;
+    /// <summary>The id of the parent node. The root node is its own parent.</summary>
+    unsigned int parentId;
+    /// <summary>The number of samples taken with the node on top of the stack.</summary>
+    unsigned int hitCount;
+    /// <summary>The UTF-8 name of the function, or one of (root), (program) and (idle).</summary>
+    const char *functionName;
+    /// <summary>The UTF-8 url of the script of the function, empty if there is none.</summary>
+    const char *url;
+    /// <summary>The id of the script of the function, 0 if there is none.</summary>
+    unsigned int scriptId;
+    /// <summary>The zero based line of the function, -1 if there is none.</summary>
+    int lineNumber;
+    /// <summary>The zero based column of the function, -1 if there is none.</summary>
+    int columnNumber;
+} JsProfileNode;
+
+/// <summary>
+///     A CPU profile, the call tree of the samples taken between <c>JsStartProfiling</c> and
+///     <c>JsStopProfiling</c>.
+/// </summary>
+typedef struct JsProfile
+{
+    /// <summary>The nodes of the call tree, the root first and parents before their children.</summary>
+    JsProfileNode *nodes;
+    /// <summary>The number of nodes.</summary>
+    size_t nodeCount;
+    /// <summary>The id of the top node of each sample, in the order they were taken.</summary>
+    unsigned int *samples;
+    /// <summary>The time of each sample, in microseconds.</summary>
+    unsigned long long *timestamps;
+    /// <summary>The number of samples.</summary>
+    size_t sampleCount;
+    /// <summary>The time profiling started, in microseconds.</summary>
+    unsigned long long startTime;
+    /// <summary>The time profiling stopped, in microseconds.</summary>
+    unsigned long long endTime;
+} JsProfile;
+
+/// <summary>
+///     Starts collecting CPU profile samples for a runtime.
+/// </summary>
+/// <remarks>
+///     Samples are only taken when requested with <c>JsRequestProfileSample</c>, so the host
+///     decides the sampling interval. A runtime profiles one session at a time.
+/// </remarks>
+/// <param name="runtime">The runtime to profile.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsStartProfiling(
+        _In_ JsRuntimeHandle runtime);
+
+/// <summary>
+///     Requests a CPU profile sample of a runtime.
+/// </summary>
+/// <remarks>
+///     <para>
+///     This API can be called from any thread, typically a timer thread of the host. When script
+///     is running the sample is taken by the runtime's thread at its next stack probe, from a
+///     function call or a loop back edge, rather than by suspending the thread.
+///     </para>
+///     <para>
+///     When no script is running, the sample is recorded as (program), or as (idle) if
+///     <paramref name="idle" /> is true.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime to sample.</param>
+/// <param name="idle">Whether the host is idle, waiting for work.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsRequestProfileSample(
+        _In_ JsRuntimeHandle runtime,
+        _In_ bool idle);
+
+/// <summary>
+///     Stops collecting CPU profile samples for a runtime and returns the profile.
+/// </summary>
+/// <remarks>
+///     The profile must be released with <c>JsReleaseProfile</c>.
+/// </remarks>
+/// <param name="runtime">The runtime being profiled.</param>
+/// <param name="profile">The profile collected since <c>JsStartProfiling</c>.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsStopProfiling(
+        _In_ JsRuntimeHandle runtime,
+        _Out_ JsProfile **profile);
+
+/// <summary>
+///     Releases a CPU profile returned by <c>JsStopProfiling</c>.
+/// </summary>
+/// <param name="profile">The profile to release.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsReleaseProfile(
+        _In_ JsProfile *profile);
+
+/// <summary>
+///     The type of a node of a heap snapshot, in the order of the node types of the
+///     .heapsnapshot format.
+/// </summary>
+typedef enum JsHeapSnapshotNodeType
+{
+    JsHeapSnapshotNodeType_Hidden = 0,
+    JsHeapSnapshotNodeType_Array = 1,
+    JsHeapSnapshotNodeType_String = 2,
+    JsHeapSnapshotNodeType_Object = 3,
+    JsHeapSnapshotNodeType_Code = 4,
+    JsHeapSnapshotNodeType_Closure = 5,
+    JsHeapSnapshotNodeType_RegExp = 6,
+    JsHeapSnapshotNodeType_Number = 7,
+    JsHeapSnapshotNodeType_Native = 8,
+    JsHeapSnapshotNodeType_Synthetic = 9,
+    JsHeapSnapshotNodeType_ConcatenatedString = 10,
+    JsHeapSnapshotNodeType_SlicedString = 11,
+    JsHeapSnapshotNodeType_Symbol = 12
+} JsHeapSnapshotNodeType;
+
+/// <summary>
+///     The type of an edge of a heap snapshot, in the order of the edge types of the
+///     .heapsnapshot format.
+/// </summary>
+typedef enum JsHeapSnapshotEdgeType
+{
+    /// <summary>A variable captured by a closure, named.</summary>
+    JsHeapSnapshotEdgeType_Context = 0,
+    /// <summary>An indexed element.</summary>
+    JsHeapSnapshotEdgeType_Element = 1,
+    /// <summary>A named property.</summary>
+    JsHeapSnapshotEdgeType_Property = 2,
+    /// <summary>A reference not visible to script, named.</summary>
+    JsHeapSnapshotEdgeType_Internal = 3,
+    /// <summary>A reference not visible to script, indexed.</summary>
+    JsHeapSnapshotEdgeType_Hidden = 4,
+    /// <summary>A named shortcut to a node also reachable through other edges.</summary>
+    JsHeapSnapshotEdgeType_Shortcut = 5,
+    /// <summary>A reference that does not keep its target alive, indexed.</summary>
+    JsHeapSnapshotEdgeType_Weak = 6
+} JsHeapSnapshotEdgeType;
+
+/// <summary>
+///     A node of a heap snapshot.
+/// </summary>
+typedef struct JsHeapSnapshotNode
+{
+    /// <summary>The type of the node.</summary>
+    JsHeapSnapshotNodeType type;
+    /// <summary>The index of the name of the node in the strings of the snapshot.</summary>
+    unsigned int name;
+    /// <summary>The id of the node.</summary>
+    unsigned int id;
+    /// <summary>The bytes used by the node itself.</summary>
+    size_t selfSize;
+    /// <summary>The number of edges from the node.</summary>
+    unsigned int edgeCount;
+} JsHeapSnapshotNode;
+
+/// <summary>
+///     An edge of a heap snapshot.
+/// </summary>
+typedef struct JsHeapSnapshotEdge
+{
+    /// <summary>The type of the edge.</summary>
+    JsHeapSnapshotEdgeType type;
+    /// <summary>
+    ///     The index of the element for element, hidden and weak edges, otherwise the index of
+    ///     the name of the edge in the strings of the snapshot.
+    /// </summary>
+    unsigned int nameOrIndex;
+    /// <summary>The index of the node the edge points to.</summary>
+    unsigned int toNode;
+} JsHeapSnapshotEdge;
+
+/// <summary>
+///     A snapshot of the objects of a runtime and the references between them.
+/// </summary>
+/// <remarks>
+///     The edges of a node follow the edges of the node before it, the first node is the root.
+/// </remarks>
+typedef struct JsHeapSnapshot
+{
+    /// <summary>The nodes of the snapshot.</summary>
+    JsHeapSnapshotNode *nodes;
+    /// <summary>The number of nodes.</summary>
+    size_t nodeCount;
+    /// <summary>The edges of the nodes.</summary>
+    JsHeapSnapshotEdge *edges;
+    /// <summary>The number of edges.</summary>
+    size_t edgeCount;
+    /// <summary>The UTF-8 names of the nodes and edges.</summary>
+    const char **strings;
+    /// <summary>The number of strings.</summary>
+    size_t stringCount;
+} JsHeapSnapshot;
+
+/// <summary>
+///     Takes a snapshot of the objects of a runtime.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The objects reachable from the global objects of the runtime's contexts and from the
+///     references held by the host are walked with collection disabled. Objects only referenced
+///     from the stack are not part of the snapshot.
+///     </para>
+///     <para>
+///     The snapshot must be released with <c>JsReleaseHeapSnapshot</c>.
+///     </para>
+/// </remarks>
+/// <param name="runtime">The runtime to take a snapshot of.</param>
+/// <param name="snapshot">The snapshot.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsTakeHeapSnapshot(
+        _In_ JsRuntimeHandle runtime,
+        _Out_ JsHeapSnapshot **snapshot);
+
+/// <summary>
+///     Releases a heap snapshot returned by <c>JsTakeHeapSnapshot</c>.
+/// </summary>
+/// <param name="snapshot">The snapshot to release.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsReleaseHeapSnapshot(
+        _In_ JsHeapSnapshot *snapshot);
+
+/// <summary>
+///     Captures the frames of the current script stack, the way <c>Error.captureStackTrace</c>
+///     does.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Only the function and bytecode offset of each frame are recorded. Names and positions
+///     are resolved when the frames are requested with <c>JsGetStackTraceFrames</c>.
+///     </para>
+///     <para>
+///     Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="skipUntil">
+///     A function whose most recent call and the frames above it are left out, or
+///     <c>JS_INVALID_REFERENCE</c> to start at the top of the stack. The stack trace is empty if
+///     the function isn't on the stack.
+/// </param>
+/// <param name="frameLimit">The maximum number of frames to capture.</param>
+/// <param name="stackTrace">An object holding the captured frames.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCaptureStackTrace(
+        _In_ JsValueRef skipUntil,
+        _In_ unsigned int frameLimit,
+        _Out_ JsValueRef *stackTrace);
+
+/// <summary>
+///     Gets the frames of a stack trace captured by <c>JsCaptureStackTrace</c>, or of the
+///     stack trace an Error object recorded when it was created or thrown.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Each frame is an object with a <c>name</c> property holding the function name. Frames
+///     of script functions also have <c>url</c>, <c>line</c> and <c>column</c> properties, with
+///     the line and column starting at 1. Frames of native library functions only have a name.
+///     </para>
+///     <para>
+///     Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="stackTrace">The stack trace object or Error object.</param>
+/// <param name="frames">An array of frames, the most recent call first.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorInvalidArgument</c> if
+///     the object has no stack trace, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetStackTraceFrames(
+        _In_ JsValueRef stackTrace,
+        _Out_ JsValueRef *frames);
+
+/// <summary>
+///     Tells the current runtime that the host expects to stay idle for some time.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Unlike <c>JsIdle</c>, which only does the idle work that is due, this uses the time the
+///     host has to spare. A concurrent collection is finished if its background work is done,
+///     the idle collection <c>JsIdle</c> would run later is started now if there is time left,
+///     and once the heap has been collected the free pages are decommitted. A collection
+///     started here trims the caches of the thread, like the idle collection does.
+///     </para>
+///     <para>
+///     Idle processing must be enabled for the current runtime. Requires an active script
+///     context.
+///     </para>
+/// </remarks>
+/// <param name="idleTimeInMs">How long the host expects to stay idle, in milliseconds.</param>
+/// <param name="done">
+///     Set to true if there is no idle work left to do until script runs again, false if the
+///     host should call again when it is idle.
+/// </param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsIdleNotification(
+        _In_ unsigned int idleTimeInMs,
+        _Out_ bool *done);
+
+/// <summary>
+///     Tells a runtime that the system is low on memory.
+/// </summary>
+/// <remarks>
+///     Runs an exhaustive collection that also cleans up the caches of the thread, and then
+///     decommits all free pages.
+/// </remarks>
+/// <param name="runtime">The runtime to release memory from.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsLowMemoryNotification(
+        _In_ JsRuntimeHandle runtime);
+
+/// <summary>
+///     A serializer that writes values in the V8 structured clone wire format.
+/// </summary>
+typedef void *JsValueSerializerHandle;
+
+/// <summary>
+///     A deserializer that reads values in the V8 structured clone wire format.
+/// </summary>
+typedef void *JsValueDeserializerHandle;
+
+/// <summary>
+///     Called when a value cannot be serialized.
+/// </summary>
+/// <remarks>
+///     The host should set an exception with <c>JsSetException</c>. If it does not, an Error
+///     with the message is thrown.
+/// </remarks>
+/// <param name="message">The message describing why the value could not be cloned.</param>
+/// <param name="callbackState">The state passed to <c>JsCreateValueSerializer</c>.</param>
+typedef void (CHAKRA_CALLBACK *JsSerializerDataCloneErrorCallback)(_In_ JsValueRef message, _In_opt_ void *callbackState);
+
+/// <summary>
+///     Called to write an external object that has internal fields.
+/// </summary>
+/// <remarks>
+///     The host writes the object with the <c>JsValueSerializerWrite*</c> functions.
+/// </remarks>
+/// <param name="object">The object to write.</param>
+/// <param name="callbackState">The state passed to <c>JsCreateValueSerializer</c>.</param>
+/// <returns>
+///     true if the object was written. On false the object is reported as not cloneable, unless
+///     the host set an exception.
+/// </returns>
+typedef bool (CHAKRA_CALLBACK *JsSerializerWriteHostObjectCallback)(_In_ JsValueRef object, _In_opt_ void *callbackState);
+
+/// <summary>
+///     Called to get the id a SharedArrayBuffer is written with.
+/// </summary>
+/// <param name="sharedArrayBuffer">The SharedArrayBuffer to write.</param>
+/// <param name="id">The id the receiving side passes to <c>JsValueDeserializerTransferArrayBuffer</c>.</param>
+/// <param name="callbackState">The state passed to <c>JsCreateValueSerializer</c>.</param>
+/// <returns>
+///     true if an id was returned. On false the buffer is reported as not cloneable, unless the
+///     host set an exception.
+/// </returns>
+typedef bool (CHAKRA_CALLBACK *JsSerializerGetSharedArrayBufferIdCallback)(_In_ JsValueRef sharedArrayBuffer, _Out_ unsigned int *id, _In_opt_ void *callbackState);
+
+/// <summary>
+///     Called to grow the buffer the serializer writes to.
+/// </summary>
+/// <param name="buffer">The current buffer, or null if nothing has been written yet.</param>
+/// <param name="size">The size the buffer needs at least.</param>
+/// <param name="allocatedSize">The size actually allocated.</param>
+/// <param name="callbackState">The state passed to <c>JsCreateValueSerializer</c>.</param>
+/// <returns>The new buffer, or null if it could not be allocated.</returns>
+typedef void * (CHAKRA_CALLBACK *JsSerializerReallocateBufferCallback)(_In_opt_ void *buffer, _In_ size_t size, _Out_ size_t *allocatedSize, _In_opt_ void *callbackState);
+
+/// <summary>
+///     Called to free a buffer allocated with the reallocate callback.
+/// </summary>
+/// <param name="buffer">The buffer to free.</param>
+/// <param name="callbackState">The state passed to <c>JsCreateValueSerializer</c>.</param>
+typedef void (CHAKRA_CALLBACK *JsSerializerFreeBufferCallback)(_In_ void *buffer, _In_opt_ void *callbackState);
+
+/// <summary>
+///     Called to read an object written by a host object callback of the serializer.
+/// </summary>
+/// <remarks>
+///     The host reads the object with the <c>JsValueDeserializerRead*</c> functions.
+/// </remarks>
+/// <param name="callbackState">The state passed to <c>JsCreateValueDeserializer</c>.</param>
+/// <returns>
+///     The object read. On <c>JS_INVALID_REFERENCE</c> the data is reported as invalid, unless the
+///     host set an exception.
+/// </returns>
+typedef JsValueRef (CHAKRA_CALLBACK *JsDeserializerReadHostObjectCallback)(_In_opt_ void *callbackState);
+
+/// <summary>
+///     The host callbacks of a serializer.
+/// </summary>
+/// <remarks>
+///     <c>reallocateBuffer</c> and <c>freeBuffer</c> are required. Without <c>writeHostObject</c>
+///     or <c>getSharedArrayBufferId</c> host objects and SharedArrayBuffers cannot be cloned.
+/// </remarks>
+typedef struct JsValueSerializerCallbacks
+{
+    JsSerializerDataCloneErrorCallback dataCloneError;
+    JsSerializerWriteHostObjectCallback writeHostObject;
+    JsSerializerGetSharedArrayBufferIdCallback getSharedArrayBufferId;
+    JsSerializerReallocateBufferCallback reallocateBuffer;
+    JsSerializerFreeBufferCallback freeBuffer;
+} JsValueSerializerCallbacks;
+
+/// <summary>
+///     Creates a serializer for the current script context.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The serializer writes the same bytes as V8's <c>ValueSerializer</c>, so data can be
+///     exchanged with V8 based hosts. Objects are written once; later references to them are
+///     written as back references.
+///     </para>
+///     <para>
+///     The serializer must be used on the script context it was created for and disposed with
+///     <c>JsDisposeValueSerializer</c>. Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="callbacks">The host callbacks, copied by the serializer.</param>
+/// <param name="callbackState">User provided state that will be passed to the callbacks.</param>
+/// <param name="serializer">The new serializer.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateValueSerializer(
+        _In_ const JsValueSerializerCallbacks *callbacks,
+        _In_opt_ void *callbackState,
+        _Out_ JsValueSerializerHandle *serializer);
+
+/// <summary>
+///     Disposes a serializer, freeing the buffer if it was not released.
+/// </summary>
+/// <param name="serializer">The serializer to dispose.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsDisposeValueSerializer(
+        _In_ JsValueSerializerHandle serializer);
+
+/// <summary>
+///     Writes the wire format version.
+/// </summary>
+/// <param name="serializer">The serializer.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerWriteHeader(
+        _In_ JsValueSerializerHandle serializer);
+
+/// <summary>
+///     Writes a value and everything reachable from it.
+/// </summary>
+/// <remarks>
+///     Requires an active script context.
+/// </remarks>
+/// <param name="serializer">The serializer.</param>
+/// <param name="value">The value to write.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorScriptException</c> if
+///     the value could not be cloned, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerWriteValue(
+        _In_ JsValueSerializerHandle serializer,
+        _In_ JsValueRef value);
+
+/// <summary>
+///     Marks an ArrayBuffer as transferred, so it is written as the id instead of its contents.
+/// </summary>
+/// <param name="serializer">The serializer.</param>
+/// <param name="transferId">The id the receiving side passes to <c>JsValueDeserializerTransferArrayBuffer</c>.</param>
+/// <param name="arrayBuffer">The ArrayBuffer.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerTransferArrayBuffer(
+        _In_ JsValueSerializerHandle serializer,
+        _In_ unsigned int transferId,
+        _In_ JsValueRef arrayBuffer);
+
+/// <summary>
+///     Sets whether typed arrays and DataViews are written with the host object callback.
+/// </summary>
+/// <param name="serializer">The serializer.</param>
+/// <param name="treatAsHostObjects">Whether views are written as host objects.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerSetTreatArrayBufferViewsAsHostObjects(
+        _In_ JsValueSerializerHandle serializer,
+        _In_ bool treatAsHostObjects);
+
+/// <summary>
+///     Writes an unsigned integer as a base 128 varint.
+/// </summary>
+/// <param name="serializer">The serializer.</param>
+/// <param name="value">The value to write.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerWriteVarint(
+        _In_ JsValueSerializerHandle serializer,
+        _In_ uint64_t value);
+
+/// <summary>
+///     Writes a double in host byte order.
+/// </summary>
+/// <param name="serializer">The serializer.</param>
+/// <param name="value">The value to write.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerWriteDouble(
+        _In_ JsValueSerializerHandle serializer,
+        _In_ double value);
+
+/// <summary>
+///     Writes bytes as they are.
+/// </summary>
+/// <param name="serializer">The serializer.</param>
+/// <param name="source">The bytes to write.</param>
+/// <param name="length">The number of bytes.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerWriteRawBytes(
+        _In_ JsValueSerializerHandle serializer,
+        _In_reads_bytes_(length) const void *source,
+        _In_ size_t length);
+
+/// <summary>
+///     Hands the written bytes over to the host and resets the serializer.
+/// </summary>
+/// <remarks>
+///     The buffer was allocated with the reallocate callback and must be freed by the host.
+/// </remarks>
+/// <param name="serializer">The serializer.</param>
+/// <param name="buffer">The buffer, or null if nothing was written.</param>
+/// <param name="size">The number of bytes written.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueSerializerReleaseBuffer(
+        _In_ JsValueSerializerHandle serializer,
+        _Outptr_result_maybenull_ void **buffer,
+        _Out_ size_t *size);
+
+/// <summary>
+///     Creates a deserializer for the current script context.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The data is not copied and must stay alive until the deserializer is disposed with
+///     <c>JsDisposeValueDeserializer</c>.
+///     </para>
+///     <para>
+///     Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="data">The bytes to read.</param>
+/// <param name="size">The number of bytes.</param>
+/// <param name="readHostObject">The callback reading host objects, or null if there are none.</param>
+/// <param name="callbackState">User provided state that will be passed to the callback.</param>
+/// <param name="deserializer">The new deserializer.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateValueDeserializer(
+        _In_reads_bytes_(size) const void *data,
+        _In_ size_t size,
+        _In_opt_ JsDeserializerReadHostObjectCallback readHostObject,
+        _In_opt_ void *callbackState,
+        _Out_ JsValueDeserializerHandle *deserializer);
+
+/// <summary>
+///     Disposes a deserializer.
+/// </summary>
+/// <param name="deserializer">The deserializer to dispose.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsDisposeValueDeserializer(
+        _In_ JsValueDeserializerHandle deserializer);
+
+/// <summary>
+///     Reads the wire format version, if the data has one.
+/// </summary>
+/// <remarks>
+///     Requires an active script context.
+/// </remarks>
+/// <param name="deserializer">The deserializer.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorScriptException</c> if
+///     the version is not supported, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueDeserializerReadHeader(
+        _In_ JsValueDeserializerHandle deserializer);
+
+/// <summary>
+///     Reads a value.
+/// </summary>
+/// <remarks>
+///     Requires an active script context.
+/// </remarks>
+/// <param name="deserializer">The deserializer.</param>
+/// <param name="value">The value read.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorScriptException</c> if
+///     the data could not be read, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueDeserializerReadValue(
+        _In_ JsValueDeserializerHandle deserializer,
+        _Out_ JsValueRef *value);
+
+/// <summary>
+///     Provides the ArrayBuffer or SharedArrayBuffer that was written with an id.
+/// </summary>
+/// <param name="deserializer">The deserializer.</param>
+/// <param name="transferId">The id it was written with.</param>
+/// <param name="arrayBuffer">The ArrayBuffer or SharedArrayBuffer.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueDeserializerTransferArrayBuffer(
+        _In_ JsValueDeserializerHandle deserializer,
+        _In_ unsigned int transferId,
+        _In_ JsValueRef arrayBuffer);
+
+/// <summary>
+///     Gets the wire format version read by <c>JsValueDeserializerReadHeader</c>.
+/// </summary>
+/// <param name="deserializer">The deserializer.</param>
+/// <param name="version">The version, 0 if the data has no header.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueDeserializerGetWireFormatVersion(
+        _In_ JsValueDeserializerHandle deserializer,
+        _Out_ unsigned int *version);
+
+/// <summary>
+///     Reads an unsigned integer written as a base 128 varint.
+/// </summary>
+/// <param name="deserializer">The deserializer.</param>
+/// <param name="value">The value read.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorInvalidArgument</c> if
+///     the data ends first, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueDeserializerReadVarint(
+        _In_ JsValueDeserializerHandle deserializer,
+        _Out_ uint64_t *value);
+
+/// <summary>
+///     Reads a double in host byte order.
+/// </summary>
+/// <param name="deserializer">The deserializer.</param>
+/// <param name="value">The value read.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorInvalidArgument</c> if
+///     the data ends first, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueDeserializerReadDouble(
+        _In_ JsValueDeserializerHandle deserializer,
+        _Out_ double *value);
+
+/// <summary>
+///     Reads bytes as they are.
+/// </summary>
+/// <param name="deserializer">The deserializer.</param>
+/// <param name="length">The number of bytes.</param>
+/// <param name="data">Points into the data passed to <c>JsCreateValueDeserializer</c>.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorInvalidArgument</c> if
+///     the data ends first, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsValueDeserializerReadRawBytes(
+        _In_ JsValueDeserializerHandle deserializer,
+        _In_ size_t length,
+        _Outptr_result_bytebuffer_(length) const void **data);
+
+/// <summary>
+///     Creates a new object that stores some external data and has a number of internal fields.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Internal fields are stored inline in the object and are not visible to script. They
+///     start out as <c>nullptr</c> and are accessed with <c>JsGetExternalObjectField</c> and
+///     <c>JsSetExternalObjectField</c>, which don't need to look up any property.
+///     </para>
+///     <para>
+///     A field may hold either a host pointer or a <c>JsValueRef</c>. A <c>JsValueRef</c>
+///     stored in a field is kept alive for as long as the object is alive.
+///     </para>
+///     <para>
+///     Requires an active script context.
 ///     </para>
 /// </remarks>
-/// <param name="value">JavascriptString value</param>
-/// <param name="buffer">Pointer to buffer</param>
-/// <param name="bufferSize">Buffer size</param>
-/// <param name="written">Total number of characters written</param>
+/// <param name="data">External data that the object will represent. May be null.</param>
+/// <param name="finalizeCallback">
+///     A callback for when the object is finalized. May be null.
+/// </param>
+/// <param name="fieldCount">The number of internal fields.</param>
+/// <param name="object">The new object.</param>
 /// <returns>
 ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
 /// </returns>
 CHAKRA_API
-    JsCopyString(
-        _In_ JsValueRef value,
-        _Out_opt_ char* buffer,
-        _In_ size_t bufferSize,
-        _Out_opt_ size_t* written);
+    JsCreateExternalObjectWithFields(
+        _In_opt_ void *data,
+        _In_opt_ JsFinalizeCallback finalizeCallback,
+        _In_ unsigned int fieldCount,
+        _Out_ JsValueRef *object);
 
 /// <summary>
-///     Write string value into Utf16 string buffer
+///     Retrieves an internal field of an object created by <c>JsCreateExternalObjectWithFields</c>.
+/// </summary>
+/// <remarks>
+///     Returns <c>JsErrorInvalidArgument</c> if the object is not an external object or
+///     <c>index</c> is out of range.
+/// </remarks>
+/// <param name="object">The object.</param>
+/// <param name="index">The index of the internal field.</param>
+/// <param name="value">The value of the internal field.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetExternalObjectField(
+        _In_ JsValueRef object,
+        _In_ unsigned int index,
+        _Out_ void **value);
+
+/// <summary>
+///     Sets an internal field of an object created by <c>JsCreateExternalObjectWithFields</c>.
+/// </summary>
+/// <remarks>
+///     Returns <c>JsErrorInvalidArgument</c> if the object is not an external object or
+///     <c>index</c> is out of range.
+/// </remarks>
+/// <param name="object">The object.</param>
+/// <param name="index">The index of the internal field.</param>
+/// <param name="value">The new value of the internal field. May be null.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsSetExternalObjectField(
+        _In_ JsValueRef object,
+        _In_ unsigned int index,
+        _In_opt_ void *value);
+
+/// <summary>
+///     A callback called before an external object is collected.
+/// </summary>
+/// <remarks>
+///     Use <c>JsSetExternalObjectWeakCallback</c> to register this callback.
+/// </remarks>
+/// <param name="object">The object to be collected.</param>
+/// <param name="callbackState">The state passed to <c>JsSetExternalObjectWeakCallback</c>.</param>
+/// <param name="callbackData">The data passed to <c>JsSetExternalObjectWeakCallback</c>.</param>
+typedef void (CHAKRA_CALLBACK *JsExternalObjectWeakCallback)(_In_ JsValueRef object, _In_opt_ void *callbackState, _In_opt_ void *callbackData);
+
+/// <summary>
+///     Sets a callback function that is called by the runtime before garbage collection of
+///     an external object.
 /// </summary>
 /// <remarks>
 ///     <para>
-///         When size of the `buffer` is unknown,
-///         `buffer` argument can be nullptr.
-///         In that case, `written` argument will return the length needed.
+///     Works like <c>JsSetObjectBeforeCollectCallback</c>, but the callback is kept in the
+///     object itself, so setting or clearing it doesn't allocate. An object has at most one
+///     such callback, and it is cleared before it is called. The callback may set a new one
+///     to keep the object alive.
 ///     </para>
 ///     <para>
-///         when start is out of range or &lt; 0, returns JsErrorInvalidArgument
-///         and `written` will be equal to 0.
-///         If calculated length is 0 (It can be due to string length or `start`
-///         and length combination), then `written` will be equal to 0 and call
-///         returns JsNoError
+///     Returns <c>JsErrorInvalidArgument</c> if the object is not an external object.
+///     </para>
+/// </remarks>
+/// <param name="object">The external object for which to register the callback.</param>
+/// <param name="weakCallback">The callback function being set. Use null to clear
+///     previously registered callback.</param>
+/// <param name="callbackState">
+///     User provided state that will be passed back to the callback.
+/// </param>
+/// <param name="callbackData">
+///     User provided data that will be passed back to the callback.
+/// </param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsSetExternalObjectWeakCallback(
+        _In_ JsValueRef object,
+        _In_opt_ JsExternalObjectWeakCallback weakCallback,
+        _In_opt_ void *callbackState,
+        _In_opt_ void *callbackData);
+
+/// <summary>
+///     Attributes of a property reported by a query interceptor.
+/// </summary>
+typedef enum JsInterceptedPropertyAttributes
+{
+    JsInterceptedPropertyAttributes_None = 0x00000000,
+    JsInterceptedPropertyAttributes_ReadOnly = 0x00000001,
+    JsInterceptedPropertyAttributes_DontEnum = 0x00000002,
+    JsInterceptedPropertyAttributes_DontDelete = 0x00000004
+} JsInterceptedPropertyAttributes;
+
+/// <summary>
+///     A callback called when a named property of an object with interceptors is read.
+/// </summary>
+/// <param name="object">The object that has the interceptors.</param>
+/// <param name="name">The name of the property, a string or a symbol.</param>
+/// <param name="value">The value of the property, if intercepted.</param>
+/// <returns>
+///     true if the access was intercepted, false to continue with the ordinary lookup.
+/// </returns>
+typedef bool (CHAKRA_CALLBACK *JsNamedPropertyGetterCallback)(_In_ JsValueRef object, _In_ JsValueRef name, _Out_ JsValueRef *value);
+
+/// <summary>
+///     A callback called when a named property of an object with interceptors is written.
+/// </summary>
+/// <returns>
+///     true if the write was intercepted, false to continue with the ordinary assignment.
+/// </returns>
+typedef bool (CHAKRA_CALLBACK *JsNamedPropertySetterCallback)(_In_ JsValueRef object, _In_ JsValueRef name, _In_ JsValueRef value);
+
+/// <summary>
+///     A callback called to find out whether an object with interceptors has a named property.
+/// </summary>
+/// <returns>
+///     true if the object has the property, in which case <c>attributes</c> receives its
+///     attributes; false to continue with the ordinary lookup.
+/// </returns>
+typedef bool (CHAKRA_CALLBACK *JsNamedPropertyQueryCallback)(_In_ JsValueRef object, _In_ JsValueRef name, _Out_ JsInterceptedPropertyAttributes *attributes);
+
+/// <summary>
+///     A callback called when a named property of an object with interceptors is deleted.
+/// </summary>
+/// <returns>
+///     true if the delete was intercepted, in which case <c>result</c> receives whether it
+///     succeeded; false to continue with the ordinary delete.
+/// </returns>
+typedef bool (CHAKRA_CALLBACK *JsNamedPropertyDeleterCallback)(_In_ JsValueRef object, _In_ JsValueRef name, _Out_ bool *result);
+
+/// <summary>
+///     A callback called to enumerate the intercepted named properties of an object.
+/// </summary>
+/// <returns>
+///     An array of property names, or <c>JS_INVALID_REFERENCE</c> if there are none.
+/// </returns>
+typedef JsValueRef (CHAKRA_CALLBACK *JsNamedPropertyEnumeratorCallback)(_In_ JsValueRef object);
+
+/// <summary>
+///     Indexed variant of <c>JsNamedPropertyGetterCallback</c>.
+/// </summary>
+typedef bool (CHAKRA_CALLBACK *JsIndexedPropertyGetterCallback)(_In_ JsValueRef object, _In_ unsigned int index, _Out_ JsValueRef *value);
+
+/// <summary>
+///     Indexed variant of <c>JsNamedPropertySetterCallback</c>.
+/// </summary>
+typedef bool (CHAKRA_CALLBACK *JsIndexedPropertySetterCallback)(_In_ JsValueRef object, _In_ unsigned int index, _In_ JsValueRef value);
+
+/// <summary>
+///     Indexed variant of <c>JsNamedPropertyQueryCallback</c>.
+/// </summary>
+typedef bool (CHAKRA_CALLBACK *JsIndexedPropertyQueryCallback)(_In_ JsValueRef object, _In_ unsigned int index, _Out_ JsInterceptedPropertyAttributes *attributes);
+
+/// <summary>
+///     Indexed variant of <c>JsNamedPropertyDeleterCallback</c>.
+/// </summary>
+typedef bool (CHAKRA_CALLBACK *JsIndexedPropertyDeleterCallback)(_In_ JsValueRef object, _In_ unsigned int index, _Out_ bool *result);
+
+/// <summary>
+///     Indexed variant of <c>JsNamedPropertyEnumeratorCallback</c>.
+/// </summary>
+typedef JsValueRef (CHAKRA_CALLBACK *JsIndexedPropertyEnumeratorCallback)(_In_ JsValueRef object);
+
+/// <summary>
+///     The interceptors of an object created by <c>JsCreateExternalObjectWithInterceptors</c>.
+///     Any of the callbacks may be null.
+/// </summary>
+typedef struct JsPropertyInterceptors
+{
+    JsNamedPropertyGetterCallback namedGetter;
+    JsNamedPropertySetterCallback namedSetter;
+    JsNamedPropertyQueryCallback namedQuery;
+    JsNamedPropertyDeleterCallback namedDeleter;
+    JsNamedPropertyEnumeratorCallback namedEnumerator;
+    JsIndexedPropertyGetterCallback indexedGetter;
+    JsIndexedPropertySetterCallback indexedSetter;
+    JsIndexedPropertyQueryCallback indexedQuery;
+    JsIndexedPropertyDeleterCallback indexedDeleter;
+    JsIndexedPropertyEnumeratorCallback indexedEnumerator;
+} JsPropertyInterceptors;
+
+/// <summary>
+///     Creates a new external object whose property accesses are intercepted by host callbacks.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The interceptors are called directly by the engine before the ordinary property lookup,
+///     both on the object itself and when the object is on the prototype chain of the object
+///     being accessed. When an interceptor declines, the ordinary lookup is performed. Accesses
+///     of a kind (named or indexed) with no interceptors are cached like those of any other
+///     object.
+///     </para>
+///     <para>
+///     The interceptors are copied. Objects created with the same <c>interceptors</c> pointer,
+///     contents and finalize callback share their type.
+///     </para>
+///     <para>
+///     An interceptor may throw by setting an exception with <c>JsSetException</c>.
+///     </para>
+///     <para>
+///     Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="data">External data that the object will represent. May be null.</param>
+/// <param name="finalizeCallback">
+///     A callback for when the object is finalized. May be null.
+/// </param>
+/// <param name="fieldCount">The number of internal fields.</param>
+/// <param name="interceptors">The property interceptors.</param>
+/// <param name="object">The new object.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateExternalObjectWithInterceptors(
+        _In_opt_ void *data,
+        _In_opt_ JsFinalizeCallback finalizeCallback,
+        _In_ unsigned int fieldCount,
+        _In_ const JsPropertyInterceptors *interceptors,
+        _Out_ JsValueRef *object);
+
+/// <summary>
+///     Creates a new object and initializes its own data properties in a single call.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The properties are defined in order as writable, enumerable and configurable data
+///     properties, the same as an object literal would. Setters on the prototype chain are not
+///     called. Objects created with the same property ids in the same order share their type.
+///     </para>
+///     <para>
+///     Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="propertyIds">The ids of the properties to define.</param>
+/// <param name="values">The values of the properties, in the same order as the ids.</param>
+/// <param name="count">The number of properties.</param>
+/// <param name="object">The new object.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCreateObjectWithProperties(
+        _In_reads_(count) const JsPropertyIdRef *propertyIds,
+        _In_reads_(count) const JsValueRef *values,
+        _In_ unsigned int count,
+        _Out_ JsValueRef *object);
+
+/// <summary>
+///     Invokes a list of functions in order, with <c>undefined</c> as this and no arguments.
+/// </summary>
+/// <remarks>
+///     <para>
+///     The functions are called in a single entry into the runtime, which makes this cheaper than
+///     calling <c>JsCallFunction</c> for each of them, for example to drain a queue of promise
+///     reactions.
+///     </para>
+///     <para>
+///     Calling stops at the first function that throws. The exception is left for the host to
+///     get with <c>JsGetAndClearException</c>, and the remaining functions can be called with
+///     another call starting after the one that threw.
+///     </para>
+///     <para>
+///     Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="functions">The functions to invoke.</param>
+/// <param name="count">The number of functions.</param>
+/// <param name="callCount">
+///     The number of functions that were called, including one that threw.
+/// </param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsCallFunctions(
+        _In_reads_(count) const JsValueRef *functions,
+        _In_ unsigned int count,
+        _Out_ unsigned int *callCount);
+
+/// <summary>
+///     Get the length of a string value when encoded as Utf8
+/// </summary>
+/// <remarks>
+///     <para>
+///         Returns the same length as calling JsCopyString with a null buffer,
+///         without encoding the string.
+///     </para>
+///     <para>
+///         The result is remembered on the string, so asking again for the same
+///         string is cheap.
 ///     </para>
 /// </remarks>
 /// <param name="value">JavascriptString value</param>
-/// <param name="start">start offset of buffer</param>
-/// <param name="length">length to be written</param>
-/// <param name="buffer">Pointer to buffer</param>
-/// <param name="written">Total number of characters written</param>
+/// <param name="length">Length of the Utf8 encoded string, not including a null terminator</param>
 /// <returns>
 ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
 /// </returns>
 CHAKRA_API
-    JsCopyStringUtf16(
+    JsGetStringUtf8Length(
         _In_ JsValueRef value,
-        _In_ int start,
-        _In_ int length,
-        _Out_opt_ uint16_t* buffer,
-        _Out_opt_ size_t* written);
+        _Out_ size_t* length);
 
 /// <summary>
 ///     Parses a script and returns a function representing the script.
@@ -429,6 +1870,54 @@ CHAKRA_API
         _In_ size_t bufferSize,
         _Out_ size_t* length);
 
+/// <summary>
+///     Gets the property ID associated with the contents of a string value.
+/// </summary>
+/// <remarks>
+///     <para>
+///         Unlike <c>JsCreatePropertyId</c>, the string is not transcoded. Strings returned by
+///         <c>JsGetPropertyIdString</c> already hold their property ID, which is returned without
+///         a lookup.
+///     </para>
+///     <para>
+///         Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="stringValue">The string value.</param>
+/// <param name="propertyId">The property ID in this runtime for the contents of the string.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorPropertyNotString</c> if
+///     the value is not a string, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetPropertyIdFromString(
+        _In_ JsValueRef stringValue,
+        _Out_ JsPropertyIdRef *propertyId);
+
+/// <summary>
+///     Gets the interned string value for a property ID.
+/// </summary>
+/// <remarks>
+///     <para>
+///         The string is cached by the script context and held weakly, so repeated calls return the
+///         same value for as long as it is reachable. Passing it back to
+///         <c>JsGetPropertyIdFromString</c> returns the property ID without a lookup.
+///     </para>
+///     <para>
+///         Requires an active script context.
+///     </para>
+/// </remarks>
+/// <param name="propertyId">The property ID. Symbol property IDs are not supported.</param>
+/// <param name="stringValue">The string value of the property ID.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, <c>JsErrorPropertyNotString</c> if
+///     the property ID is a symbol, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetPropertyIdString(
+        _In_ JsPropertyIdRef propertyId,
+        _Out_ JsValueRef *stringValue);
+
 /// <summary>
 ///     Serializes a parsed script to a buffer than can be reused.
 /// </summary>
@@ -528,6 +2017,27 @@ CHAKRA_API
         _In_ JsValueRef sourceUrl,
         _Out_ JsValueRef *result);
 
+/// <summary>
+///     Gets a value identifying the format of serialized scripts produced by this engine.
+/// </summary>
+/// <remarks>
+///     <para>
+///     Does not require an active script context.
+///     </para>
+///     <para>
+///     Serialized scripts are only accepted by an engine of the same version and architecture.
+///     Hosts that keep serialized scripts across processes can store this value with them and
+///     discard any whose value differs, instead of relying on the parse to fail.
+///     </para>
+/// </remarks>
+/// <param name="version">The serialized script version.</param>
+/// <returns>
+///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+/// </returns>
+CHAKRA_API
+    JsGetSerializedScriptVersion(
+        _Out_ unsigned int *version);
+
 /// <summary>
 ///     Creates a new JavaScript Promise object.
 /// </summary>
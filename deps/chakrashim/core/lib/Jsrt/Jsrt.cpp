@@ -5,7 +5,11 @@
 #include "JsrtPch.h"
 #include "JsrtInternal.h"
 #include "JsrtExternalObject.h"
+#include "JsrtInterceptorObject.h"
 #include "JsrtExternalArrayBuffer.h"
+#include "JsrtExternalString.h"
+#include "JsrtHeapSnapshot.h"
+#include "JsrtValueSerializer.h"
 #include "jsrtHelper.h"
 
 #include "JsrtSourceHolder.h"
@@ -495,10 +499,22 @@ CHAKRA_API JsDisposeRuntime(_In_ JsRuntimeHandle runtimeHandle)
 
         // Close any open Contexts.
         // We need to do this before recycler shutdown, because ScriptEngine->Close won't work then.
+        // Stop profiling while the recycler can still release the function bodies it pinned
+        if (runtime->GetProfiler() != nullptr && runtime->GetProfiler()->IsProfiling())
+        {
+            JsProfile * profile = runtime->GetProfiler()->Stop();
+            if (profile != nullptr)
+            {
+                JsrtProfiler::ReleaseProfile(profile);
+            }
+        }
+
         runtime->CloseContexts();
 
         runtime->DeleteJsrtDebugManager();
 
+        runtime->FreeRootBlocks();
+
 #if defined(CHECK_MEMORY_LEAK) || defined(LEAK_REPORT)
         bool doFinalGC = false;
 
@@ -2213,6 +2229,132 @@ CHAKRA_API JsSetExternalData(_In_ JsValueRef object, _In_opt_ void *data)
     END_JSRT_NO_EXCEPTION
 }
 
+CHAKRA_API JsCreateExternalObjectWithFields(_In_opt_ void *data, _In_opt_ JsFinalizeCallback finalizeCallback,
+    _In_ unsigned int fieldCount, _Out_ JsValueRef *object)
+{
+    return ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION(scriptContext, RecordJsRTAllocateExternalObject);
+
+        PARAM_NOT_NULL(object);
+
+        *object = JsrtExternalObject::Create(data, finalizeCallback, scriptContext, fieldCount);
+
+        PERFORM_JSRT_TTD_RECORD_ACTION_RESULT(scriptContext, object);
+
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsGetExternalObjectField(_In_ JsValueRef object, _In_ unsigned int index, _Out_ void **value)
+{
+    VALIDATE_JSREF(object);
+    PARAM_NOT_NULL(value);
+
+    BEGIN_JSRT_NO_EXCEPTION
+    {
+        if (JsrtExternalObject::Is(object) &&
+            index < JsrtExternalObject::FromVar(object)->GetInternalFieldCount())
+        {
+            *value = JsrtExternalObject::FromVar(object)->GetInternalField(index);
+        }
+        else
+        {
+            *value = nullptr;
+            RETURN_NO_EXCEPTION(JsErrorInvalidArgument);
+        }
+    }
+    END_JSRT_NO_EXCEPTION
+}
+
+CHAKRA_API JsSetExternalObjectField(_In_ JsValueRef object, _In_ unsigned int index, _In_opt_ void *value)
+{
+    VALIDATE_JSREF(object);
+
+    BEGIN_JSRT_NO_EXCEPTION
+    {
+        if (JsrtExternalObject::Is(object) &&
+            index < JsrtExternalObject::FromVar(object)->GetInternalFieldCount())
+        {
+            JsrtExternalObject::FromVar(object)->SetInternalField(index, value);
+        }
+        else
+        {
+            RETURN_NO_EXCEPTION(JsErrorInvalidArgument);
+        }
+    }
+    END_JSRT_NO_EXCEPTION
+}
+
+CHAKRA_API JsSetExternalObjectWeakCallback(_In_ JsValueRef object, _In_opt_ JsExternalObjectWeakCallback weakCallback,
+    _In_opt_ void *callbackState, _In_opt_ void *callbackData)
+{
+    VALIDATE_JSREF(object);
+
+    BEGIN_JSRT_NO_EXCEPTION
+    {
+        if (JsrtExternalObject::Is(object))
+        {
+            JsrtExternalObject::FromVar(object)->SetWeakCallback(weakCallback, callbackState, callbackData);
+        }
+        else
+        {
+            RETURN_NO_EXCEPTION(JsErrorInvalidArgument);
+        }
+    }
+    END_JSRT_NO_EXCEPTION
+}
+
+CHAKRA_API JsCreateExternalObjectWithInterceptors(_In_opt_ void *data, _In_opt_ JsFinalizeCallback finalizeCallback,
+    _In_ unsigned int fieldCount, _In_ const JsPropertyInterceptors *interceptors, _Out_ JsValueRef *object)
+{
+    return ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION(scriptContext, RecordJsRTAllocateExternalObject);
+
+        PARAM_NOT_NULL(interceptors);
+        PARAM_NOT_NULL(object);
+
+        *object = JsrtInterceptorObject::Create(data, finalizeCallback, interceptors, fieldCount, scriptContext);
+
+        PERFORM_JSRT_TTD_RECORD_ACTION_RESULT(scriptContext, object);
+
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsCreateObjectWithProperties(_In_reads_(count) const JsPropertyIdRef *propertyIds,
+    _In_reads_(count) const JsValueRef *values, _In_ unsigned int count, _Out_ JsValueRef *object)
+{
+    return ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION_NOT_IMPLEMENTED(scriptContext);
+
+        PARAM_NOT_NULL(object);
+        *object = JS_INVALID_REFERENCE;
+        if (count > 0)
+        {
+            PARAM_NOT_NULL(propertyIds);
+            PARAM_NOT_NULL(values);
+        }
+
+        // Same starting type as an object literal of this size, so objects built with the
+        // same properties in the same order end up sharing one path type
+        Js::PropertyIndex inlineSlotCapacity = (Js::PropertyIndex)min(count, (unsigned int)MaxPreInitializedObjectTypeInlineSlotCount);
+        Js::DynamicObject *newObject = scriptContext->GetLibrary()->CreateObject(true, inlineSlotCapacity);
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            JsPropertyIdRef propertyId = propertyIds[i];
+            Js::Var value = values[i];
+            VALIDATE_INCOMING_PROPERTYID(propertyId);
+            VALIDATE_INCOMING_REFERENCE(value, scriptContext);
+
+            Js::JavascriptOperators::InitProperty(newObject, ((Js::PropertyRecord *)propertyId)->GetPropertyId(), value);
+        }
+
+        *object = newObject;
+        return JsNoError;
+    });
+}
+
 CHAKRA_API JsCallFunction(_In_ JsValueRef function, _In_reads_(cargs) JsValueRef *args, _In_ ushort cargs, _Out_opt_ JsValueRef *result)
 {
     if(result != nullptr)
@@ -2276,6 +2418,60 @@ CHAKRA_API JsCallFunction(_In_ JsValueRef function, _In_reads_(cargs) JsValueRef
     });
 }
 
+CHAKRA_API JsCallFunctions(_In_reads_(count) const JsValueRef *functions, _In_ unsigned int count, _Out_ unsigned int *callCount)
+{
+    PARAM_NOT_NULL(callCount);
+    *callCount = 0;
+
+    if (count == 0)
+    {
+        return JsNoError;
+    }
+
+    PARAM_NOT_NULL(functions);
+
+#if ENABLE_TTD
+    // Every call must be recorded as a separate top-level call action, so go through JsCallFunction
+    JsrtContext *currentContext = JsrtContext::GetCurrent();
+    if (currentContext != nullptr && PERFORM_JSRT_TTD_RECORD_ACTION_CHECK(currentContext->GetScriptContext()))
+    {
+        JsValueRef args[] = { currentContext->GetScriptContext()->GetLibrary()->GetUndefined() };
+        for (unsigned int i = 0; i < count; i++)
+        {
+            JsErrorCode errorCode = JsCallFunction(functions[i], args, _countof(args), nullptr);
+            if (errorCode == JsNoError || errorCode == JsErrorScriptException)
+            {
+                *callCount = i + 1;
+            }
+
+            if (errorCode != JsNoError)
+            {
+                return errorCode;
+            }
+        }
+
+        return JsNoError;
+    }
+#endif
+
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            JsValueRef function = functions[i];
+            VALIDATE_INCOMING_FUNCTION(function, scriptContext);
+
+            Js::Var args[] = { scriptContext->GetLibrary()->GetUndefined() };
+            Js::Arguments jsArgs(Js::CallInfo(1), args);
+
+            // Counted before the call so a call that throws is included
+            *callCount = i + 1;
+            Js::JavascriptFunction::FromVar(function)->CallRootFunction(jsArgs, scriptContext, true);
+        }
+
+        return JsNoError;
+    });
+}
+
 CHAKRA_API JsConstructObject(_In_ JsValueRef function, _In_reads_(cargs) JsValueRef *args, _In_ ushort cargs, _Out_ JsValueRef *result)
 {
     return ContextAPIWrapper<true>([&] (Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
@@ -2613,6 +2809,74 @@ CHAKRA_API JsGetRuntimeMemoryUsage(_In_ JsRuntimeHandle runtimeHandle, _Out_ siz
     return JsNoError;
 }
 
+template <typename TPageAllocator>
+static void AddHeapSpacePageUsage(JsHeapSpaceStatistics * statistics, TPageAllocator * pageAllocator)
+{
+    statistics->usedBytes += pageAllocator->GetUsedBytes();
+    statistics->committedBytes += pageAllocator->GetCommittedBytes();
+    // Stash the reserved bytes until the decommitted bytes can be computed
+    statistics->decommittedBytes += pageAllocator->GetReservedBytes();
+}
+
+CHAKRA_API JsGetRuntimeHeapSpaceStatistics(_In_ JsRuntimeHandle runtimeHandle, _In_ JsHeapSpace space, _Out_ JsHeapSpaceStatistics * statistics)
+{
+    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+    PARAM_NOT_NULL(statistics);
+    memset(statistics, 0, sizeof(*statistics));
+
+    ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+    Recycler * recycler = threadContext->GetRecycler();
+
+    switch (space)
+    {
+    case JsHeapSpace_Object:
+    case JsHeapSpace_Leaf:
+    case JsHeapSpace_LargeObject:
+        if (recycler != nullptr)
+        {
+            IdleDecommitPageAllocator * leafPageAllocator = recycler->GetRecyclerLeafPageAllocator();
+            IdleDecommitPageAllocator * largeBlockPageAllocator = recycler->GetRecyclerLargeBlockPageAllocator();
+            recycler->ForEachPageAllocator([&](IdleDecommitPageAllocator * pageAllocator)
+            {
+                JsHeapSpace pageAllocatorSpace =
+                    pageAllocator == leafPageAllocator ? JsHeapSpace_Leaf :
+                    pageAllocator == largeBlockPageAllocator ? JsHeapSpace_LargeObject :
+                    JsHeapSpace_Object;
+                if (pageAllocatorSpace == space)
+                {
+                    AddHeapSpacePageUsage(statistics, pageAllocator);
+                }
+            });
+        }
+        break;
+    case JsHeapSpace_Code:
+#if ENABLE_NATIVE_CODEGEN
+        {
+            CustomHeap::InProcCodePageAllocators * codePageAllocators = threadContext->GetCodePageAllocators();
+            AutoCriticalSection autoLock(&codePageAllocators->cs);
+            AddHeapSpacePageUsage(statistics, codePageAllocators);
+        }
+#if DYNAMIC_INTERPRETER_THUNK || defined(ASMJS_PLAT)
+        {
+            CustomHeap::InProcCodePageAllocators * thunkPageAllocators = threadContext->GetThunkPageAllocators();
+            AutoCriticalSection autoLock(&thunkPageAllocators->cs);
+            AddHeapSpacePageUsage(statistics, thunkPageAllocators);
+        }
+#endif
+#endif
+        break;
+    default:
+        return JsErrorInvalidArgument;
+    }
+
+    // The recycler's counters are read without a lock, so don't let the differences wrap around
+    size_t reservedBytes = statistics->decommittedBytes;
+    statistics->decommittedBytes = reservedBytes > statistics->committedBytes ? reservedBytes - statistics->committedBytes : 0;
+    statistics->availableBytes = statistics->committedBytes > statistics->usedBytes ? statistics->committedBytes - statistics->usedBytes : 0;
+
+    return JsNoError;
+}
+
 CHAKRA_API JsSetRuntimeMemoryLimit(_In_ JsRuntimeHandle runtimeHandle, _In_ size_t memoryLimit)
 {
     VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
@@ -2666,40 +2930,83 @@ CHAKRA_API JsSetRuntimeBeforeCollectCallback(_In_ JsRuntimeHandle runtime, _In_o
     });
 }
 
-CHAKRA_API JsDisableRuntimeExecution(_In_ JsRuntimeHandle runtimeHandle)
+CHAKRA_API JsSetRuntimeGarbageCollectionCallback(_In_ JsRuntimeHandle runtime, _In_opt_ void *callbackState, _In_opt_ JsGarbageCollectionCallback callback)
 {
-    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtime);
 
-    ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
-    if (!threadContext->TestThreadContextFlag(ThreadContextFlagCanDisableExecution))
-    {
-        return JsErrorCannotDisableExecution;
-    }
+        JsrtRuntime::FromHandle(runtime)->SetGarbageCollectionCallback(callback, callbackState);
+        return JsNoError;
+    });
+}
 
-    if (threadContext->GetRecycler() && threadContext->GetRecycler()->IsHeapEnumInProgress())
-    {
-        return JsErrorHeapEnumInProgress;
-    }
-    else if (threadContext->IsInThreadServiceCallback())
+CHAKRA_API JsStartProfiling(_In_ JsRuntimeHandle runtimeHandle)
+{
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        JsrtProfiler * profiler = JsrtRuntime::FromHandle(runtimeHandle)->EnsureProfiler();
+        if (profiler->IsProfiling())
+        {
+            return JsErrorAlreadyProfilingContext;
+        }
+
+        profiler->Start();
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsRequestProfileSample(_In_ JsRuntimeHandle runtimeHandle, _In_ bool idle)
+{
+    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+    // Called from the host's sampling thread, so this can't enter the runtime
+    JsrtProfiler * profiler = JsrtRuntime::FromHandle(runtimeHandle)->GetProfiler();
+    if (profiler != nullptr)
     {
-        return JsErrorInThreadServiceCallback;
+        profiler->RequestSample(idle);
     }
-
-    threadContext->DisableExecution();
     return JsNoError;
 }
 
-CHAKRA_API JsEnableRuntimeExecution(_In_ JsRuntimeHandle runtimeHandle)
+CHAKRA_API JsStopProfiling(_In_ JsRuntimeHandle runtimeHandle, _Out_ JsProfile **profile)
 {
-    return GlobalAPIWrapper_NoRecord([&] () -> JsErrorCode {
+    PARAM_NOT_NULL(profile);
+    *profile = nullptr;
+
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
         VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
 
-        ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
-        if (!threadContext->TestThreadContextFlag(ThreadContextFlagCanDisableExecution))
+        JsrtProfiler * profiler = JsrtRuntime::FromHandle(runtimeHandle)->GetProfiler();
+        if (profiler == nullptr || !profiler->IsProfiling())
         {
-            return JsNoError;
+            return JsErrorInvalidArgument;
         }
 
+        *profile = profiler->Stop();
+        return *profile != nullptr ? JsNoError : JsErrorOutOfMemory;
+    });
+}
+
+CHAKRA_API JsReleaseProfile(_In_ JsProfile *profile)
+{
+    PARAM_NOT_NULL(profile);
+
+    JsrtProfiler::ReleaseProfile(profile);
+    return JsNoError;
+}
+
+CHAKRA_API JsTakeHeapSnapshot(_In_ JsRuntimeHandle runtimeHandle, _Out_ JsHeapSnapshot **snapshot)
+{
+    PARAM_NOT_NULL(snapshot);
+    *snapshot = nullptr;
+
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        JsrtRuntime * runtime = JsrtRuntime::FromHandle(runtimeHandle);
+        ThreadContext * threadContext = runtime->GetThreadContext();
+
         if (threadContext->GetRecycler() && threadContext->GetRecycler()->IsHeapEnumInProgress())
         {
             return JsErrorHeapEnumInProgress;
@@ -2716,60 +3023,293 @@ CHAKRA_API JsEnableRuntimeExecution(_In_ JsRuntimeHandle runtimeHandle)
             return JsErrorWrongThread;
         }
 
-        threadContext->EnableExecution();
-        return JsNoError;
+        *snapshot = JsrtHeapSnapshot::Take(runtime);
+        return *snapshot != nullptr ? JsNoError : JsErrorOutOfMemory;
     });
 }
 
-CHAKRA_API JsIsRuntimeExecutionDisabled(_In_ JsRuntimeHandle runtimeHandle, _Out_ bool *isDisabled)
+CHAKRA_API JsReleaseHeapSnapshot(_In_ JsHeapSnapshot *snapshot)
 {
-    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
-    PARAM_NOT_NULL(isDisabled);
-    *isDisabled = false;
+    PARAM_NOT_NULL(snapshot);
 
-    ThreadContext* threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
-    *isDisabled = threadContext->IsExecutionDisabled();
+    JsrtHeapSnapshot::Release(snapshot);
     return JsNoError;
 }
 
-CHAKRA_API JsGetPropertyIdFromName(_In_z_ const WCHAR *name, _Out_ JsPropertyIdRef *propertyId)
+CHAKRA_API JsCaptureStackTrace(_In_ JsValueRef skipUntil, _In_ unsigned int frameLimit, _Out_ JsValueRef *stackTrace)
 {
-    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext * scriptContext) -> JsErrorCode {
-        PARAM_NOT_NULL(name);
-        PARAM_NOT_NULL(propertyId);
-        *propertyId = nullptr;
-
-        size_t cPropertyNameLength = wcslen(name);
-
-        if (cPropertyNameLength <= INT_MAX)
-        {
-            scriptContext->GetOrAddPropertyRecord(name, static_cast<int>(cPropertyNameLength), (Js::PropertyRecord const **)propertyId);
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        PARAM_NOT_NULL(stackTrace);
+        *stackTrace = JS_INVALID_REFERENCE;
 
-            return JsNoError;
-        }
-        else
+        Js::JavascriptFunction * skipUntilFunction = nullptr;
+        if (skipUntil != JS_INVALID_REFERENCE)
         {
-            return JsErrorOutOfMemory;
+            VALIDATE_INCOMING_FUNCTION(skipUntil, scriptContext);
+            skipUntilFunction = Js::JavascriptFunction::FromVar(skipUntil);
         }
+
+        Js::JavascriptExceptionContext::StackTrace * frames =
+            Js::JavascriptExceptionOperators::CaptureStackTrace(*scriptContext, skipUntilFunction, frameLimit);
+
+        Js::DynamicObject * holder = scriptContext->GetLibrary()->CreateObject();
+        holder->SetInternalProperty(Js::InternalPropertyIds::StackTrace, frames, Js::PropertyOperation_None, nullptr);
+
+        *stackTrace = holder;
+        return JsNoError;
     });
 }
 
-CHAKRA_API JsGetPropertyIdFromSymbol(_In_ JsValueRef symbol, _Out_ JsPropertyIdRef *propertyId)
+CHAKRA_API JsGetStackTraceFrames(_In_ JsValueRef stackTrace, _Out_ JsValueRef *frames)
 {
-    return ContextAPINoScriptWrapper([&](Js::ScriptContext * scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
-        PERFORM_JSRT_TTD_RECORD_ACTION(scriptContext, RecordJsRTGetPropertyIdFromSymbol, symbol);
-
-        VALIDATE_INCOMING_REFERENCE(symbol, scriptContext);
-        PARAM_NOT_NULL(propertyId);
-        *propertyId = nullptr;
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        PARAM_NOT_NULL(frames);
+        *frames = JS_INVALID_REFERENCE;
+        VALIDATE_INCOMING_OBJECT(stackTrace, scriptContext);
 
-        if (!Js::JavascriptSymbol::Is(symbol))
+        Js::RecyclableObject * object = Js::RecyclableObject::FromVar(stackTrace);
+        Js::JavascriptExceptionContext::StackTrace * trace = nullptr;
+        if (!object->GetInternalProperty(object, Js::InternalPropertyIds::StackTrace, (Js::Var *)&trace, nullptr, scriptContext) ||
+            trace == nullptr)
         {
-            return JsErrorPropertyNotSymbol;
+            return JsErrorInvalidArgument;
         }
 
-        *propertyId = (JsPropertyIdRef)Js::JavascriptSymbol::FromVar(symbol)->GetValue();
-        return JsNoError;
+        Js::JavascriptLibrary * library = scriptContext->GetLibrary();
+        Js::JavascriptArray * frameArray = library->CreateArray(trace->Count());
+        for (int i = 0; i < trace->Count(); i++)
+        {
+            const Js::JavascriptExceptionContext::StackFrame& currentFrame = trace->Item(i);
+            Js::DynamicObject * frame = library->CreateObject();
+
+            Js::FunctionBody * functionBody = currentFrame.GetFunctionBody();
+            const bool isLibraryCode = !functionBody || functionBody->GetUtf8SourceInfo()->GetIsLibraryCode();
+            LPCWSTR functionName = isLibraryCode ? currentFrame.GetFunctionName() : functionBody->GetExternalDisplayName();
+            Js::JavascriptOperators::InitProperty(frame, Js::PropertyIds::name,
+                Js::JavascriptString::NewCopySz(functionName ? functionName : _u(""), scriptContext));
+
+            ULONG line = 0;
+            LONG column = 0;
+            if (!isLibraryCode && functionBody->GetLineCharOffset(currentFrame.GetByteCodeOffset(), &line, &column))
+            {
+                LPCWSTR url = functionBody->GetSourceName();
+                Js::JavascriptOperators::InitProperty(frame, Js::PropertyIds::url,
+                    Js::JavascriptString::NewCopySz(url ? url : _u(""), scriptContext));
+                Js::JavascriptOperators::InitProperty(frame, Js::PropertyIds::line,
+                    Js::JavascriptNumber::ToVar((uint32)(line + 1), scriptContext));
+                Js::JavascriptOperators::InitProperty(frame, Js::PropertyIds::column,
+                    Js::JavascriptNumber::ToVar((int32)(column + 1), scriptContext));
+            }
+
+            frameArray->DirectSetItemAt(i, (Js::Var)frame);
+        }
+
+        *frames = frameArray;
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsIdleNotification(_In_ unsigned int idleTimeInMs, _Out_ bool *done)
+{
+    PARAM_NOT_NULL(done);
+
+    return ContextAPINoScriptWrapper_NoRecord([&] (Js::ScriptContext * scriptContext) -> JsErrorCode {
+
+            *done = false;
+
+            if (scriptContext->GetThreadContext()->GetRecycler() && scriptContext->GetThreadContext()->GetRecycler()->IsHeapEnumInProgress())
+            {
+                return JsErrorHeapEnumInProgress;
+            }
+            else if (scriptContext->GetThreadContext()->IsInThreadServiceCallback())
+            {
+                return JsErrorInThreadServiceCallback;
+            }
+
+            JsrtRuntime * runtime = JsrtContext::GetCurrent()->GetRuntime();
+
+            if (!runtime->UseIdle())
+            {
+                return JsErrorIdleNotEnabled;
+            }
+
+            *done = runtime->IdleNotification(idleTimeInMs);
+
+            return JsNoError;
+    });
+}
+
+CHAKRA_API JsLowMemoryNotification(_In_ JsRuntimeHandle runtimeHandle)
+{
+    return JsCollectGarbageCommon<CollectOnLowMemory>(runtimeHandle);
+}
+
+CHAKRA_API JsAllocRootBlock(_In_ JsRuntimeHandle runtimeHandle, _In_ size_t count, _Outptr_result_buffer_(count) JsValueRef ** block)
+{
+    PARAM_NOT_NULL(block);
+    *block = nullptr;
+
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        if (count == 0)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        *block = JsrtRuntime::FromHandle(runtimeHandle)->AllocateRootBlock(count);
+        return *block != nullptr ? JsNoError : JsErrorOutOfMemory;
+    });
+}
+
+CHAKRA_API JsFreeRootBlock(_In_ JsRuntimeHandle runtimeHandle, _In_ JsValueRef * block)
+{
+    PARAM_NOT_NULL(block);
+
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        return JsrtRuntime::FromHandle(runtimeHandle)->FreeRootBlock(block) ? JsNoError : JsErrorInvalidArgument;
+    });
+}
+
+CHAKRA_API JsAddExternalMemoryUsage(_In_ JsRuntimeHandle runtimeHandle, _In_ size_t size)
+{
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+        Recycler * recycler = threadContext->GetRecycler();
+
+        if (recycler == nullptr || size == 0)
+        {
+            return JsNoError;
+        }
+        else if (recycler->IsHeapEnumInProgress())
+        {
+            return JsErrorHeapEnumInProgress;
+        }
+        else if (threadContext->IsInThreadServiceCallback())
+        {
+            return JsErrorInThreadServiceCallback;
+        }
+
+        ThreadContextScope scope(threadContext);
+
+        if (!scope.IsValid())
+        {
+            return JsErrorWrongThread;
+        }
+
+        recycler->AddExternalMemoryUsage(size);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsDisableRuntimeExecution(_In_ JsRuntimeHandle runtimeHandle)
+{
+    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+    ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+    if (!threadContext->TestThreadContextFlag(ThreadContextFlagCanDisableExecution))
+    {
+        return JsErrorCannotDisableExecution;
+    }
+
+    if (threadContext->GetRecycler() && threadContext->GetRecycler()->IsHeapEnumInProgress())
+    {
+        return JsErrorHeapEnumInProgress;
+    }
+    else if (threadContext->IsInThreadServiceCallback())
+    {
+        return JsErrorInThreadServiceCallback;
+    }
+
+    threadContext->DisableExecution();
+    return JsNoError;
+}
+
+CHAKRA_API JsEnableRuntimeExecution(_In_ JsRuntimeHandle runtimeHandle)
+{
+    return GlobalAPIWrapper_NoRecord([&] () -> JsErrorCode {
+        VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+
+        ThreadContext * threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+        if (!threadContext->TestThreadContextFlag(ThreadContextFlagCanDisableExecution))
+        {
+            return JsNoError;
+        }
+
+        if (threadContext->GetRecycler() && threadContext->GetRecycler()->IsHeapEnumInProgress())
+        {
+            return JsErrorHeapEnumInProgress;
+        }
+        else if (threadContext->IsInThreadServiceCallback())
+        {
+            return JsErrorInThreadServiceCallback;
+        }
+
+        ThreadContextScope scope(threadContext);
+
+        if (!scope.IsValid())
+        {
+            return JsErrorWrongThread;
+        }
+
+        threadContext->EnableExecution();
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsIsRuntimeExecutionDisabled(_In_ JsRuntimeHandle runtimeHandle, _Out_ bool *isDisabled)
+{
+    VALIDATE_INCOMING_RUNTIME_HANDLE(runtimeHandle);
+    PARAM_NOT_NULL(isDisabled);
+    *isDisabled = false;
+
+    ThreadContext* threadContext = JsrtRuntime::FromHandle(runtimeHandle)->GetThreadContext();
+    *isDisabled = threadContext->IsExecutionDisabled();
+    return JsNoError;
+}
+
+CHAKRA_API JsGetPropertyIdFromName(_In_z_ const WCHAR *name, _Out_ JsPropertyIdRef *propertyId)
+{
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext * scriptContext) -> JsErrorCode {
+        PARAM_NOT_NULL(name);
+        PARAM_NOT_NULL(propertyId);
+        *propertyId = nullptr;
+
+        size_t cPropertyNameLength = wcslen(name);
+
+        if (cPropertyNameLength <= INT_MAX)
+        {
+            scriptContext->GetOrAddPropertyRecord(name, static_cast<int>(cPropertyNameLength), (Js::PropertyRecord const **)propertyId);
+
+            return JsNoError;
+        }
+        else
+        {
+            return JsErrorOutOfMemory;
+        }
+    });
+}
+
+CHAKRA_API JsGetPropertyIdFromSymbol(_In_ JsValueRef symbol, _Out_ JsPropertyIdRef *propertyId)
+{
+    return ContextAPINoScriptWrapper([&](Js::ScriptContext * scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION(scriptContext, RecordJsRTGetPropertyIdFromSymbol, symbol);
+
+        VALIDATE_INCOMING_REFERENCE(symbol, scriptContext);
+        PARAM_NOT_NULL(propertyId);
+        *propertyId = nullptr;
+
+        if (!Js::JavascriptSymbol::Is(symbol))
+        {
+            return JsErrorPropertyNotSymbol;
+        }
+
+        *propertyId = (JsPropertyIdRef)Js::JavascriptSymbol::FromVar(symbol)->GetValue();
+        return JsNoError;
     },
     /*allowInObjectBeforeCollectCallback*/true);
 }
@@ -4120,65 +4660,226 @@ CHAKRA_API JsCreateStringUtf16(
         reinterpret_cast<const char16*>(content), length, value);
 }
 
-
-template <class CopyFunc>
-JsErrorCode WriteStringCopy(
-    JsValueRef value,
-    int start,
-    int length,
-    _Out_opt_ size_t* written,
-    const CopyFunc& copyFunc)
+CHAKRA_API JsCreateStringLatin1(
+    _In_ const char *content,
+    _In_ size_t length,
+    _Out_ JsValueRef *value)
 {
-    if (written)
-    {
-        *written = 0;  // init to 0 for default
-    }
+    PARAM_NOT_NULL(content);
 
-    const char16* str = nullptr;
-    size_t strLength = 0;
-    JsErrorCode errorCode = JsStringToPointer(value, &str, &strLength);
-    if (errorCode != JsNoError)
-    {
-        return errorCode;
-    }
+    return ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PARAM_NOT_NULL(value);
 
-    if (start < 0 || (size_t)start > strLength)
-    {
-        return JsErrorInvalidArgument;  // start out of range, no chars written
-    }
+        if (!Js::IsValidCharCount(length))
+        {
+            Js::JavascriptError::ThrowOutOfMemoryError(scriptContext);
+        }
 
-    size_t count = min(static_cast<size_t>(length), strLength - start);
-    if (count == 0)
-    {
-        return JsNoError;  // no chars written
-    }
+        // Widen straight into the string buffer, no intermediate Utf8 or Utf16 copy
+        const charcount_t count = static_cast<charcount_t>(length);
+        char16* buffer = RecyclerNewArrayLeaf(scriptContext->GetRecycler(), char16, count + 1);
+        utf8::DecodeLatin1Into(buffer, reinterpret_cast<const BYTE*>(content), count);
+        buffer[count] = _u('\0');
 
-    errorCode = copyFunc(str + start, count, written);
-    if (errorCode != JsNoError)
-    {
-        return errorCode;
-    }
+        PERFORM_JSRT_TTD_RECORD_ACTION(scriptContext, RecordJsRTCreateString, buffer, count);
 
-    if (written)
-    {
-        *written = count;
-    }
+        *value = Js::JavascriptString::NewWithBuffer(buffer, count, scriptContext);
 
-    return JsNoError;
+        PERFORM_JSRT_TTD_RECORD_ACTION_RESULT(scriptContext, value);
+
+        return JsNoError;
+    });
 }
 
-CHAKRA_API JsCopyStringUtf16(
-    _In_ JsValueRef value,
-    _In_ int start,
-    _In_ int length,
-    _Out_opt_ uint16_t* buffer,
-    _Out_opt_ size_t* written)
+template <class CreateFunc>
+JsErrorCode CreateExternalString(
+    size_t length,
+    JsFinalizeCallback finalizeCallback,
+    void *callbackState,
+    _Out_ JsValueRef *value,
+    const CreateFunc& createFunc)
 {
-    PARAM_NOT_NULL(value);
-    VALIDATE_JSREF(value);
+    return ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PARAM_NOT_NULL(value);
+        *value = nullptr;
 
-    return WriteStringCopy(value, start, length, written,
-        [buffer](const char16* src, size_t count, size_t *needed)
+        if (!Js::IsValidCharCount(length))
+        {
+            Js::JavascriptError::ThrowOutOfMemoryError(scriptContext);
+        }
+
+        if (length == 0)
+        {
+            // Nothing to reference, hand the memory back right away
+            *value = scriptContext->GetLibrary()->GetEmptyString();
+            if (finalizeCallback != nullptr)
+            {
+                finalizeCallback(callbackState);
+            }
+            return JsNoError;
+        }
+
+        *value = createFunc(static_cast<charcount_t>(length), scriptContext);
+
+        JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(*value));
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsCreateExternalStringUtf16(
+    _In_ const uint16_t *content,
+    _In_ size_t length,
+    _In_opt_ JsFinalizeCallback finalizeCallback,
+    _In_opt_ void *callbackState,
+    _Out_ JsValueRef *value)
+{
+    PARAM_NOT_NULL(content);
+
+#if ENABLE_TTD
+    JsrtContext *currentContext = JsrtContext::GetCurrent();
+    if (currentContext != nullptr &&
+        PERFORM_JSRT_TTD_RECORD_ACTION_CHECK(currentContext->GetScriptContext()))
+    {
+        // The TTD log only knows about copied strings
+        JsErrorCode errorCode = JsCreateStringUtf16(content, length, value);
+        if (errorCode == JsNoError && finalizeCallback != nullptr)
+        {
+            finalizeCallback(callbackState);
+        }
+        return errorCode;
+    }
+#endif
+
+    return CreateExternalString(length, finalizeCallback, callbackState, value,
+        [&](charcount_t count, Js::ScriptContext *scriptContext) -> Js::JavascriptString*
+        {
+            return Js::JsrtExternalString::NewUtf16(
+                reinterpret_cast<const char16*>(content), count,
+                finalizeCallback, callbackState, scriptContext);
+        });
+}
+
+CHAKRA_API JsCreateExternalStringLatin1(
+    _In_ const char *content,
+    _In_ size_t length,
+    _In_opt_ JsFinalizeCallback finalizeCallback,
+    _In_opt_ void *callbackState,
+    _Out_ JsValueRef *value)
+{
+    PARAM_NOT_NULL(content);
+
+#if ENABLE_TTD
+    JsrtContext *currentContext = JsrtContext::GetCurrent();
+    if (currentContext != nullptr &&
+        PERFORM_JSRT_TTD_RECORD_ACTION_CHECK(currentContext->GetScriptContext()))
+    {
+        // The TTD log only knows about copied strings
+        AutoArrayPtr<char16> wide(HeapNewNoThrowArray(char16, length + 1), length + 1);
+        if (wide == nullptr)
+        {
+            return JsErrorOutOfMemory;
+        }
+        utf8::DecodeLatin1Into(wide, reinterpret_cast<const BYTE*>(content), length);
+        JsErrorCode errorCode = JsPointerToString(wide, length, value);
+        if (errorCode == JsNoError && finalizeCallback != nullptr)
+        {
+            finalizeCallback(callbackState);
+        }
+        return errorCode;
+    }
+#endif
+
+    return CreateExternalString(length, finalizeCallback, callbackState, value,
+        [&](charcount_t count, Js::ScriptContext *scriptContext) -> Js::JavascriptString*
+        {
+            return Js::JsrtExternalString::NewLatin1(
+                content, count, finalizeCallback, callbackState, scriptContext);
+        });
+}
+
+
+// Similar to JsStringToPointer, but the buffer isn't required to be '\0' terminated.
+// Strings that reference external (or shared) memory don't need to be copied first.
+static JsErrorCode StringToBuffer(
+    JsValueRef value,
+    _Outptr_result_buffer_(*length) const char16** buffer,
+    _Out_ size_t* length)
+{
+    *buffer = nullptr;
+    *length = 0;
+
+    if (!Js::JavascriptString::Is(value))
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        Js::JavascriptString *jsString = Js::JavascriptString::FromVar(value);
+
+        *buffer = jsString->GetString();
+        *length = jsString->GetLength();
+        return JsNoError;
+    });
+}
+
+template <class CopyFunc>
+JsErrorCode WriteStringCopy(
+    JsValueRef value,
+    int start,
+    int length,
+    _Out_opt_ size_t* written,
+    const CopyFunc& copyFunc)
+{
+    if (written)
+    {
+        *written = 0;  // init to 0 for default
+    }
+
+    const char16* str = nullptr;
+    size_t strLength = 0;
+    JsErrorCode errorCode = StringToBuffer(value, &str, &strLength);
+    if (errorCode != JsNoError)
+    {
+        return errorCode;
+    }
+
+    if (start < 0 || (size_t)start > strLength)
+    {
+        return JsErrorInvalidArgument;  // start out of range, no chars written
+    }
+
+    size_t count = min(static_cast<size_t>(length), strLength - start);
+    if (count == 0)
+    {
+        return JsNoError;  // no chars written
+    }
+
+    errorCode = copyFunc(str + start, count, written);
+    if (errorCode != JsNoError)
+    {
+        return errorCode;
+    }
+
+    if (written)
+    {
+        *written = count;
+    }
+
+    return JsNoError;
+}
+
+CHAKRA_API JsCopyStringUtf16(
+    _In_ JsValueRef value,
+    _In_ int start,
+    _In_ int length,
+    _Out_opt_ uint16_t* buffer,
+    _Out_opt_ size_t* written)
+{
+    PARAM_NOT_NULL(value);
+    VALIDATE_JSREF(value);
+
+    return WriteStringCopy(value, start, length, written,
+        [buffer](const char16* src, size_t count, size_t *needed)
         {
             if (buffer)
             {
@@ -4192,6 +4893,120 @@ CHAKRA_API JsCopyStringUtf16(
         });
 }
 
+// Returns the Latin1 content of strings that are still backed by external Latin1 memory
+static bool TryGetExternalLatin1(JsValueRef value, const char** content, size_t* length)
+{
+    if (Js::JsrtExternalString::Is(value))
+    {
+        Js::JsrtExternalString* externalString = Js::JsrtExternalString::FromVar(value);
+        *content = externalString->GetOneByteContent();
+        *length = externalString->GetLength();
+        return *content != nullptr;
+    }
+
+    return false;
+}
+
+CHAKRA_API JsCopyStringOneByte(
+    _In_ JsValueRef value,
+    _In_ int start,
+    _In_ int length,
+    _Out_opt_ char* buffer,
+    _Out_opt_ size_t* written)
+{
+    PARAM_NOT_NULL(value);
+    VALIDATE_JSREF(value);
+
+    const char* latin1 = nullptr;
+    size_t latin1Length = 0;
+    if (TryGetExternalLatin1(value, &latin1, &latin1Length))
+    {
+        if (written)
+        {
+            *written = 0;
+        }
+
+        if (start < 0 || (size_t)start > latin1Length)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        size_t count = min(static_cast<size_t>(length), latin1Length - start);
+        if (buffer)
+        {
+            memmove(buffer, latin1 + start, count);
+        }
+        if (written)
+        {
+            *written = count;
+        }
+        return JsNoError;
+    }
+
+    return WriteStringCopy(value, start, length, written,
+        [buffer](const char16* src, size_t count, size_t *needed)
+        {
+            if (buffer)
+            {
+                utf8::EncodeLatin1Into(reinterpret_cast<BYTE*>(buffer), src, count);
+            }
+            else
+            {
+                *needed = count;
+            }
+            return JsNoError;
+        });
+}
+
+static JsErrorCode GetStringUtf8Length(JsValueRef value, _Out_ size_t* length)
+{
+    *length = 0;
+
+    if (!Js::JavascriptString::Is(value))
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    Js::JavascriptString *jsString = Js::JavascriptString::FromVar(value);
+    if (jsString->TryGetCachedUtf8Length(length))
+    {
+        return JsNoError;
+    }
+
+    const char* latin1 = nullptr;
+    size_t latin1Length = 0;
+    if (TryGetExternalLatin1(value, &latin1, &latin1Length))
+    {
+        *length = utf8::CountLatin1AsUtf8(reinterpret_cast<const BYTE*>(latin1), latin1Length);
+    }
+    else
+    {
+        const char16* str = nullptr;
+        size_t strLength = 0;
+        JsErrorCode errorCode = StringToBuffer(value, &str, &strLength);
+        if (errorCode != JsNoError)
+        {
+            return errorCode;
+        }
+
+        *length = utf8::CountTrueUtf8(str, static_cast<charcount_t>(strLength));
+    }
+
+    jsString->CacheUtf8Length(*length);
+    return JsNoError;
+}
+
+CHAKRA_API JsGetStringUtf8Length(
+    _In_ JsValueRef value,
+    _Out_ size_t* length)
+{
+    PARAM_NOT_NULL(value);
+    VALIDATE_JSREF(value);
+    PARAM_NOT_NULL(length);
+
+    return GetStringUtf8Length(value, length);
+}
+
 CHAKRA_API JsCopyString(
     _In_ JsValueRef value,
     _Out_opt_ char* buffer,
@@ -4201,37 +5016,82 @@ CHAKRA_API JsCopyString(
     PARAM_NOT_NULL(value);
     VALIDATE_JSREF(value);
 
+    if (!buffer)
+    {
+        // Only the size is wanted, no need to encode
+        size_t utf8Length = 0;
+        JsErrorCode errorCode = GetStringUtf8Length(value, &utf8Length);
+        if (errorCode == JsNoError && length)
+        {
+            *length = utf8Length;
+        }
+        return errorCode;
+    }
+
     const char16* str = nullptr;
     size_t strLength = 0;
-    JsErrorCode errorCode = JsStringToPointer(value, &str, &strLength);
+    JsErrorCode errorCode = StringToBuffer(value, &str, &strLength);
     if (errorCode != JsNoError)
     {
         return errorCode;
     }
 
-    utf8::WideToNarrow utf8Str(str, strLength);
-    if (!buffer)
+    // Encode straight into the buffer, copying whole characters only if it is too small
+    charcount_t consumed = 0;
+    size_t count = utf8::EncodeTrueUtf8IntoBounded(reinterpret_cast<LPUTF8>(buffer), bufferSize,
+        str, static_cast<charcount_t>(strLength), &consumed, true);
+    if (length)
     {
-        if (length)
-        {
-            *length = utf8Str.Length();
-        }
+        *length = count;
     }
-    else
+
+    return JsNoError;
+}
+
+CHAKRA_API JsCopyStringUtf8Partial(
+    _In_ JsValueRef value,
+    _Out_writes_(bufferSize) char* buffer,
+    _In_ size_t bufferSize,
+    _In_ JsCopyStringUtf8Flags flags,
+    _Out_opt_ size_t* written,
+    _Out_opt_ size_t* charsRead)
+{
+    PARAM_NOT_NULL(value);
+    VALIDATE_JSREF(value);
+    if (bufferSize > 0)
     {
-        size_t count = min(bufferSize, utf8Str.Length());
-        // Try to copy whole characters if buffer size insufficient
-        auto maxFitChars = utf8::ByteIndexIntoCharacterIndex(
-            (LPCUTF8)(const char*)utf8Str, count,
-            utf8::DecodeOptions::doChunkedEncoding);
-        count = utf8::CharacterIndexToByteIndex(
-            (LPCUTF8)(const char*)utf8Str, utf8Str.Length(), maxFitChars);
+        PARAM_NOT_NULL(buffer);
+    }
 
-        memmove(buffer, utf8Str, sizeof(char) * count);
-        if (length)
-        {
-            *length = count;
-        }
+    if (written)
+    {
+        *written = 0;
+    }
+    if (charsRead)
+    {
+        *charsRead = 0;
+    }
+
+    const char16* str = nullptr;
+    size_t strLength = 0;
+    JsErrorCode errorCode = StringToBuffer(value, &str, &strLength);
+    if (errorCode != JsNoError)
+    {
+        return errorCode;
+    }
+
+    charcount_t consumed = 0;
+    size_t count = utf8::EncodeTrueUtf8IntoBounded(reinterpret_cast<LPUTF8>(buffer), bufferSize,
+        str, static_cast<charcount_t>(strLength), &consumed,
+        (flags & JsCopyStringUtf8Flags_ReplaceInvalid) != 0);
+
+    if (written)
+    {
+        *written = count;
+    }
+    if (charsRead)
+    {
+        *charsRead = consumed;
     }
 
     return JsNoError;
@@ -4388,6 +5248,58 @@ CHAKRA_API JsCopyPropertyId(
     return JsNoError;
 }
 
+CHAKRA_API JsGetPropertyIdFromString(_In_ JsValueRef stringValue, _Out_ JsPropertyIdRef *propertyId)
+{
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext * scriptContext) -> JsErrorCode {
+        VALIDATE_INCOMING_REFERENCE(stringValue, scriptContext);
+        PARAM_NOT_NULL(propertyId);
+        *propertyId = nullptr;
+
+        if (!Js::JavascriptString::Is(stringValue))
+        {
+            return JsErrorPropertyNotString;
+        }
+
+        Js::JavascriptString * jsString = Js::JavascriptString::FromVar(stringValue);
+
+        // Strings handed out by JsGetPropertyIdString (and property keys the engine already
+        // interned) carry their property record, so no hashing is needed for them
+        if (VirtualTableInfo<Js::PropertyString>::HasVirtualTable(jsString))
+        {
+            *propertyId = (JsPropertyIdRef)((Js::PropertyString *)jsString)->GetPropertyRecord();
+            return JsNoError;
+        }
+
+        charcount_t length = jsString->GetLength();
+        if (length > INT_MAX)
+        {
+            return JsErrorOutOfMemory;
+        }
+
+        scriptContext->GetOrAddPropertyRecord(jsString->GetString(), static_cast<int>(length),
+            (Js::PropertyRecord const **)propertyId);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsGetPropertyIdString(_In_ JsPropertyIdRef propertyId, _Out_ JsValueRef *stringValue)
+{
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext * scriptContext) -> JsErrorCode {
+        VALIDATE_INCOMING_PROPERTYID(propertyId);
+        PARAM_NOT_NULL(stringValue);
+        *stringValue = nullptr;
+
+        Js::PropertyRecord const * propertyRecord = (Js::PropertyRecord const *)propertyId;
+        if (propertyRecord->IsSymbol())
+        {
+            return JsErrorPropertyNotString;
+        }
+
+        *stringValue = scriptContext->GetPropertyString(propertyRecord->GetPropertyId());
+        return JsNoError;
+    });
+}
+
 CHAKRA_API JsSerialize(
     _In_ JsValueRef scriptVal,
     _Out_ JsValueRef *bufferVal,
@@ -4401,7 +5313,6 @@ CHAKRA_API JsSerialize(
 
     bool isExternalArray = Js::ExternalArrayBuffer::Is(scriptVal),
          isString = false;
-    bool isUtf8   = !(parseAttributes & JsParseScriptAttributeArrayBufferIsUtf16Encoded);
     if (!isExternalArray)
     {
         isString = Js::JavascriptString::Is(scriptVal);
@@ -4411,13 +5322,16 @@ CHAKRA_API JsSerialize(
         }
     }
 
+    // JavascriptString is always Utf16
+    bool isUtf8 = !isString && !(parseAttributes & JsParseScriptAttributeArrayBufferIsUtf16Encoded);
+
     LoadScriptFlag scriptFlag;
     const byte* script = isExternalArray ?
         ((Js::ExternalArrayBuffer*)(scriptVal))->GetBuffer() :
         (const byte*)((Js::JavascriptString*)(scriptVal))->GetSz();
     const size_t cb = isExternalArray ?
         ((Js::ExternalArrayBuffer*)(scriptVal))->GetByteLength() :
-        ((Js::JavascriptString*)(scriptVal))->GetLength();
+        ((Js::JavascriptString*)(scriptVal))->GetLength() * sizeof(WCHAR);
 
     if (isExternalArray && isUtf8)
     {
@@ -4524,6 +5438,16 @@ CHAKRA_API JsRunSerialized(
         buffer, bufferVal, sourceContext, url, false, result);
 }
 
+CHAKRA_API JsGetSerializedScriptVersion(_Out_ unsigned int *version)
+{
+    return GlobalAPIWrapper_NoRecord([&]() -> JsErrorCode {
+        PARAM_NOT_NULL(version);
+
+        *version = Js::ByteCodeSerializer::GetVersionHash();
+        return JsNoError;
+    });
+}
+
 CHAKRA_API JsCreatePromise(_Out_ JsValueRef *promise, _Out_ JsValueRef *resolve, _Out_ JsValueRef *reject)
 {
     return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
@@ -4682,4 +5606,269 @@ CHAKRA_API JsGetAndClearExceptionWithMetadata(_Out_ JsValueRef *metadata)
         return JsNoError;
     });
 }
+
+CHAKRA_API JsCreateValueSerializer(
+    _In_ const JsValueSerializerCallbacks *callbacks,
+    _In_opt_ void *callbackState,
+    _Out_ JsValueSerializerHandle *serializer)
+{
+    PARAM_NOT_NULL(callbacks);
+    PARAM_NOT_NULL(serializer);
+    *serializer = nullptr;
+
+    if (callbacks->reallocateBuffer == nullptr || callbacks->freeBuffer == nullptr)
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        *serializer = HeapNew(JsrtValueSerializer, scriptContext, callbacks, callbackState);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsDisposeValueSerializer(_In_ JsValueSerializerHandle serializer)
+{
+    PARAM_NOT_NULL(serializer);
+
+    HeapDelete(static_cast<JsrtValueSerializer *>(serializer));
+    return JsNoError;
+}
+
+CHAKRA_API JsValueSerializerWriteHeader(_In_ JsValueSerializerHandle serializer)
+{
+    PARAM_NOT_NULL(serializer);
+
+    JsrtValueSerializer * valueSerializer = static_cast<JsrtValueSerializer *>(serializer);
+    valueSerializer->WriteHeader();
+    return JsNoError;
+}
+
+CHAKRA_API JsValueSerializerWriteValue(_In_ JsValueSerializerHandle serializer, _In_ JsValueRef value)
+{
+    PARAM_NOT_NULL(serializer);
+
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION_NOT_IMPLEMENTED(scriptContext);
+
+        VALIDATE_INCOMING_REFERENCE(value, scriptContext);
+
+        JsrtValueSerializer * valueSerializer = static_cast<JsrtValueSerializer *>(serializer);
+        if (valueSerializer->GetScriptContext() != scriptContext)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        valueSerializer->WriteValue(value);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsValueSerializerTransferArrayBuffer(
+    _In_ JsValueSerializerHandle serializer,
+    _In_ unsigned int transferId,
+    _In_ JsValueRef arrayBuffer)
+{
+    PARAM_NOT_NULL(serializer);
+
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        VALIDATE_INCOMING_REFERENCE(arrayBuffer, scriptContext);
+
+        JsrtValueSerializer * valueSerializer = static_cast<JsrtValueSerializer *>(serializer);
+        if (!Js::ArrayBufferBase::Is(arrayBuffer) || valueSerializer->GetScriptContext() != scriptContext)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        valueSerializer->TransferArrayBuffer(transferId, arrayBuffer);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsValueSerializerSetTreatArrayBufferViewsAsHostObjects(_In_ JsValueSerializerHandle serializer, _In_ bool mode)
+{
+    PARAM_NOT_NULL(serializer);
+
+    static_cast<JsrtValueSerializer *>(serializer)->SetTreatArrayBufferViewsAsHostObjects(mode);
+    return JsNoError;
+}
+
+CHAKRA_API JsValueSerializerWriteVarint(_In_ JsValueSerializerHandle serializer, _In_ uint64_t value)
+{
+    PARAM_NOT_NULL(serializer);
+
+    return static_cast<JsrtValueSerializer *>(serializer)->WriteVarint(value) ? JsNoError : JsErrorOutOfMemory;
+}
+
+CHAKRA_API JsValueSerializerWriteDouble(_In_ JsValueSerializerHandle serializer, _In_ double value)
+{
+    PARAM_NOT_NULL(serializer);
+
+    return static_cast<JsrtValueSerializer *>(serializer)->WriteDouble(value) ? JsNoError : JsErrorOutOfMemory;
+}
+
+CHAKRA_API JsValueSerializerWriteRawBytes(
+    _In_ JsValueSerializerHandle serializer,
+    _In_reads_bytes_(length) const void *source,
+    _In_ size_t length)
+{
+    PARAM_NOT_NULL(serializer);
+    if (length != 0)
+    {
+        PARAM_NOT_NULL(source);
+    }
+
+    return static_cast<JsrtValueSerializer *>(serializer)->WriteRawBytes(source, length) ? JsNoError : JsErrorOutOfMemory;
+}
+
+CHAKRA_API JsValueSerializerReleaseBuffer(
+    _In_ JsValueSerializerHandle serializer,
+    _Outptr_result_maybenull_ void **buffer,
+    _Out_ size_t *size)
+{
+    PARAM_NOT_NULL(serializer);
+    PARAM_NOT_NULL(buffer);
+    PARAM_NOT_NULL(size);
+
+    static_cast<JsrtValueSerializer *>(serializer)->ReleaseBuffer(buffer, size);
+    return JsNoError;
+}
+
+CHAKRA_API JsCreateValueDeserializer(
+    _In_reads_bytes_(size) const void *data,
+    _In_ size_t size,
+    _In_opt_ JsDeserializerReadHostObjectCallback readHostObject,
+    _In_opt_ void *callbackState,
+    _Out_ JsValueDeserializerHandle *deserializer)
+{
+    PARAM_NOT_NULL(deserializer);
+    *deserializer = nullptr;
+    if (size != 0)
+    {
+        PARAM_NOT_NULL(data);
+    }
+
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        *deserializer = HeapNew(JsrtValueDeserializer, scriptContext, static_cast<const byte *>(data), size, readHostObject, callbackState);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsDisposeValueDeserializer(_In_ JsValueDeserializerHandle deserializer)
+{
+    PARAM_NOT_NULL(deserializer);
+
+    HeapDelete(static_cast<JsrtValueDeserializer *>(deserializer));
+    return JsNoError;
+}
+
+CHAKRA_API JsValueDeserializerReadHeader(_In_ JsValueDeserializerHandle deserializer)
+{
+    PARAM_NOT_NULL(deserializer);
+
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION_NOT_IMPLEMENTED(scriptContext);
+
+        JsrtValueDeserializer * valueDeserializer = static_cast<JsrtValueDeserializer *>(deserializer);
+        if (valueDeserializer->GetScriptContext() != scriptContext)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        valueDeserializer->ReadHeader();
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsValueDeserializerReadValue(_In_ JsValueDeserializerHandle deserializer, _Out_ JsValueRef *value)
+{
+    PARAM_NOT_NULL(deserializer);
+    PARAM_NOT_NULL(value);
+    *value = JS_INVALID_REFERENCE;
+
+    return ContextAPIWrapper<true>([&](Js::ScriptContext *scriptContext, TTDRecorder& _actionEntryPopper) -> JsErrorCode {
+        PERFORM_JSRT_TTD_RECORD_ACTION_NOT_IMPLEMENTED(scriptContext);
+
+        JsrtValueDeserializer * valueDeserializer = static_cast<JsrtValueDeserializer *>(deserializer);
+        if (valueDeserializer->GetScriptContext() != scriptContext)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        *value = valueDeserializer->ReadValue();
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsValueDeserializerTransferArrayBuffer(
+    _In_ JsValueDeserializerHandle deserializer,
+    _In_ unsigned int transferId,
+    _In_ JsValueRef arrayBuffer)
+{
+    PARAM_NOT_NULL(deserializer);
+
+    return ContextAPINoScriptWrapper_NoRecord([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        VALIDATE_INCOMING_REFERENCE(arrayBuffer, scriptContext);
+
+        JsrtValueDeserializer * valueDeserializer = static_cast<JsrtValueDeserializer *>(deserializer);
+        if (!Js::ArrayBufferBase::Is(arrayBuffer) || valueDeserializer->GetScriptContext() != scriptContext)
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        valueDeserializer->TransferArrayBuffer(transferId, arrayBuffer);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsValueDeserializerGetWireFormatVersion(_In_ JsValueDeserializerHandle deserializer, _Out_ unsigned int *version)
+{
+    PARAM_NOT_NULL(deserializer);
+    PARAM_NOT_NULL(version);
+
+    *version = static_cast<JsrtValueDeserializer *>(deserializer)->GetWireFormatVersion();
+    return JsNoError;
+}
+
+CHAKRA_API JsValueDeserializerReadVarint(_In_ JsValueDeserializerHandle deserializer, _Out_ uint64_t *value)
+{
+    PARAM_NOT_NULL(deserializer);
+    PARAM_NOT_NULL(value);
+
+    uint64 result = 0;
+    if (!static_cast<JsrtValueDeserializer *>(deserializer)->ReadVarint(&result))
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    *value = result;
+    return JsNoError;
+}
+
+CHAKRA_API JsValueDeserializerReadDouble(_In_ JsValueDeserializerHandle deserializer, _Out_ double *value)
+{
+    PARAM_NOT_NULL(deserializer);
+    PARAM_NOT_NULL(value);
+
+    return static_cast<JsrtValueDeserializer *>(deserializer)->ReadDouble(value) ? JsNoError : JsErrorInvalidArgument;
+}
+
+CHAKRA_API JsValueDeserializerReadRawBytes(
+    _In_ JsValueDeserializerHandle deserializer,
+    _In_ size_t length,
+    _Outptr_result_bytebuffer_(length) const void **data)
+{
+    PARAM_NOT_NULL(deserializer);
+    PARAM_NOT_NULL(data);
+    *data = nullptr;
+
+    const byte * bytes = nullptr;
+    if (!static_cast<JsrtValueDeserializer *>(deserializer)->ReadRawBytes(length, &bytes))
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    *data = bytes;
+    return JsNoError;
+}
 #endif // CHAKRACOREBUILD_
@@ -5,9 +5,10 @@
 #include "JsrtPch.h"
 #include "jsrtHelper.h"
 #include "JsrtExternalObject.h"
+#include "JsrtInterceptorObject.h"
 #include "Types/PathTypeHandler.h"
 
-JsrtExternalType::JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback)
+JsrtExternalType::JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback, const JsPropertyInterceptors * interceptors)
     : Js::DynamicType(
         scriptContext,
         Js::TypeIds_Object,
@@ -17,18 +18,46 @@ JsrtExternalType::JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeC
         true,
         true)
         , jsFinalizeCallback(finalizeCallback)
+        , interceptors(nullptr)
 {
     this->flags |= TypeFlagMask_JsrtExternal;
+
+    if (interceptors != nullptr)
+    {
+        JsPropertyInterceptors * interceptorsCopy = RecyclerNewStructLeaf(scriptContext->GetRecycler(), JsPropertyInterceptors);
+        *interceptorsCopy = *interceptors;
+        this->interceptors = interceptorsCopy;
+        this->flags |= TypeFlagMask_CanHaveInterceptors;
+    }
+}
+
+bool JsrtExternalType::HasSameInterceptors(JsFinalizeCallback finalizeCallback, const JsPropertyInterceptors * interceptors) const
+{
+    return this->jsFinalizeCallback == finalizeCallback &&
+        this->interceptors != nullptr &&
+        memcmp(this->interceptors, interceptors, sizeof(JsPropertyInterceptors)) == 0;
 }
 
-JsrtExternalObject::JsrtExternalObject(JsrtExternalType * type, void *data) :
+JsrtExternalObject::JsrtExternalObject(JsrtExternalType * type, void *data, uint internalFieldCount) :
     slot(data),
+    internalFieldCount(internalFieldCount),
+    weakCallback(nullptr),
+    weakCallbackState(nullptr),
+    weakCallbackData(nullptr),
     Js::DynamicObject(type, false/* initSlots*/)
 {
+    // Recycler memory comes back zeroed, so the inline fields start out as nullptr
+#if DBG
+    for (uint i = 0; i < internalFieldCount; i++)
+    {
+        Assert(this->GetInternalFields()[i] == nullptr);
+    }
+#endif
 }
 
 /* static */
-JsrtExternalObject* JsrtExternalObject::Create(void *data, JsFinalizeCallback finalizeCallback, Js::ScriptContext *scriptContext)
+JsrtExternalObject* JsrtExternalObject::Create(void *data, JsFinalizeCallback finalizeCallback, Js::ScriptContext *scriptContext,
+    uint internalFieldCount)
 {
     Js::DynamicType * dynamicType = scriptContext->GetLibrary()->GetCachedJsrtExternalType(reinterpret_cast<uintptr_t>(finalizeCallback));
 
@@ -40,8 +69,16 @@ JsrtExternalObject* JsrtExternalObject::Create(void *data, JsFinalizeCallback fi
 
     Assert(dynamicType->IsJsrtExternal());
     Assert(dynamicType->GetIsShared());
+    Assert(static_cast<JsrtExternalType*>(dynamicType)->GetInterceptors() == nullptr);
+
+    if (internalFieldCount == 0)
+    {
+        return RecyclerNewFinalized(scriptContext->GetRecycler(), JsrtExternalObject, static_cast<JsrtExternalType*>(dynamicType), data);
+    }
 
-    return RecyclerNewFinalized(scriptContext->GetRecycler(), JsrtExternalObject, static_cast<JsrtExternalType*>(dynamicType), data);
+    size_t fieldsSize = UInt32Math::Mul<sizeof(void *)>(internalFieldCount);
+    return RecyclerNewFinalizedPlus(scriptContext->GetRecycler(), fieldsSize, JsrtExternalObject,
+        static_cast<JsrtExternalType*>(dynamicType), data, internalFieldCount);
 }
 
 bool JsrtExternalObject::Is(Js::Var value)
@@ -52,7 +89,8 @@ bool JsrtExternalObject::Is(Js::Var value)
     }
 
     return (VirtualTableInfo<JsrtExternalObject>::HasVirtualTable(value)) ||
-        (VirtualTableInfo<Js::CrossSiteObject<JsrtExternalObject>>::HasVirtualTable(value));
+        (VirtualTableInfo<Js::CrossSiteObject<JsrtExternalObject>>::HasVirtualTable(value)) ||
+        JsrtInterceptorObject::Is(value);
 }
 
 JsrtExternalObject * JsrtExternalObject::FromVar(Js::Var value)
@@ -63,6 +101,9 @@ JsrtExternalObject * JsrtExternalObject::FromVar(Js::Var value)
 
 void JsrtExternalObject::Finalize(bool isShutdown)
 {
+    // The recycler calls the weak callback, and unlinks it, before the object is collected
+    Assert(!this->weakCallbackNode.IsRegistered());
+
     JsFinalizeCallback finalizeCallback = this->GetExternalType()->GetJsFinalizeCallback();
     if (nullptr != finalizeCallback)
     {
@@ -85,6 +126,53 @@ void JsrtExternalObject::SetSlotData(void * data)
     this->slot = data;
 }
 
+void * JsrtExternalObject::GetInternalField(uint index) const
+{
+    Assert(index < this->internalFieldCount);
+    return this->GetInternalFields()[index];
+}
+
+void JsrtExternalObject::SetInternalField(uint index, void * value)
+{
+    Assert(index < this->internalFieldCount);
+    this->GetInternalFields()[index] = value;
+}
+
+void JsrtExternalObject::SetWeakCallback(JsExternalObjectWeakCallback callback, void * callbackState, void * callbackData)
+{
+    Recycler * recycler = this->GetRecycler();
+    if (callback == nullptr)
+    {
+        recycler->UnregisterObjectWeakCallback(&this->weakCallbackNode);
+        this->weakCallback = nullptr;
+        this->weakCallbackState = nullptr;
+        this->weakCallbackData = nullptr;
+        return;
+    }
+
+    this->weakCallback = callback;
+    this->weakCallbackState = callbackState;
+    this->weakCallbackData = callbackData;
+    recycler->RegisterObjectWeakCallback(&this->weakCallbackNode, this, &JsrtExternalObject::WeakCallbackThunk);
+}
+
+/* static */
+void CALLBACK JsrtExternalObject::WeakCallbackThunk(void * object)
+{
+    JsrtExternalObject * externalObject = static_cast<JsrtExternalObject *>(object);
+    JsExternalObjectWeakCallback callback = externalObject->weakCallback;
+    void * callbackState = externalObject->weakCallbackState;
+    void * callbackData = externalObject->weakCallbackData;
+
+    // The callback is one-shot, like the object's before collect callback. It may set a new one.
+    externalObject->weakCallback = nullptr;
+    externalObject->weakCallbackState = nullptr;
+    externalObject->weakCallbackData = nullptr;
+
+    JsrtCallbackState scope(nullptr);
+    callback(externalObject, callbackState, callbackData);
+}
+
 Js::DynamicType* JsrtExternalObject::DuplicateType()
 {
     return RecyclerNew(this->GetScriptContext()->GetRecycler(), JsrtExternalType,
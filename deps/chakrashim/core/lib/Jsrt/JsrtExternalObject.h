@@ -4,7 +4,7 @@
 //-------------------------------------------------------------------------------------------------------
 #pragma once
 
-#include "ChakraCommon.h"
+#include "ChakraCore.h"
 
 #define BEGIN_INTERCEPTOR(scriptContext) \
     BEGIN_LEAVE_SCRIPT(scriptContext) \
@@ -27,14 +27,19 @@
 class JsrtExternalType sealed : public Js::DynamicType
 {
 public:
-    JsrtExternalType(JsrtExternalType *type) : Js::DynamicType(type), jsFinalizeCallback(type->jsFinalizeCallback) {}
-    JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback);
+    JsrtExternalType(JsrtExternalType *type) : Js::DynamicType(type), jsFinalizeCallback(type->jsFinalizeCallback), interceptors(type->interceptors) {}
+    JsrtExternalType(Js::ScriptContext* scriptContext, JsFinalizeCallback finalizeCallback, const JsPropertyInterceptors * interceptors = nullptr);
 
     //Js::PropertyId GetNameId() const { return ((Js::PropertyRecord *)typeDescription.className)->GetPropertyId(); }
     JsFinalizeCallback GetJsFinalizeCallback() const { return this->jsFinalizeCallback; }
 
+    // Recycler owned copy of the interceptors, nullptr for plain external objects
+    const JsPropertyInterceptors * GetInterceptors() const { return this->interceptors; }
+    bool HasSameInterceptors(JsFinalizeCallback finalizeCallback, const JsPropertyInterceptors * interceptors) const;
+
 private:
     FieldNoBarrier(JsFinalizeCallback) jsFinalizeCallback;
+    Field(const JsPropertyInterceptors *) interceptors;
 };
 AUTO_REGISTER_RECYCLER_OBJECT_DUMPER(JsrtExternalType, &Js::Type::DumpObjectFunction);
 
@@ -45,11 +50,12 @@ protected:
     DEFINE_MARSHAL_OBJECT_TO_SCRIPT_CONTEXT(JsrtExternalObject);
 
 public:
-    JsrtExternalObject(JsrtExternalType * type, void *data);
+    JsrtExternalObject(JsrtExternalType * type, void *data, uint internalFieldCount = 0);
 
     static bool Is(Js::Var value);
     static JsrtExternalObject * FromVar(Js::Var value);
-    static JsrtExternalObject * Create(void *data, JsFinalizeCallback finalizeCallback, Js::ScriptContext *scriptContext);
+    static JsrtExternalObject * Create(void *data, JsFinalizeCallback finalizeCallback, Js::ScriptContext *scriptContext,
+        uint internalFieldCount = 0);
 
     JsrtExternalType * GetExternalType() const { return (JsrtExternalType *)this->GetType(); }
 
@@ -63,8 +69,32 @@ public:
     void * GetSlotData() const;
     void SetSlotData(void * data);
 
+    // Internal fields are allocated inline right after the object. They are
+    // scanned by the recycler like any other field, so a field holding a Var
+    // keeps it alive for as long as this object is alive.
+    uint GetInternalFieldCount() const { return this->internalFieldCount; }
+    void * GetInternalField(uint index) const;
+    void SetInternalField(uint index, void * value);
+
+    // Weak callback kept in the object itself and linked into the recycler's list, so setting
+    // and clearing it doesn't allocate. A nullptr callback clears it.
+    void SetWeakCallback(JsExternalObjectWeakCallback callback, void * callbackState, void * callbackData);
+
 private:
+    static void CALLBACK WeakCallbackThunk(void * object);
+
+    Field(void *) * GetInternalFields() const
+    {
+        return reinterpret_cast<Field(void *) *>(const_cast<JsrtExternalObject *>(this) + 1);
+    }
+
     Field(void *) slot;
+    Field(uint) internalFieldCount;
+
+    FieldNoBarrier(Recycler::ObjectWeakCallbackNode) weakCallbackNode;
+    FieldNoBarrier(JsExternalObjectWeakCallback) weakCallback;
+    FieldNoBarrier(void *) weakCallbackState;
+    FieldNoBarrier(void *) weakCallbackData;
 
 #if ENABLE_TTD
 public:
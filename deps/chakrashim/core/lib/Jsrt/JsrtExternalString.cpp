@@ -0,0 +1,128 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "JsrtPch.h"
+#include "jsrtHelper.h"
+#include "JsrtExternalString.h"
+
+namespace Js
+{
+    JsrtExternalString::JsrtExternalString(StaticType* type, const char16* content, const char* oneByteContent,
+        charcount_t length, JsFinalizeCallback finalizeCallback, void* callbackState)
+        : JavascriptString(type),
+        content(content),
+        oneByteContent(oneByteContent),
+        isTerminated(false),
+        finalizeCallback(finalizeCallback),
+        callbackState(callbackState)
+    {
+        Assert((content == nullptr) != (oneByteContent == nullptr));
+
+        // Latin1 backed strings start out unflattened
+        this->SetBuffer(content);
+        this->SetLength(length);
+
+#ifdef PROFILE_STRINGS
+        if (content != nullptr)
+        {
+            StringProfiler::RecordNewString(type->GetScriptContext(), content, length);
+        }
+#endif
+    }
+
+    JsrtExternalString* JsrtExternalString::NewUtf16(const char16* content, charcount_t length,
+        JsFinalizeCallback finalizeCallback, void* callbackState, ScriptContext* scriptContext)
+    {
+        Recycler* recycler = scriptContext->GetRecycler();
+        return RecyclerNewFinalized(recycler, JsrtExternalString, scriptContext->GetLibrary()->GetStringTypeStatic(),
+            content, nullptr, length, finalizeCallback, callbackState);
+    }
+
+    JsrtExternalString* JsrtExternalString::NewLatin1(const char* content, charcount_t length,
+        JsFinalizeCallback finalizeCallback, void* callbackState, ScriptContext* scriptContext)
+    {
+        Recycler* recycler = scriptContext->GetRecycler();
+        return RecyclerNewFinalized(recycler, JsrtExternalString, scriptContext->GetLibrary()->GetStringTypeStatic(),
+            nullptr, content, length, finalizeCallback, callbackState);
+    }
+
+    bool JsrtExternalString::Is(Var value)
+    {
+        return JavascriptString::Is(value) && VirtualTableInfo<JsrtExternalString>::HasVirtualTable(value);
+    }
+
+    JsrtExternalString* JsrtExternalString::FromVar(Var value)
+    {
+        Assert(Is(value));
+        return static_cast<JsrtExternalString*>(value);
+    }
+
+    const char16* JsrtExternalString::GetSz()
+    {
+        if (!this->isTerminated)
+        {
+            Recycler* recycler = this->GetScriptContext()->GetRecycler();
+            const charcount_t length = this->GetLength();
+            char16* buffer;
+
+            if (this->oneByteContent != nullptr)
+            {
+                buffer = RecyclerNewArrayLeaf(recycler, char16, SafeSzSize(length));
+                utf8::DecodeLatin1Into(buffer, reinterpret_cast<const BYTE*>(this->oneByteContent), length);
+                buffer[length] = _u('\0');
+            }
+            else
+            {
+                buffer = AllocateLeafAndCopySz(recycler, this->content, length);
+            }
+
+            // From here on the external content is only kept alive for the finalize callback
+            this->SetBuffer(buffer);
+            this->isTerminated = true;
+        }
+
+        return this->UnsafeGetBuffer();
+    }
+
+    void JsrtExternalString::CopyVirtual(
+        _Out_writes_(m_charLength) char16 *const buffer,
+        StringCopyInfoStack &nestedStringTreeCopyInfos,
+        const byte recursionDepth)
+    {
+        Assert(!this->IsFinalized());
+        Assert(this->oneByteContent != nullptr);
+
+        // Widen straight into the destination, no need to flatten this string
+        utf8::DecodeLatin1Into(buffer, reinterpret_cast<const BYTE*>(this->oneByteContent), this->GetLength());
+    }
+
+    size_t JsrtExternalString::GetAllocatedByteCount() const
+    {
+        if (!this->isTerminated)
+        {
+            return 0;
+        }
+        return __super::GetAllocatedByteCount();
+    }
+
+    void const * JsrtExternalString::GetOriginalStringReference()
+    {
+        // The host buffer is only valid while this string is alive, so substrings need to keep
+        // the string itself alive rather than the buffer
+        return this;
+    }
+
+    void JsrtExternalString::Finalize(bool isShutdown)
+    {
+        if (this->finalizeCallback != nullptr)
+        {
+            JsrtCallbackState scope(nullptr);
+            this->finalizeCallback(this->callbackState);
+        }
+    }
+
+    void JsrtExternalString::Dispose(bool isShutdown)
+    {
+    }
+}
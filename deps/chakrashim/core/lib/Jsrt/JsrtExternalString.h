@@ -0,0 +1,56 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace Js
+{
+    // String backed by host owned memory. The content is not copied; the host is notified
+    // through the finalize callback once the string is collected.
+    //
+    // Utf16 content is used in place. Since host memory is not guaranteed to be '\0' terminated,
+    // GetSz() makes a terminated copy on demand (like SubString).
+    //
+    // Latin1 content can't be used in place as char16. The string stays unflattened (null buffer)
+    // until someone needs the char16 contents, at which point it is widened into a recycler buffer.
+    // Until then JSRT string accessors can read the one byte content directly.
+    class JsrtExternalString sealed : public JavascriptString
+    {
+    protected:
+        DEFINE_VTABLE_CTOR(JsrtExternalString, JavascriptString);
+        DECLARE_CONCRETE_STRING_CLASS;
+
+        JsrtExternalString(StaticType* type, const char16* content, const char* oneByteContent,
+            charcount_t length, JsFinalizeCallback finalizeCallback, void* callbackState);
+
+    public:
+        static JsrtExternalString* NewUtf16(const char16* content, charcount_t length,
+            JsFinalizeCallback finalizeCallback, void* callbackState, ScriptContext* scriptContext);
+        static JsrtExternalString* NewLatin1(const char* content, charcount_t length,
+            JsFinalizeCallback finalizeCallback, void* callbackState, ScriptContext* scriptContext);
+
+        static bool Is(Var value);
+        static JsrtExternalString* FromVar(Var value);
+
+        // Returns the latin1 content if this string is latin1 backed, nullptr otherwise
+        const char* GetOneByteContent() const { return this->oneByteContent; }
+
+        virtual const char16* GetSz() override;
+        virtual void CopyVirtual(_Out_writes_(m_charLength) char16 *const buffer,
+            StringCopyInfoStack &nestedStringTreeCopyInfos, const byte recursionDepth) override;
+        virtual size_t GetAllocatedByteCount() const override;
+        virtual void const * GetOriginalStringReference() override;
+
+        void Finalize(bool isShutdown) override;
+        void Dispose(bool isShutdown) override;
+
+    private:
+        FieldNoBarrier(const char16*) content;
+        FieldNoBarrier(const char*) oneByteContent;
+        Field(bool) isTerminated;
+        FieldNoBarrier(JsFinalizeCallback) finalizeCallback;
+        Field(void *) callbackState;
+    };
+}
+AUTO_REGISTER_RECYCLER_OBJECT_DUMPER(Js::JsrtExternalString, &Js::RecyclableObject::DumpObjectFunction);
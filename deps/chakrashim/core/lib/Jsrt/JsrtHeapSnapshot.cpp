@@ -0,0 +1,695 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "JsrtPch.h"
+#include "JsrtHeapSnapshot.h"
+#include "JsrtRuntime.h"
+#include "JsrtExternalObject.h"
+#include "Library/JavascriptSymbol.h"
+#include "Library/BoundFunction.h"
+#include "Library/MapOrSetDataList.h"
+#include "Library/JavascriptMap.h"
+#include "Library/JavascriptSet.h"
+
+JsrtHeapSnapshot::JsrtHeapSnapshot(ThreadContext * threadContext) :
+    threadContext(threadContext),
+    recycler(threadContext->EnsureRecycler()),
+    nodeList(&HeapAllocator::Instance),
+    edgeList(&HeapAllocator::Instance),
+    stringList(&HeapAllocator::Instance),
+    pendingNodes(nullptr),
+    nodeIndices(nullptr),
+    stringIndices(nullptr),
+    propertyNameIndices(nullptr),
+    libraries(nullptr)
+{
+    memset(static_cast<JsHeapSnapshot *>(this), 0, sizeof(JsHeapSnapshot));
+}
+
+JsrtHeapSnapshot::~JsrtHeapSnapshot()
+{
+    this->Seal();
+
+    for (int i = 0; i < this->stringList.Count(); i++)
+    {
+        const char * str = this->stringList.Item(i);
+        if (str != nullptr)
+        {
+            HeapDeleteArray(strlen(str) + 1, const_cast<char *>(str));
+        }
+    }
+}
+
+JsHeapSnapshot * JsrtHeapSnapshot::Take(JsrtRuntime * runtime)
+{
+    JsrtHeapSnapshot * snapshot = nullptr;
+    try
+    {
+        snapshot = HeapNew(JsrtHeapSnapshot, runtime->GetThreadContext());
+        snapshot->Walk(runtime);
+        snapshot->Seal();
+    }
+    catch (Js::OutOfMemoryException)
+    {
+        if (snapshot != nullptr)
+        {
+            HeapDelete(snapshot);
+        }
+        return nullptr;
+    }
+
+    return snapshot;
+}
+
+void JsrtHeapSnapshot::Release(JsHeapSnapshot * snapshot)
+{
+    HeapDelete(static_cast<JsrtHeapSnapshot *>(snapshot));
+}
+
+void JsrtHeapSnapshot::Walk(JsrtRuntime * runtime)
+{
+    this->pendingNodes = HeapNew(PendingNodeList, &HeapAllocator::Instance);
+    this->nodeIndices = HeapNew(NodeIndexMap, &HeapAllocator::Instance);
+    this->stringIndices = HeapNew(StringIndexMap, &HeapAllocator::Instance);
+    this->propertyNameIndices = HeapNew(PropertyNameIndexMap, &HeapAllocator::Instance);
+    this->libraries = HeapNew(LibraryList, &HeapAllocator::Instance);
+
+    for (Js::ScriptContext * scriptContext = this->threadContext->GetScriptContextList(); scriptContext != nullptr; scriptContext = scriptContext->next)
+    {
+        if (!scriptContext->IsClosed())
+        {
+            this->libraries->Add(scriptContext->GetLibrary());
+        }
+    }
+
+    // Nothing is collected or moved until the walk is done
+    Recycler::AutoSetupRecyclerForNonCollectingMark autoSetup(*this->recycler, true);
+    autoSetup.SetupForHeapEnumeration();
+
+    // The synthetic nodes come first so that their edges are recorded before any object's
+    uint root = this->AddNode(JsHeapSnapshotNodeType_Synthetic, this->GetString(_u("")), 0, nullptr, NodeKind_Synthetic);
+    uint gcRoots = this->AddNode(JsHeapSnapshotNodeType_Synthetic, this->GetString(_u("(GC roots)")), 0, nullptr, NodeKind_Synthetic);
+    uint globalHandles = this->AddNode(JsHeapSnapshotNodeType_Synthetic, this->GetString(_u("(Global handles)")), 0, nullptr, NodeKind_Synthetic);
+    uint handleScope = this->AddNode(JsHeapSnapshotNodeType_Synthetic, this->GetString(_u("(Handle scope)")), 0, nullptr, NodeKind_Synthetic);
+
+    uint edgeStart = this->edgeList.Count();
+    this->AddEdge(JsHeapSnapshotEdgeType_Element, 1, gcRoots);
+    for (int i = 0; i < this->libraries->Count(); i++)
+    {
+        this->AddEdge(JsHeapSnapshotEdgeType_Shortcut, this->GetString(_u("global")), (Js::Var)this->libraries->Item(i)->GetGlobalObject());
+    }
+    this->nodeList.Item(root).edgeCount = this->edgeList.Count() - edgeStart;
+
+    edgeStart = this->edgeList.Count();
+    uint index = 1;
+    this->AddEdge(JsHeapSnapshotEdgeType_Element, index++, globalHandles);
+    this->AddEdge(JsHeapSnapshotEdgeType_Element, index++, handleScope);
+    for (int i = 0; i < this->libraries->Count(); i++)
+    {
+        this->AddEdge(JsHeapSnapshotEdgeType_Element, index++, (Js::Var)this->libraries->Item(i)->GetGlobalObject());
+    }
+    this->nodeList.Item(gcRoots).edgeCount = this->edgeList.Count() - edgeStart;
+
+    // Objects pinned with JsAddRef
+    edgeStart = this->edgeList.Count();
+    index = 1;
+    this->recycler->MapPinnedObjects([&](void * obj)
+    {
+        if (this->IsRecyclableObject(obj) && this->AddEdge(JsHeapSnapshotEdgeType_Element, index, obj))
+        {
+            index++;
+        }
+    });
+    this->nodeList.Item(globalHandles).edgeCount = this->edgeList.Count() - edgeStart;
+
+    // Values the host keeps in the runtime's root blocks
+    edgeStart = this->edgeList.Count();
+    index = 1;
+    runtime->MapRootBlockValues([&](Js::Var value)
+    {
+        if (this->AddEdge(JsHeapSnapshotEdgeType_Element, index, value))
+        {
+            index++;
+        }
+    });
+    this->nodeList.Item(handleScope).edgeCount = this->edgeList.Count() - edgeStart;
+
+    // Breadth first, every node found is appended and has its edges recorded in turn
+    for (int i = handleScope + 1; i < this->pendingNodes->Count(); i++)
+    {
+        PendingNode pending = this->pendingNodes->Item(i);
+        edgeStart = this->edgeList.Count();
+        if (pending.kind == NodeKind_ScopeSlots)
+        {
+            this->AddScopeSlotsEdges(static_cast<Js::Var *>(pending.address));
+        }
+        else
+        {
+            Assert(pending.kind == NodeKind_Object);
+            this->AddObjectEdges(static_cast<Js::RecyclableObject *>(pending.address));
+        }
+        this->nodeList.Item(i).edgeCount = this->edgeList.Count() - edgeStart;
+    }
+}
+
+void JsrtHeapSnapshot::Seal()
+{
+    if (this->pendingNodes != nullptr)
+    {
+        HeapDelete(this->pendingNodes);
+        this->pendingNodes = nullptr;
+    }
+    if (this->nodeIndices != nullptr)
+    {
+        HeapDelete(this->nodeIndices);
+        this->nodeIndices = nullptr;
+    }
+    if (this->stringIndices != nullptr)
+    {
+        HeapDelete(this->stringIndices);
+        this->stringIndices = nullptr;
+    }
+    if (this->propertyNameIndices != nullptr)
+    {
+        HeapDelete(this->propertyNameIndices);
+        this->propertyNameIndices = nullptr;
+    }
+    if (this->libraries != nullptr)
+    {
+        HeapDelete(this->libraries);
+        this->libraries = nullptr;
+    }
+
+    // The lists own the buffers handed out, they are not copied again
+    this->nodes = const_cast<JsHeapSnapshotNode *>(this->nodeList.GetBuffer());
+    this->nodeCount = this->nodeList.Count();
+    this->edges = const_cast<JsHeapSnapshotEdge *>(this->edgeList.GetBuffer());
+    this->edgeCount = this->edgeList.Count();
+    this->strings = const_cast<const char **>(this->stringList.GetBuffer());
+    this->stringCount = this->stringList.Count();
+}
+
+uint JsrtHeapSnapshot::AddNode(JsHeapSnapshotNodeType type, uint name, size_t selfSize, void * address, NodeKind kind)
+{
+    // Ids are odd like v8's object ids, they are only unique within one snapshot
+    uint index = this->nodeList.Count();
+    JsHeapSnapshotNode node = { type, name, index * 2 + 1, selfSize, 0 };
+    this->nodeList.Add(node);
+
+    PendingNode pending = { address, kind };
+    this->pendingNodes->Add(pending);
+    if (address != nullptr)
+    {
+        this->nodeIndices->Add(address, index);
+    }
+    return index;
+}
+
+uint JsrtHeapSnapshot::GetNode(Js::Var value)
+{
+    if (value == nullptr || Js::TaggedNumber::Is(value))
+    {
+        return NoNode;
+    }
+
+    uint index;
+    if (this->nodeIndices->TryGetValue(value, &index))
+    {
+        return index;
+    }
+
+    Js::RecyclableObject * object = Js::RecyclableObject::FromVar(value);
+    Js::TypeId typeId = object->GetTypeId();
+    if (typeId <= Js::TypeIds_Boolean || typeId == Js::TypeIds_UndeclBlockVar)
+    {
+        return NoNode;
+    }
+
+    JsHeapSnapshotNodeType type;
+    uint name;
+    size_t selfSize = this->GetAllocationSize(object);
+    this->DescribeObject(object, &type, &name, &selfSize);
+    return this->AddNode(type, name, selfSize, object, NodeKind_Object);
+}
+
+uint JsrtHeapSnapshot::GetScopeSlotsNode(Js::Var * slotArray)
+{
+    uint index;
+    if (this->nodeIndices->TryGetValue(slotArray, &index))
+    {
+        return index;
+    }
+
+    return this->AddNode(JsHeapSnapshotNodeType_Hidden, this->GetString(_u("system / Context")),
+        this->GetAllocationSize(slotArray), slotArray, NodeKind_ScopeSlots);
+}
+
+void JsrtHeapSnapshot::AddEdge(JsHeapSnapshotEdgeType type, uint nameOrIndex, uint toNode)
+{
+    JsHeapSnapshotEdge edge = { type, nameOrIndex, toNode };
+    this->edgeList.Add(edge);
+}
+
+bool JsrtHeapSnapshot::AddEdge(JsHeapSnapshotEdgeType type, uint nameOrIndex, Js::Var value)
+{
+    uint toNode = this->GetNode(value);
+    if (toNode == NoNode)
+    {
+        return false;
+    }
+
+    this->AddEdge(type, nameOrIndex, toNode);
+    return true;
+}
+
+void JsrtHeapSnapshot::AddObjectEdges(Js::RecyclableObject * object)
+{
+    Js::TypeId typeId = object->GetTypeId();
+    if (!Js::DynamicType::Is(typeId))
+    {
+        return;
+    }
+
+    Js::DynamicObject * dynamicObject = Js::DynamicObject::FromVar(object);
+    this->AddEdge(JsHeapSnapshotEdgeType_Property, this->GetString(_u("__proto__")), (Js::Var)object->GetPrototype());
+    this->AddPropertyEdges(dynamicObject);
+
+    if (Js::JavascriptArray::IsVarArray(typeId))
+    {
+        this->AddElementEdges(Js::JavascriptArray::FromVar(object));
+    }
+    else if (dynamicObject->HasObjectArray())
+    {
+        Js::ArrayObject * objectArray = dynamicObject->GetObjectArray();
+        if (Js::JavascriptArray::IsVarArray(objectArray->GetTypeId()))
+        {
+            this->AddElementEdges(Js::JavascriptArray::FromVar(objectArray));
+        }
+    }
+
+    if (typeId == Js::TypeIds_Function)
+    {
+        this->AddFunctionEdges(Js::JavascriptFunction::FromVar(object));
+    }
+    else if (typeId == Js::TypeIds_Map)
+    {
+        Js::JavascriptMap::MapDataList::Iterator iterator = Js::JavascriptMap::FromVar(object)->GetIterator();
+        while (iterator.Next())
+        {
+            const Js::JavascriptMap::MapDataKeyValuePair& entry = iterator.Current();
+            this->AddEdge(JsHeapSnapshotEdgeType_Internal, this->GetString(_u("key")), (Js::Var)entry.Key());
+            this->AddEdge(JsHeapSnapshotEdgeType_Internal, this->GetString(_u("value")), (Js::Var)entry.Value());
+        }
+    }
+    else if (typeId == Js::TypeIds_Set)
+    {
+        uint index = 0;
+        Js::JavascriptSet::SetDataList::Iterator iterator = Js::JavascriptSet::FromVar(object)->GetIterator();
+        while (iterator.Next())
+        {
+            this->AddEdge(JsHeapSnapshotEdgeType_Hidden, index++, iterator.Current());
+        }
+    }
+    else if ((typeId >= Js::TypeIds_TypedArrayMin && typeId <= Js::TypeIds_TypedArrayMax) || typeId == Js::TypeIds_DataView)
+    {
+        this->AddEdge(JsHeapSnapshotEdgeType_Internal, this->GetString(_u("buffer")),
+            (Js::Var)static_cast<Js::ArrayBufferParent *>(object)->GetArrayBuffer());
+    }
+    else if (JsrtExternalObject::Is(object))
+    {
+        // Internal fields may hold anything the host likes, only script objects are followed
+        JsrtExternalObject * externalObject = JsrtExternalObject::FromVar(object);
+        for (uint i = 0; i < externalObject->GetInternalFieldCount(); i++)
+        {
+            void * field = externalObject->GetInternalField(i);
+            if (field != nullptr && this->IsRecyclableObject(field))
+            {
+                this->AddEdge(JsHeapSnapshotEdgeType_Hidden, i, (Js::Var)field);
+            }
+        }
+    }
+}
+
+void JsrtHeapSnapshot::AddPropertyEdges(Js::DynamicObject * object)
+{
+    Js::DynamicTypeHandler * typeHandler = object->GetTypeHandler();
+    Js::ScriptContext * scriptContext = object->GetScriptContext();
+    JsHeapSnapshotEdgeType propertyEdgeType = object->GetTypeId() == Js::TypeIds_ActivationObject ?
+        JsHeapSnapshotEdgeType_Context : JsHeapSnapshotEdgeType_Property;
+
+#if DBG
+    // String keyed type handlers allocate the property records of their keys
+    Recycler::AutoAllowAllocationDuringHeapEnum autoAllowAllocation(this->recycler);
+#endif
+
+    int count = typeHandler->GetPropertyCount();
+    for (int i = 0; i < count; i++)
+    {
+        Js::PropertyId propertyId = typeHandler->GetPropertyId(scriptContext, (Js::BigPropertyIndex)i);
+        if (propertyId == Js::Constants::NoProperty)
+        {
+            continue;
+        }
+
+        JsHeapSnapshotEdgeType edgeType = Js::IsInternalPropertyId(propertyId) ? JsHeapSnapshotEdgeType_Internal : propertyEdgeType;
+        uint name = this->GetPropertyName(propertyId);
+
+        // Accessors are recorded as the getter and setter functions, no script runs during the walk
+        Js::Var getter = nullptr;
+        Js::Var setter = nullptr;
+        Js::Var value = nullptr;
+        Js::PropertyIndex slot = typeHandler->GetPropertyIndex(this->threadContext->GetPropertyName(propertyId));
+        if (slot != Js::Constants::NoSlot)
+        {
+            this->AddEdge(edgeType, name, typeHandler->GetSlot(object, slot));
+        }
+        else if (typeHandler->GetAccessors(object, propertyId, &getter, &setter))
+        {
+            this->AddEdge(edgeType, name, getter);
+            this->AddEdge(edgeType, name, setter);
+        }
+        else if (typeHandler->GetProperty(object, object, propertyId, &value, nullptr, scriptContext))
+        {
+            this->AddEdge(edgeType, name, value);
+        }
+    }
+}
+
+void JsrtHeapSnapshot::AddElementEdges(Js::JavascriptArray * array)
+{
+    for (Js::SparseArraySegmentBase * segment = array->GetHead(); segment != nullptr; segment = segment->next)
+    {
+        Js::SparseArraySegment<Js::Var> * varSegment = static_cast<Js::SparseArraySegment<Js::Var> *>(segment);
+        for (uint32 i = 0; i < segment->length; i++)
+        {
+            Js::Var value = varSegment->elements[i];
+            if (!Js::SparseArraySegment<Js::Var>::IsMissingItem(&value))
+            {
+                this->AddEdge(JsHeapSnapshotEdgeType_Element, segment->left + i, value);
+            }
+        }
+    }
+}
+
+void JsrtHeapSnapshot::AddFunctionEdges(Js::JavascriptFunction * function)
+{
+    if (Js::ScriptFunction::Is(function))
+    {
+        Js::FrameDisplay * environment = Js::ScriptFunction::FromVar(function)->GetEnvironment();
+        if (environment == nullptr)
+        {
+            return;
+        }
+
+        for (uint16 i = 0; i < environment->GetLength(); i++)
+        {
+            void * scope = environment->GetItem(i);
+            if (scope == nullptr)
+            {
+                continue;
+            }
+
+            uint toNode = Js::FrameDisplay::GetScopeType(scope) == Js::ScopeType_SlotArray ?
+                this->GetScopeSlotsNode(static_cast<Js::Var *>(scope)) : this->GetNode(scope);
+            if (toNode != NoNode)
+            {
+                this->AddEdge(JsHeapSnapshotEdgeType_Internal, this->GetString(_u("context")), toNode);
+            }
+        }
+    }
+    else if (Js::BoundFunction::Is(function))
+    {
+        Js::BoundFunction * boundFunction = Js::BoundFunction::FromVar(function);
+        this->AddEdge(JsHeapSnapshotEdgeType_Internal, this->GetString(_u("bound_function")), (Js::Var)boundFunction->GetTargetFunction());
+
+        Field(Js::Var) * args = boundFunction->GetArgsForHeapEnum();
+        for (uint i = 0; i < boundFunction->GetArgsCountForHeapEnum(); i++)
+        {
+            this->AddEdge(JsHeapSnapshotEdgeType_Hidden, i, (Js::Var)args[i]);
+        }
+    }
+}
+
+void JsrtHeapSnapshot::AddScopeSlotsEdges(Js::Var * slotArray)
+{
+    Js::ScopeSlots slots(slotArray);
+    Js::PropertyId * propertyIds = nullptr;
+    uint propertyIdCount = 0;
+    if (slots.IsFunctionScopeSlotArray())
+    {
+        Js::FunctionProxy * proxy = slots.GetFunctionInfo()->GetFunctionProxy();
+        if (proxy != nullptr && proxy->IsFunctionBody())
+        {
+            propertyIds = proxy->GetFunctionBody()->GetPropertyIdsForScopeSlotArray();
+            propertyIdCount = proxy->GetFunctionBody()->GetScopeSlotArraySize();
+        }
+    }
+
+    uint count = slots.GetCount();
+    for (uint i = 0; i < count; i++)
+    {
+        Js::Var value = slots.Get(i);
+        if (propertyIds != nullptr && i < propertyIdCount && propertyIds[i] != Js::Constants::NoProperty)
+        {
+            this->AddEdge(JsHeapSnapshotEdgeType_Context, this->GetPropertyName(propertyIds[i]), value);
+        }
+        else
+        {
+            this->AddEdge(JsHeapSnapshotEdgeType_Hidden, i, value);
+        }
+    }
+}
+
+void JsrtHeapSnapshot::DescribeObject(Js::RecyclableObject * object, JsHeapSnapshotNodeType * type, uint * name, size_t * selfSize)
+{
+    switch (object->GetTypeId())
+    {
+    case Js::TypeIds_String:
+    {
+        // Ropes are not flattened, that would allocate
+        Js::JavascriptString * str = Js::JavascriptString::FromVar(object);
+        if (str->IsFinalized())
+        {
+            *type = JsHeapSnapshotNodeType_String;
+            *name = this->GetString(str->UnsafeGetBuffer(), min(str->GetLength(), (charcount_t)MaxStringNameLength));
+            *selfSize += str->GetLength() * sizeof(char16);
+        }
+        else
+        {
+            *type = JsHeapSnapshotNodeType_ConcatenatedString;
+            *name = this->GetString(_u("(concatenated string)"));
+        }
+        return;
+    }
+
+    case Js::TypeIds_Symbol:
+        *type = JsHeapSnapshotNodeType_Symbol;
+        *name = this->GetPropertyName(Js::JavascriptSymbol::FromVar(object)->GetValue()->GetPropertyId());
+        return;
+
+    case Js::TypeIds_Number:
+    case Js::TypeIds_Int64Number:
+    case Js::TypeIds_UInt64Number:
+        *type = JsHeapSnapshotNodeType_Number;
+        *name = this->GetString(_u("number"));
+        return;
+
+    case Js::TypeIds_Function:
+        *type = JsHeapSnapshotNodeType_Closure;
+        *name = this->GetString(this->GetFunctionName(Js::JavascriptFunction::FromVar(object)));
+        return;
+
+    case Js::TypeIds_ActivationObject:
+        *type = JsHeapSnapshotNodeType_Hidden;
+        *name = this->GetString(_u("system / Context"));
+        return;
+
+    case Js::TypeIds_RegEx:
+        *type = JsHeapSnapshotNodeType_RegExp;
+        *name = this->GetString(_u("RegExp"));
+        return;
+
+    case Js::TypeIds_ArrayBuffer:
+    case Js::TypeIds_SharedArrayBuffer:
+        *selfSize += Js::ArrayBufferBase::FromVar(object)->GetByteLength();
+        break;
+    }
+
+    if (Js::DynamicType::Is(object->GetTypeId()))
+    {
+        Js::DynamicTypeHandler * typeHandler = Js::DynamicObject::FromVar(object)->GetTypeHandler();
+        if (typeHandler->GetSlotCapacity() > typeHandler->GetInlineSlotCapacity())
+        {
+            *selfSize += (typeHandler->GetSlotCapacity() - typeHandler->GetInlineSlotCapacity()) * sizeof(Js::Var);
+        }
+    }
+
+    const char16 * constructorName = this->GetConstructorName(object);
+    *type = JsHeapSnapshotNodeType_Object;
+    *name = this->GetString(constructorName != nullptr && constructorName[0] != _u('\0') ?
+        constructorName : GetTypeName(object->GetTypeId()));
+}
+
+const char16 * JsrtHeapSnapshot::GetConstructorName(Js::RecyclableObject * object)
+{
+    // Only a data property of the prototype is looked at, getters would run script
+    Js::RecyclableObject * prototype = object->GetPrototype();
+    if (prototype == nullptr || !Js::DynamicType::Is(prototype->GetTypeId()))
+    {
+        return nullptr;
+    }
+
+    Js::DynamicObject * dynamicPrototype = Js::DynamicObject::FromVar(prototype);
+    Js::DynamicTypeHandler * typeHandler = dynamicPrototype->GetTypeHandler();
+    Js::PropertyIndex slot = typeHandler->GetPropertyIndex(this->threadContext->GetPropertyName(Js::PropertyIds::constructor));
+    if (slot == Js::Constants::NoSlot)
+    {
+        return nullptr;
+    }
+
+    Js::Var constructor = typeHandler->GetSlot(dynamicPrototype, slot);
+    if (!Js::JavascriptFunction::Is(constructor))
+    {
+        return nullptr;
+    }
+    return this->GetFunctionName(Js::JavascriptFunction::FromVar(constructor));
+}
+
+const char16 * JsrtHeapSnapshot::GetFunctionName(Js::JavascriptFunction * function)
+{
+    Js::FunctionProxy * proxy = function->GetFunctionInfo()->GetFunctionProxy();
+    if (proxy != nullptr)
+    {
+        return proxy->GetDisplayName();
+    }
+
+    // Library functions are named by the property id they were created for
+    Js::Var nameId = function->GetSourceString();
+    if (nameId != nullptr && Js::TaggedInt::Is(nameId))
+    {
+        return this->threadContext->GetPropertyName(Js::TaggedInt::ToInt32(nameId))->GetBuffer();
+    }
+    return nullptr;
+}
+
+const char16 * JsrtHeapSnapshot::GetTypeName(Js::TypeId typeId)
+{
+    switch (typeId)
+    {
+    case Js::TypeIds_Array:
+    case Js::TypeIds_NativeIntArray:
+    case Js::TypeIds_CopyOnAccessNativeIntArray:
+    case Js::TypeIds_NativeFloatArray:
+    case Js::TypeIds_ES5Array:
+        return _u("Array");
+    case Js::TypeIds_Date: return _u("Date");
+    case Js::TypeIds_Error: return _u("Error");
+    case Js::TypeIds_BooleanObject: return _u("Boolean");
+    case Js::TypeIds_NumberObject: return _u("Number");
+    case Js::TypeIds_StringObject: return _u("String");
+    case Js::TypeIds_SymbolObject: return _u("Symbol");
+    case Js::TypeIds_Arguments: return _u("Arguments");
+    case Js::TypeIds_ArrayBuffer: return _u("ArrayBuffer");
+    case Js::TypeIds_SharedArrayBuffer: return _u("SharedArrayBuffer");
+    case Js::TypeIds_Int8Array: return _u("Int8Array");
+    case Js::TypeIds_Uint8Array: return _u("Uint8Array");
+    case Js::TypeIds_Uint8ClampedArray: return _u("Uint8ClampedArray");
+    case Js::TypeIds_Int16Array: return _u("Int16Array");
+    case Js::TypeIds_Uint16Array: return _u("Uint16Array");
+    case Js::TypeIds_Int32Array: return _u("Int32Array");
+    case Js::TypeIds_Uint32Array: return _u("Uint32Array");
+    case Js::TypeIds_Float32Array: return _u("Float32Array");
+    case Js::TypeIds_Float64Array: return _u("Float64Array");
+    case Js::TypeIds_DataView: return _u("DataView");
+    case Js::TypeIds_Map: return _u("Map");
+    case Js::TypeIds_Set: return _u("Set");
+    case Js::TypeIds_WeakMap: return _u("WeakMap");
+    case Js::TypeIds_WeakSet: return _u("WeakSet");
+    case Js::TypeIds_ArrayIterator: return _u("Array Iterator");
+    case Js::TypeIds_MapIterator: return _u("Map Iterator");
+    case Js::TypeIds_SetIterator: return _u("Set Iterator");
+    case Js::TypeIds_StringIterator: return _u("String Iterator");
+    case Js::TypeIds_Generator: return _u("Generator");
+    case Js::TypeIds_Promise: return _u("Promise");
+    case Js::TypeIds_Proxy: return _u("Proxy");
+    case Js::TypeIds_GlobalObject: return _u("global");
+    case Js::TypeIds_WithScopeObject: return _u("system / WithScope");
+    default: return _u("Object");
+    }
+}
+
+bool JsrtHeapSnapshot::IsRecyclableObject(void * candidate)
+{
+    if (Js::TaggedNumber::Is(candidate) || !this->recycler->IsValidObject(candidate, sizeof(Js::RecyclableObject)))
+    {
+        return false;
+    }
+
+    // Anything else in the recycler does not point to a type of one of this runtime's libraries
+    Js::Type * type = static_cast<Js::RecyclableObject *>(candidate)->GetType();
+    if (!this->recycler->IsValidObject(type, sizeof(Js::Type)) || type->GetTypeId() >= Js::TypeIds_Limit)
+    {
+        return false;
+    }
+    return this->libraries->Contains(type->GetLibrary());
+}
+
+size_t JsrtHeapSnapshot::GetAllocationSize(void * address)
+{
+    RecyclerHeapObjectInfo heapObject;
+    if (this->recycler->FindHeapObjectWithClearedAllocators(address, heapObject))
+    {
+        return heapObject.GetSize();
+    }
+    return 0;
+}
+
+uint JsrtHeapSnapshot::GetString(const char16 * str)
+{
+    // Only for names that live as long as the runtime, they are shared by address
+    if (str == nullptr)
+    {
+        str = _u("");
+    }
+
+    uint index;
+    if (this->stringIndices->TryGetValue(str, &index))
+    {
+        return index;
+    }
+
+    index = this->GetString(str, (charcount_t)wcslen(str));
+    this->stringIndices->Add(str, index);
+    return index;
+}
+
+uint JsrtHeapSnapshot::GetString(const char16 * str, charcount_t length)
+{
+    // Reserve the entry first so that the copy is owned by the list as soon as it exists
+    uint index = this->stringList.Add(nullptr);
+
+    size_t utf8Length = utf8::CountTrueUtf8(str, length) + 1;
+    char * utf8 = HeapNewArray(char, utf8Length);
+    charcount_t consumed;
+    size_t written = utf8::EncodeTrueUtf8IntoBounded((LPUTF8)utf8, utf8Length, str, length, &consumed, true);
+    Assert(written < utf8Length);
+    utf8[written] = '\0';
+
+    this->stringList.Item(index, utf8);
+    return index;
+}
+
+uint JsrtHeapSnapshot::GetPropertyName(Js::PropertyId propertyId)
+{
+    uint index;
+    if (this->propertyNameIndices->TryGetValue(propertyId, &index))
+    {
+        return index;
+    }
+
+    Js::PropertyRecord const * propertyRecord = this->threadContext->GetPropertyName(propertyId);
+    index = this->GetString(propertyRecord->GetBuffer(), propertyRecord->GetLength());
+    this->propertyNameIndices->Add(propertyId, index);
+    return index;
+}
@@ -0,0 +1,87 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "ChakraCore.h"
+
+class JsrtRuntime;
+
+// Heap snapshot of a runtime. The script object graph is walked breadth first from the global
+// objects and the host's references while the recycler is set up for heap enumeration, so
+// nothing is collected under the walk. Nodes are recorded flat, with the edges of each node
+// right after the edges of the node before it, so the host can stream the .heapsnapshot JSON
+// from it without another copy of the graph.
+class JsrtHeapSnapshot : public JsHeapSnapshot
+{
+public:
+    static JsHeapSnapshot * Take(JsrtRuntime * runtime);
+    static void Release(JsHeapSnapshot * snapshot);
+
+private:
+    static const uint NoNode = (uint)-1;
+    static const uint MaxStringNameLength = 1024;
+
+    enum NodeKind : byte
+    {
+        NodeKind_Synthetic,
+        NodeKind_Object,
+        NodeKind_ScopeSlots
+    };
+
+    struct PendingNode
+    {
+        void * address;
+        NodeKind kind;
+    };
+
+    typedef JsUtil::List<PendingNode, HeapAllocator> PendingNodeList;
+    typedef JsUtil::BaseDictionary<void *, uint, HeapAllocator> NodeIndexMap;
+    typedef JsUtil::BaseDictionary<const char16 *, uint, HeapAllocator> StringIndexMap;
+    typedef JsUtil::BaseDictionary<Js::PropertyId, uint, HeapAllocator> PropertyNameIndexMap;
+    typedef JsUtil::List<Js::JavascriptLibrary *, HeapAllocator> LibraryList;
+
+    JsrtHeapSnapshot(ThreadContext * threadContext);
+    ~JsrtHeapSnapshot();
+
+    void Walk(JsrtRuntime * runtime);
+    void Seal();
+
+    uint AddNode(JsHeapSnapshotNodeType type, uint name, size_t selfSize, void * address, NodeKind kind);
+    uint GetNode(Js::Var value);
+    uint GetScopeSlotsNode(Js::Var * slotArray);
+    void AddEdge(JsHeapSnapshotEdgeType type, uint nameOrIndex, uint toNode);
+    bool AddEdge(JsHeapSnapshotEdgeType type, uint nameOrIndex, Js::Var value);
+
+    void AddObjectEdges(Js::RecyclableObject * object);
+    void AddPropertyEdges(Js::DynamicObject * object);
+    void AddElementEdges(Js::JavascriptArray * array);
+    void AddFunctionEdges(Js::JavascriptFunction * function);
+    void AddScopeSlotsEdges(Js::Var * slotArray);
+
+    void DescribeObject(Js::RecyclableObject * object, JsHeapSnapshotNodeType * type, uint * name, size_t * selfSize);
+    const char16 * GetConstructorName(Js::RecyclableObject * object);
+    const char16 * GetFunctionName(Js::JavascriptFunction * function);
+    static const char16 * GetTypeName(Js::TypeId typeId);
+    bool IsRecyclableObject(void * candidate);
+    size_t GetAllocationSize(void * address);
+
+    uint GetString(const char16 * str);
+    uint GetString(const char16 * str, charcount_t length);
+    uint GetPropertyName(Js::PropertyId propertyId);
+
+    ThreadContext * threadContext;
+    Recycler * recycler;
+
+    JsUtil::List<JsHeapSnapshotNode, HeapAllocator> nodeList;
+    JsUtil::List<JsHeapSnapshotEdge, HeapAllocator> edgeList;
+    JsUtil::List<const char *, HeapAllocator> stringList;
+
+    // Only needed while walking, released before the snapshot is handed to the host
+    PendingNodeList * pendingNodes;
+    NodeIndexMap * nodeIndices;
+    StringIndexMap * stringIndices;
+    PropertyNameIndexMap * propertyNameIndices;
+    LibraryList * libraries;
+};
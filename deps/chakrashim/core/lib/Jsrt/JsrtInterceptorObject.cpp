@@ -0,0 +1,599 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "JsrtPch.h"
+#include "jsrtHelper.h"
+#include "JsrtInterceptorObject.h"
+
+// Internal fields are laid out right after the object, so this type must not add any fields
+CompileAssert(sizeof(JsrtInterceptorObject) == sizeof(JsrtExternalObject));
+
+JsrtInterceptorObject::JsrtInterceptorObject(JsrtExternalType * type, void *data, uint internalFieldCount) :
+    JsrtExternalObject(type, data, internalFieldCount)
+{
+    Assert(type->GetInterceptors() != nullptr);
+    Assert(type->CanHaveInterceptors());
+}
+
+/* static */
+JsrtInterceptorObject* JsrtInterceptorObject::Create(void *data, JsFinalizeCallback finalizeCallback, const JsPropertyInterceptors *interceptors,
+    uint internalFieldCount, Js::ScriptContext *scriptContext)
+{
+    // Hosts keep one JsPropertyInterceptors per template, so its address is a good cache key. The
+    // finalizer and contents are checked too, as the address can be reused once the host frees it.
+    uintptr_t typeKey = reinterpret_cast<uintptr_t>(interceptors);
+    Js::DynamicType * dynamicType = scriptContext->GetLibrary()->GetCachedJsrtExternalType(typeKey);
+
+    if (dynamicType == nullptr ||
+        !static_cast<JsrtExternalType*>(dynamicType)->HasSameInterceptors(finalizeCallback, interceptors))
+    {
+        dynamicType = RecyclerNew(scriptContext->GetRecycler(), JsrtExternalType, scriptContext, finalizeCallback, interceptors);
+        scriptContext->GetLibrary()->CacheJsrtExternalType(typeKey, dynamicType);
+    }
+
+    Assert(dynamicType->IsJsrtExternal());
+    Assert(dynamicType->GetIsShared());
+
+    if (internalFieldCount == 0)
+    {
+        return RecyclerNewFinalized(scriptContext->GetRecycler(), JsrtInterceptorObject, static_cast<JsrtExternalType*>(dynamicType), data, 0);
+    }
+
+    size_t fieldsSize = UInt32Math::Mul<sizeof(void *)>(internalFieldCount);
+    return RecyclerNewFinalizedPlus(scriptContext->GetRecycler(), fieldsSize, JsrtInterceptorObject,
+        static_cast<JsrtExternalType*>(dynamicType), data, internalFieldCount);
+}
+
+bool JsrtInterceptorObject::Is(Js::Var value)
+{
+    if (Js::TaggedNumber::Is(value))
+    {
+        return false;
+    }
+
+    return (VirtualTableInfo<JsrtInterceptorObject>::HasVirtualTable(value)) ||
+        (VirtualTableInfo<Js::CrossSiteObject<JsrtInterceptorObject>>::HasVirtualTable(value));
+}
+
+JsrtInterceptorObject * JsrtInterceptorObject::FromVar(Js::Var value)
+{
+    Assert(Is(value));
+    return static_cast<JsrtInterceptorObject *>(value);
+}
+
+bool JsrtInterceptorObject::HasNamedInterceptors() const
+{
+    const JsPropertyInterceptors * interceptors = this->GetInterceptors();
+    return interceptors->namedGetter != nullptr || interceptors->namedSetter != nullptr ||
+        interceptors->namedQuery != nullptr || interceptors->namedDeleter != nullptr;
+}
+
+bool JsrtInterceptorObject::HasIndexedInterceptors() const
+{
+    const JsPropertyInterceptors * interceptors = this->GetInterceptors();
+    return interceptors->indexedGetter != nullptr || interceptors->indexedSetter != nullptr ||
+        interceptors->indexedQuery != nullptr || interceptors->indexedDeleter != nullptr;
+}
+
+bool JsrtInterceptorObject::IsInterceptedProperty(Js::PropertyRecord const * propertyRecord, uint32 * index) const
+{
+    if (propertyRecord->IsNumeric())
+    {
+        *index = propertyRecord->GetNumericValue();
+        return this->HasIndexedInterceptors();
+    }
+
+    *index = Js::JavascriptArray::InvalidIndex;
+    return this->HasNamedInterceptors();
+}
+
+Js::PropertyRecord const * JsrtInterceptorObject::GetPropertyRecord(Js::JavascriptString * propertyNameString)
+{
+    Js::PropertyRecord const * propertyRecord;
+    this->GetScriptContext()->GetOrAddPropertyRecord(propertyNameString->GetString(), propertyNameString->GetLength(), &propertyRecord);
+    return propertyRecord;
+}
+
+Js::Var JsrtInterceptorObject::GetPropertyName(Js::PropertyRecord const * propertyRecord)
+{
+    Js::ScriptContext * scriptContext = this->GetScriptContext();
+    if (propertyRecord->IsSymbol())
+    {
+        return scriptContext->GetLibrary()->CreateSymbol(propertyRecord);
+    }
+    return scriptContext->GetPropertyString(propertyRecord->GetPropertyId());
+}
+
+template <class Fn>
+bool JsrtInterceptorObject::CallInterceptor(Fn interceptor)
+{
+    Js::ScriptContext * scriptContext = this->GetScriptContext();
+    ThreadContext * threadContext = scriptContext->GetThreadContext();
+
+    // The interceptor is host code, so treat it like any other implicit call
+    if (threadContext->IsDisableImplicitCall())
+    {
+        threadContext->AddImplicitCallFlags(Js::ImplicitCall_External);
+        return false;
+    }
+
+    bool intercepted = false;
+    Js::ImplicitCallFlags savedImplicitCallFlags = threadContext->GetImplicitCallFlags();
+
+    BEGIN_INTERCEPTOR(scriptContext)
+    {
+        intercepted = interceptor();
+    }
+    END_INTERCEPTOR(scriptContext);
+
+    threadContext->SetImplicitCallFlags((Js::ImplicitCallFlags)(savedImplicitCallFlags | Js::ImplicitCall_External));
+    return intercepted;
+}
+
+bool JsrtInterceptorObject::InterceptGet(Js::PropertyRecord const * propertyRecord, uint32 index, Js::Var* value, Js::ScriptContext* requestContext)
+{
+    const JsPropertyInterceptors * interceptors = this->GetInterceptors();
+    JsValueRef result = JS_INVALID_REFERENCE;
+    bool intercepted;
+
+    if (index != Js::JavascriptArray::InvalidIndex)
+    {
+        if (interceptors->indexedGetter == nullptr)
+        {
+            return false;
+        }
+        intercepted = this->CallInterceptor([&]() { return interceptors->indexedGetter(this, index, &result); });
+    }
+    else
+    {
+        if (interceptors->namedGetter == nullptr)
+        {
+            return false;
+        }
+        Js::Var name = this->GetPropertyName(propertyRecord);
+        intercepted = this->CallInterceptor([&]() { return interceptors->namedGetter(this, name, &result); });
+    }
+
+    if (!intercepted)
+    {
+        return false;
+    }
+
+    *value = result == JS_INVALID_REFERENCE ?
+        requestContext->GetLibrary()->GetUndefined() :
+        Js::CrossSite::MarshalVar(requestContext, result);
+    return true;
+}
+
+bool JsrtInterceptorObject::InterceptSet(Js::PropertyRecord const * propertyRecord, uint32 index, Js::Var value)
+{
+    const JsPropertyInterceptors * interceptors = this->GetInterceptors();
+
+    if (index != Js::JavascriptArray::InvalidIndex)
+    {
+        return interceptors->indexedSetter != nullptr &&
+            this->CallInterceptor([&]() { return interceptors->indexedSetter(this, index, value); });
+    }
+
+    if (interceptors->namedSetter == nullptr)
+    {
+        return false;
+    }
+    Js::Var name = this->GetPropertyName(propertyRecord);
+    return this->CallInterceptor([&]() { return interceptors->namedSetter(this, name, value); });
+}
+
+bool JsrtInterceptorObject::InterceptQuery(Js::PropertyRecord const * propertyRecord, uint32 index, JsInterceptedPropertyAttributes* attributes)
+{
+    const JsPropertyInterceptors * interceptors = this->GetInterceptors();
+    *attributes = JsInterceptedPropertyAttributes_None;
+
+    if (index != Js::JavascriptArray::InvalidIndex)
+    {
+        if (interceptors->indexedQuery != nullptr &&
+            this->CallInterceptor([&]() { return interceptors->indexedQuery(this, index, attributes); }))
+        {
+            return true;
+        }
+    }
+    else if (interceptors->namedQuery != nullptr)
+    {
+        Js::Var name = this->GetPropertyName(propertyRecord);
+        if (this->CallInterceptor([&]() { return interceptors->namedQuery(this, name, attributes); }))
+        {
+            return true;
+        }
+    }
+
+    // Without a query interceptor, a property the getter produces is a plain data property
+    Js::Var value;
+    *attributes = JsInterceptedPropertyAttributes_None;
+    return this->InterceptGet(propertyRecord, index, &value, this->GetScriptContext());
+}
+
+bool JsrtInterceptorObject::InterceptDelete(Js::PropertyRecord const * propertyRecord, uint32 index, BOOL* result)
+{
+    const JsPropertyInterceptors * interceptors = this->GetInterceptors();
+    bool deleted = false;
+    bool intercepted;
+
+    if (index != Js::JavascriptArray::InvalidIndex)
+    {
+        if (interceptors->indexedDeleter == nullptr)
+        {
+            return false;
+        }
+        intercepted = this->CallInterceptor([&]() { return interceptors->indexedDeleter(this, index, &deleted); });
+    }
+    else
+    {
+        if (interceptors->namedDeleter == nullptr)
+        {
+            return false;
+        }
+        Js::Var name = this->GetPropertyName(propertyRecord);
+        intercepted = this->CallInterceptor([&]() { return interceptors->namedDeleter(this, name, &deleted); });
+    }
+
+    if (intercepted)
+    {
+        *result = deleted;
+    }
+    return intercepted;
+}
+
+void JsrtInterceptorObject::DisableCaches(Js::PropertyValueInfo* info, Js::RecyclableObject* instance)
+{
+    // The interceptors can produce a different answer on every lookup. The type handler has
+    // already filled in info by now, so this has to come after it.
+    Js::PropertyValueInfo::SetNoCache(info, instance);
+    Js::PropertyValueInfo::DisablePrototypeCache(info, instance);
+}
+
+BOOL JsrtInterceptorObject::HasProperty(Js::PropertyId propertyId)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    JsInterceptedPropertyAttributes attributes;
+    uint32 index;
+
+    if (this->IsInterceptedProperty(propertyRecord, &index) && this->InterceptQuery(propertyRecord, index, &attributes))
+    {
+        return TRUE;
+    }
+    return __super::HasProperty(propertyId);
+}
+
+BOOL JsrtInterceptorObject::HasOwnProperty(Js::PropertyId propertyId)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    JsInterceptedPropertyAttributes attributes;
+    uint32 index;
+
+    if (this->IsInterceptedProperty(propertyRecord, &index) && this->InterceptQuery(propertyRecord, index, &attributes))
+    {
+        return TRUE;
+    }
+    return __super::HasOwnProperty(propertyId);
+}
+
+BOOL JsrtInterceptorObject::GetProperty(Js::Var originalInstance, Js::PropertyId propertyId, Js::Var* value, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    uint32 index;
+
+    if (!this->IsInterceptedProperty(propertyRecord, &index))
+    {
+        return __super::GetProperty(originalInstance, propertyId, value, info, requestContext);
+    }
+
+    BOOL found = this->InterceptGet(propertyRecord, index, value, requestContext) ||
+        __super::GetProperty(originalInstance, propertyId, value, info, requestContext);
+    DisableCaches(info, this);
+    return found;
+}
+
+BOOL JsrtInterceptorObject::GetProperty(Js::Var originalInstance, Js::JavascriptString* propertyNameString, Js::Var* value, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext)
+{
+    if (!this->HasNamedInterceptors() && !this->HasIndexedInterceptors())
+    {
+        return __super::GetProperty(originalInstance, propertyNameString, value, info, requestContext);
+    }
+
+    Js::PropertyRecord const * propertyRecord = this->GetPropertyRecord(propertyNameString);
+    return this->GetProperty(originalInstance, propertyRecord->GetPropertyId(), value, info, requestContext);
+}
+
+BOOL JsrtInterceptorObject::GetPropertyReference(Js::Var originalInstance, Js::PropertyId propertyId, Js::Var* value, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    uint32 index;
+
+    if (!this->IsInterceptedProperty(propertyRecord, &index))
+    {
+        return __super::GetPropertyReference(originalInstance, propertyId, value, info, requestContext);
+    }
+
+    BOOL found = this->InterceptGet(propertyRecord, index, value, requestContext) ||
+        __super::GetPropertyReference(originalInstance, propertyId, value, info, requestContext);
+    DisableCaches(info, this);
+    return found;
+}
+
+BOOL JsrtInterceptorObject::SetProperty(Js::PropertyId propertyId, Js::Var value, Js::PropertyOperationFlags flags, Js::PropertyValueInfo* info)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    uint32 index;
+
+    if (!this->IsInterceptedProperty(propertyRecord, &index))
+    {
+        return __super::SetProperty(propertyId, value, flags, info);
+    }
+
+    BOOL result = this->InterceptSet(propertyRecord, index, value) ||
+        __super::SetProperty(propertyId, value, flags, info);
+    DisableCaches(info, this);
+    return result;
+}
+
+BOOL JsrtInterceptorObject::SetProperty(Js::JavascriptString* propertyNameString, Js::Var value, Js::PropertyOperationFlags flags, Js::PropertyValueInfo* info)
+{
+    if (!this->HasNamedInterceptors() && !this->HasIndexedInterceptors())
+    {
+        return __super::SetProperty(propertyNameString, value, flags, info);
+    }
+
+    Js::PropertyRecord const * propertyRecord = this->GetPropertyRecord(propertyNameString);
+    return this->SetProperty(propertyRecord->GetPropertyId(), value, flags, info);
+}
+
+Js::DescriptorFlags JsrtInterceptorObject::GetSetter(Js::PropertyId propertyId, Js::Var *setterValue, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    uint32 index;
+
+    if (!this->IsInterceptedProperty(propertyRecord, &index))
+    {
+        return __super::GetSetter(propertyId, setterValue, info, requestContext);
+    }
+
+    // Stores through the prototype chain go to the receiver, so only keep them out of the caches
+    Js::DescriptorFlags descriptorFlags = __super::GetSetter(propertyId, setterValue, info, requestContext);
+    DisableCaches(info, this);
+    return descriptorFlags;
+}
+
+Js::DescriptorFlags JsrtInterceptorObject::GetSetter(Js::JavascriptString* propertyNameString, Js::Var *setterValue, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext)
+{
+    if (!this->HasNamedInterceptors() && !this->HasIndexedInterceptors())
+    {
+        return __super::GetSetter(propertyNameString, setterValue, info, requestContext);
+    }
+
+    Js::PropertyRecord const * propertyRecord = this->GetPropertyRecord(propertyNameString);
+    return this->GetSetter(propertyRecord->GetPropertyId(), setterValue, info, requestContext);
+}
+
+BOOL JsrtInterceptorObject::DeleteProperty(Js::PropertyId propertyId, Js::PropertyOperationFlags flags)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    uint32 index;
+    BOOL result;
+
+    if (this->IsInterceptedProperty(propertyRecord, &index) && this->InterceptDelete(propertyRecord, index, &result))
+    {
+        return result;
+    }
+    return __super::DeleteProperty(propertyId, flags);
+}
+
+BOOL JsrtInterceptorObject::DeleteProperty(Js::JavascriptString *propertyNameString, Js::PropertyOperationFlags flags)
+{
+    if (!this->HasNamedInterceptors() && !this->HasIndexedInterceptors())
+    {
+        return __super::DeleteProperty(propertyNameString, flags);
+    }
+
+    Js::PropertyRecord const * propertyRecord = this->GetPropertyRecord(propertyNameString);
+    return this->DeleteProperty(propertyRecord->GetPropertyId(), flags);
+}
+
+BOOL JsrtInterceptorObject::HasItem(uint32 index)
+{
+    JsInterceptedPropertyAttributes attributes;
+    if (this->HasIndexedInterceptors() && this->InterceptQuery(nullptr, index, &attributes))
+    {
+        return TRUE;
+    }
+    return __super::HasItem(index);
+}
+
+BOOL JsrtInterceptorObject::HasOwnItem(uint32 index)
+{
+    JsInterceptedPropertyAttributes attributes;
+    if (this->HasIndexedInterceptors() && this->InterceptQuery(nullptr, index, &attributes))
+    {
+        return TRUE;
+    }
+    return __super::HasOwnItem(index);
+}
+
+BOOL JsrtInterceptorObject::GetItem(Js::Var originalInstance, uint32 index, Js::Var* value, Js::ScriptContext * requestContext)
+{
+    if (this->HasIndexedInterceptors() && this->InterceptGet(nullptr, index, value, requestContext))
+    {
+        return TRUE;
+    }
+    return __super::GetItem(originalInstance, index, value, requestContext);
+}
+
+BOOL JsrtInterceptorObject::GetItemReference(Js::Var originalInstance, uint32 index, Js::Var* value, Js::ScriptContext * requestContext)
+{
+    if (this->HasIndexedInterceptors() && this->InterceptGet(nullptr, index, value, requestContext))
+    {
+        return TRUE;
+    }
+    return __super::GetItemReference(originalInstance, index, value, requestContext);
+}
+
+BOOL JsrtInterceptorObject::SetItem(uint32 index, Js::Var value, Js::PropertyOperationFlags flags)
+{
+    if (this->HasIndexedInterceptors() && this->InterceptSet(nullptr, index, value))
+    {
+        return TRUE;
+    }
+    return __super::SetItem(index, value, flags);
+}
+
+BOOL JsrtInterceptorObject::DeleteItem(uint32 index, Js::PropertyOperationFlags flags)
+{
+    BOOL result;
+    if (this->HasIndexedInterceptors() && this->InterceptDelete(nullptr, index, &result))
+    {
+        return result;
+    }
+    return __super::DeleteItem(index, flags);
+}
+
+BOOL JsrtInterceptorObject::GetEnumerator(Js::JavascriptStaticEnumerator * enumerator, Js::EnumeratorFlags flags, Js::ScriptContext * requestContext, Js::ForInCache * forInCache)
+{
+    const JsPropertyInterceptors * interceptors = this->GetInterceptors();
+    if (interceptors->indexedEnumerator == nullptr && interceptors->namedEnumerator == nullptr)
+    {
+        return __super::GetEnumerator(enumerator, flags, requestContext, forInCache);
+    }
+
+    ThreadContext * threadContext = requestContext->GetThreadContext();
+    if (threadContext->IsDisableImplicitCall())
+    {
+        threadContext->AddImplicitCallFlags(Js::ImplicitCall_External);
+        return FALSE;
+    }
+
+    auto getKeys = [&](JsNamedPropertyEnumeratorCallback keysEnumerator) -> Js::JavascriptArray *
+    {
+        JsValueRef keys = JS_INVALID_REFERENCE;
+        if (keysEnumerator != nullptr)
+        {
+            this->CallInterceptor([&]() { keys = keysEnumerator(this); return true; });
+        }
+        return keys != JS_INVALID_REFERENCE && Js::JavascriptArray::Is(keys) ? Js::JavascriptArray::FromVar(keys) : nullptr;
+    };
+
+    Js::JavascriptArray * indexedKeys = getKeys(interceptors->indexedEnumerator);
+    Js::JavascriptArray * namedKeys = getKeys(interceptors->namedEnumerator);
+
+    return GetEnumeratorWithPrefix(
+        RecyclerNew(requestContext->GetRecycler(), JsrtInterceptorEnumerator, indexedKeys, namedKeys, flags, requestContext),
+        enumerator, flags, requestContext, forInCache);
+}
+
+BOOL JsrtInterceptorObject::IsWritable(Js::PropertyId propertyId)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    JsInterceptedPropertyAttributes attributes;
+    uint32 index;
+
+    if (this->IsInterceptedProperty(propertyRecord, &index) && this->InterceptQuery(propertyRecord, index, &attributes))
+    {
+        return (attributes & JsInterceptedPropertyAttributes_ReadOnly) == 0;
+    }
+    return __super::IsWritable(propertyId);
+}
+
+BOOL JsrtInterceptorObject::IsConfigurable(Js::PropertyId propertyId)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    JsInterceptedPropertyAttributes attributes;
+    uint32 index;
+
+    if (this->IsInterceptedProperty(propertyRecord, &index) && this->InterceptQuery(propertyRecord, index, &attributes))
+    {
+        return (attributes & JsInterceptedPropertyAttributes_DontDelete) == 0;
+    }
+    return __super::IsConfigurable(propertyId);
+}
+
+BOOL JsrtInterceptorObject::IsEnumerable(Js::PropertyId propertyId)
+{
+    Js::PropertyRecord const * propertyRecord = this->GetScriptContext()->GetPropertyName(propertyId);
+    JsInterceptedPropertyAttributes attributes;
+    uint32 index;
+
+    if (this->IsInterceptedProperty(propertyRecord, &index) && this->InterceptQuery(propertyRecord, index, &attributes))
+    {
+        return (attributes & JsInterceptedPropertyAttributes_DontEnum) == 0;
+    }
+    return __super::IsEnumerable(propertyId);
+}
+
+BOOL JsrtInterceptorObject::StrictEquals(__in Js::Var other, __out BOOL* value, Js::ScriptContext* requestContext)
+{
+    // Objects that can have interceptors are compared here rather than inline
+    *value = (this == other);
+    return TRUE;
+}
+
+JsrtInterceptorEnumerator::JsrtInterceptorEnumerator(Js::JavascriptArray * indexedKeys, Js::JavascriptArray * namedKeys,
+    Js::EnumeratorFlags flags, Js::ScriptContext * scriptContext) :
+    Js::JavascriptEnumerator(scriptContext),
+    indexedKeys(indexedKeys),
+    namedKeys(namedKeys),
+    flags(flags),
+    index(0),
+    enumeratingNamedKeys(false)
+{
+}
+
+void JsrtInterceptorEnumerator::Reset()
+{
+    this->index = 0;
+    this->enumeratingNamedKeys = false;
+}
+
+Js::Var JsrtInterceptorEnumerator::MoveAndGetNext(Js::PropertyId& propertyId, Js::PropertyAttributes* attributes)
+{
+    Js::ScriptContext * scriptContext = this->GetScriptContext();
+    propertyId = Js::Constants::NoProperty;
+
+    while (true)
+    {
+        Js::JavascriptArray * keys = this->enumeratingNamedKeys ? this->namedKeys : this->indexedKeys;
+        if (keys == nullptr || this->index >= keys->GetLength())
+        {
+            if (this->enumeratingNamedKeys)
+            {
+                return nullptr;
+            }
+            this->enumeratingNamedKeys = true;
+            this->index = 0;
+            continue;
+        }
+
+        Js::Var key;
+        if (!Js::JavascriptOperators::GetItem(keys, this->index++, &key, scriptContext))
+        {
+            continue;
+        }
+
+        if (Js::JavascriptSymbol::Is(key))
+        {
+            if (!(this->flags & Js::EnumeratorFlags::EnumSymbols))
+            {
+                continue;
+            }
+            propertyId = Js::JavascriptSymbol::FromVar(key)->GetValue()->GetPropertyId();
+        }
+        else
+        {
+            // Property records for string keys are created by the consumer if it needs them
+            key = Js::JavascriptConversion::ToString(key, scriptContext);
+        }
+
+        if (attributes != nullptr)
+        {
+            *attributes = PropertyEnumerable;
+        }
+        return key;
+    }
+}
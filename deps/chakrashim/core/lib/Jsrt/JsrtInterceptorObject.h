@@ -0,0 +1,96 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "JsrtExternalObject.h"
+
+// External object whose property accesses are intercepted by host callbacks. The interceptors are
+// kept on the JsrtExternalType, so objects created with the same interceptors share a type.
+//
+// Every lookup of a kind (named or indexed) that has interceptors calls them before the type
+// handler, and falls through to the ordinary DynamicObject lookup when they decline. Inline caches
+// and prototype caches are disabled for those lookups only; lookups of the other kind are cached
+// as they are for any other object.
+class JsrtInterceptorObject : public JsrtExternalObject
+{
+protected:
+    DEFINE_VTABLE_CTOR(JsrtInterceptorObject, JsrtExternalObject);
+    DEFINE_MARSHAL_OBJECT_TO_SCRIPT_CONTEXT(JsrtInterceptorObject);
+
+public:
+    JsrtInterceptorObject(JsrtExternalType * type, void *data, uint internalFieldCount);
+
+    static bool Is(Js::Var value);
+    static JsrtInterceptorObject * FromVar(Js::Var value);
+    static JsrtInterceptorObject * Create(void *data, JsFinalizeCallback finalizeCallback, const JsPropertyInterceptors *interceptors,
+        uint internalFieldCount, Js::ScriptContext *scriptContext);
+
+    virtual BOOL HasProperty(Js::PropertyId propertyId) override;
+    virtual BOOL HasOwnProperty(Js::PropertyId propertyId) override;
+    virtual BOOL GetProperty(Js::Var originalInstance, Js::PropertyId propertyId, Js::Var* value, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext) override;
+    virtual BOOL GetProperty(Js::Var originalInstance, Js::JavascriptString* propertyNameString, Js::Var* value, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext) override;
+    virtual BOOL GetPropertyReference(Js::Var originalInstance, Js::PropertyId propertyId, Js::Var* value, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext) override;
+    virtual BOOL SetProperty(Js::PropertyId propertyId, Js::Var value, Js::PropertyOperationFlags flags, Js::PropertyValueInfo* info) override;
+    virtual BOOL SetProperty(Js::JavascriptString* propertyNameString, Js::Var value, Js::PropertyOperationFlags flags, Js::PropertyValueInfo* info) override;
+    virtual Js::DescriptorFlags GetSetter(Js::PropertyId propertyId, Js::Var *setterValue, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext) override;
+    virtual Js::DescriptorFlags GetSetter(Js::JavascriptString* propertyNameString, Js::Var *setterValue, Js::PropertyValueInfo* info, Js::ScriptContext* requestContext) override;
+    virtual BOOL DeleteProperty(Js::PropertyId propertyId, Js::PropertyOperationFlags flags) override;
+    virtual BOOL DeleteProperty(Js::JavascriptString *propertyNameString, Js::PropertyOperationFlags flags) override;
+    virtual BOOL HasItem(uint32 index) override;
+    virtual BOOL HasOwnItem(uint32 index) override;
+    virtual BOOL GetItem(Js::Var originalInstance, uint32 index, Js::Var* value, Js::ScriptContext * requestContext) override;
+    virtual BOOL GetItemReference(Js::Var originalInstance, uint32 index, Js::Var* value, Js::ScriptContext * requestContext) override;
+    virtual BOOL SetItem(uint32 index, Js::Var value, Js::PropertyOperationFlags flags) override;
+    virtual BOOL DeleteItem(uint32 index, Js::PropertyOperationFlags flags) override;
+    virtual BOOL GetEnumerator(Js::JavascriptStaticEnumerator * enumerator, Js::EnumeratorFlags flags, Js::ScriptContext * requestContext, Js::ForInCache * forInCache = nullptr) override;
+    virtual BOOL IsWritable(Js::PropertyId propertyId) override;
+    virtual BOOL IsConfigurable(Js::PropertyId propertyId) override;
+    virtual BOOL IsEnumerable(Js::PropertyId propertyId) override;
+    virtual BOOL StrictEquals(__in Js::Var other, __out BOOL* value, Js::ScriptContext* requestContext) override;
+
+#if DBG
+    virtual BOOL DbgCanHaveInterceptors() const override { return true; }
+#endif
+
+private:
+    const JsPropertyInterceptors * GetInterceptors() const { return this->GetExternalType()->GetInterceptors(); }
+    bool HasNamedInterceptors() const;
+    bool HasIndexedInterceptors() const;
+    bool IsInterceptedProperty(Js::PropertyRecord const * propertyRecord, uint32 * index) const;
+    Js::PropertyRecord const * GetPropertyRecord(Js::JavascriptString * propertyNameString);
+
+    template <class Fn> bool CallInterceptor(Fn interceptor);
+
+    // Indexed interceptors are called when index is not JavascriptArray::InvalidIndex, named
+    // interceptors with the property record otherwise
+    bool InterceptGet(Js::PropertyRecord const * propertyRecord, uint32 index, Js::Var* value, Js::ScriptContext* requestContext);
+    bool InterceptSet(Js::PropertyRecord const * propertyRecord, uint32 index, Js::Var value);
+    bool InterceptQuery(Js::PropertyRecord const * propertyRecord, uint32 index, JsInterceptedPropertyAttributes* attributes);
+    bool InterceptDelete(Js::PropertyRecord const * propertyRecord, uint32 index, BOOL* result);
+    Js::Var GetPropertyName(Js::PropertyRecord const * propertyRecord);
+
+    static void DisableCaches(Js::PropertyValueInfo* info, Js::RecyclableObject* instance);
+};
+AUTO_REGISTER_RECYCLER_OBJECT_DUMPER(JsrtInterceptorObject, &Js::RecyclableObject::DumpObjectFunction);
+
+// Enumerates the keys returned by the enumerator interceptors, ahead of the object's own properties
+class JsrtInterceptorEnumerator sealed : public Js::JavascriptEnumerator
+{
+protected:
+    DEFINE_VTABLE_CTOR(JsrtInterceptorEnumerator, Js::JavascriptEnumerator);
+
+public:
+    JsrtInterceptorEnumerator(Js::JavascriptArray * indexedKeys, Js::JavascriptArray * namedKeys, Js::EnumeratorFlags flags, Js::ScriptContext * scriptContext);
+
+    virtual void Reset() override;
+    virtual Js::Var MoveAndGetNext(Js::PropertyId& propertyId, Js::PropertyAttributes* attributes = nullptr) override;
+
+private:
+    Field(Js::JavascriptArray *) indexedKeys;
+    Field(Js::JavascriptArray *) namedKeys;
+    Field(Js::EnumeratorFlags) flags;
+    Field(uint32) index;
+    Field(bool) enumeratingNamedKeys;
+};
@@ -0,0 +1,376 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "JsrtPch.h"
+#include "JsrtProfiler.h"
+#include "Language/JavascriptStackWalker.h"
+
+namespace
+{
+    // The profile handed out to the host, owning the arrays and strings it points to
+    class JsrtProfile : public JsProfile
+    {
+    public:
+        JsrtProfile() : strings(nullptr), stringsLength(0)
+        {
+            memset(static_cast<JsProfile *>(this), 0, sizeof(JsProfile));
+        }
+
+        ~JsrtProfile()
+        {
+            if (this->nodes != nullptr)
+            {
+                HeapDeleteArray(this->nodeCount, this->nodes);
+            }
+            if (this->samples != nullptr)
+            {
+                HeapDeleteArray(this->sampleCount, this->samples);
+            }
+            if (this->timestamps != nullptr)
+            {
+                HeapDeleteArray(this->sampleCount, this->timestamps);
+            }
+            if (this->strings != nullptr)
+            {
+                HeapDeleteArray(this->stringsLength, this->strings);
+            }
+        }
+
+        char * strings;
+        size_t stringsLength;
+    };
+
+    const char16 * const syntheticFunctionNames[] = { _u("(root)"), _u("(program)"), _u("(idle)") };
+
+    size_t GetUtf8Length(const char16 * str)
+    {
+        return utf8::CountTrueUtf8(str, (charcount_t)wcslen(str)) + 1;
+    }
+
+    const char * CopyUtf8(const char16 * str, char ** buffer, size_t * bufferLength)
+    {
+        char * result = *buffer;
+        charcount_t consumed;
+        size_t length = utf8::EncodeTrueUtf8IntoBounded((LPUTF8)result, *bufferLength,
+            str, (charcount_t)wcslen(str), &consumed, true);
+        Assert(length < *bufferLength);
+        result[length] = '\0';
+        *buffer += length + 1;
+        *bufferLength -= length + 1;
+        return result;
+    }
+}
+
+JsrtProfiler::JsrtProfiler(ThreadContext * threadContext) :
+    threadContext(threadContext),
+    isProfiling(false),
+    startTimeMicroseconds(0),
+    nodes(&HeapAllocator::Instance),
+    children(&HeapAllocator::Instance),
+    functions(&HeapAllocator::Instance),
+    functionIds(&HeapAllocator::Instance),
+    samples(&HeapAllocator::Instance),
+    timestamps(&HeapAllocator::Instance)
+{
+}
+
+JsrtProfiler::~JsrtProfiler()
+{
+    // A runtime disposed while profiling takes the pinned function bodies down with its recycler
+}
+
+void JsrtProfiler::Start()
+{
+    Assert(!this->isProfiling);
+    this->Reset();
+
+    for (uint i = 0; i < SyntheticFunctionCount; i++)
+    {
+        this->functions.Add(nullptr);
+    }
+    Node root = { RootFunction, RootFunction, 0 };
+    this->nodes.Add(root);
+
+    this->startTimeMicroseconds = Js::Tick::Now().ToMicroseconds();
+    this->threadContext->SetStackSampleCallback(&JsrtProfiler::StackSampleCallbackStatic, this);
+    this->isProfiling = true;
+}
+
+JsProfile * JsrtProfiler::Stop()
+{
+    Assert(this->isProfiling);
+    {
+        AutoCriticalSection autoCs(&this->csProfile);
+        this->isProfiling = false;
+    }
+    this->threadContext->SetStackSampleCallback(nullptr, nullptr);
+
+    JsProfile * profile = nullptr;
+    try
+    {
+        profile = this->CreateProfile();
+    }
+    catch (Js::OutOfMemoryException)
+    {
+        profile = nullptr;
+    }
+
+    this->Reset();
+    return profile;
+}
+
+void JsrtProfiler::Reset()
+{
+    this->ReleaseFunctions();
+    this->nodes.Clear();
+    this->children.Clear();
+    this->samples.Clear();
+    this->timestamps.Clear();
+}
+
+void JsrtProfiler::ReleaseFunctions()
+{
+    Recycler * recycler = this->threadContext->GetRecycler();
+    this->functions.Map([recycler](int index, Js::FunctionBody * body)
+    {
+        if (body != nullptr)
+        {
+            recycler->RootRelease(body);
+        }
+    });
+    this->functions.Clear();
+    this->functionIds.Clear();
+}
+
+void JsrtProfiler::RequestSample(bool idle)
+{
+    if (!this->isProfiling)
+    {
+        return;
+    }
+
+    // Stack samples are taken by the script thread itself. Outside of script there is no stack
+    // to walk, so the sample is recorded right away.
+    if (!idle && this->threadContext->RequestStackSample())
+    {
+        return;
+    }
+
+    uint function = idle ? IdleFunction : ProgramFunction;
+    this->AddSample(&function, 1);
+}
+
+void JsrtProfiler::StackSampleCallbackStatic(void * context, ThreadContext * threadContext, PVOID returnAddress)
+{
+    JsrtProfiler * profiler = static_cast<JsrtProfiler *>(context);
+    Assert(profiler->threadContext == threadContext);
+    profiler->TakeStackSample(returnAddress);
+}
+
+void JsrtProfiler::TakeStackSample(PVOID returnAddress)
+{
+    Js::ScriptEntryExitRecord * entryExitRecord = this->threadContext->GetScriptEntryExit();
+    if (!this->isProfiling || entryExitRecord == nullptr)
+    {
+        return;
+    }
+
+    Js::ScriptContext * scriptContext = entryExitRecord->scriptContext;
+    if (!Js::JavascriptStackWalker::IsWalkable(scriptContext))
+    {
+        return;
+    }
+
+    // Walk from the top of the stack, then record the functions from the bottom
+    Js::FunctionBody * stack[MaxSampleDepth];
+    uint depth = 0;
+    Js::JavascriptStackWalker walker(scriptContext, true, returnAddress);
+    Js::JavascriptFunction * function;
+    while (depth < MaxSampleDepth && walker.GetDisplayCaller(&function))
+    {
+        if (function->GetFunctionInfo()->HasBody())
+        {
+            stack[depth++] = function->GetFunctionBody();
+        }
+    }
+
+    uint sample[MaxSampleDepth + 1];
+    uint count = 0;
+    try
+    {
+        AutoCriticalSection autoCs(&this->csProfile);
+        if (!this->isProfiling)
+        {
+            return;
+        }
+
+        if (depth == 0)
+        {
+            sample[count++] = ProgramFunction;
+        }
+        while (depth > 0)
+        {
+            sample[count++] = this->GetFunction(stack[--depth]);
+        }
+    }
+    catch (Js::OutOfMemoryException)
+    {
+        return;
+    }
+
+    this->AddSample(sample, count);
+}
+
+uint JsrtProfiler::GetFunction(Js::FunctionBody * body)
+{
+    uint function;
+    if (!this->functionIds.TryGetValue(body, &function))
+    {
+        function = (uint)this->functions.Add(body);
+        this->functionIds.Add(body, function);
+        this->threadContext->GetRecycler()->RootAddRef(body);
+    }
+    return function;
+}
+
+uint JsrtProfiler::GetChild(uint parent, uint function)
+{
+    uint64 key = ((uint64)parent << 32) | function;
+    uint child;
+    if (!this->children.TryGetValue(key, &child))
+    {
+        Node node = { parent, function, 0 };
+        child = (uint)this->nodes.Add(node);
+        this->children.Add(key, child);
+    }
+    return child;
+}
+
+void JsrtProfiler::AddSample(uint const * functions, uint count)
+{
+    uint64 timestamp = Js::Tick::Now().ToMicroseconds();
+
+    try
+    {
+        AutoCriticalSection autoCs(&this->csProfile);
+        if (!this->isProfiling)
+        {
+            return;
+        }
+
+        uint node = 0;
+        for (uint i = 0; i < count; i++)
+        {
+            node = this->GetChild(node, functions[i]);
+        }
+
+        this->nodes.Item(node).hitCount++;
+        this->samples.Add(node);
+        this->timestamps.Add(timestamp);
+    }
+    catch (Js::OutOfMemoryException)
+    {
+        // Drop the sample
+    }
+}
+
+JsProfile * JsrtProfiler::CreateProfile()
+{
+    // Measure the UTF-8 names and urls of the functions first, so they fit in a single buffer
+    size_t stringsLength = 0;
+    for (int i = 0; i < this->functions.Count(); i++)
+    {
+        Js::FunctionBody * body = this->functions.Item(i);
+        if (body == nullptr)
+        {
+            stringsLength += GetUtf8Length(syntheticFunctionNames[i]) + GetUtf8Length(_u(""));
+        }
+        else
+        {
+            LPCWSTR url = body->GetSourceName();
+            stringsLength += GetUtf8Length(body->GetExternalDisplayName()) + GetUtf8Length(url != nullptr ? url : _u(""));
+        }
+    }
+
+    JsrtProfile * profile = HeapNew(JsrtProfile);
+    profile->stringsLength = stringsLength;
+    profile->strings = HeapNewNoThrowArray(char, stringsLength);
+    profile->nodeCount = this->nodes.Count();
+    profile->nodes = HeapNewNoThrowArray(JsProfileNode, profile->nodeCount);
+    profile->sampleCount = this->samples.Count();
+    profile->samples = HeapNewNoThrowArray(unsigned int, profile->sampleCount);
+    profile->timestamps = HeapNewNoThrowArray(unsigned long long, profile->sampleCount);
+    if (profile->strings == nullptr || profile->nodes == nullptr ||
+        (profile->sampleCount != 0 && (profile->samples == nullptr || profile->timestamps == nullptr)))
+    {
+        HeapDelete(profile);
+        return nullptr;
+    }
+
+    // Copy the strings of each function once, the nodes of a function share them
+    char * strings = profile->strings;
+    const char ** functionNames = HeapNewNoThrowArray(const char *, this->functions.Count() * 2);
+    if (functionNames == nullptr)
+    {
+        HeapDelete(profile);
+        return nullptr;
+    }
+    const char ** functionUrls = functionNames + this->functions.Count();
+    for (int i = 0; i < this->functions.Count(); i++)
+    {
+        Js::FunctionBody * body = this->functions.Item(i);
+        if (body == nullptr)
+        {
+            functionNames[i] = CopyUtf8(syntheticFunctionNames[i], &strings, &stringsLength);
+            functionUrls[i] = CopyUtf8(_u(""), &strings, &stringsLength);
+        }
+        else
+        {
+            LPCWSTR url = body->GetSourceName();
+            functionNames[i] = CopyUtf8(body->GetExternalDisplayName(), &strings, &stringsLength);
+            functionUrls[i] = CopyUtf8(url != nullptr ? url : _u(""), &strings, &stringsLength);
+        }
+    }
+
+    for (int i = 0; i < this->nodes.Count(); i++)
+    {
+        const Node& node = this->nodes.Item(i);
+        JsProfileNode * profileNode = &profile->nodes[i];
+        profileNode->id = i;
+        profileNode->parentId = node.parent;
+        profileNode->hitCount = node.hitCount;
+        profileNode->functionName = functionNames[node.function];
+        profileNode->url = functionUrls[node.function];
+
+        Js::FunctionBody * body = this->functions.Item(node.function);
+        if (body == nullptr)
+        {
+            profileNode->scriptId = 0;
+            profileNode->lineNumber = -1;
+            profileNode->columnNumber = -1;
+        }
+        else
+        {
+            profileNode->scriptId = body->GetUtf8SourceInfo()->GetSourceInfoId();
+            profileNode->lineNumber = (int)body->GetLineNumber();
+            profileNode->columnNumber = (int)body->GetColumnNumber();
+        }
+    }
+    HeapDeleteArray(this->functions.Count() * 2, functionNames);
+
+    for (int i = 0; i < this->samples.Count(); i++)
+    {
+        profile->samples[i] = this->samples.Item(i);
+        profile->timestamps[i] = this->timestamps.Item(i);
+    }
+
+    profile->startTime = this->startTimeMicroseconds;
+    profile->endTime = Js::Tick::Now().ToMicroseconds();
+    return profile;
+}
+
+void JsrtProfiler::ReleaseProfile(JsProfile * profile)
+{
+    HeapDelete(static_cast<JsrtProfile *>(profile));
+}
@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "ChakraCore.h"
+
+// Sampling CPU profiler for a runtime. Samples are requested from any thread with RequestSample;
+// stack samples are taken by the script thread itself at its next stack probe (see
+// ThreadContext::RequestStackSample) and folded into a call tree keyed by function body.
+class JsrtProfiler
+{
+public:
+    JsrtProfiler(ThreadContext * threadContext);
+    ~JsrtProfiler();
+
+    void Start();
+    JsProfile * Stop();
+    bool IsProfiling() const { return this->isProfiling; }
+
+    void RequestSample(bool idle);
+
+    static void ReleaseProfile(JsProfile * profile);
+
+private:
+    static const uint RootFunction = 0;
+    static const uint ProgramFunction = 1;
+    static const uint IdleFunction = 2;
+    static const uint SyntheticFunctionCount = 3;
+    static const uint MaxSampleDepth = 256;
+
+    struct Node
+    {
+        uint parent;
+        uint function;
+        uint hitCount;
+    };
+
+    static void StackSampleCallbackStatic(void * context, ThreadContext * threadContext, PVOID returnAddress);
+    void TakeStackSample(PVOID returnAddress);
+
+    uint GetFunction(Js::FunctionBody * body);
+    uint GetChild(uint parent, uint function);
+    void AddSample(uint const * functions, uint count);
+    void ReleaseFunctions();
+    void Reset();
+
+    JsProfile * CreateProfile();
+
+    ThreadContext * threadContext;
+    CriticalSection csProfile;
+    bool isProfiling;
+    uint64 startTimeMicroseconds;
+
+    // Index 0 is the root, its children are keyed with parent 0
+    JsUtil::List<Node, HeapAllocator> nodes;
+    JsUtil::BaseDictionary<uint64, uint, HeapAllocator> children;
+    // Function bodies are pinned with a root reference until the profile is stopped
+    JsUtil::List<Js::FunctionBody *, HeapAllocator> functions;
+    JsUtil::BaseDictionary<Js::FunctionBody *, uint, HeapAllocator> functionIds;
+    JsUtil::List<uint, HeapAllocator> samples;
+    JsUtil::List<uint64, HeapAllocator> timestamps;
+};
@@ -15,6 +15,11 @@ JsrtRuntime::JsrtRuntime(ThreadContext * threadContext, bool useIdle, bool dispa
     this->collectCallback = NULL;
     this->beforeCollectCallback = NULL;
     this->callbackContext = NULL;
+    this->garbageCollectionCollectCallback = NULL;
+    this->garbageCollectionCallback = NULL;
+    this->garbageCollectionCallbackContext = NULL;
+    memset(&this->garbageCollectionInfo, 0, sizeof(this->garbageCollectionInfo));
+    this->inGarbageCollection = false;
     this->allocationPolicyManager = threadContext->GetAllocationPolicyManager();
     this->useIdle = useIdle;
     this->dispatchExceptions = dispatchExceptions;
@@ -28,6 +33,7 @@ JsrtRuntime::JsrtRuntime(ThreadContext * threadContext, bool useIdle, bool dispa
     serializeByteCodeForLibrary = false;
 #endif
     this->jsrtDebugManager = nullptr;
+    this->profiler = nullptr;
 }
 
 JsrtRuntime::~JsrtRuntime()
@@ -38,6 +44,11 @@ JsrtRuntime::~JsrtRuntime()
         HeapDelete(this->jsrtDebugManager);
         this->jsrtDebugManager = nullptr;
     }
+    if (this->profiler != nullptr)
+    {
+        HeapDelete(this->profiler);
+        this->profiler = nullptr;
+    }
 }
 
 // This is called at process detach.
@@ -79,6 +90,88 @@ void JsrtRuntime::CloseContexts()
     }
 }
 
+Js::Var * JsrtRuntime::RootBlockList::Allocate(Recycler * recycler, size_t count)
+{
+    if (count > (SIZE_MAX - sizeof(ArenaMemoryBlock)) / sizeof(Js::Var))
+    {
+        return nullptr;
+    }
+
+    if (!this->isRegistered)
+    {
+        if (recycler->RegisterExternalGuestArena(this) == nullptr)
+        {
+            return nullptr;
+        }
+        this->isRegistered = true;
+    }
+
+    // Zeroed, so the whole block can be scanned without the host having to track what it uses
+    size_t nbytes = count * sizeof(Js::Var);
+    ArenaMemoryBlock * block = HeapNewNoThrowPlusZ(nbytes, ArenaMemoryBlock);
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+
+    block->nbytes = nbytes;
+    block->next = this->mallocBlocks;
+    this->mallocBlocks = block;
+    return reinterpret_cast<Js::Var *>(block->GetBytes());
+}
+
+bool JsrtRuntime::RootBlockList::Free(Js::Var * blockBytes)
+{
+    ArenaMemoryBlock ** prev = &this->mallocBlocks;
+    for (ArenaMemoryBlock * block = this->mallocBlocks; block != nullptr; block = block->next)
+    {
+        if (reinterpret_cast<Js::Var *>(block->GetBytes()) == blockBytes)
+        {
+            *prev = block->next;
+            HeapDeletePlus(block->nbytes, block);
+            return true;
+        }
+        prev = &block->next;
+    }
+
+    return false;
+}
+
+void JsrtRuntime::RootBlockList::FreeAll(Recycler * recycler)
+{
+    while (this->mallocBlocks != nullptr)
+    {
+        ArenaMemoryBlock * block = this->mallocBlocks;
+        this->mallocBlocks = block->next;
+        HeapDeletePlus(block->nbytes, block);
+    }
+
+    if (this->isRegistered)
+    {
+        recycler->UnregisterExternalGuestArena(this);
+        this->isRegistered = false;
+    }
+}
+
+Js::Var * JsrtRuntime::AllocateRootBlock(size_t count)
+{
+    return this->rootBlocks.Allocate(this->threadContext->EnsureRecycler(), count);
+}
+
+bool JsrtRuntime::FreeRootBlock(Js::Var * block)
+{
+    return this->rootBlocks.Free(block);
+}
+
+void JsrtRuntime::FreeRootBlocks()
+{
+    Recycler * recycler = this->threadContext->GetRecycler();
+    if (recycler != nullptr)
+    {
+        this->rootBlocks.FreeAll(recycler);
+    }
+}
+
 void JsrtRuntime::SetBeforeCollectCallback(JsBeforeCollectCallback beforeCollectCallback, void * callbackContext)
 {
     if (beforeCollectCallback != NULL)
@@ -121,11 +214,110 @@ void JsrtRuntime::RecyclerCollectCallbackStatic(void * context, RecyclerCollectC
     }
 }
 
+void JsrtRuntime::SetGarbageCollectionCallback(JsGarbageCollectionCallback garbageCollectionCallback, void * callbackContext)
+{
+    if (garbageCollectionCallback != NULL)
+    {
+        if (this->garbageCollectionCollectCallback == NULL)
+        {
+            this->garbageCollectionCollectCallback = this->threadContext->AddRecyclerCollectCallBack(GarbageCollectionCallbackStatic, this);
+        }
+
+        this->garbageCollectionCallback = garbageCollectionCallback;
+        this->garbageCollectionCallbackContext = callbackContext;
+    }
+    else
+    {
+        if (this->garbageCollectionCollectCallback != NULL)
+        {
+            this->threadContext->RemoveRecyclerCollectCallBack(this->garbageCollectionCollectCallback);
+            this->garbageCollectionCollectCallback = NULL;
+        }
+
+        this->garbageCollectionCallback = NULL;
+        this->garbageCollectionCallbackContext = NULL;
+        this->inGarbageCollection = false;
+    }
+}
+
+void JsrtRuntime::GarbageCollectionCallbackStatic(void * context, RecyclerCollectCallBackFlags flags)
+{
+    JsrtRuntime * _this = reinterpret_cast<JsrtRuntime *>(context);
+    Recycler * recycler = _this->threadContext->GetRecycler();
+    JsGarbageCollectionEvent event;
+
+    if (flags & Collect_Begin)
+    {
+        // A collection that is already in progress can be restarted, e.g. when a partial
+        // collection is turned into a full one. Only report the first begin.
+        if (_this->inGarbageCollection)
+        {
+            return;
+        }
+
+        int collectionFlags = JsGarbageCollectionFlags_None;
+        if ((flags & Collect_Begin_Partial) == Collect_Begin_Partial)
+        {
+            collectionFlags |= JsGarbageCollectionFlags_Partial;
+        }
+        if ((flags & Collect_Begin_Concurrent) == Collect_Begin_Concurrent)
+        {
+            collectionFlags |= JsGarbageCollectionFlags_Concurrent;
+        }
+        if (recycler->InExhaustiveCollection())
+        {
+            collectionFlags |= JsGarbageCollectionFlags_Exhaustive;
+        }
+
+        memset(&_this->garbageCollectionInfo, 0, sizeof(_this->garbageCollectionInfo));
+        _this->garbageCollectionInfo.flags = (JsGarbageCollectionFlags)collectionFlags;
+        _this->garbageCollectionInfo.usedBytesBefore = recycler->GetUsedBytes();
+        _this->garbageCollectionStart = Js::Tick::Now();
+        _this->inGarbageCollection = true;
+        event = JsGarbageCollectionEvent_Begin;
+    }
+    else if (flags & Collect_End)
+    {
+        if (!_this->inGarbageCollection)
+        {
+            return;
+        }
+
+        JsGarbageCollectionInfo * info = &_this->garbageCollectionInfo;
+        info->duration = (unsigned long long)(Js::Tick::Now() - _this->garbageCollectionStart).ToMicroseconds();
+        info->usedBytesAfter = recycler->GetUsedBytes();
+        info->freedBytes = info->usedBytesBefore > info->usedBytesAfter ?
+            info->usedBytesBefore - info->usedBytesAfter : 0;
+        _this->inGarbageCollection = false;
+        event = JsGarbageCollectionEvent_End;
+    }
+    else
+    {
+        // Collect_Wait can be called from the concurrent thread
+        return;
+    }
+
+    try
+    {
+        JsrtCallbackState scope(reinterpret_cast<ThreadContext*>(_this->GetThreadContext()));
+        _this->garbageCollectionCallback(event, &_this->garbageCollectionInfo, _this->garbageCollectionCallbackContext);
+    }
+    catch (...)
+    {
+        AssertMsg(false, "Unexpected non-engine exception.");
+    }
+}
+
 unsigned int JsrtRuntime::Idle()
 {
     return this->threadService.Idle();
 }
 
+bool JsrtRuntime::IdleNotification(unsigned int idleTicks)
+{
+    return this->threadService.IdleNotification(idleTicks);
+}
+
 void JsrtRuntime::EnsureJsrtDebugManager()
 {
     if (this->jsrtDebugManager == nullptr)
@@ -149,6 +341,15 @@ JsrtDebugManager * JsrtRuntime::GetJsrtDebugManager()
     return this->jsrtDebugManager;
 }
 
+JsrtProfiler * JsrtRuntime::EnsureProfiler()
+{
+    if (this->profiler == nullptr)
+    {
+        this->profiler = HeapNew(JsrtProfiler, this->threadContext);
+    }
+    return this->profiler;
+}
+
 #if ENABLE_TTD
 uint32 JsrtRuntime::BPRegister_TTD(int64 bpID, Js::ScriptContext* scriptContext, Js::Utf8SourceInfo* utf8SourceInfo, uint32 line, uint32 column, BOOL* isNewBP)
 {
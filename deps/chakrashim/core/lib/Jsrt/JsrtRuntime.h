@@ -7,6 +7,7 @@
 #include "ChakraCore.h"
 #include "JsrtThreadService.h"
 #include "JsrtDebugManager.h"
+#include "JsrtProfiler.h"
 
 class JsrtContext;
 
@@ -31,21 +32,32 @@ public:
 
     bool UseIdle() const { return useIdle; }
     unsigned int Idle();
+    bool IdleNotification(unsigned int idleTicks);
 
     bool DispatchExceptions() const { return dispatchExceptions; }
 
     void CloseContexts();
     void SetBeforeCollectCallback(JsBeforeCollectCallback beforeCollectCallback, void * callbackContext);
+    void SetGarbageCollectionCallback(JsGarbageCollectionCallback garbageCollectionCallback, void * callbackContext);
 
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     void SetSerializeByteCodeForLibrary(bool set) { serializeByteCodeForLibrary = set; }
     bool IsSerializeByteCodeForLibrary() const { return serializeByteCodeForLibrary; }
 #endif
 
+    Js::Var * AllocateRootBlock(size_t count);
+    bool FreeRootBlock(Js::Var * block);
+    void FreeRootBlocks();
+    template <class Fn>
+    void MapRootBlockValues(Fn fn) { this->rootBlocks.MapValues(fn); }
+
     void EnsureJsrtDebugManager();
     void DeleteJsrtDebugManager();
     JsrtDebugManager * GetJsrtDebugManager();
 
+    JsrtProfiler * EnsureProfiler();
+    JsrtProfiler * GetProfiler() const { return this->profiler; }
+
 #if ENABLE_TTD
     uint32 BPRegister_TTD(int64 bpID, Js::ScriptContext* scriptContext, Js::Utf8SourceInfo* utf8SourceInfo, uint32 line, uint32 column, BOOL* isNewBP);
     void BPDelete_TTD(uint32 bpID);
@@ -54,6 +66,38 @@ public:
 
 private:
     static void __cdecl RecyclerCollectCallbackStatic(void * context, RecyclerCollectCallBackFlags flags);
+    static void __cdecl GarbageCollectionCallbackStatic(void * context, RecyclerCollectCallBackFlags flags);
+
+    // Host owned blocks of references that are scanned as roots. The blocks live on the
+    // malloc block list so the recycler scans them like any other registered guest arena.
+    class RootBlockList : public ArenaData
+    {
+    public:
+        RootBlockList() : ArenaData(nullptr), isRegistered(false) {}
+
+        Js::Var * Allocate(Recycler * recycler, size_t count);
+        bool Free(Js::Var * block);
+        void FreeAll(Recycler * recycler);
+
+        template <class Fn>
+        void MapValues(Fn fn)
+        {
+            for (ArenaMemoryBlock * block = this->mallocBlocks; block != nullptr; block = block->next)
+            {
+                Js::Var * values = reinterpret_cast<Js::Var *>(block->GetBytes());
+                for (size_t i = 0; i < block->nbytes / sizeof(Js::Var); i++)
+                {
+                    if (values[i] != nullptr)
+                    {
+                        fn(values[i]);
+                    }
+                }
+            }
+        }
+
+    private:
+        bool isRegistered;
+    };
 
 private:
     ThreadContext * threadContext;
@@ -63,10 +107,19 @@ private:
     JsBeforeCollectCallback beforeCollectCallback;
     JsrtThreadService threadService;
     void * callbackContext;
+    ThreadContext::CollectCallBack * garbageCollectionCollectCallback;
+    JsGarbageCollectionCallback garbageCollectionCallback;
+    void * garbageCollectionCallbackContext;
+    // Statistics of the collection in progress, from its Collect_Begin to its Collect_End
+    JsGarbageCollectionInfo garbageCollectionInfo;
+    Js::Tick garbageCollectionStart;
+    bool inGarbageCollection;
     bool useIdle;
     bool dispatchExceptions;
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
     bool serializeByteCodeForLibrary;
 #endif
     JsrtDebugManager * jsrtDebugManager;
+    JsrtProfiler * profiler;
+    RootBlockList rootBlocks;
 };
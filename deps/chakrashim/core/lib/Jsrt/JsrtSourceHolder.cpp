@@ -253,7 +253,6 @@ namespace Js
 
         bool isExternalArray = Js::ExternalArrayBuffer::Is(scriptVal),
              isString = false;
-        bool isUtf8   = !(attributes & JsParseScriptAttributeArrayBufferIsUtf16Encoded);
 
         if (!isExternalArray)
         {
@@ -265,6 +264,9 @@ namespace Js
             }
         }
 
+        // JavascriptString is always Utf16
+        bool isUtf8 = !isString && !(attributes & JsParseScriptAttributeArrayBufferIsUtf16Encoded);
+
         const byte* script = isExternalArray ?
             ((Js::ExternalArrayBuffer*)(scriptVal))->GetBuffer() :
             (const byte*)((Js::JavascriptString*)(scriptVal))->GetSz();
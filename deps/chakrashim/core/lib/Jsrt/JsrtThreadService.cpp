@@ -37,6 +37,11 @@ unsigned int JsrtThreadService::Idle()
     return nextIdleTick;
 }
 
+bool JsrtThreadService::IdleNotification(unsigned int idleTicks)
+{
+    return IdleCollectUntil(GetTickCount() + idleTicks);
+}
+
 bool JsrtThreadService::OnScheduleIdleCollect(uint ticks, bool /* canScheduleAsTask */)
 {
     nextIdleTick = GetTickCount() + ticks;
@@ -14,6 +14,7 @@ public:
 
     bool Initialize(ThreadContext *threadContext);
     unsigned int Idle();
+    bool IdleNotification(unsigned int idleTicks);
 
     // Does nothing, we don't force idle collection for JSRT
     void SetForceOneIdleCollection() override {}
@@ -0,0 +1,1613 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "JsrtPch.h"
+#include "JsrtValueSerializer.h"
+#include "JsrtExternalObject.h"
+#include "JsrtInterceptorObject.h"
+#include "Library/DataView.h"
+#include "Library/DateImplementation.h"
+#include "Library/JavascriptDate.h"
+#include "Library/JavascriptBooleanObject.h"
+#include "Library/JavascriptNumberObject.h"
+#include "Library/JavascriptStringObject.h"
+#include "Library/JavascriptRegularExpression.h"
+#include "Library/JavascriptSymbol.h"
+#include "Library/MapOrSetDataList.h"
+#include "Library/JavascriptMap.h"
+#include "Library/JavascriptSet.h"
+#include "Codex/Utf8Helper.h"
+
+// Tags of the V8 wire format, see src/value-serializer.cc in V8
+enum SerializationTag : byte
+{
+    SerializationTag_Version = 0xFF,
+    SerializationTag_Padding = '\0',
+    SerializationTag_VerifyObjectCount = '?',
+    SerializationTag_TheHole = '-',
+    SerializationTag_Undefined = '_',
+    SerializationTag_Null = '0',
+    SerializationTag_True = 'T',
+    SerializationTag_False = 'F',
+    SerializationTag_Int32 = 'I',
+    SerializationTag_Uint32 = 'U',
+    SerializationTag_Double = 'N',
+    SerializationTag_Utf8String = 'S',
+    SerializationTag_OneByteString = '"',
+    SerializationTag_TwoByteString = 'c',
+    SerializationTag_ObjectReference = '^',
+    SerializationTag_BeginJSObject = 'o',
+    SerializationTag_EndJSObject = '{',
+    SerializationTag_BeginSparseJSArray = 'a',
+    SerializationTag_EndSparseJSArray = '@',
+    SerializationTag_BeginDenseJSArray = 'A',
+    SerializationTag_EndDenseJSArray = '$',
+    SerializationTag_Date = 'D',
+    SerializationTag_TrueObject = 'y',
+    SerializationTag_FalseObject = 'x',
+    SerializationTag_NumberObject = 'n',
+    SerializationTag_StringObject = 's',
+    SerializationTag_RegExp = 'R',
+    SerializationTag_BeginJSMap = ';',
+    SerializationTag_EndJSMap = ':',
+    SerializationTag_BeginJSSet = '\'',
+    SerializationTag_EndJSSet = ',',
+    SerializationTag_ArrayBuffer = 'B',
+    SerializationTag_ArrayBufferTransfer = 't',
+    SerializationTag_ArrayBufferView = 'V',
+    SerializationTag_SharedArrayBuffer = 'u',
+    SerializationTag_HostObject = '\\'
+};
+
+static const uint32 LatestWireFormatVersion = 13;
+
+// Subtags of array buffer views, indexed by type id starting at TypeIds_Int8Array
+static const byte TypedArrayViewTags[] = { 'b', 'B', 'C', 'w', 'W', 'd', 'D', 'f', 'F' };
+static const byte DataViewTag = '?';
+
+// V8 numbers the regular expression flags differently
+static const uint32 RegExpFlagGlobal = 1 << 0;
+static const uint32 RegExpFlagIgnoreCase = 1 << 1;
+static const uint32 RegExpFlagMultiline = 1 << 2;
+static const uint32 RegExpFlagSticky = 1 << 3;
+static const uint32 RegExpFlagUnicode = 1 << 4;
+
+static bool IsHostObject(Js::RecyclableObject * object)
+{
+    return JsrtInterceptorObject::Is(object) ||
+        (JsrtExternalObject::Is(object) && JsrtExternalObject::FromVar(object)->GetInternalFieldCount() > 0);
+}
+
+static uint32 GetVarintSize(uint64 value)
+{
+    uint32 size = 1;
+    while (value >>= 7)
+    {
+        size++;
+    }
+    return size;
+}
+
+JsrtValueSerializer::JsrtValueSerializer(Js::ScriptContext * scriptContext, const JsValueSerializerCallbacks * callbacks, void * callbackState) :
+    scriptContext(scriptContext),
+    recycler(scriptContext->GetRecycler()),
+    callbacks(*callbacks),
+    callbackState(callbackState),
+    buffer(nullptr),
+    bufferSize(0),
+    bufferCapacity(0),
+    outOfMemory(false),
+    treatArrayBufferViewsAsHostObjects(false),
+    nextId(0),
+    idMap(nullptr),
+    transferMap(nullptr)
+{
+    this->idMap = RecyclerNew(this->recycler, ObjectIdMap, this->recycler);
+    this->recycler->RootAddRef(this->idMap);
+}
+
+JsrtValueSerializer::~JsrtValueSerializer()
+{
+    if (this->buffer != nullptr)
+    {
+        this->callbacks.freeBuffer(this->buffer, this->callbackState);
+    }
+
+    this->recycler->RootRelease(this->idMap);
+    if (this->transferMap != nullptr)
+    {
+        this->recycler->RootRelease(this->transferMap);
+    }
+}
+
+void JsrtValueSerializer::WriteHeader()
+{
+    this->WriteTag(SerializationTag_Version);
+    this->WriteVarint(LatestWireFormatVersion);
+}
+
+void JsrtValueSerializer::WriteValue(Js::Var value)
+{
+    this->WriteObject(value);
+}
+
+void JsrtValueSerializer::TransferArrayBuffer(uint32 transferId, Js::Var arrayBuffer)
+{
+    if (this->transferMap == nullptr)
+    {
+        this->transferMap = RecyclerNew(this->recycler, ObjectIdMap, this->recycler);
+        this->recycler->RootAddRef(this->transferMap);
+    }
+    this->transferMap->Item(arrayBuffer, transferId);
+}
+
+byte * JsrtValueSerializer::ReserveRawBytes(size_t length)
+{
+    if (this->outOfMemory)
+    {
+        return nullptr;
+    }
+
+    size_t newSize = this->bufferSize + length;
+    if (newSize < this->bufferSize)
+    {
+        this->outOfMemory = true;
+        return nullptr;
+    }
+
+    if (newSize > this->bufferCapacity)
+    {
+        size_t requestedCapacity = max(newSize, this->bufferCapacity * 2) + 64;
+        size_t allocatedCapacity = 0;
+        void * newBuffer = this->callbacks.reallocateBuffer(this->buffer, requestedCapacity, &allocatedCapacity, this->callbackState);
+        if (newBuffer == nullptr || allocatedCapacity < newSize)
+        {
+            // The old buffer is still valid, it is freed with the serializer
+            this->outOfMemory = true;
+            return nullptr;
+        }
+        this->buffer = static_cast<byte *>(newBuffer);
+        this->bufferCapacity = allocatedCapacity;
+    }
+
+    byte * bytes = this->buffer + this->bufferSize;
+    this->bufferSize = newSize;
+    return bytes;
+}
+
+bool JsrtValueSerializer::WriteRawBytes(const void * source, size_t length)
+{
+    byte * bytes = this->ReserveRawBytes(length);
+    if (bytes == nullptr)
+    {
+        return false;
+    }
+
+    if (length != 0)
+    {
+        memcpy(bytes, source, length);
+    }
+    return true;
+}
+
+bool JsrtValueSerializer::WriteVarint(uint64 value)
+{
+    byte bytes[(sizeof(uint64) * 8) / 7 + 1];
+    size_t count = 0;
+    do
+    {
+        bytes[count++] = static_cast<byte>(value & 0x7F) | 0x80;
+        value >>= 7;
+    } while (value != 0);
+    bytes[count - 1] &= 0x7F;
+
+    return this->WriteRawBytes(bytes, count);
+}
+
+bool JsrtValueSerializer::WriteDouble(double value)
+{
+    // Doubles are written in host byte order, like V8 does
+    return this->WriteRawBytes(&value, sizeof(value));
+}
+
+void JsrtValueSerializer::ReleaseBuffer(void ** buffer, size_t * size)
+{
+    *buffer = this->buffer;
+    *size = this->bufferSize;
+
+    this->buffer = nullptr;
+    this->bufferSize = 0;
+    this->bufferCapacity = 0;
+}
+
+void JsrtValueSerializer::WriteTag(byte tag)
+{
+    this->WriteRawBytes(&tag, sizeof(tag));
+}
+
+void JsrtValueSerializer::WriteZigZag(int32 value)
+{
+    this->WriteVarint((static_cast<uint32>(value) << 1) ^ static_cast<uint32>(value >> 31));
+}
+
+void JsrtValueSerializer::WriteNumber(double value)
+{
+    // Numbers that fit a small integer in V8 are written as one, so the bytes match
+    int32 intValue;
+    if (Js::JavascriptNumber::TryGetInt32Value(value, &intValue))
+    {
+        this->WriteTag(SerializationTag_Int32);
+        this->WriteZigZag(intValue);
+    }
+    else
+    {
+        this->WriteTag(SerializationTag_Double);
+        this->WriteDouble(value);
+    }
+}
+
+void JsrtValueSerializer::WriteString(Js::JavascriptString * string)
+{
+    const char16 * chars = string->GetString();
+    charcount_t length = string->GetLength();
+
+    bool oneByte = true;
+    for (charcount_t i = 0; i < length && oneByte; i++)
+    {
+        oneByte = chars[i] <= 0xFF;
+    }
+
+    if (oneByte)
+    {
+        this->WriteTag(SerializationTag_OneByteString);
+        this->WriteVarint(length);
+        byte * bytes = this->ReserveRawBytes(length);
+        if (bytes != nullptr)
+        {
+            utf8::EncodeLatin1Into(bytes, chars, length);
+        }
+    }
+    else
+    {
+        // Two byte strings are aligned so the reader can use them in place
+        uint32 byteLength = length * sizeof(char16);
+        if ((this->bufferSize + 1 + GetVarintSize(byteLength)) & 1)
+        {
+            this->WriteTag(SerializationTag_Padding);
+        }
+        this->WriteTag(SerializationTag_TwoByteString);
+        this->WriteVarint(byteLength);
+        this->WriteRawBytes(chars, byteLength);
+    }
+}
+
+void JsrtValueSerializer::WriteObject(Js::Var value)
+{
+    PROBE_STACK(this->scriptContext, Js::Constants::MinStackDefault);
+
+    Js::TypeId typeId = Js::JavascriptOperators::GetTypeId(value);
+    switch (typeId)
+    {
+    case Js::TypeIds_Undefined:
+        this->WriteTag(SerializationTag_Undefined);
+        break;
+
+    case Js::TypeIds_Null:
+        this->WriteTag(SerializationTag_Null);
+        break;
+
+    case Js::TypeIds_Boolean:
+        this->WriteTag(Js::JavascriptBoolean::FromVar(value)->GetValue() ? SerializationTag_True : SerializationTag_False);
+        break;
+
+    case Js::TypeIds_Integer:
+        this->WriteTag(SerializationTag_Int32);
+        this->WriteZigZag(Js::TaggedInt::ToInt32(value));
+        break;
+
+    case Js::TypeIds_Number:
+    case Js::TypeIds_Int64Number:
+    case Js::TypeIds_UInt64Number:
+        this->WriteNumber(Js::JavascriptConversion::ToNumber(value, this->scriptContext));
+        break;
+
+    case Js::TypeIds_String:
+        this->WriteString(Js::JavascriptString::FromVar(value));
+        break;
+
+    case Js::TypeIds_Symbol:
+        this->ThrowDataCloneError(JSERR_DataCloneError, value);
+
+    default:
+        {
+            Js::RecyclableObject * object = Js::RecyclableObject::FromVar(value);
+
+            // Views are preceded by their buffer, before the view itself gets an id
+            bool isView = (typeId >= Js::TypeIds_TypedArraySCAMin && typeId <= Js::TypeIds_TypedArraySCAMax) || typeId == Js::TypeIds_DataView;
+            if (isView && !this->treatArrayBufferViewsAsHostObjects && !this->idMap->ContainsKey(object))
+            {
+                this->WriteReceiver(static_cast<Js::ArrayBufferParent *>(object)->GetArrayBuffer());
+            }
+            this->WriteReceiver(object);
+        }
+        break;
+    }
+
+    this->ThrowIfOutOfMemory();
+}
+
+void JsrtValueSerializer::WriteReceiver(Js::RecyclableObject * object)
+{
+    uint32 id;
+    if (this->idMap->TryGetValue(object, &id))
+    {
+        this->WriteTag(SerializationTag_ObjectReference);
+        this->WriteVarint(id);
+        return;
+    }
+
+    // The id is taken even if the object turns out not to be cloneable, like V8 does
+    this->idMap->Add(object, this->nextId++);
+
+    Js::TypeId typeId = object->GetTypeId();
+    switch (typeId)
+    {
+    case Js::TypeIds_Array:
+    case Js::TypeIds_NativeIntArray:
+    case Js::TypeIds_CopyOnAccessNativeIntArray:
+    case Js::TypeIds_NativeFloatArray:
+    case Js::TypeIds_ES5Array:
+        this->WriteJSArray(Js::JavascriptArray::FromAnyArray(object));
+        return;
+
+    case Js::TypeIds_Object:
+        if (IsHostObject(object))
+        {
+            this->WriteHostObject(object);
+        }
+        else
+        {
+            this->WriteJSObject(Js::DynamicObject::FromVar(object));
+        }
+        return;
+
+    case Js::TypeIds_Date:
+        this->WriteTag(SerializationTag_Date);
+        this->WriteDouble(Js::JavascriptDate::FromVar(object)->GetTime());
+        return;
+
+    case Js::TypeIds_BooleanObject:
+    case Js::TypeIds_NumberObject:
+    case Js::TypeIds_StringObject:
+        this->WriteJSValue(object);
+        return;
+
+    case Js::TypeIds_RegEx:
+        this->WriteJSRegExp(Js::JavascriptRegExp::FromVar(object));
+        return;
+
+    case Js::TypeIds_Map:
+        this->WriteJSMap(Js::JavascriptMap::FromVar(object));
+        return;
+
+    case Js::TypeIds_Set:
+        this->WriteJSSet(Js::JavascriptSet::FromVar(object));
+        return;
+
+    case Js::TypeIds_ArrayBuffer:
+    case Js::TypeIds_SharedArrayBuffer:
+        this->WriteJSArrayBuffer(Js::ArrayBufferBase::FromVar(object));
+        return;
+
+    case Js::TypeIds_DataView:
+        this->WriteJSArrayBufferView(object);
+        return;
+
+    default:
+        if (typeId >= Js::TypeIds_TypedArraySCAMin && typeId <= Js::TypeIds_TypedArraySCAMax)
+        {
+            this->WriteJSArrayBufferView(object);
+            return;
+        }
+        if (IsHostObject(object))
+        {
+            this->WriteHostObject(object);
+            return;
+        }
+        break;
+    }
+
+    // Functions, proxies, errors, promises, weak collections and other exotic objects
+    this->ThrowDataCloneError(JSERR_DataCloneError, object);
+}
+
+Js::JavascriptArray * JsrtValueSerializer::GetOwnPropertyKeys(Js::DynamicObject * object)
+{
+    // Enumerable string keys straight from the type handler. They are collected before any value
+    // is read, getters can change the type of the object.
+    Js::JavascriptArray * keys = this->scriptContext->GetLibrary()->CreateArray(0);
+    Js::DynamicType * type = object->GetDynamicType();
+    Js::JavascriptString * propertyString = nullptr;
+    Js::PropertyId propertyId = Js::Constants::NoProperty;
+    uint32 count = 0;
+
+    for (Js::BigPropertyIndex index = 0;
+        object->FindNextProperty(index, &propertyString, &propertyId, nullptr, type, Js::EnumeratorFlags::None, this->scriptContext);
+        index++)
+    {
+        if (!Js::IsInternalPropertyId(propertyId))
+        {
+            keys->DirectSetItemAt(count++, static_cast<Js::Var>(propertyString));
+        }
+    }
+    return keys;
+}
+
+uint32 JsrtValueSerializer::WriteProperties(Js::RecyclableObject * object, Js::JavascriptArray * keys)
+{
+    uint32 written = 0;
+    uint32 keyCount = keys->GetLength();
+    for (uint32 i = 0; i < keyCount; i++)
+    {
+        Js::Var key = keys->DirectGetItem(i);
+        const Js::PropertyRecord * propertyRecord = nullptr;
+        Js::JavascriptConversion::ToPropertyKey(key, this->scriptContext, &propertyRecord);
+
+        // Properties removed by an earlier getter are left out
+        Js::Var value = nullptr;
+        if (propertyRecord->IsNumeric())
+        {
+            uint32 index = propertyRecord->GetNumericValue();
+            if (!Js::JavascriptOperators::GetOwnItem(object, index, &value, this->scriptContext))
+            {
+                continue;
+            }
+            this->WriteNumber(index);
+        }
+        else
+        {
+            if (!Js::JavascriptOperators::GetOwnProperty(object, propertyRecord->GetPropertyId(), &value, this->scriptContext))
+            {
+                continue;
+            }
+            this->WriteString(Js::JavascriptString::FromVar(key));
+        }
+
+        this->WriteObject(value);
+        written++;
+    }
+    return written;
+}
+
+void JsrtValueSerializer::WriteJSObject(Js::DynamicObject * object)
+{
+    Js::JavascriptArray * keys;
+    if (!object->HasObjectArray() && !object->HasDeferredTypeHandler())
+    {
+        keys = this->GetOwnPropertyKeys(object);
+    }
+    else
+    {
+        keys = Js::JavascriptOperators::GetOwnEnumerablePropertyNames(object, this->scriptContext);
+    }
+
+    this->WriteTag(SerializationTag_BeginJSObject);
+    uint32 written = this->WriteProperties(object, keys);
+    this->WriteTag(SerializationTag_EndJSObject);
+    this->WriteVarint(written);
+}
+
+void JsrtValueSerializer::WriteJSArray(Js::JavascriptArray * array)
+{
+    uint32 length = array->GetLength();
+    Js::TypeId typeId = array->GetTypeId();
+    // Elements of ES5 arrays may be accessors, copy on access arrays have no segments to walk yet
+    bool useGenericEnumeration = typeId == Js::TypeIds_ES5Array || typeId == Js::TypeIds_CopyOnAccessNativeIntArray;
+
+    // Arrays without holes are written element by element, like V8's packed arrays
+    bool dense = false;
+    if (typeId == Js::TypeIds_Array || typeId == Js::TypeIds_NativeIntArray || typeId == Js::TypeIds_NativeFloatArray)
+    {
+        Js::SparseArraySegmentBase * head = array->GetHead();
+        dense = head->left == 0 && head->length == length && head->next == nullptr && array->HasNoMissingValues();
+    }
+
+    if (dense)
+    {
+        this->WriteTag(SerializationTag_BeginDenseJSArray);
+        this->WriteVarint(length);
+        for (uint32 i = 0; i < length; i++)
+        {
+            // Elements removed by an earlier getter are written as holes
+            Js::Var element = nullptr;
+            if (Js::JavascriptOperators::GetOwnItem(array, i, &element, this->scriptContext))
+            {
+                this->WriteObject(element);
+            }
+            else
+            {
+                this->WriteTag(SerializationTag_TheHole);
+            }
+        }
+
+        uint32 written = this->WriteProperties(array, this->GetOwnPropertyKeys(array));
+        this->WriteTag(SerializationTag_EndDenseJSArray);
+        this->WriteVarint(written);
+        this->WriteVarint(length);
+        return;
+    }
+
+    this->WriteTag(SerializationTag_BeginSparseJSArray);
+    this->WriteVarint(length);
+
+    uint32 written = 0;
+    if (useGenericEnumeration)
+    {
+        written = this->WriteProperties(array, Js::JavascriptOperators::GetOwnEnumerablePropertyNames(array, this->scriptContext));
+    }
+    else
+    {
+        for (uint32 index = array->GetNextIndex(Js::JavascriptArray::InvalidIndex);
+            index != Js::JavascriptArray::InvalidIndex;
+            index = array->GetNextIndex(index))
+        {
+            Js::Var element = nullptr;
+            if (Js::JavascriptOperators::GetOwnItem(array, index, &element, this->scriptContext))
+            {
+                this->WriteNumber(index);
+                this->WriteObject(element);
+                written++;
+            }
+        }
+        written += this->WriteProperties(array, this->GetOwnPropertyKeys(array));
+    }
+
+    this->WriteTag(SerializationTag_EndSparseJSArray);
+    this->WriteVarint(written);
+    this->WriteVarint(length);
+}
+
+void JsrtValueSerializer::WriteJSValue(Js::RecyclableObject * object)
+{
+    switch (object->GetTypeId())
+    {
+    case Js::TypeIds_BooleanObject:
+        this->WriteTag(Js::JavascriptBooleanObject::FromVar(object)->GetValue() ? SerializationTag_TrueObject : SerializationTag_FalseObject);
+        break;
+
+    case Js::TypeIds_NumberObject:
+        this->WriteTag(SerializationTag_NumberObject);
+        this->WriteDouble(Js::JavascriptNumberObject::FromVar(object)->GetValue());
+        break;
+
+    case Js::TypeIds_StringObject:
+        this->WriteTag(SerializationTag_StringObject);
+        this->WriteString(Js::JavascriptStringObject::FromVar(object)->Unwrap());
+        break;
+
+    default:
+        Assert(UNREACHED);
+        break;
+    }
+}
+
+void JsrtValueSerializer::WriteJSRegExp(Js::JavascriptRegExp * regExp)
+{
+    InternalString source = regExp->GetSource();
+    UnifiedRegex::RegexFlags flags = regExp->GetFlags();
+
+    uint32 v8Flags = 0;
+    v8Flags |= (flags & UnifiedRegex::GlobalRegexFlag) ? RegExpFlagGlobal : 0;
+    v8Flags |= (flags & UnifiedRegex::IgnoreCaseRegexFlag) ? RegExpFlagIgnoreCase : 0;
+    v8Flags |= (flags & UnifiedRegex::MultilineRegexFlag) ? RegExpFlagMultiline : 0;
+    v8Flags |= (flags & UnifiedRegex::StickyRegexFlag) ? RegExpFlagSticky : 0;
+    v8Flags |= (flags & UnifiedRegex::UnicodeRegexFlag) ? RegExpFlagUnicode : 0;
+
+    this->WriteTag(SerializationTag_RegExp);
+    this->WriteString(Js::JavascriptString::NewCopyBuffer(source.GetBuffer(), source.GetLength(), this->scriptContext));
+    this->WriteVarint(v8Flags);
+}
+
+void JsrtValueSerializer::WriteJSMap(Js::JavascriptMap * map)
+{
+    // Entries are copied first, writing them can run getters that change the map
+    Js::JavascriptArray * entries = this->scriptContext->GetLibrary()->CreateArray(0);
+    uint32 length = 0;
+    Js::JavascriptMap::MapDataList::Iterator iterator = map->GetIterator();
+    while (iterator.Next())
+    {
+        const Js::JavascriptMap::MapDataKeyValuePair& entry = iterator.Current();
+        entries->DirectSetItemAt(length++, static_cast<Js::Var>(entry.Key()));
+        entries->DirectSetItemAt(length++, static_cast<Js::Var>(entry.Value()));
+    }
+
+    this->WriteTag(SerializationTag_BeginJSMap);
+    for (uint32 i = 0; i < length; i++)
+    {
+        this->WriteObject(entries->DirectGetItem(i));
+    }
+    this->WriteTag(SerializationTag_EndJSMap);
+    this->WriteVarint(length);
+}
+
+void JsrtValueSerializer::WriteJSSet(Js::JavascriptSet * set)
+{
+    Js::JavascriptArray * entries = this->scriptContext->GetLibrary()->CreateArray(0);
+    uint32 length = 0;
+    Js::JavascriptSet::SetDataList::Iterator iterator = set->GetIterator();
+    while (iterator.Next())
+    {
+        entries->DirectSetItemAt(length++, static_cast<Js::Var>(iterator.Current()));
+    }
+
+    this->WriteTag(SerializationTag_BeginJSSet);
+    for (uint32 i = 0; i < length; i++)
+    {
+        this->WriteObject(entries->DirectGetItem(i));
+    }
+    this->WriteTag(SerializationTag_EndJSSet);
+    this->WriteVarint(length);
+}
+
+void JsrtValueSerializer::WriteJSArrayBuffer(Js::ArrayBufferBase * arrayBuffer)
+{
+    if (arrayBuffer->IsSharedArrayBuffer())
+    {
+        if (this->callbacks.getSharedArrayBufferId == nullptr)
+        {
+            this->ThrowDataCloneError(JSERR_DataCloneError, arrayBuffer);
+        }
+
+        unsigned int id = 0;
+        bool succeeded = false;
+        BEGIN_INTERCEPTOR(this->scriptContext)
+        {
+            succeeded = this->callbacks.getSharedArrayBufferId(arrayBuffer, &id, this->callbackState);
+        }
+        END_INTERCEPTOR(this->scriptContext);
+
+        if (!succeeded)
+        {
+            this->ThrowDataCloneError(JSERR_DataCloneError, arrayBuffer);
+        }
+
+        this->WriteTag(SerializationTag_SharedArrayBuffer);
+        this->WriteVarint(id);
+        return;
+    }
+
+    uint32 transferId;
+    if (this->transferMap != nullptr && this->transferMap->TryGetValue(arrayBuffer, &transferId))
+    {
+        this->WriteTag(SerializationTag_ArrayBufferTransfer);
+        this->WriteVarint(transferId);
+        return;
+    }
+
+    if (arrayBuffer->IsDetached())
+    {
+        this->ThrowDataCloneError(JSERR_DataCloneDetachedArrayBuffer, nullptr);
+    }
+
+    uint32 byteLength = arrayBuffer->GetByteLength();
+    this->WriteTag(SerializationTag_ArrayBuffer);
+    this->WriteVarint(byteLength);
+    this->WriteRawBytes(arrayBuffer->GetBuffer(), byteLength);
+}
+
+void JsrtValueSerializer::WriteJSArrayBufferView(Js::RecyclableObject * view)
+{
+    if (this->treatArrayBufferViewsAsHostObjects)
+    {
+        this->WriteHostObject(view);
+        return;
+    }
+
+    byte subtag;
+    uint32 byteOffset;
+    uint32 byteLength;
+    if (Js::DataView::Is(view))
+    {
+        Js::DataView * dataView = Js::DataView::FromVar(view);
+        subtag = DataViewTag;
+        byteOffset = dataView->GetByteOffset();
+        byteLength = dataView->GetLength();
+    }
+    else
+    {
+        Js::TypedArrayBase * typedArray = Js::TypedArrayBase::FromVar(view);
+        subtag = TypedArrayViewTags[view->GetTypeId() - Js::TypeIds_TypedArraySCAMin];
+        byteOffset = typedArray->GetByteOffset();
+        byteLength = typedArray->GetByteLength();
+    }
+
+    this->WriteTag(SerializationTag_ArrayBufferView);
+    this->WriteVarint(subtag);
+    this->WriteVarint(byteOffset);
+    this->WriteVarint(byteLength);
+}
+
+void JsrtValueSerializer::WriteHostObject(Js::RecyclableObject * object)
+{
+    this->WriteTag(SerializationTag_HostObject);
+    if (this->callbacks.writeHostObject == nullptr)
+    {
+        this->ThrowDataCloneError(JSERR_DataCloneError, object);
+    }
+
+    bool succeeded = false;
+    BEGIN_INTERCEPTOR(this->scriptContext)
+    {
+        succeeded = this->callbacks.writeHostObject(object, this->callbackState);
+    }
+    END_INTERCEPTOR(this->scriptContext);
+
+    if (!succeeded)
+    {
+        this->ThrowDataCloneError(JSERR_DataCloneError, object);
+    }
+}
+
+Js::JavascriptString * JsrtValueSerializer::GetDescription(Js::Var value)
+{
+    // Describes the value without running script, the way V8 does in its messages
+    Js::JavascriptLibrary * library = this->scriptContext->GetLibrary();
+    Js::TypeId typeId = Js::JavascriptOperators::GetTypeId(value);
+
+    if (typeId == Js::TypeIds_Symbol)
+    {
+        return Js::JavascriptSymbol::ToString(Js::JavascriptSymbol::FromVar(value)->GetValue(), this->scriptContext);
+    }
+    else if (typeId == Js::TypeIds_Function)
+    {
+        Js::Var source = Js::JavascriptFunction::FromVar(value)->EnsureSourceString();
+        if (source != nullptr && Js::JavascriptString::Is(source))
+        {
+            return Js::JavascriptString::FromVar(source);
+        }
+    }
+    else if (typeId != Js::TypeIds_Proxy && Js::DynamicType::Is(typeId))
+    {
+        // Only a data property of the prototype is looked at, getters would run script
+        Js::RecyclableObject * prototype = Js::RecyclableObject::FromVar(value)->GetPrototype();
+        if (prototype != nullptr && Js::DynamicType::Is(prototype->GetTypeId()))
+        {
+            Js::DynamicObject * dynamicPrototype = Js::DynamicObject::FromVar(prototype);
+            Js::DynamicTypeHandler * typeHandler = dynamicPrototype->GetTypeHandler();
+            Js::PropertyIndex slot = typeHandler->GetPropertyIndex(this->scriptContext->GetPropertyName(Js::PropertyIds::constructor));
+            Js::Var constructor = slot != Js::Constants::NoSlot ? typeHandler->GetSlot(dynamicPrototype, slot) : nullptr;
+            if (constructor != nullptr && Js::JavascriptFunction::Is(constructor))
+            {
+                Js::FunctionProxy * proxy = Js::JavascriptFunction::FromVar(constructor)->GetFunctionInfo()->GetFunctionProxy();
+                const char16 * name = proxy != nullptr ? proxy->GetDisplayName() : nullptr;
+                Js::Var nameId = Js::JavascriptFunction::FromVar(constructor)->GetSourceString();
+                if (name == nullptr && nameId != nullptr && Js::TaggedInt::Is(nameId))
+                {
+                    name = this->scriptContext->GetPropertyName(Js::TaggedInt::ToInt32(nameId))->GetBuffer();
+                }
+                if (name != nullptr && name[0] != _u('\0'))
+                {
+                    return Js::JavascriptString::Concat3(
+                        library->CreateStringFromCppLiteral(_u("#<")),
+                        Js::JavascriptString::NewCopySz(name, this->scriptContext),
+                        library->CreateStringFromCppLiteral(_u(">")));
+                }
+            }
+        }
+    }
+
+    return library->CreateStringFromCppLiteral(_u("[object Object]"));
+}
+
+void JsrtValueSerializer::ThrowIfOutOfMemory()
+{
+    if (this->outOfMemory)
+    {
+        this->ThrowDataCloneError(JSERR_DataCloneOutOfMemory, nullptr);
+    }
+}
+
+void __declspec(noreturn) JsrtValueSerializer::ThrowDataCloneError(int32 hCode, Js::Var value)
+{
+    Js::JavascriptError * error = this->scriptContext->GetLibrary()->CreateError();
+    Js::JavascriptError::SetErrorMessage(error, hCode, value != nullptr ? this->GetDescription(value)->GetSz() : nullptr, this->scriptContext);
+
+    // The host gets to throw an error of its own from the message, otherwise the Error is thrown
+    if (this->callbacks.dataCloneError != nullptr)
+    {
+        Js::Var message = Js::JavascriptOperators::GetProperty(error, Js::PropertyIds::message, this->scriptContext);
+        BEGIN_INTERCEPTOR(this->scriptContext)
+        {
+            this->callbacks.dataCloneError(message, this->callbackState);
+        }
+        END_INTERCEPTOR(this->scriptContext);
+    }
+
+    Js::JavascriptExceptionOperators::Throw(error, this->scriptContext);
+}
+
+JsrtValueDeserializer::JsrtValueDeserializer(Js::ScriptContext * scriptContext, const byte * data, size_t size,
+    JsDeserializerReadHostObjectCallback readHostObject, void * callbackState) :
+    scriptContext(scriptContext),
+    recycler(scriptContext->GetRecycler()),
+    readHostObject(readHostObject),
+    callbackState(callbackState),
+    position(data),
+    end(data + size),
+    version(0),
+    nextId(0),
+    idMap(nullptr),
+    transferMap(nullptr)
+{
+    this->idMap = RecyclerNew(this->recycler, IdObjectMap, this->recycler);
+    this->recycler->RootAddRef(this->idMap);
+}
+
+JsrtValueDeserializer::~JsrtValueDeserializer()
+{
+    this->recycler->RootRelease(this->idMap);
+    if (this->transferMap != nullptr)
+    {
+        this->recycler->RootRelease(this->transferMap);
+    }
+}
+
+void JsrtValueDeserializer::ReadHeader()
+{
+    if (this->position < this->end && *this->position == SerializationTag_Version)
+    {
+        this->position++;
+        if (!this->ReadVarint32(&this->version) || this->version > LatestWireFormatVersion)
+        {
+            Js::JavascriptError::ThrowError(this->scriptContext, JSERR_DataCloneDeserializationVersionError);
+        }
+    }
+}
+
+Js::Var JsrtValueDeserializer::ReadValue()
+{
+    // Data from before version 13 is read as well, except for the legacy format without a header
+    if (this->version == 0)
+    {
+        Js::JavascriptError::ThrowError(this->scriptContext, JSERR_DataCloneDeserializationVersionError);
+    }
+
+    return this->ReadObject();
+}
+
+void JsrtValueDeserializer::TransferArrayBuffer(uint32 transferId, Js::Var arrayBuffer)
+{
+    if (this->transferMap == nullptr)
+    {
+        this->transferMap = RecyclerNew(this->recycler, IdObjectMap, this->recycler);
+        this->recycler->RootAddRef(this->transferMap);
+    }
+    this->transferMap->Item(transferId, arrayBuffer);
+}
+
+bool JsrtValueDeserializer::ReadVarint(uint64 * value)
+{
+    // Bits past the width of the value are dropped, like V8 does
+    uint64 result = 0;
+    uint32 shift = 0;
+    bool hasAnotherByte;
+    do
+    {
+        if (this->position >= this->end)
+        {
+            return false;
+        }
+
+        byte current = *this->position++;
+        if (shift < sizeof(uint64) * 8)
+        {
+            result |= static_cast<uint64>(current & 0x7F) << shift;
+            shift += 7;
+        }
+        hasAnotherByte = (current & 0x80) != 0;
+    } while (hasAnotherByte);
+
+    *value = result;
+    return true;
+}
+
+bool JsrtValueDeserializer::ReadVarint32(uint32 * value)
+{
+    uint64 result;
+    if (!this->ReadVarint(&result))
+    {
+        return false;
+    }
+
+    *value = static_cast<uint32>(result);
+    return true;
+}
+
+bool JsrtValueDeserializer::ReadZigZag(int32 * value)
+{
+    uint32 result;
+    if (!this->ReadVarint32(&result))
+    {
+        return false;
+    }
+
+    *value = static_cast<int32>((result >> 1) ^ (0 - (result & 1)));
+    return true;
+}
+
+bool JsrtValueDeserializer::ReadDouble(double * value)
+{
+    if (static_cast<size_t>(this->end - this->position) < sizeof(double))
+    {
+        return false;
+    }
+
+    memcpy(value, this->position, sizeof(double));
+    this->position += sizeof(double);
+
+    // Only the canonical NaN is a valid value
+    if (Js::JavascriptNumber::IsNan(*value))
+    {
+        *value = Js::JavascriptNumber::NaN;
+    }
+    return true;
+}
+
+bool JsrtValueDeserializer::ReadRawBytes(size_t length, const byte ** data)
+{
+    if (length > static_cast<size_t>(this->end - this->position))
+    {
+        return false;
+    }
+
+    *data = this->position;
+    this->position += length;
+    return true;
+}
+
+bool JsrtValueDeserializer::ReadTag(byte * tag)
+{
+    do
+    {
+        if (this->position >= this->end)
+        {
+            return false;
+        }
+        *tag = *this->position++;
+    } while (*tag == SerializationTag_Padding);
+    return true;
+}
+
+bool JsrtValueDeserializer::PeekTag(byte * tag)
+{
+    const byte * peekPosition = this->position;
+    do
+    {
+        if (peekPosition >= this->end)
+        {
+            return false;
+        }
+        *tag = *peekPosition++;
+    } while (*tag == SerializationTag_Padding);
+    return true;
+}
+
+void JsrtValueDeserializer::AddObjectWithId(uint32 id, Js::Var object)
+{
+    this->idMap->Item(id, object);
+}
+
+Js::Var JsrtValueDeserializer::ReadObject()
+{
+    PROBE_STACK(this->scriptContext, Js::Constants::MinStackDefault);
+
+    Js::Var result = this->ReadObjectInternal();
+
+    // A view follows the buffer it is on, whether the buffer was written in full or referenced
+    byte tag;
+    if (result != nullptr && Js::ArrayBufferBase::Is(result) && this->PeekTag(&tag) && tag == SerializationTag_ArrayBufferView)
+    {
+        this->ReadTag(&tag);
+        result = this->ReadJSArrayBufferView(Js::ArrayBufferBase::FromVar(result));
+    }
+
+    if (result == nullptr)
+    {
+        Js::JavascriptError::ThrowError(this->scriptContext, JSERR_DataCloneDeserializationError);
+    }
+    return result;
+}
+
+Js::Var JsrtValueDeserializer::ReadObjectInternal()
+{
+    Js::JavascriptLibrary * library = this->scriptContext->GetLibrary();
+
+    byte tag;
+    if (!this->ReadTag(&tag))
+    {
+        return nullptr;
+    }
+
+    switch (tag)
+    {
+    case SerializationTag_VerifyObjectCount:
+        {
+            // Only written by old versions, the count is not needed
+            uint32 count;
+            if (!this->ReadVarint32(&count))
+            {
+                return nullptr;
+            }
+            return this->ReadObject();
+        }
+
+    case SerializationTag_Undefined:
+        return library->GetUndefined();
+
+    case SerializationTag_Null:
+        return library->GetNull();
+
+    case SerializationTag_True:
+        return library->GetTrue();
+
+    case SerializationTag_False:
+        return library->GetFalse();
+
+    case SerializationTag_Int32:
+        {
+            int32 value;
+            return this->ReadZigZag(&value) ? Js::JavascriptNumber::ToVar(value, this->scriptContext) : nullptr;
+        }
+
+    case SerializationTag_Uint32:
+        {
+            uint32 value;
+            return this->ReadVarint32(&value) ? Js::JavascriptNumber::ToVar(value, this->scriptContext) : nullptr;
+        }
+
+    case SerializationTag_Double:
+        {
+            double value;
+            return this->ReadDouble(&value) ? Js::JavascriptNumber::ToVarIntCheck(value, this->scriptContext) : nullptr;
+        }
+
+    case SerializationTag_Utf8String:
+        return this->ReadUtf8String();
+
+    case SerializationTag_OneByteString:
+        return this->ReadOneByteString();
+
+    case SerializationTag_TwoByteString:
+        return this->ReadTwoByteString();
+
+    case SerializationTag_ObjectReference:
+        return this->ReadObjectReference();
+
+    case SerializationTag_BeginJSObject:
+        return this->ReadJSObject();
+
+    case SerializationTag_BeginSparseJSArray:
+        return this->ReadSparseJSArray();
+
+    case SerializationTag_BeginDenseJSArray:
+        return this->ReadDenseJSArray();
+
+    case SerializationTag_Date:
+        return this->ReadJSDate();
+
+    case SerializationTag_TrueObject:
+    case SerializationTag_FalseObject:
+    case SerializationTag_NumberObject:
+    case SerializationTag_StringObject:
+        return this->ReadJSValue(tag);
+
+    case SerializationTag_RegExp:
+        return this->ReadJSRegExp();
+
+    case SerializationTag_BeginJSMap:
+        return this->ReadJSMap();
+
+    case SerializationTag_BeginJSSet:
+        return this->ReadJSSet();
+
+    case SerializationTag_ArrayBuffer:
+        return this->ReadJSArrayBuffer();
+
+    case SerializationTag_ArrayBufferTransfer:
+    case SerializationTag_SharedArrayBuffer:
+        return this->ReadTransferredJSArrayBuffer();
+
+    case SerializationTag_HostObject:
+        return this->ReadHostObject();
+
+    default:
+        // Before version 13 host objects were written without a tag of their own
+        if (this->version < 13)
+        {
+            this->position--;
+            return this->ReadHostObject();
+        }
+        return nullptr;
+    }
+}
+
+Js::JavascriptString * JsrtValueDeserializer::ReadString()
+{
+    if (this->version < 12)
+    {
+        return this->ReadUtf8String();
+    }
+
+    Js::Var value = this->ReadObject();
+    return Js::JavascriptString::Is(value) ? Js::JavascriptString::FromVar(value) : nullptr;
+}
+
+Js::JavascriptString * JsrtValueDeserializer::ReadOneByteString()
+{
+    uint32 byteLength;
+    const byte * bytes;
+    if (!this->ReadVarint32(&byteLength) || !this->ReadRawBytes(byteLength, &bytes))
+    {
+        return nullptr;
+    }
+
+    if (!Js::IsValidCharCount(byteLength))
+    {
+        Js::JavascriptError::ThrowOutOfMemoryError(this->scriptContext);
+    }
+
+    char16 * buffer = RecyclerNewArrayLeaf(this->recycler, char16, byteLength + 1);
+    utf8::DecodeLatin1Into(buffer, bytes, byteLength);
+    buffer[byteLength] = _u('\0');
+    return Js::JavascriptString::NewWithBuffer(buffer, byteLength, this->scriptContext);
+}
+
+Js::JavascriptString * JsrtValueDeserializer::ReadTwoByteString()
+{
+    uint32 byteLength;
+    const byte * bytes;
+    if (!this->ReadVarint32(&byteLength) || (byteLength % sizeof(char16)) != 0 || !this->ReadRawBytes(byteLength, &bytes))
+    {
+        return nullptr;
+    }
+
+    // The data need not be aligned, so it is copied as bytes
+    charcount_t length = byteLength / sizeof(char16);
+    char16 * buffer = RecyclerNewArrayLeaf(this->recycler, char16, length + 1);
+    memcpy(buffer, bytes, byteLength);
+    buffer[length] = _u('\0');
+    return Js::JavascriptString::NewWithBuffer(buffer, length, this->scriptContext);
+}
+
+Js::JavascriptString * JsrtValueDeserializer::ReadUtf8String()
+{
+    uint32 byteLength;
+    const byte * bytes;
+    if (!this->ReadVarint32(&byteLength) || !this->ReadRawBytes(byteLength, &bytes))
+    {
+        return nullptr;
+    }
+
+    if (byteLength == 0)
+    {
+        return this->scriptContext->GetLibrary()->GetEmptyString();
+    }
+
+    utf8::NarrowToWide wide(reinterpret_cast<const char *>(bytes), byteLength);
+    if (!wide)
+    {
+        Js::JavascriptError::ThrowOutOfMemoryError(this->scriptContext);
+    }
+    return Js::JavascriptString::NewCopyBuffer(wide, static_cast<charcount_t>(wide.Length()), this->scriptContext);
+}
+
+Js::Var JsrtValueDeserializer::ReadObjectReference()
+{
+    uint32 id;
+    Js::Var object;
+    if (!this->ReadVarint32(&id) || !this->idMap->TryGetValue(id, &object))
+    {
+        return nullptr;
+    }
+    return object;
+}
+
+Js::Var JsrtValueDeserializer::ReadJSObject()
+{
+    uint32 id = this->nextId++;
+    Js::DynamicObject * object = this->scriptContext->GetLibrary()->CreateObject();
+    this->AddObjectWithId(id, object);
+
+    uint32 count;
+    uint32 expectedCount;
+    if (!this->ReadProperties(object, SerializationTag_EndJSObject, &count) ||
+        !this->ReadVarint32(&expectedCount) || count != expectedCount)
+    {
+        return nullptr;
+    }
+    return object;
+}
+
+Js::Var JsrtValueDeserializer::ReadSparseJSArray()
+{
+    uint32 length;
+    if (!this->ReadVarint32(&length))
+    {
+        return nullptr;
+    }
+
+    uint32 id = this->nextId++;
+    Js::JavascriptArray * array = this->scriptContext->GetLibrary()->CreateArray(0);
+    array->SetLength(length);
+    this->AddObjectWithId(id, array);
+
+    uint32 count;
+    uint32 expectedCount;
+    uint32 expectedLength;
+    if (!this->ReadProperties(array, SerializationTag_EndSparseJSArray, &count) ||
+        !this->ReadVarint32(&expectedCount) || !this->ReadVarint32(&expectedLength) ||
+        count != expectedCount || length != expectedLength)
+    {
+        return nullptr;
+    }
+    return array;
+}
+
+Js::Var JsrtValueDeserializer::ReadDenseJSArray()
+{
+    // Every element takes at least a byte, so a larger length can't be right
+    uint32 length;
+    if (!this->ReadVarint32(&length) || length > static_cast<size_t>(this->end - this->position))
+    {
+        return nullptr;
+    }
+
+    uint32 id = this->nextId++;
+    Js::JavascriptArray * array = this->scriptContext->GetLibrary()->CreateArray(length);
+    this->AddObjectWithId(id, array);
+
+    for (uint32 i = 0; i < length; i++)
+    {
+        byte tag;
+        if (this->PeekTag(&tag) && tag == SerializationTag_TheHole)
+        {
+            this->ReadTag(&tag);
+            continue;
+        }
+
+        Js::Var element = this->ReadObject();
+
+        // Before version 11 holes were written as undefined
+        if (this->version < 11 && Js::JavascriptOperators::IsUndefined(element))
+        {
+            continue;
+        }
+        array->SetItem(i, element, Js::PropertyOperation_None);
+    }
+
+    uint32 count;
+    uint32 expectedCount;
+    uint32 expectedLength;
+    if (!this->ReadProperties(array, SerializationTag_EndDenseJSArray, &count) ||
+        !this->ReadVarint32(&expectedCount) || !this->ReadVarint32(&expectedLength) ||
+        count != expectedCount || length != expectedLength)
+    {
+        return nullptr;
+    }
+    return array;
+}
+
+bool JsrtValueDeserializer::ReadProperties(Js::RecyclableObject * object, byte endTag, uint32 * count)
+{
+    for (uint32 properties = 0;; properties++)
+    {
+        byte tag;
+        if (!this->PeekTag(&tag))
+        {
+            return false;
+        }
+
+        if (tag == endTag)
+        {
+            this->ReadTag(&tag);
+            *count = properties;
+            return true;
+        }
+
+        Js::Var key = this->ReadObject();
+        Js::Var value = this->ReadObject();
+
+        // Keys must be strings or numbers
+        if (!Js::JavascriptString::Is(key) && !Js::TaggedInt::Is(key) && !Js::JavascriptNumber::Is(key))
+        {
+            return false;
+        }
+
+        const Js::PropertyRecord * propertyRecord = nullptr;
+        Js::JavascriptConversion::ToPropertyKey(key, this->scriptContext, &propertyRecord);
+        if (propertyRecord->IsNumeric())
+        {
+            object->SetItem(propertyRecord->GetNumericValue(), value, Js::PropertyOperation_None);
+        }
+        else
+        {
+            Js::JavascriptOperators::InitProperty(object, propertyRecord->GetPropertyId(), value);
+        }
+    }
+}
+
+Js::Var JsrtValueDeserializer::ReadJSDate()
+{
+    double value;
+    if (!this->ReadDouble(&value))
+    {
+        return nullptr;
+    }
+
+    uint32 id = this->nextId++;
+    Js::Var date = this->scriptContext->GetLibrary()->CreateDate(value);
+    this->AddObjectWithId(id, date);
+    return date;
+}
+
+Js::Var JsrtValueDeserializer::ReadJSValue(byte tag)
+{
+    Js::JavascriptLibrary * library = this->scriptContext->GetLibrary();
+    uint32 id = this->nextId++;
+    Js::Var object = nullptr;
+
+    switch (tag)
+    {
+    case SerializationTag_TrueObject:
+        object = library->CreateBooleanObject(TRUE);
+        break;
+
+    case SerializationTag_FalseObject:
+        object = library->CreateBooleanObject(FALSE);
+        break;
+
+    case SerializationTag_NumberObject:
+        {
+            double value;
+            if (!this->ReadDouble(&value))
+            {
+                return nullptr;
+            }
+            object = library->CreateNumberObject(Js::JavascriptNumber::ToVarIntCheck(value, this->scriptContext));
+        }
+        break;
+
+    case SerializationTag_StringObject:
+        {
+            Js::JavascriptString * value = this->ReadString();
+            if (value == nullptr)
+            {
+                return nullptr;
+            }
+            object = library->CreateStringObject(value);
+        }
+        break;
+
+    default:
+        Assert(UNREACHED);
+        return nullptr;
+    }
+
+    this->AddObjectWithId(id, object);
+    return object;
+}
+
+Js::Var JsrtValueDeserializer::ReadJSRegExp()
+{
+    uint32 id = this->nextId++;
+    Js::JavascriptString * source = this->ReadString();
+    uint32 v8Flags;
+    if (source == nullptr || !this->ReadVarint32(&v8Flags))
+    {
+        return nullptr;
+    }
+
+    const uint32 knownFlags = RegExpFlagGlobal | RegExpFlagIgnoreCase | RegExpFlagMultiline | RegExpFlagSticky | RegExpFlagUnicode;
+    if ((v8Flags & ~knownFlags) != 0)
+    {
+        return nullptr;
+    }
+
+    uint32 flags = UnifiedRegex::NoRegexFlags;
+    flags |= (v8Flags & RegExpFlagGlobal) ? UnifiedRegex::GlobalRegexFlag : 0;
+    flags |= (v8Flags & RegExpFlagIgnoreCase) ? UnifiedRegex::IgnoreCaseRegexFlag : 0;
+    flags |= (v8Flags & RegExpFlagMultiline) ? UnifiedRegex::MultilineRegexFlag : 0;
+    flags |= (v8Flags & RegExpFlagSticky) ? UnifiedRegex::StickyRegexFlag : 0;
+    flags |= (v8Flags & RegExpFlagUnicode) ? UnifiedRegex::UnicodeRegexFlag : 0;
+
+    Js::JavascriptRegExp * regExp = Js::JavascriptRegExp::CreateRegEx(source->GetString(), source->GetLength(),
+        static_cast<UnifiedRegex::RegexFlags>(flags), this->scriptContext);
+    this->AddObjectWithId(id, regExp);
+    return regExp;
+}
+
+Js::Var JsrtValueDeserializer::ReadJSMap()
+{
+    uint32 id = this->nextId++;
+    Js::JavascriptMap * map = this->scriptContext->GetLibrary()->CreateMap();
+    this->AddObjectWithId(id, map);
+
+    uint32 length = 0;
+    while (true)
+    {
+        byte tag;
+        if (!this->PeekTag(&tag))
+        {
+            return nullptr;
+        }
+
+        if (tag == SerializationTag_EndJSMap)
+        {
+            this->ReadTag(&tag);
+            break;
+        }
+
+        Js::Var key = this->ReadObject();
+        Js::Var value = this->ReadObject();
+        map->Set(key, value);
+        length += 2;
+    }
+
+    uint32 expectedLength;
+    if (!this->ReadVarint32(&expectedLength) || length != expectedLength)
+    {
+        return nullptr;
+    }
+    return map;
+}
+
+Js::Var JsrtValueDeserializer::ReadJSSet()
+{
+    uint32 id = this->nextId++;
+    Js::JavascriptSet * set = this->scriptContext->GetLibrary()->CreateSet();
+    this->AddObjectWithId(id, set);
+
+    uint32 length = 0;
+    while (true)
+    {
+        byte tag;
+        if (!this->PeekTag(&tag))
+        {
+            return nullptr;
+        }
+
+        if (tag == SerializationTag_EndJSSet)
+        {
+            this->ReadTag(&tag);
+            break;
+        }
+
+        set->Add(this->ReadObject());
+        length++;
+    }
+
+    uint32 expectedLength;
+    if (!this->ReadVarint32(&expectedLength) || length != expectedLength)
+    {
+        return nullptr;
+    }
+    return set;
+}
+
+Js::Var JsrtValueDeserializer::ReadJSArrayBuffer()
+{
+    uint32 id = this->nextId++;
+    uint32 byteLength;
+    const byte * bytes;
+    if (!this->ReadVarint32(&byteLength) || !this->ReadRawBytes(byteLength, &bytes))
+    {
+        return nullptr;
+    }
+
+    Js::ArrayBuffer * arrayBuffer = this->scriptContext->GetLibrary()->CreateArrayBuffer(byteLength);
+    if (byteLength != 0)
+    {
+        memcpy(arrayBuffer->GetBuffer(), bytes, byteLength);
+    }
+    this->AddObjectWithId(id, arrayBuffer);
+    return arrayBuffer;
+}
+
+Js::Var JsrtValueDeserializer::ReadTransferredJSArrayBuffer()
+{
+    uint32 id = this->nextId++;
+    uint32 transferId;
+    Js::Var arrayBuffer;
+    if (!this->ReadVarint32(&transferId) || this->transferMap == nullptr ||
+        !this->transferMap->TryGetValue(transferId, &arrayBuffer))
+    {
+        return nullptr;
+    }
+
+    this->AddObjectWithId(id, arrayBuffer);
+    return arrayBuffer;
+}
+
+Js::Var JsrtValueDeserializer::ReadJSArrayBufferView(Js::ArrayBufferBase * arrayBuffer)
+{
+    uint32 bufferByteLength = arrayBuffer->GetByteLength();
+    uint32 subtag;
+    uint32 byteOffset;
+    uint32 byteLength;
+    if (!this->ReadVarint32(&subtag) || !this->ReadVarint32(&byteOffset) || !this->ReadVarint32(&byteLength) ||
+        byteOffset > bufferByteLength || byteLength > bufferByteLength - byteOffset)
+    {
+        return nullptr;
+    }
+
+    Js::JavascriptLibrary * library = this->scriptContext->GetLibrary();
+    uint32 id = this->nextId++;
+
+    if (subtag == DataViewTag)
+    {
+        Js::Var dataView = library->CreateDataView(arrayBuffer, byteOffset, byteLength);
+        this->AddObjectWithId(id, dataView);
+        return dataView;
+    }
+
+    Js::JavascriptFunction * constructor = nullptr;
+    uint32 elementSize = 0;
+    switch (subtag)
+    {
+    case 'b': constructor = library->GetInt8ArrayConstructor(); elementSize = 1; break;
+    case 'B': constructor = library->GetUint8ArrayConstructor(); elementSize = 1; break;
+    case 'C': constructor = library->GetUint8ClampedArrayConstructor(); elementSize = 1; break;
+    case 'w': constructor = library->GetInt16ArrayConstructor(); elementSize = 2; break;
+    case 'W': constructor = library->GetUint16ArrayConstructor(); elementSize = 2; break;
+    case 'd': constructor = library->GetInt32ArrayConstructor(); elementSize = 4; break;
+    case 'D': constructor = library->GetUint32ArrayConstructor(); elementSize = 4; break;
+    case 'f': constructor = library->GetFloat32ArrayConstructor(); elementSize = 4; break;
+    case 'F': constructor = library->GetFloat64ArrayConstructor(); elementSize = 8; break;
+    default:
+        return nullptr;
+    }
+
+    if (byteOffset % elementSize != 0 || byteLength % elementSize != 0)
+    {
+        return nullptr;
+    }
+
+    Js::Var values[4] =
+    {
+        library->GetUndefined(),
+        arrayBuffer,
+        Js::JavascriptNumber::ToVar(byteOffset, this->scriptContext),
+        Js::JavascriptNumber::ToVar(byteLength / elementSize, this->scriptContext)
+    };
+    Js::CallInfo info(Js::CallFlags_New, 4);
+    Js::Arguments args(info, values);
+
+    Js::Var typedArray = Js::JavascriptFunction::CallAsConstructor(constructor, /* overridingNewTarget = */nullptr, args, this->scriptContext);
+    this->AddObjectWithId(id, typedArray);
+    return typedArray;
+}
+
+Js::Var JsrtValueDeserializer::ReadHostObject()
+{
+    if (this->readHostObject == nullptr)
+    {
+        return nullptr;
+    }
+
+    uint32 id = this->nextId++;
+    Js::Var object = nullptr;
+    BEGIN_INTERCEPTOR(this->scriptContext)
+    {
+        object = this->readHostObject(this->callbackState);
+    }
+    END_INTERCEPTOR(this->scriptContext);
+
+    if (object == nullptr || !Js::JavascriptOperators::IsObject(object))
+    {
+        return nullptr;
+    }
+
+    this->AddObjectWithId(id, object);
+    return object;
+}
@@ -0,0 +1,141 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "ChakraCore.h"
+
+// Structured clone in the wire format of V8's ValueSerializer (version 13), so the bytes can be
+// exchanged with V8 based hosts. Objects are written once and get an id in the order they are
+// first seen; later references to them are written as the id. Plain objects are walked with the
+// property enumeration of their type handler, other objects through the generic own enumerable
+// property lookup. The buffer is allocated and owned through the host's callbacks.
+class JsrtValueSerializer
+{
+public:
+    JsrtValueSerializer(Js::ScriptContext * scriptContext, const JsValueSerializerCallbacks * callbacks, void * callbackState);
+    ~JsrtValueSerializer();
+
+    Js::ScriptContext * GetScriptContext() const { return this->scriptContext; }
+
+    void WriteHeader();
+    void WriteValue(Js::Var value);
+    void TransferArrayBuffer(uint32 transferId, Js::Var arrayBuffer);
+    void SetTreatArrayBufferViewsAsHostObjects(bool mode) { this->treatArrayBufferViewsAsHostObjects = mode; }
+
+    bool WriteVarint(uint64 value);
+    bool WriteDouble(double value);
+    bool WriteRawBytes(const void * source, size_t length);
+    void ReleaseBuffer(void ** buffer, size_t * size);
+
+private:
+    typedef JsUtil::BaseDictionary<Js::Var, uint32, Recycler> ObjectIdMap;
+
+    byte * ReserveRawBytes(size_t length);
+    void WriteTag(byte tag);
+    void WriteZigZag(int32 value);
+    void WriteNumber(double value);
+    void WriteString(Js::JavascriptString * string);
+
+    void WriteObject(Js::Var value);
+    void WriteReceiver(Js::RecyclableObject * object);
+    void WriteJSObject(Js::DynamicObject * object);
+    void WriteJSArray(Js::JavascriptArray * array);
+    uint32 WriteProperties(Js::RecyclableObject * object, Js::JavascriptArray * keys);
+    void WriteJSValue(Js::RecyclableObject * object);
+    void WriteJSRegExp(Js::JavascriptRegExp * regExp);
+    void WriteJSMap(Js::JavascriptMap * map);
+    void WriteJSSet(Js::JavascriptSet * set);
+    void WriteJSArrayBuffer(Js::ArrayBufferBase * arrayBuffer);
+    void WriteJSArrayBufferView(Js::RecyclableObject * view);
+    void WriteHostObject(Js::RecyclableObject * object);
+
+    Js::JavascriptArray * GetOwnPropertyKeys(Js::DynamicObject * object);
+    Js::JavascriptString * GetDescription(Js::Var value);
+    void ThrowIfOutOfMemory();
+    void __declspec(noreturn) ThrowDataCloneError(int32 hCode, Js::Var value);
+
+    Js::ScriptContext * scriptContext;
+    Recycler * recycler;
+    JsValueSerializerCallbacks callbacks;
+    void * callbackState;
+
+    byte * buffer;
+    size_t bufferSize;
+    size_t bufferCapacity;
+    bool outOfMemory;
+    bool treatArrayBufferViewsAsHostObjects;
+
+    // Both maps are pinned with a root reference while the serializer lives
+    uint32 nextId;
+    ObjectIdMap * idMap;
+    ObjectIdMap * transferMap;
+};
+
+// Reads data written by JsrtValueSerializer or V8's ValueSerializer. Objects are added to the id
+// map as soon as they are created, before their contents are read, so back references to objects
+// that are still being read resolve.
+class JsrtValueDeserializer
+{
+public:
+    JsrtValueDeserializer(Js::ScriptContext * scriptContext, const byte * data, size_t size,
+        JsDeserializerReadHostObjectCallback readHostObject, void * callbackState);
+    ~JsrtValueDeserializer();
+
+    Js::ScriptContext * GetScriptContext() const { return this->scriptContext; }
+
+    void ReadHeader();
+    Js::Var ReadValue();
+    void TransferArrayBuffer(uint32 transferId, Js::Var arrayBuffer);
+    uint32 GetWireFormatVersion() const { return this->version; }
+
+    bool ReadVarint(uint64 * value);
+    bool ReadDouble(double * value);
+    bool ReadRawBytes(size_t length, const byte ** data);
+
+private:
+    typedef JsUtil::BaseDictionary<uint32, Js::Var, Recycler> IdObjectMap;
+
+    bool ReadTag(byte * tag);
+    bool PeekTag(byte * tag);
+    bool ReadVarint32(uint32 * value);
+    bool ReadZigZag(int32 * value);
+
+    Js::Var ReadObject();
+    Js::Var ReadObjectInternal();
+    Js::JavascriptString * ReadString();
+    Js::JavascriptString * ReadOneByteString();
+    Js::JavascriptString * ReadTwoByteString();
+    Js::JavascriptString * ReadUtf8String();
+    Js::Var ReadObjectReference();
+    Js::Var ReadJSObject();
+    Js::Var ReadSparseJSArray();
+    Js::Var ReadDenseJSArray();
+    bool ReadProperties(Js::RecyclableObject * object, byte endTag, uint32 * count);
+    Js::Var ReadJSDate();
+    Js::Var ReadJSValue(byte tag);
+    Js::Var ReadJSRegExp();
+    Js::Var ReadJSMap();
+    Js::Var ReadJSSet();
+    Js::Var ReadJSArrayBuffer();
+    Js::Var ReadTransferredJSArrayBuffer();
+    Js::Var ReadJSArrayBufferView(Js::ArrayBufferBase * arrayBuffer);
+    Js::Var ReadHostObject();
+
+    void AddObjectWithId(uint32 id, Js::Var object);
+
+    Js::ScriptContext * scriptContext;
+    Recycler * recycler;
+    JsDeserializerReadHostObjectCallback readHostObject;
+    void * callbackState;
+
+    const byte * position;
+    const byte * end;
+    uint32 version;
+
+    // Both maps are pinned with a root reference while the deserializer lives
+    uint32 nextId;
+    IdObjectMap * idMap;
+    IdObjectMap * transferMap;
+};
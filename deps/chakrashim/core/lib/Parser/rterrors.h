@@ -364,6 +364,11 @@ RT_ERROR_MSG(JSERR_CannotSuspendBuffer, 5665, "", "Current agent cannot be suspe
 RT_ERROR_MSG(JSERR_CantDeleteNonConfigProp, 5666, "Cannot delete non-configurable property '%s'", "Cannot delete non-configurable property", kjstTypeError, 0)
 RT_ERROR_MSG(JSERR_CantRedefineProp, 5667, "Cannot redefine property '%s'", "Cannot redefine property", kjstTypeError, 0)
 RT_ERROR_MSG(JSERR_FunctionArgument_NeedArrayLike, 5668, "%s: argument is not an array or array-like object", "Array or array-like object expected", kjstTypeError, 0)
+RT_ERROR_MSG(JSERR_DataCloneError, 5669, "%s could not be cloned.", "Object could not be cloned.", kjstError, 0)
+RT_ERROR_MSG(JSERR_DataCloneOutOfMemory, 5670, "", "Data cannot be cloned, out of memory.", kjstError, 0)
+RT_ERROR_MSG(JSERR_DataCloneDetachedArrayBuffer, 5671, "", "An ArrayBuffer is detached and could not be cloned.", kjstError, 0)
+RT_ERROR_MSG(JSERR_DataCloneDeserializationError, 5672, "", "Unable to deserialize cloned data.", kjstError, 0)
+RT_ERROR_MSG(JSERR_DataCloneDeserializationVersionError, 5673, "", "Unable to deserialize cloned data due to invalid or unsupported version.", kjstError, 0)
 
 // WebAssembly Errors
 RT_ERROR_MSG(WASMERR_WasmCompileError, 7000, "%s", "Compilation failed.", kjstWebAssemblyCompileError, 0)
@@ -33,6 +33,7 @@ const size_t Constants::StackLimitForScriptInterrupt = 0x7fffffffffffffff;
 #else
 const size_t Constants::StackLimitForScriptInterrupt = 0x7fffffff;
 #endif
+const size_t Constants::StackLimitForStackSample = Constants::StackLimitForScriptInterrupt - 1;
 
 #pragma warning(push)
 #pragma warning(disable:4815) // Allow no storage for zero-sized array at end of NullFrameDisplay struct.
@@ -118,6 +118,7 @@ namespace Js
 #endif
 
         static const size_t StackLimitForScriptInterrupt;
+        static const size_t StackLimitForStackSample;
 
 
         // Arguments object created on the fly is 1 slot before the frame
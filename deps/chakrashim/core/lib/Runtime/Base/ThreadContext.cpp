@@ -120,6 +120,8 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
     jobProcessor(nullptr),
 #endif
     interruptPoller(nullptr),
+    stackSampleCallback(nullptr),
+    stackSampleCallbackContext(nullptr),
     expirableCollectModeGcCount(-1),
     expirableObjectList(nullptr),
     expirableObjectDisposeList(nullptr),
@@ -1619,6 +1621,7 @@ ThreadContext::IsOnStack(void const *ptr)
     FAULTINJECT_SCRIPT_TERMINATION;
     size_t limit = this->stackLimitForCurrentThread;
     Assert(limit == Js::Constants::StackLimitForScriptInterrupt
+        || limit == Js::Constants::StackLimitForStackSample
         || !this->GetStackProber()
         || limit == this->GetStackProber()->GetScriptStackLimit());
     return limit;
@@ -1631,7 +1634,7 @@ ThreadContext::SetStackLimitForCurrentThread(size_t limit)
 
 _NOINLINE //Win8 947081: might use wrong _AddressOfReturnAddress() if this and caller are inlined
 bool
-ThreadContext::IsStackAvailable(size_t size)
+ThreadContext::IsStackAvailable(size_t size, bool* isStackSampleRequested)
 {
     size_t sp = (size_t)_AddressOfReturnAddress();
     size_t stackLimit = this->GetStackLimitForCurrentThread();
@@ -1660,6 +1663,19 @@ ThreadContext::IsStackAvailable(size_t size)
                 Js::Throw::FatalInternalError();
             }
         }
+        else if (stackLimit == Js::Constants::StackLimitForStackSample)
+        {
+            if (isStackSampleRequested != nullptr)
+            {
+                *isStackSampleRequested = true;
+                return false;
+            }
+
+            // Callers that can't take the sample check against the real limit and leave the request
+            // pending for the next stack probe.
+            size_t scriptStackLimit = this->GetStackProber()->GetScriptStackLimit();
+            return sp > size && (sp - size) > scriptStackLimit;
+        }
     }
 
     return false;
@@ -1671,6 +1687,10 @@ ThreadContext::IsStackAvailableNoThrow(size_t size)
 {
     size_t sp = (size_t)_AddressOfReturnAddress();
     size_t stackLimit = this->GetStackLimitForCurrentThread();
+    if (stackLimit == Js::Constants::StackLimitForStackSample)
+    {
+        stackLimit = this->GetStackProber()->GetScriptStackLimit();
+    }
     bool stackAvailable = (sp > stackLimit) && (sp > size) && ((sp - size) > stackLimit);
 
     FAULTINJECT_STACK_PROBE
@@ -1700,16 +1720,26 @@ void
 ThreadContext::ProbeStackNoDispose(size_t size, Js::ScriptContext *scriptContext, PVOID returnAddress)
 {
     AssertCanHandleStackOverflow();
-    if (!this->IsStackAvailable(size))
+    bool isStackSampleRequested = false;
+    if (!this->IsStackAvailable(size, &isStackSampleRequested))
     {
-        if (this->IsExecutionDisabled())
+        if (isStackSampleRequested)
         {
-            // The probe failed because we hammered the stack limit to trigger script interrupt.
-            Assert(this->DoInterruptProbe());
-            throw Js::ScriptAbortException();
+            // The probe failed because the profiler hammered the stack limit to request a sample.
+            this->TakeStackSample(returnAddress);
         }
 
-        Js::Throw::StackOverflow(scriptContext, returnAddress);
+        if (!isStackSampleRequested || !this->IsStackAvailable(size))
+        {
+            if (this->IsExecutionDisabled())
+            {
+                // The probe failed because we hammered the stack limit to trigger script interrupt.
+                Assert(this->DoInterruptProbe());
+                throw Js::ScriptAbortException();
+            }
+
+            Js::Throw::StackOverflow(scriptContext, returnAddress);
+        }
     }
 
 #if defined(NTBUILD) || defined(__IOS__) || defined(__ANDROID__)
@@ -1746,22 +1776,32 @@ ThreadContext::ProbeStack(size_t size, Js::RecyclableObject * obj, Js::ScriptCon
     AssertCanHandleStackOverflowCall(obj->IsExternal() ||
         (Js::JavascriptOperators::GetTypeId(obj) == Js::TypeIds_Function &&
         Js::JavascriptFunction::FromVar(obj)->IsExternalFunction()));
-    if (!this->IsStackAvailable(size))
+    bool isStackSampleRequested = false;
+    if (!this->IsStackAvailable(size, &isStackSampleRequested))
     {
-        if (this->IsExecutionDisabled())
+        if (isStackSampleRequested)
         {
-            // The probe failed because we hammered the stack limit to trigger script interrupt.
-            Assert(this->DoInterruptProbe());
-            throw Js::ScriptAbortException();
+            // The probe failed because the profiler hammered the stack limit to request a sample.
+            this->TakeStackSample(nullptr);
         }
 
-        if (obj->IsExternal() ||
-            (Js::JavascriptOperators::GetTypeId(obj) == Js::TypeIds_Function &&
-            Js::JavascriptFunction::FromVar(obj)->IsExternalFunction()))
+        if (!isStackSampleRequested || !this->IsStackAvailable(size))
         {
-            Js::JavascriptError::ThrowStackOverflowError(scriptContext);
+            if (this->IsExecutionDisabled())
+            {
+                // The probe failed because we hammered the stack limit to trigger script interrupt.
+                Assert(this->DoInterruptProbe());
+                throw Js::ScriptAbortException();
+            }
+
+            if (obj->IsExternal() ||
+                (Js::JavascriptOperators::GetTypeId(obj) == Js::TypeIds_Function &&
+                Js::JavascriptFunction::FromVar(obj)->IsExternalFunction()))
+            {
+                Js::JavascriptError::ThrowStackOverflowError(scriptContext);
+            }
+            Js::Throw::StackOverflow(scriptContext, NULL);
         }
-        Js::Throw::StackOverflow(scriptContext, NULL);
     }
 
 }
@@ -4590,6 +4630,45 @@ void ThreadContext::DisableExecution()
     return;
 }
 
+void ThreadContext::SetStackSampleCallback(StackSampleCallback callback, void * context)
+{
+    this->stackSampleCallback = callback;
+    this->stackSampleCallbackContext = context;
+}
+
+bool ThreadContext::RequestStackSample()
+{
+    // May be called from any thread. Only hammer the normal stack limit, so that a pending script
+    // interrupt or an outstanding sample request is left alone.
+    if (this->GetStackProber() == nullptr || !this->IsScriptActive())
+    {
+        return false;
+    }
+
+    size_t scriptStackLimit = this->GetStackProber()->GetScriptStackLimit();
+    return InterlockedCompareExchangePointer(
+        (PVOID*)&this->stackLimitForCurrentThread,
+        (PVOID)Js::Constants::StackLimitForStackSample,
+        (PVOID)scriptStackLimit) == (PVOID)scriptStackLimit;
+}
+
+void ThreadContext::TakeStackSample(PVOID returnAddress)
+{
+    // Restore the normal stack limit first. If execution was disabled in the meantime the exchange
+    // fails and the interrupt is left in place for the caller to act on.
+    InterlockedCompareExchangePointer(
+        (PVOID*)&this->stackLimitForCurrentThread,
+        (PVOID)this->GetStackProber()->GetScriptStackLimit(),
+        (PVOID)Js::Constants::StackLimitForStackSample);
+
+    // Skip the sample rather than overflow the stack walking it
+    if (this->stackSampleCallback != nullptr && this->IsScriptActive()
+        && this->IsStackAvailableNoThrow(Js::Constants::MinStackRuntime))
+    {
+        this->stackSampleCallback(this->stackSampleCallbackContext, this, returnAddress);
+    }
+}
+
 void ThreadContext::EnableExecution()
 {
     Assert(this->GetStackProber());
@@ -1396,7 +1396,7 @@ public:
     }
 
     static BOOLEAN IsOnStack(void const *ptr);
-    _NOINLINE bool IsStackAvailable(size_t size);
+    _NOINLINE bool IsStackAvailable(size_t size, bool* isStackSampleRequested = nullptr);
     _NOINLINE bool IsStackAvailableNoThrow(size_t size = Js::Constants::MinStackDefault);
     static bool IsCurrentStackAvailable(size_t size);
     void ProbeStackNoDispose(size_t size, Js::ScriptContext *scriptContext, PVOID returnAddress = nullptr);
@@ -1604,6 +1604,16 @@ public:
     }
     void DisableExecution();
     void EnableExecution();
+
+    // Sampling profiler support: a sample request hammers the stack limit (like DisableExecution) so
+    // that the next stack probe on the script thread calls back with the current stack.
+    typedef void (*StackSampleCallback)(void * context, ThreadContext * threadContext, PVOID returnAddress);
+    void SetStackSampleCallback(StackSampleCallback callback, void * context);
+    bool RequestStackSample();
+    bool IsStackSampleRequested() const
+    {
+        return this->stackLimitForCurrentThread == Js::Constants::StackLimitForStackSample;
+    }
     bool TestThreadContextFlag(ThreadContextFlags threadContextFlag) const;
     void SetThreadContextFlag(ThreadContextFlags threadContextFlag);
     void ClearThreadContextFlag(ThreadContextFlags threadContextFlag);
@@ -1668,6 +1678,10 @@ private:
 
     InterruptPoller *interruptPoller;
 
+    StackSampleCallback stackSampleCallback;
+    void * stackSampleCallbackContext;
+    void TakeStackSample(PVOID returnAddress);
+
     void CollectionCallBack(RecyclerCollectCallBackFlags flags);
 
     // Cache used by HostDispatch::GetBuiltInOperationFromEntryPoint
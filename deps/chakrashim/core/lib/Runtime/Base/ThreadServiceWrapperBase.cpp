@@ -11,7 +11,8 @@ ThreadServiceWrapperBase::ThreadServiceWrapperBase() :
     inIdleCollect(false),
     hasScheduledIdleCollect(false),
     shouldScheduleIdleCollectOnExitIdle(false),
-    forceIdleCollectOnce(false)
+    forceIdleCollectOnce(false),
+    needIdleDecommit(false)
 {
 }
 
@@ -150,6 +151,75 @@ bool ThreadServiceWrapperBase::IdleCollect()
     return hasScheduledIdleCollect;
 }
 
+// Does as much of the idle work as the host's idle time allows, without waiting for the
+// scheduled idle collection to be due. Returns true if nothing is left to do until script runs.
+bool ThreadServiceWrapperBase::IdleCollectUntil(unsigned int deadlineTicks)
+{
+    // Don't do anything if we are called recursively or if we are in script
+    if (inIdleCollect || threadContext->IsInScript())
+    {
+        return false;
+    }
+
+    AutoBooleanToggle autoInIdleCollect(&inIdleCollect);
+    Recycler* recycler = threadContext->GetRecycler();
+#if ENABLE_CONCURRENT_GC
+    // Only finishes the concurrent collection if the background thread is done with it
+    if (recycler->CollectionInProgress() && recycler->FinishConcurrent<FinishConcurrentOnIdle>())
+    {
+        IDLE_COLLECT_TRACE(_u("Idle notification: finish concurrent\n"));
+        JS_ETW(EventWriteJSCRIPT_GC_IDLE_CALLBACK_FINISH(this));
+    }
+#endif
+
+    // If a GC is still happening, wait for the next idle notification
+    if (recycler->CollectionInProgress())
+    {
+        return false;
+    }
+
+    if (needIdleCollect)
+    {
+        int timeLeft = deadlineTicks - GetTickCount();
+        if (timeLeft <= 0)
+        {
+            IDLE_COLLECT_TRACE(_u("Idle notification: no time left for collection\n"));
+            return false;
+        }
+
+        // Start the idle collection early, it trims the thread's caches and runs concurrently
+        IDLE_COLLECT_TRACE(_u("Idle notification: collection: %d\n"), timeLeft);
+        JS_ETW(EventWriteJSCRIPT_GC_IDLE_CALLBACK_NEWCOLLECT(this));
+
+        needIdleCollect = false;
+        recycler->CollectNow<CollectOnScriptIdle>();
+
+        if (recycler->CollectionInProgress())
+        {
+            return false;
+        }
+    }
+
+    if (needIdleDecommit)
+    {
+        IDLE_COLLECT_TRACE(_u("Idle notification: decommit\n"));
+
+        needIdleDecommit = false;
+        recycler->ForEachPageAllocator([](IdleDecommitPageAllocator* pageAlloc)
+        {
+            pageAlloc->DecommitNow();
+        });
+    }
+
+    // Nothing is left for the scheduled idle collection either
+    if (hasScheduledIdleCollect)
+    {
+        FinishIdleCollect(FinishReason::FinishReasonNormal);
+    }
+
+    return true;
+}
+
 void ThreadServiceWrapperBase::FinishIdleCollect(ThreadServiceWrapperBase::FinishReason reason)
 {
     Assert(reason == FinishReason::FinishReasonIdleTimerSetupFailed ||
@@ -187,6 +257,9 @@ bool ThreadServiceWrapperBase::ScheduleNextCollectOnExit()
 
     needIdleCollect = forceIdleCollectOnce || recycler->ShouldIdleCollectOnExit();
 
+    // Script ran, so pages may have been freed that the host's idle time can decommit
+    needIdleDecommit = true;
+
     if (needIdleCollect)
     {
         // Set up when we will do the idle decommit
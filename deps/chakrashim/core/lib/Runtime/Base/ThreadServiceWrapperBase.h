@@ -34,6 +34,7 @@ protected:
     void Shutdown();
 
     bool IdleCollect();
+    bool IdleCollectUntil(unsigned int deadlineTicks);
     void FinishIdleCollect(FinishReason reason);
     void ClearForceOneIdleCollection();
 
@@ -57,6 +58,7 @@ private:
     unsigned int tickCountNextIdleCollection;
     bool hasScheduledIdleCollect;
     bool shouldScheduleIdleCollectOnExitIdle;
+    bool needIdleDecommit;
 };
 
 
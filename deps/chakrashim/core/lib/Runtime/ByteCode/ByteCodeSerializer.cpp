@@ -4146,6 +4146,49 @@ HRESULT ByteCodeSerializer::SerializeToBuffer(ScriptContext * scriptContext, Are
     return hr;
 }
 
+uint32 ByteCodeSerializer::GetVersionHash()
+{
+    DWORD versions[4] = { 0, 0, 0, 0 };
+    switch (CurrentFileVersionScheme)
+    {
+    case EngineeringVersioningScheme:
+        Js::VerifyOkCatastrophic(AutoSystemInfo::GetJscriptFileVersion(&versions[0], &versions[1], &versions[2], &versions[3]));
+        break;
+
+    case ReleaseVersioningScheme:
+        memcpy(versions, &byteCodeCacheReleaseFileVersion, sizeof(versions));
+        break;
+
+    default:
+        Throw::InternalError();
+        break;
+    }
+
+    // FNV-1a over everything ReadHeader validates for non-library byte code
+    uint32 hash = 2166136261u;
+    auto combine = [&hash](uint32 value)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            hash = (hash ^ ((value >> (i * 8)) & 0xff)) * 16777619u;
+        }
+    };
+
+    combine(magicConstant);
+    combine(CurrentFileVersionScheme);
+    for (DWORD version : versions)
+    {
+        combine(version);
+    }
+    combine(majorVersionConstant);
+    combine(minorVersionConstant);
+    combine(magicArchitecture);
+    combine(sizeof(unaligned FunctionBody));
+    combine(TotalNumberOfBuiltInProperties);
+    combine((uint32)OpCode::Count);
+    return hash;
+}
+
 HRESULT ByteCodeSerializer::DeserializeFromBuffer(ScriptContext * scriptContext, uint32 scriptFlags, LPCUTF8 utf8Source, SRCINFO const * srcInfo, byte * buffer, NativeModule *nativeModule, Field(FunctionBody*)* function, uint sourceIndex)
 {
     return ByteCodeSerializer::DeserializeFromBufferInternal(scriptContext, scriptFlags, utf8Source, /* sourceHolder */ nullptr, srcInfo, buffer, nativeModule, function, sourceIndex);
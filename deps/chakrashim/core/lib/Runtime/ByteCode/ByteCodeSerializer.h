@@ -168,6 +168,10 @@ namespace Js
 
         static void ReadSourceInfo(const DeferDeserializeFunctionInfo* deferredFunction, int& lineNumber, int& columnNumber, bool& m_isEval, bool& m_isDynamicFunction);
 
+        // Hash of the version and architecture that DeserializeFromBuffer checks serialized (non-library) byte code against.
+        // Byte code serialized by an engine with a different hash is rejected.
+        static uint32 GetVersionHash();
+
     private:
         static HRESULT DeserializeFromBufferInternal(ScriptContext * scriptContext, uint32 scriptFlags, LPCUTF8 utf8Source, ISourceHolder* sourceHolder, SRCINFO const * srcInfo, byte * buffer, NativeModule *nativeModule, Field(FunctionBody*)* function, uint sourceIndex = Js::Constants::InvalidSourceIndex);
     };
@@ -1039,6 +1039,52 @@ namespace Js
         END_TRANSLATE_EXCEPTION_AND_ERROROBJECT_TO_HRESULT_INSCRIPT(hr)
     }
 
+    // Capture the frames of the current stack for Error.captureStackTrace. If skipUntil is given, only the frames
+    // below its most recent call are captured, and none if it isn't on the stack. Nothing is formatted here, the
+    // frames only hold the function body and bytecode offset until the host asks for them.
+    JavascriptExceptionContext::StackTrace* JavascriptExceptionOperators::CaptureStackTrace(ScriptContext& scriptContext, JavascriptFunction* skipUntil, uint64 stackCrawlLimit)
+    {
+        Recycler* recycler = scriptContext.GetRecycler();
+        JavascriptExceptionContext::StackTrace* stackTrace = RecyclerNew(recycler, JavascriptExceptionContext::StackTrace, recycler);
+
+        if (stackCrawlLimit == 0 || !JavascriptStackWalker::IsWalkable(&scriptContext))
+        {
+            return stackTrace;
+        }
+
+        JavascriptStackWalker walker(&scriptContext, true);
+        JavascriptFunction* jsFunc = nullptr;
+        if (!walker.GetDisplayCaller(&jsFunc))
+        {
+            return stackTrace;
+        }
+
+        if (skipUntil != nullptr)
+        {
+            while (jsFunc != skipUntil && StackScriptFunction::GetCurrentFunctionObject(jsFunc) != skipUntil)
+            {
+                if (!walker.GetDisplayCaller(&jsFunc))
+                {
+                    return stackTrace;
+                }
+            }
+
+            if (!walker.GetDisplayCaller(&jsFunc))
+            {
+                return stackTrace;
+            }
+        }
+
+        uint64 i = 1;
+        do
+        {
+            JavascriptExceptionContext::StackFrame stackFrame(jsFunc, walker, false);
+            stackTrace->Add(stackFrame);
+        } while (i++ < stackCrawlLimit && walker.GetDisplayCaller(&jsFunc));
+
+        return stackTrace;
+    }
+
     Var JavascriptExceptionOperators::OP_RuntimeTypeError(MessageId messageId, ScriptContext *scriptContext)
     {
         JavascriptError::ThrowTypeError(scriptContext, MAKE_HR(messageId));
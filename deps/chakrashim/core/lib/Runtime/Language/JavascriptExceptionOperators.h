@@ -79,6 +79,7 @@ namespace Js
         static void WalkStackForExceptionContext(ScriptContext& scriptContext, JavascriptExceptionContext& exceptionContext, Var thrownObject, uint64 stackCrawlLimit, PVOID returnAddress, bool isThrownException = true, bool resetSatck = false);
         static void AddStackTraceToObject(Var obj, JavascriptExceptionContext::StackTrace* stackTrace, ScriptContext& scriptContext, bool isThrownException = true, bool resetSatck = false);
         static uint64 StackCrawlLimitOnThrow(Var thrownObject, ScriptContext& scriptContext);
+        static JavascriptExceptionContext::StackTrace* CaptureStackTrace(ScriptContext& scriptContext, JavascriptFunction* skipUntil, uint64 stackCrawlLimit);
 
         class EntryInfo
         {
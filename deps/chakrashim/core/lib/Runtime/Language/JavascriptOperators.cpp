@@ -9440,6 +9440,22 @@ CommonNumber:
         throw ScriptAbortException();
     }
 
+    void JavascriptOperators::LoopInterruptProbe()
+    {
+        ThreadContext * threadContext = ThreadContext::GetContextForCurrentThread();
+        if (threadContext->IsStackSampleRequested())
+        {
+            // The profiler hammered the stack limit to request a sample, take it and keep going
+            threadContext->TakeStackSample(_ReturnAddress());
+        }
+
+        if (threadContext->IsExecutionDisabled())
+        {
+            // The probe failed because we hammered the stack limit to trigger script interrupt.
+            throw ScriptAbortException();
+        }
+    }
+
     void PolymorphicInlineCache::Finalize(bool isShutdown)
     {
         if (size == 0)
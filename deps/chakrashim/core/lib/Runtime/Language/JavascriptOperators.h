@@ -581,6 +581,7 @@ namespace Js
         static void * AllocUninitializedNumber(RecyclerJavascriptNumberAllocator * allocator);
 
         static void ScriptAbort();
+        static void LoopInterruptProbe();
 
         class EntryInfo
         {
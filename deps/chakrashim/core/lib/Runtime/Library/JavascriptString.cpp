@@ -196,12 +196,18 @@ namespace Js
         : RecyclableObject(type), m_charLength(0), m_pszValue(nullptr)
     {
         Assert(type->GetTypeId() == TypeIds_String);
+#if TARGET_64
+        m_utf8LengthCache = 0;
+#endif
     }
 
     JavascriptString::JavascriptString(StaticType * type, charcount_t charLength, const char16* szValue)
         : RecyclableObject(type), m_pszValue(szValue)
     {
         Assert(type->GetTypeId() == TypeIds_String);
+#if TARGET_64
+        m_utf8LengthCache = 0;
+#endif
         SetLength(charLength);
     }
 
@@ -236,6 +242,31 @@ namespace Js
         m_pszValue = buffer;
     }
 
+    bool JavascriptString::TryGetCachedUtf8Length(size_t* utf8Length) const
+    {
+#if TARGET_64
+        if (m_utf8LengthCache != 0)
+        {
+            *utf8Length = m_utf8LengthCache - 1;
+            return true;
+        }
+#endif
+        return false;
+    }
+
+    void JavascriptString::CacheUtf8Length(size_t utf8Length)
+    {
+#if TARGET_64
+        // Compound strings can be appended to in place (including from jitted code), so their
+        // content is not stable enough to cache anything about it
+        if (CompoundString::Is(this) || utf8Length >= UINT_MAX)
+        {
+            return;
+        }
+        m_utf8LengthCache = static_cast<uint32>(utf8Length + 1);
+#endif
+    }
+
     bool JavascriptString::IsValidIndexValue(charcount_t idx) const
     {
         return IsValidCharCount(idx) && idx < GetLength();
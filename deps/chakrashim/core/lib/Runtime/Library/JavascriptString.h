@@ -56,6 +56,9 @@ namespace Js
     private:
         Field(const char16*) m_pszValue;         // Flattened, '\0' terminated contents
         Field(charcount_t) m_charLength;          // Length in characters, not including '\0'.
+#if TARGET_64
+        Field(uint32) m_utf8LengthCache;          // UTF8 length + 1 once computed, 0 otherwise. Fits in the padding after m_charLength.
+#endif
 
         static const charcount_t MaxCharLength = INT_MAX - 1;  // Max number of chars not including '\0'.
 
@@ -185,6 +188,11 @@ namespace Js
     public:
         bool IsFinalized() const { return this->UnsafeGetBuffer() != NULL; }
 
+        // Hosts that encode strings for output repeatedly can remember the UTF8 length here.
+        // Only available on 64-bit targets; elsewhere nothing is cached.
+        bool TryGetCachedUtf8Length(size_t* utf8Length) const;
+        void CacheUtf8Length(size_t utf8Length);
+
     public:
         static JavascriptString* NewWithSz(__in_z const char16 * content, ScriptContext* scriptContext);
         static JavascriptString* NewWithBuffer(__in_ecount(charLength) const char16 * content, charcount_t charLength, ScriptContext * scriptContext);
@@ -228,6 +236,13 @@ namespace Js
             return offsetof(JavascriptString, m_charLength);
         }
 
+#if TARGET_64
+        static uint32 GetOffsetOfUtf8LengthCache()
+        {
+            return offsetof(JavascriptString, m_utf8LengthCache);
+        }
+#endif
+
 
         class EntryInfo
         {
@@ -66,9 +66,12 @@ class Platform {
   };
 
   virtual ~Platform() {}
+  virtual size_t NumberOfAvailableBackgroundThreads() { return 0; }
   virtual void CallOnBackgroundThread(Task* task,
                                       ExpectedRuntime expected_runtime) = 0;
   virtual void CallOnForegroundThread(Isolate* isolate, Task* task) = 0;
+  virtual void CallDelayedOnForegroundThread(Isolate* isolate, Task* task,
+                                             double delay_in_seconds) = 0;
   virtual double MonotonicallyIncreasingTime() = 0;
 
   /**
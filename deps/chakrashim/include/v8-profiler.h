@@ -32,13 +32,56 @@ namespace v8 {
 
 struct HeapStatsUpdate;
 
-// NOT IMPLEMENTED
+class V8_EXPORT CpuProfileNode {
+ public:
+  struct LineTick {
+    int line;
+    unsigned int hit_count;
+  };
+
+  Local<String> GetFunctionName() const;
+  const char* GetFunctionNameStr() const;
+  int GetScriptId() const;
+  Local<String> GetScriptResourceName() const;
+  const char* GetScriptResourceNameStr() const;
+  int GetLineNumber() const;
+  int GetColumnNumber() const;
+  // Samples are not attributed to source lines
+  unsigned int GetHitLineCount() const { return 0; }
+  bool GetLineTicks(LineTick* entries, unsigned int length) const {
+    return true;
+  }
+  const char* GetBailoutReason() const { return ""; }
+  unsigned GetHitCount() const;
+  unsigned GetNodeId() const;
+  int GetChildrenCount() const;
+  const CpuProfileNode* GetChild(int index) const;
+
+  static const int kNoLineNumberInfo = Message::kNoLineNumberInfo;
+  static const int kNoColumnNumberInfo = Message::kNoColumnInfo;
+};
+
+class V8_EXPORT CpuProfile {
+ public:
+  Local<String> GetTitle() const;
+  const CpuProfileNode* GetTopDownRoot() const;
+  int GetSamplesCount() const;
+  const CpuProfileNode* GetSample(int index) const;
+  int64_t GetSampleTimestamp(int index) const;
+  int64_t GetStartTime() const;
+  int64_t GetEndTime() const;
+  void Delete();
+};
+
+// Samples are taken by the script thread at its next function call or loop
+// iteration after each sampling interval, so the thread isn't suspended.
+// Only one profile is recorded at a time.
 class V8_EXPORT CpuProfiler {
  public:
-  // void SetSamplingInterval(int us);
-  // void StartProfiling(Handle<String> title, bool record_samples = false);
-  // CpuProfile* StopProfiling(Handle<String> title);
-  void SetIdle(bool is_idle) {}
+  void SetSamplingInterval(int us);
+  void StartProfiling(Local<String> title, bool record_samples = false);
+  CpuProfile* StopProfiling(Local<String> title);
+  void SetIdle(bool is_idle);
 };
 
 class V8_EXPORT OutputStream {  // NOLINT
@@ -56,16 +99,19 @@ class V8_EXPORT OutputStream {  // NOLINT
   }
 };
 
-// NOT IMPLEMENTED
+// Snapshots are taken by the runtime with collection disabled and serialized
+// as the .heapsnapshot JSON read by DevTools. Node ids are only unique within
+// a snapshot, objects are not tracked from one snapshot to the next.
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
     kJSON = 0  // See format description near 'Serialize' method.
   };
 
-  void Delete() { delete this; }
+  int GetNodesCount() const;
+  void Delete();
   void Serialize(OutputStream* stream,
-                 SerializationFormat format = kJSON) const {}
+                 SerializationFormat format = kJSON) const;
 };
 
 class V8_EXPORT ActivityControl {  // NOLINT
@@ -78,7 +124,6 @@ class V8_EXPORT ActivityControl {  // NOLINT
   virtual ControlOption ReportProgressValue(int done, int total) = 0;
 };
 
-// NOT IMPLEMENTED
 class V8_EXPORT HeapProfiler {
  public:
   typedef RetainedObjectInfo *(*WrapperInfoCallback)(
@@ -92,15 +137,15 @@ class V8_EXPORT HeapProfiler {
     virtual ~ObjectNameResolver() {}
   };
 
+  // Global objects are not named by the resolver
   const HeapSnapshot* TakeHeapSnapshot(
       ActivityControl* control = NULL,
-      ObjectNameResolver* global_object_name_resolver = NULL) {
-    return new HeapSnapshot();
-  }
+      ObjectNameResolver* global_object_name_resolver = NULL);
 
   void SetWrapperClassInfoProvider(
     uint16_t class_id, WrapperInfoCallback callback) {}
   void StartTrackingHeapObjects(bool track_allocations = false) {}
+  void StopTrackingHeapObjects() {}
 };
 
 // NOT IMPLEMENTED
@@ -86,6 +86,10 @@
     *(static_cast<T* volatile*>(0)) = static_cast<S*>(0);      \
   }
 
+namespace jsrt {
+class HandleArena;
+}
+
 namespace v8 {
 
 class AccessorSignature;
@@ -313,6 +317,7 @@ class Local {
   friend class RegExp;
   friend class Signature;
   friend class Script;
+  friend class ScriptCompiler;
   friend class StackFrame;
   friend class StackTrace;
   friend class String;
@@ -323,6 +328,8 @@ class Local {
   friend class TryCatch;
   friend class UnboundScript;
   friend class Value;
+  friend class ValueDeserializer;
+  friend class ValueSerializer;
   template <class F> friend class FunctionCallbackInfo;
   template <class F> friend class MaybeLocal;
   template <class F> friend class PersistentBase;
@@ -461,13 +468,15 @@ struct WeakReferenceCallbackWrapper {
 };
 
 // A helper method for setting an object with a WeakReferenceCallback. The
-// callback will be called before the object is released.
-V8_EXPORT void SetObjectWeakReferenceCallback(
+// callback will be called before the object is released. External objects
+// keep the callback themselves and leave *weakWrapper untouched, others get a
+// wrapper allocated in *weakWrapper. Returns false if nothing was set.
+V8_EXPORT bool SetObjectWeakReferenceCallback(
   JsValueRef object,
   WeakCallbackInfo<void>::Callback callback,
   void* parameters,
   WeakReferenceCallbackWrapper** weakWrapper);
-V8_EXPORT void SetObjectWeakReferenceCallback(
+V8_EXPORT bool SetObjectWeakReferenceCallback(
   JsValueRef object,
   WeakCallbackData<Value, void>::Callback callback,
   void* parameters,
@@ -546,7 +555,8 @@ class PersistentBase {
   template <class F> friend class Global;
 
   explicit V8_INLINE PersistentBase(T* val)
-      : val_(val), _weakWrapper(nullptr) {}
+      : val_(val), _weakWrapper(nullptr), _weakParameters(nullptr),
+        _isWeak(false) {}
   PersistentBase(PersistentBase& other) = delete;  // NOLINT
   void operator=(PersistentBase&) = delete;
   V8_INLINE static T* New(Isolate* isolate, T* that);
@@ -555,7 +565,10 @@ class PersistentBase {
   void SetWeakCommon(P* parameter, Callback callback);
 
   T* val_;
+  // Only set for weak handles of objects that aren't external objects
   chakrashim::WeakReferenceCallbackWrapper* _weakWrapper;
+  void* _weakParameters;
+  bool _isWeak;
 };
 
 
@@ -689,8 +702,12 @@ class Global : public PersistentBase<T> {
 
   V8_INLINE Global(Global&& other) : PersistentBase<T>(other.val_) {
     this->_weakWrapper = other._weakWrapper;
+    this->_weakParameters = other._weakParameters;
+    this->_isWeak = other._isWeak;
     other.val_ = nullptr;
     other._weakWrapper = nullptr;
+    other._weakParameters = nullptr;
+    other._isWeak = false;
   }
 
   V8_INLINE ~Global() { this->Reset(); }
@@ -702,8 +719,12 @@ class Global : public PersistentBase<T> {
       this->Reset();
       this->val_ = rhs.val_;
       this->_weakWrapper = rhs._weakWrapper;
+      this->_weakParameters = rhs._weakParameters;
+      this->_isWeak = rhs._isWeak;
       rhs.val_ = nullptr;
       rhs._weakWrapper = nullptr;
+      rhs._weakParameters = nullptr;
+      rhs._isWeak = false;
     }
     return *this;
   }
@@ -754,16 +775,19 @@ class V8_EXPORT HandleScope {
 
  private:
   friend class EscapableHandleScope;
+  friend class Isolate;
   template <class T> friend class Local;
   static const int kOnStackLocals = 8;  // Arbitrary number of refs on stack
 
   HandleScope *_prev;
 
-  // Save some refs on stack. 1st element on stack
-  // is the JavascriptArray where other refs go.
-  JsValueRef _locals[kOnStackLocals + 1];
+  // Save some refs on stack, the rest go to the isolate's handle arena
+  // starting at _arenaMark.
+  JsValueRef _locals[kOnStackLocals];
   int _count;
   JsContextRef _contextRef;
+  jsrt::HandleArena *_arena;
+  size_t _arenaMark;
   struct AddRefRecord {
     JsRef _ref;
     AddRefRecord *  _next;
@@ -859,21 +883,33 @@ class V8_EXPORT Script {
 class V8_EXPORT ScriptCompiler {
  public:
   struct CachedData {
-    // CHAKRA-TODO: Not implemented
     enum BufferPolicy {
       BufferNotOwned,
       BufferOwned
     };
 
+    CachedData()
+      : data(nullptr), length(0), rejected(false),
+        buffer_policy(BufferNotOwned) {}
+
+    CachedData(const uint8_t* data, int length,
+               BufferPolicy buffer_policy = BufferNotOwned)
+      : data(data), length(length), rejected(false),
+        buffer_policy(buffer_policy) {}
+
+    ~CachedData() {
+      if (buffer_policy == BufferOwned) {
+        delete[] data;
+      }
+    }
+
     const uint8_t* data;
     int length;
-    bool rejected = true;
+    bool rejected;
     BufferPolicy buffer_policy;
 
-    CachedData();
-    CachedData(const uint8_t* data, int length,
-               BufferPolicy buffer_policy = BufferNotOwned) {
-    }
+    CachedData(const CachedData&) = delete;
+    CachedData& operator=(const CachedData&) = delete;
   };
 
   class Source {
@@ -882,19 +918,27 @@ class V8_EXPORT ScriptCompiler {
       Local<String> source_string,
       const ScriptOrigin& origin,
       CachedData * cached_data = NULL)
-      : source_string(source_string), resource_name(origin.ResourceName()) {
+      : source_string(source_string), resource_name(origin.ResourceName()),
+        cached_data(cached_data) {
     }
 
     Source(Local<String> source_string, CachedData * cached_data = NULL)
-      : source_string(source_string) {
+      : source_string(source_string), cached_data(cached_data) {
     }
 
-    const CachedData* GetCachedData() const { return nullptr; }
+    ~Source() { delete cached_data; }
+
+    // Ownership of the cached data lies with the Source
+    const CachedData* GetCachedData() const { return cached_data; }
 
    private:
     friend ScriptCompiler;
+    Source(const Source&) = delete;
+    Source& operator=(const Source&) = delete;
+
     Local<String> source_string;
     Handle<Value> resource_name;
+    CachedData* cached_data;
   };
 
   enum CompileOptions {
@@ -1037,10 +1081,7 @@ class V8_EXPORT Value : public Data {
   bool IsFloat32Array() const;
   bool IsFloat64Array() const;
   bool IsDataView() const;
-  bool IsSharedArrayBuffer() const {
-    // CHAKRA-TODO Not implemented
-    return false;
-  }
+  bool IsSharedArrayBuffer() const;
   bool IsMapIterator() const;
   bool IsSetIterator() const;
   bool IsMap() const;
@@ -1515,6 +1556,11 @@ class V8_EXPORT Object : public Value {
 
   Isolate* GetIsolate();
   static Local<Object> New(Isolate* isolate = nullptr);
+  // Creates the object with all of its data properties in one engine call.
+  // Objects created with the same names in the same order share one shape.
+  static Local<Object> New(Isolate* isolate, Local<Value> prototype_or_null,
+                           Local<Name>* names, Local<Value>* values,
+                           size_t length);
   static Object *Cast(Value *obj);
 
  private:
@@ -1792,6 +1838,13 @@ class V8_EXPORT Function : public Object {
   V8_WARN_UNUSED_RESULT MaybeLocal<Value> Call(Local<Context> context,
                                                Handle<Value> recv, int argc,
                                                Handle<Value> argv[]);
+  // CHAKRA: Same as Call, for hot host-to-script paths (node::MakeCallback)
+  // that already hold the isolate. Skips the current isolate lookups, and
+  // exceptions are only checked for when the call fails.
+  V8_WARN_UNUSED_RESULT MaybeLocal<Value> FastCall(Isolate* isolate,
+                                                   Handle<Value> recv,
+                                                   int argc,
+                                                   Handle<Value> argv[]);
 
   void SetName(Handle<String> name);
   Local<Value> GetName() const;
@@ -2101,6 +2154,15 @@ public:
 private:
   ValueSerializer(const ValueSerializer&) = delete;
   void operator=(const ValueSerializer&) = delete;
+
+  static void CHAKRA_CALLBACK DataCloneErrorCallback(
+    JsValueRef message, void* callbackState);
+  static bool CHAKRA_CALLBACK WriteHostObjectCallback(
+    JsValueRef object, void* callbackState);
+  static bool CHAKRA_CALLBACK GetSharedArrayBufferIdCallback(
+    JsValueRef shared_array_buffer, unsigned int* id, void* callbackState);
+
+  JsValueSerializerHandle handle_;
 };
 
 class V8_EXPORT ValueDeserializer {
@@ -2131,6 +2193,11 @@ public:
 private:
   ValueDeserializer(const ValueDeserializer&) = delete;
   void operator=(const ValueDeserializer&) = delete;
+
+  static JsValueRef CHAKRA_CALLBACK ReadHostObjectCallback(
+    void* callbackState);
+
+  JsValueDeserializerHandle handle_;
 };
 
 enum AccessType {
@@ -2453,12 +2520,17 @@ class V8_EXPORT HeapStatistics {
 
 class V8_EXPORT HeapSpaceStatistics {
  public:
-  HeapSpaceStatistics() {}
-  const char* space_name() { return ""; }
-  size_t space_size() { return 0; }
-  size_t space_used_size() { return 0; }
-  size_t space_available_size() { return 0; }
-  size_t physical_space_size() { return 0; }
+  HeapSpaceStatistics()
+      : space_name_(""),
+        space_size_(0),
+        space_used_size_(0),
+        space_available_size_(0),
+        physical_space_size_(0) {}
+  const char* space_name() { return space_name_; }
+  size_t space_size() { return space_size_; }
+  size_t space_used_size() { return space_used_size_; }
+  size_t space_available_size() { return space_available_size_; }
+  size_t physical_space_size() { return physical_space_size_; }
 
  private:
   const char* space_name_;
@@ -2734,12 +2806,16 @@ class V8_EXPORT TryCatch {
   friend class Function;
 
   void SetNonUser() { user = false; }
+  // The guarded call returned normally, so there is no exception to clear
+  void SetNoException() { noException = true; }
   void GetAndClearException();
   void CheckReportExternalException();
 
+  Isolate* isolate_;
   JsValueRef error;
   TryCatch* prev;
   bool rethrow;
+  bool noException;
   bool user;
   bool verbose;
 };
@@ -2851,6 +2927,8 @@ void Persistent<T, M>::Copy(const Persistent<S, M2>& that) {
 
   this->val_ = that.val_;
   this->_weakWrapper = that._weakWrapper;
+  this->_weakParameters = that._weakParameters;
+  this->_isWeak = that._isWeak;
   if (this->val_ && !this->IsWeak()) {
     JsAddRef(this->val_, nullptr);
   }
@@ -2865,7 +2943,7 @@ bool PersistentBase<T>::IsNearDeath() const {
 
 template <class T>
 bool PersistentBase<T>::IsWeak() const {
-  return static_cast<bool>(_weakWrapper);
+  return _isWeak;
 }
 
 template <class T>
@@ -2873,11 +2951,11 @@ void PersistentBase<T>::Reset() {
   if (this->IsEmpty() || V8::IsDead()) return;
 
   if (IsWeak()) {
-    if (_weakWrapper) {
-      chakrashim::ClearObjectWeakReferenceCallback(val_, /*revive*/false);
-      delete _weakWrapper;
-      _weakWrapper = nullptr;
-    }
+    chakrashim::ClearObjectWeakReferenceCallback(val_, /*revive*/false);
+    delete _weakWrapper;
+    _weakWrapper = nullptr;
+    _weakParameters = nullptr;
+    _isWeak = false;
   } else {
     JsRelease(val_, nullptr);
   }
@@ -2910,8 +2988,13 @@ void PersistentBase<T>::SetWeakCommon(P* parameter, Callback callback) {
   if (this->IsEmpty()) return;
 
   bool wasStrong = !IsWeak();
-  chakrashim::SetObjectWeakReferenceCallback(val_, callback, parameter,
-                                             &_weakWrapper);
+  if (!chakrashim::SetObjectWeakReferenceCallback(val_, callback, parameter,
+                                                  &_weakWrapper)) {
+    return;
+  }
+
+  _weakParameters = parameter;
+  _isWeak = true;
   if (wasStrong) {
     JsRelease(val_, nullptr);
   }
@@ -2940,12 +3023,12 @@ template <typename P>
 P* PersistentBase<T>::ClearWeak() {
   if (!IsWeak()) return nullptr;
 
-  P* parameters = reinterpret_cast<P*>(_weakWrapper->parameters);
-  if (_weakWrapper) {
-    chakrashim::ClearObjectWeakReferenceCallback(val_, /*revive*/true);
-    delete _weakWrapper;
-    _weakWrapper = nullptr;
-  }
+  P* parameters = reinterpret_cast<P*>(_weakParameters);
+  chakrashim::ClearObjectWeakReferenceCallback(val_, /*revive*/true);
+  delete _weakWrapper;
+  _weakWrapper = nullptr;
+  _weakParameters = nullptr;
+  _isWeak = false;
 
   JsAddRef(val_, nullptr);
   return parameters;
@@ -41,6 +41,8 @@
     Global_ParseInt = parseInt;
   var BuiltInError = Error;
   var global = this;
+  var nativeCaptureStackTrace = keepAlive.nativeCaptureStackTrace;
+  var nativeGetStackTraceFrames = keepAlive.nativeGetStackTraceFrames;
 
   // Simulate V8 JavaScript stack trace API
   function StackFrame(func, funcName, fileName, lineNumber, columnNumber) {
@@ -52,8 +54,8 @@
   }
 
   StackFrame.prototype.getFunction = function() {
-    // TODO: Fix if .stack is called from different callsite
-    // from where Error() or Error.captureStackTrace was called
+    // TODO: Frames are captured natively and don't keep their functions,
+    // like V8 frames of strict mode functions
     return this.function;
   };
 
@@ -118,90 +120,53 @@
     return stackString;
   }
 
-  // Parse 'stack' string into StackTrace frames. Skip top 'skipDepth' frames,
-  // and optionally skip top to 'startName' function frames.
-  function parseStack(stack, skipDepth, startName) {
-    var stackSplitter = /\)\s*at/;
-    var reStackDetails = /\s(?:at\s)?(.*)\s\((.*)/;
-    var fileDetailsSplitter = /:(\d+)/;
+  function getStackTraceLimit() {
+    var limit = BuiltInError.stackTraceLimit;
+    return typeof limit === 'number' ? limit : 0;
+  }
 
-    var curr = parseStack;
-    var splittedStack = stack.split(stackSplitter);
+  // Materialize StackTrace frames from a stack trace captured by
+  // nativeCaptureStackTrace.
+  function getStackFrames(stackTrace) {
     var errstack = [];
+    var frames = stackTrace && nativeGetStackTraceFrames(stackTrace);
+    if (!frames) {
+      return errstack;
+    }
 
-    for (var i = 0; i < splittedStack.length; i++) {
-      // parseStack has 1 frame lesser than skipDepth. So skip calling .caller
-      // once. After that, continue calling .caller
-      if (skipDepth !== 1 && curr) {
-        try {
-          curr = curr.caller;
-        } catch (e) {
-          curr = undefined;  // .caller might not be allowed in curr's context
-        }
-      }
-
-      if (skipDepth-- > 0) {
-        continue;
-      }
-
-      var func = curr;
-      var stackDetails = reStackDetails.exec(splittedStack[i]);
-      var funcName = stackDetails[1];
-
-      if (startName) {
-        if (funcName === startName) {
-          startName = undefined;
-        }
-        continue;
-      }
+    for (var i = 0; i < frames.length; i++) {
+      var frame = frames[i];
+      var funcName = frame.name;
       if (funcName === 'Anonymous function') {
         funcName = null;
       }
 
-      var fileDetails = stackDetails[2].split(fileDetailsSplitter);
-
-      var fileName = fileDetails[0];
-      var lineNumber = fileDetails[1] ? fileDetails[1] : 0;
-      var columnNumber = fileDetails[3] ? fileDetails[3] : 0;
-
-      errstack.push(
-          new StackFrame(func, funcName, fileName, lineNumber, columnNumber));
+      // Native library frames have no position
+      errstack.push(frame.url === undefined ?
+        new StackFrame(undefined, funcName, 'native code', 0, 0) :
+        new StackFrame(undefined, funcName, frame.url, frame.line,
+                       frame.column));
     }
     return errstack;
   }
 
-  function findFuncDepth(func) {
-    if (!func) {
-      return 0;
+  // Chakra resets the stack of an Error object when it is thrown, unless the
+  // stack was set through the builtin accessor. Call that setter once so the
+  // stack accessors defined below are kept.
+  var builtInStackSetter;
+  function keepStackOnThrow(err) {
+    if (!builtInStackSetter) {
+      var desc = Object_getOwnPropertyDescriptor(new BuiltInError(), 'stack');
+      builtInStackSetter = desc && desc.set;
     }
-
-    try {
-      var curr = privateCaptureStackTrace.caller;
-      var limit = Error.stackTraceLimit;
-      var skipDepth = 0;
-      while (curr) {
-        skipDepth++;
-        if (curr === func) {
-          return skipDepth;
-        }
-        if (skipDepth > limit) {
-          return 0;
-        }
-        curr = curr.caller;
-      }
-    } catch (e) {
-      // Strict mode may throw on .caller. Will try to match by function name.
-      return -1;
+    if (builtInStackSetter) {
+      Reflect_apply(builtInStackSetter, err, ['']);
     }
-
-    return 0;
   }
 
-  function withStackTraceLimitOffset(offset, f) {
+  function withoutBuiltInStackTrace(f) {
     var oldLimit = BuiltInError.stackTraceLimit;
-    if (typeof oldLimit === 'number') {
-      BuiltInError.stackTraceLimit = oldLimit + offset;
-    }
+    BuiltInError.stackTraceLimit = 0;
     try {
       return f();
     } finally {
@@ -210,32 +175,25 @@
   }
 
   function captureStackTrace(err, func) {
-    // skip 3 frames: lambda, withStackTraceLimitOffset, this frame
-    return privateCaptureStackTrace(
-      err, func,
-      withStackTraceLimitOffset(3, () => new BuiltInError()),
-      3);
+    privateCaptureStackTrace(err, nativeCaptureStackTrace(
+      typeof func === 'function' ? func : captureStackTrace,
+      getStackTraceLimit()));
   }
 
   // private captureStackTrace implementation
-  //  err, func -- args from Error.captureStackTrace
-  //  e -- a new Error object which already captured stack
-  //  skipDepth -- known number of top frames to be skipped
-  function privateCaptureStackTrace(err, func, e, skipDepth) {
-    var currentStack = e;
+  //  err -- the object to define 'stack' on
+  //  stackTrace -- frames captured by nativeCaptureStackTrace
+  // The frames are only materialized, and prepareStackTrace only called, when
+  // 'stack' is read.
+  function privateCaptureStackTrace(err, stackTrace) {
+    var currentStack;
     var isPrepared = false;
-    var oldStackDesc = Object_getOwnPropertyDescriptor(e, 'stack');
-
-    var funcSkipDepth = findFuncDepth(func);
-    var startFuncName = (func && funcSkipDepth < 0) ? func.name : undefined;
-    skipDepth += Math.max(funcSkipDepth - 1, 0);
 
     var currentStackTrace;
     function ensureStackTrace() {
       if (!currentStackTrace) {
-        currentStackTrace = parseStack(
-          Reflect_apply(oldStackDesc.get, e, []) || '', // Call saved old getter
-          skipDepth, startFuncName);
+        currentStackTrace = getStackFrames(stackTrace);
+        stackTrace = undefined;
       }
       return currentStackTrace;
     }
@@ -250,22 +208,13 @@
     function stackSetter(value) {
       currentStack = value;
       isPrepared = true;
-      // Notify original Error object of this setter call. Without knowing
-      // this Chakra runtime would reset stack at throw time.
-      Reflect_apply(oldStackDesc.set, e, [value]);
     }
 
-    // To retain overriden stackAccessors below,notify Chakra runtime to not
-    // reset stack for this error object.
-    if (e !== err) {
-      Reflect_apply(oldStackDesc.set, err, ['']);
-    }
+    keepStackOnThrow(err);
 
     Object_defineProperty(err, 'stack', {
       get: stackGetter, set: stackSetter, configurable: true, enumerable: false
     });
-
-    return ensureStackTrace; // For chakrashim native to get stack frames
   }
 
   // patch Error types to hook with Error.captureStackTrace/prepareStackTrace
@@ -279,10 +228,12 @@
       URIError
     ].forEach(function(type) {
       function newType() {
-        var e = withStackTraceLimitOffset(
-          3, () => Reflect_construct(type, arguments, new.target || newType));
-        // skip 3 frames: lambda, withStackTraceLimitOffset, this frame
-        privateCaptureStackTrace(e, undefined, e, 3);
+        // The builtin constructor doesn't need to walk the stack, the frames
+        // below this one are captured natively instead
+        var limit = getStackTraceLimit();
+        var e = withoutBuiltInStackTrace(
+          () => Reflect_construct(type, arguments, new.target || newType));
+        privateCaptureStackTrace(e, nativeCaptureStackTrace(newType, limit));
         return e;
       }
 
@@ -426,9 +377,6 @@
     };
   }
 
-  // Simulate v8 micro tasks queue
-  var microTasks = [];
-
   function patchUtils(utils) {
     var isUintRegex = /^(0|[1-9]\d*)$/;
 
@@ -510,8 +458,8 @@
       });
       return props;
     };
-    utils.getStackTrace = function() {
-      return captureStackTrace({}, undefined)();
+    utils.getStackTrace = function getStackTrace(frameLimit) {
+      return getStackFrames(nativeCaptureStackTrace(getStackTrace, frameLimit));
     };
     utils.isMapIterator = function(value) {
       return value[mapIteratorProperty] === true;
@@ -576,6 +524,9 @@
     utils.isSymbolObject = function(obj) {
       return compareType(obj, 'Symbol');
     };
+    utils.isSharedArrayBuffer = function(obj) {
+      return compareType(obj, 'SharedArrayBuffer');
+    };
     utils.isName = function(obj) {
       return compareType(obj, 'String') || compareType(obj, 'Symbol');
     };
@@ -586,12 +537,6 @@
       return Symbol_for(key);
     };
     utils.ensureDebug = ensureDebug;
-    utils.enqueueMicrotask = function(task) {
-      microTasks.push(task);
-    };
-    utils.dequeueMicrotask = function(task) {
-      return microTasks.shift();
-    };
     utils.isProxy = function(value) {
       // CHAKRA-TODO: Need to add JSRT API to detect this
       return false;
@@ -24,7 +24,6 @@
 
 namespace v8 {
   extern bool g_trace_debug_json;
-  extern THREAD_LOCAL JsSourceContext currentContext;
 }
 
 namespace jsrt {
@@ -96,10 +95,10 @@ ContextShim::ContextShim(IsolateShim * isolateShim,
       getSymbolKeyForFunction(JS_INVALID_REFERENCE),
       getSymbolForFunction(JS_INVALID_REFERENCE),
       ensureDebugFunction(JS_INVALID_REFERENCE),
-      enqueueMicrotaskFunction(JS_INVALID_REFERENCE),
-      dequeueMicrotaskFunction(JS_INVALID_REFERENCE),
       getPropertyAttributesFunction(JS_INVALID_REFERENCE),
-      getOwnPropertyNamesFunction(JS_INVALID_REFERENCE) {
+      getOwnPropertyNamesFunction(JS_INVALID_REFERENCE),
+      microtaskQueue(isolateShim->GetRuntimeHandle()),
+      runningMicrotasks(false) {
   memset(globalConstructor, 0, sizeof(globalConstructor));
   memset(globalPrototypeFunction, 0, sizeof(globalPrototypeFunction));
 }
@@ -108,6 +107,11 @@ ContextShim::~ContextShim() {
   if (globalObjectTemplateInstance != JS_INVALID_REFERENCE) {
     JsRelease(globalObjectTemplateInstance, nullptr);
   }
+
+  // Root blocks are freed along with the runtime
+  if (!isolateShim->IsDisposing()) {
+    microtaskQueue.Free();
+  }
 }
 
 bool ContextShim::CheckConfigGlobalObjectTemplate() {
@@ -387,6 +391,10 @@ bool ContextShim::DoInitializeContextShim() {
     return false;
   }
 
+  if (!InitializeStackTraceFunctions()) {
+    return false;
+  }
+
   if (!ExecuteChakraShimJS()) {
     return false;
   }
@@ -438,15 +446,33 @@ bool ContextShim::ExposeGc() {
   return true;
 }
 
+// Native stack trace capture used by chakra_shim.js for Error.captureStackTrace
+// and the Error constructors.
+bool ContextShim::InitializeStackTraceFunctions() {
+  JsValueRef function;
+
+  if (JsCreateFunction(jsrt::CaptureStackTrace, nullptr,
+                       &function) != JsNoError ||
+      jsrt::SetProperty(keepAliveObject,
+                        CachedPropertyIdRef::nativeCaptureStackTrace,
+                        function) != JsNoError) {
+    return false;
+  }
+
+  if (JsCreateFunction(jsrt::GetStackTraceFrames, nullptr,
+                       &function) != JsNoError ||
+      jsrt::SetProperty(keepAliveObject,
+                        CachedPropertyIdRef::nativeGetStackTraceFrames,
+                        function) != JsNoError) {
+    return false;
+  }
+
+  return true;
+}
+
 bool ContextShim::ExecuteChakraShimJS() {
   JsValueRef getInitFunction;
-  JsValueRef url;
-  jsrt::CreateString("chakra_shim.js", &url);
-  if (JsParse(GetIsolateShim()->GetChakraShimJsArrayBuffer(),
-                    v8::currentContext++,
-                    url,
-                    JsParseScriptAttributeNone,
-                    &getInitFunction) != JsNoError) {
+  if (GetIsolateShim()->ParseChakraShimJs(&getInitFunction) != JsNoError) {
     return false;
   }
   JsValueRef initFunction;
@@ -462,13 +488,8 @@ bool ContextShim::ExecuteChakraShimJS() {
 bool ContextShim::ExecuteChakraInspectorShimJS(
   JsValueRef * chakraDebugObject) {
   JsValueRef getInitFunction;
-  JsValueRef url;
-  jsrt::CreateString("chakra_inspector.js", &url);
-  if (JsParse(GetIsolateShim()->GetChakraInspectorShimJsArrayBuffer(),
-    v8::currentContext++,
-    url,
-    JsParseScriptAttributeNone,
-    &getInitFunction) != JsNoError) {
+  if (GetIsolateShim()->ParseChakraInspectorShimJs(&getInitFunction) !=
+      JsNoError) {
     return false;
   }
 
@@ -506,21 +527,96 @@ void ContextShim::SetAlignedPointerInEmbedderData(int index, void * value) {
   }
 }
 
-void ContextShim::RunMicrotasks() {
-  JsValueRef dequeueMicrotaskFunction = GetdequeueMicrotaskFunction();
+bool MicrotaskQueue::Enqueue(JsValueRef task) {
+  if (count == capacity && !Grow()) {
+    return false;
+  }
 
-  for (;;) {
-    JsValueRef task;
-    if (jsrt::CallFunction(dequeueMicrotaskFunction, &task) != JsNoError ||
-      reinterpret_cast<v8::Value*>(task)->IsUndefined()) {
-      break;
-    }
+  tasks[(head + count) & (capacity - 1)] = task;
+  count++;
+  return true;
+}
+
+size_t MicrotaskQueue::Dequeue(JsValueRef * buffer, size_t maxCount) {
+  size_t n = std::min(count, maxCount);
+  for (size_t i = 0; i < n; i++) {
+    // Clear the slot so the GC doesn't keep the task alive after it ran
+    buffer[i] = tasks[head];
+    tasks[head] = JS_INVALID_REFERENCE;
+    head = (head + 1) & (capacity - 1);
+  }
 
-    JsValueRef notUsed;
-    if (jsrt::CallFunction(task, &notUsed) != JsNoError) {
-      JsGetAndClearException(&notUsed);  // swallow any exception from task
+  count -= n;
+  return n;
+}
+
+bool MicrotaskQueue::Grow() {
+  size_t newCapacity = capacity == 0 ? kInitialCapacity : capacity * 2;
+  JsValueRef * newTasks;
+  if (JsAllocRootBlock(runtime, newCapacity, &newTasks) != JsNoError) {
+    return false;
+  }
+
+  // Unwrap the queue to the front of the new block
+  for (size_t i = 0; i < count; i++) {
+    newTasks[i] = tasks[(head + i) & (capacity - 1)];
+  }
+
+  Free();
+  tasks = newTasks;
+  capacity = newCapacity;
+  head = 0;
+  return true;
+}
+
+void MicrotaskQueue::Free() {
+  if (tasks != nullptr) {
+    JsFreeRootBlock(runtime, tasks);
+    tasks = nullptr;
+  }
+}
+
+void ContextShim::EnqueueMicrotask(JsValueRef task) {
+  if (!microtaskQueue.Enqueue(task)) {
+    // Out of memory, nothing we can do but drop the task
+    CHAKRA_ASSERT(false);
+  }
+}
+
+void ContextShim::RunMicrotasks() {
+  // Like v8, tasks that run microtasks themselves leave it to the outer loop
+  if (runningMicrotasks) {
+    return;
+  }
+  runningMicrotasks = true;
+
+  // Tasks are moved to the stack in batches before they run, because the
+  // reactions they queue can grow (and move) the queue's block. The stack is
+  // scanned by the GC, so the batch stays alive.
+  JsValueRef batch[64];
+  size_t count;
+  while ((count = microtaskQueue.Dequeue(batch, _countof(batch))) != 0) {
+    size_t done = 0;
+    while (done < count) {
+      unsigned int called;
+      JsErrorCode error = JsCallFunctions(
+        batch + done, static_cast<unsigned int>(count - done), &called);
+      done += called;
+
+      if (error != JsNoError) {
+        if (error != JsErrorScriptException) {
+          // Script can no longer run, e.g. execution was terminated
+          runningMicrotasks = false;
+          return;
+        }
+
+        JsValueRef notUsed;
+        JsGetAndClearException(&notUsed);  // swallow any exception from task
+      }
     }
   }
+
+  runningMicrotasks = false;
 }
 
 // check initialization state first instead of calling
@@ -630,8 +726,6 @@ CHAKRASHIM_FUNCTION_GETTER(getStackTrace)
 CHAKRASHIM_FUNCTION_GETTER(getSymbolKeyFor)
 CHAKRASHIM_FUNCTION_GETTER(getSymbolFor)
 CHAKRASHIM_FUNCTION_GETTER(ensureDebug)
-CHAKRASHIM_FUNCTION_GETTER(enqueueMicrotask);
-CHAKRASHIM_FUNCTION_GETTER(dequeueMicrotask);
 CHAKRASHIM_FUNCTION_GETTER(getPropertyAttributes);
 CHAKRASHIM_FUNCTION_GETTER(getOwnPropertyNames);
 
@@ -24,6 +24,31 @@ namespace jsrt {
 
 class IsolateShim;
 
+// Promise reactions waiting to run. The tasks are stored in a root block
+// allocated from the runtime, used as a ring buffer that doubles when full,
+// so queued tasks stay alive without going through a JS array.
+class MicrotaskQueue {
+ public:
+  explicit MicrotaskQueue(JsRuntimeHandle runtime)
+      : runtime(runtime), tasks(nullptr), capacity(0), head(0), count(0) {}
+
+  bool Enqueue(JsValueRef task);
+  // Moves up to maxCount tasks from the front of the queue to buffer
+  size_t Dequeue(JsValueRef * buffer, size_t maxCount);
+  void Free();
+
+ private:
+  static const size_t kInitialCapacity = 64;
+
+  bool Grow();
+
+  JsRuntimeHandle runtime;
+  JsValueRef * tasks;
+  size_t capacity;  // zero or a power of two
+  size_t head;
+  size_t count;
+};
+
 class ContextShim {
  public:
   // This has the same layout as v8::Context::Scope
@@ -91,6 +116,7 @@ class ContextShim {
 
   void * GetAlignedPointerFromEmbedderData(int index);
   void SetAlignedPointerInEmbedderData(int index, void * value);
+  void EnqueueMicrotask(JsValueRef task);
   void RunMicrotasks();
 
   static ContextShim * GetCurrent();
@@ -111,6 +137,7 @@ class ContextShim {
   bool KeepAlive(JsValueRef value);
   JsValueRef GetCachedShimFunction(CachedPropertyIdRef id, JsValueRef* func);
   bool ExposeGc();
+  bool InitializeStackTraceFunctions();
   bool CheckConfigGlobalObjectTemplate();
   bool ExecuteChakraShimJS();
 
@@ -160,10 +187,11 @@ private: \
   DECLARE_CHAKRASHIM_FUNCTION_GETTER(getSymbolKeyFor);
   DECLARE_CHAKRASHIM_FUNCTION_GETTER(getSymbolFor);
   DECLARE_CHAKRASHIM_FUNCTION_GETTER(ensureDebug);
-  DECLARE_CHAKRASHIM_FUNCTION_GETTER(enqueueMicrotask);
-  DECLARE_CHAKRASHIM_FUNCTION_GETTER(dequeueMicrotask);
   DECLARE_CHAKRASHIM_FUNCTION_GETTER(getPropertyAttributes);
   DECLARE_CHAKRASHIM_FUNCTION_GETTER(getOwnPropertyNames);
+
+  MicrotaskQueue microtaskQueue;
+  bool runningMicrotasks;
 };
 
 }  // namespace jsrt
@@ -0,0 +1,160 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "jsrtcpuprofiler.h"
+#include "jsrtutils.h"
+
+namespace jsrt {
+
+CpuProfileShim::CpuProfileShim(const std::string& title, JsProfile * profile,
+                               bool recordSamples)
+    : title(title),
+      profile(profile),
+      recordSamples(recordSamples),
+      nodes(profile->nodeCount) {
+  // Parents come before their children, the root is its own parent
+  for (size_t i = 0; i < profile->nodeCount; i++) {
+    nodes[i].node = &profile->nodes[i];
+    if (i != 0) {
+      nodes[profile->nodes[i].parentId].children.push_back(&nodes[i]);
+    }
+  }
+}
+
+CpuProfileShim::~CpuProfileShim() {
+  JsReleaseProfile(profile);
+}
+
+int CpuProfileShim::GetSamplesCount() const {
+  return recordSamples ? static_cast<int>(profile->sampleCount) : 0;
+}
+
+const CpuProfileNodeShim * CpuProfileShim::GetSample(int index) const {
+  return &nodes[profile->samples[index]];
+}
+
+int64_t CpuProfileShim::GetSampleTimestamp(int index) const {
+  return static_cast<int64_t>(profile->timestamps[index]);
+}
+
+int64_t CpuProfileShim::GetStartTime() const {
+  return static_cast<int64_t>(profile->startTime);
+}
+
+int64_t CpuProfileShim::GetEndTime() const {
+  return static_cast<int64_t>(profile->endTime);
+}
+
+CpuProfilerShim::CpuProfilerShim(JsRuntimeHandle runtime)
+    : runtime(runtime),
+      samplingIntervalUs(DefaultSamplingIntervalUs),
+      recordSamples(false),
+      isProfiling(false),
+      isIdle(false),
+      stopSampler(false) {
+  uv_mutex_init(&samplerMutex);
+  uv_cond_init(&samplerCond);
+}
+
+CpuProfilerShim::~CpuProfilerShim() {
+  if (isProfiling) {
+    StopSamplerThread();
+    JsProfile * profile;
+    if (JsStopProfiling(runtime, &profile) == JsNoError) {
+      JsReleaseProfile(profile);
+    }
+  }
+
+  uv_cond_destroy(&samplerCond);
+  uv_mutex_destroy(&samplerMutex);
+}
+
+void CpuProfilerShim::SetSamplingInterval(int us) {
+  // Takes effect from the next profile, like v8
+  if (us > 0) {
+    samplingIntervalUs = us;
+  }
+}
+
+bool CpuProfilerShim::StartProfiling(const std::string& title,
+                                     bool recordSamples) {
+  if (isProfiling || JsStartProfiling(runtime) != JsNoError) {
+    return false;
+  }
+
+  this->title = title;
+  this->recordSamples = recordSamples;
+  this->stopSampler = false;
+  if (uv_thread_create(&samplerThread, SamplerThreadProc, this) != 0) {
+    JsProfile * profile;
+    if (JsStopProfiling(runtime, &profile) == JsNoError) {
+      JsReleaseProfile(profile);
+    }
+    return false;
+  }
+
+  isProfiling = true;
+  return true;
+}
+
+CpuProfileShim * CpuProfilerShim::StopProfiling(const std::string& title) {
+  if (!isProfiling || (!title.empty() && title != this->title)) {
+    return nullptr;
+  }
+
+  StopSamplerThread();
+  isProfiling = false;
+
+  JsProfile * profile;
+  if (JsStopProfiling(runtime, &profile) != JsNoError) {
+    return nullptr;
+  }
+
+  return new CpuProfileShim(this->title, profile, recordSamples);
+}
+
+void CpuProfilerShim::StopSamplerThread() {
+  uv_mutex_lock(&samplerMutex);
+  stopSampler = true;
+  uv_cond_signal(&samplerCond);
+  uv_mutex_unlock(&samplerMutex);
+
+  uv_thread_join(&samplerThread);
+}
+
+/* static */ void CpuProfilerShim::SamplerThreadProc(void * arg) {
+  CpuProfilerShim * profiler = static_cast<CpuProfilerShim *>(arg);
+  uint64_t timeout = static_cast<uint64_t>(profiler->samplingIntervalUs) * 1000;
+
+  uv_mutex_lock(&profiler->samplerMutex);
+  while (!profiler->stopSampler) {
+    if (uv_cond_timedwait(&profiler->samplerCond, &profiler->samplerMutex,
+                          timeout) != UV_ETIMEDOUT) {
+      continue;
+    }
+
+    uv_mutex_unlock(&profiler->samplerMutex);
+    JsRequestProfileSample(profiler->runtime, profiler->isIdle);
+    uv_mutex_lock(&profiler->samplerMutex);
+  }
+  uv_mutex_unlock(&profiler->samplerMutex);
+}
+
+}  // namespace jsrt
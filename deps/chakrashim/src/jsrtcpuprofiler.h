@@ -0,0 +1,126 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "v8-profiler.h"
+#include "ChakraCore.h"
+#include <uv.h>
+
+namespace jsrt {
+
+class CpuProfileShim;
+
+// v8::CpuProfileNode has no data member, each one is a CpuProfileNodeShim
+class CpuProfileNodeShim {
+ public:
+  CpuProfileNodeShim() : node(nullptr) {}
+
+  static CpuProfileNodeShim * FromCpuProfileNode(
+      const v8::CpuProfileNode * node) {
+    return reinterpret_cast<CpuProfileNodeShim *>(
+      const_cast<v8::CpuProfileNode *>(node));
+  }
+  static const v8::CpuProfileNode * ToCpuProfileNode(
+      const CpuProfileNodeShim * node) {
+    return reinterpret_cast<const v8::CpuProfileNode *>(node);
+  }
+
+  const JsProfileNode * node;
+  std::vector<CpuProfileNodeShim *> children;
+};
+
+// v8::CpuProfile has no data member, each one is a CpuProfileShim that owns
+// the profile returned by the runtime
+class CpuProfileShim {
+ public:
+  CpuProfileShim(const std::string& title, JsProfile * profile,
+                 bool recordSamples);
+  ~CpuProfileShim();
+
+  static CpuProfileShim * FromCpuProfile(const v8::CpuProfile * profile) {
+    return reinterpret_cast<CpuProfileShim *>(
+      const_cast<v8::CpuProfile *>(profile));
+  }
+  static v8::CpuProfile * ToCpuProfile(CpuProfileShim * profile) {
+    return reinterpret_cast<v8::CpuProfile *>(profile);
+  }
+
+  const std::string& GetTitle() const { return title; }
+  const CpuProfileNodeShim * GetRoot() const { return &nodes[0]; }
+  int GetSamplesCount() const;
+  const CpuProfileNodeShim * GetSample(int index) const;
+  int64_t GetSampleTimestamp(int index) const;
+  int64_t GetStartTime() const;
+  int64_t GetEndTime() const;
+
+ private:
+  std::string title;
+  JsProfile * profile;
+  bool recordSamples;
+  std::vector<CpuProfileNodeShim> nodes;
+};
+
+// v8::CpuProfiler has no data member, the isolate's profiler is a
+// CpuProfilerShim. Samples are requested from a sampler thread, the runtime
+// takes them on its own thread at the next function call or loop iteration.
+class CpuProfilerShim {
+ public:
+  explicit CpuProfilerShim(JsRuntimeHandle runtime);
+  ~CpuProfilerShim();
+
+  static CpuProfilerShim * FromCpuProfiler(v8::CpuProfiler * profiler) {
+    return reinterpret_cast<CpuProfilerShim *>(profiler);
+  }
+  static v8::CpuProfiler * ToCpuProfiler(CpuProfilerShim * profiler) {
+    return reinterpret_cast<v8::CpuProfiler *>(profiler);
+  }
+
+  void SetSamplingInterval(int us);
+  void SetIdle(bool isIdle) { this->isIdle = isIdle; }
+
+  // The runtime profiles one session at a time, a profile started while
+  // another one is running is not recorded
+  bool StartProfiling(const std::string& title, bool recordSamples);
+  CpuProfileShim * StopProfiling(const std::string& title);
+
+ private:
+  static const int DefaultSamplingIntervalUs = 1000;
+
+  static void SamplerThreadProc(void * arg);
+  void StopSamplerThread();
+
+  JsRuntimeHandle runtime;
+  int samplingIntervalUs;
+  std::string title;
+  bool recordSamples;
+  bool isProfiling;
+  volatile bool isIdle;
+
+  uv_thread_t samplerThread;
+  uv_mutex_t samplerMutex;
+  uv_cond_t samplerCond;
+  bool stopSampler;
+};
+
+}  // namespace jsrt
@@ -0,0 +1,253 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#include "jsrtheapprofiler.h"
+#include <stdio.h>
+#include <vector>
+
+namespace jsrt {
+
+namespace {
+
+const char snapshotMeta[] =
+  "{\"snapshot\":{\"meta\":{"
+  "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\","
+  "\"trace_node_id\"],"
+  "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\","
+  "\"closure\",\"regexp\",\"number\",\"native\",\"synthetic\","
+  "\"concatenated string\",\"sliced string\",\"symbol\"],"
+  "\"string\",\"number\",\"number\",\"number\",\"number\",\"number\"],"
+  "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+  "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\","
+  "\"hidden\",\"shortcut\",\"weak\"],\"string_or_number\",\"node\"],"
+  "\"trace_function_info_fields\":[\"function_id\",\"name\",\"script_name\","
+  "\"script_id\",\"line\",\"column\"],"
+  "\"trace_node_fields\":[\"id\",\"function_info_index\",\"count\",\"size\","
+  "\"children\"],"
+  "\"sample_fields\":[\"timestamp_us\",\"last_assigned_id\"]},";
+
+// Edges point at the first field of a node in the flat nodes array
+const size_t nodeFieldCount = 6;
+
+// Buffers the JSON in chunks of the size the stream asks for, a stream that
+// aborts is not written to again and does not get EndOfStream
+class HeapSnapshotWriter {
+ public:
+  explicit HeapSnapshotWriter(v8::OutputStream * stream)
+      : stream(stream),
+        chunk(stream->GetChunkSize() > 0 ? stream->GetChunkSize() : 1024),
+        chunkPos(0),
+        aborted(false) {}
+
+  bool IsAborted() const { return aborted; }
+
+  void AddCharacter(char c) {
+    chunk[chunkPos++] = c;
+    if (chunkPos == chunk.size()) {
+      WriteChunk();
+    }
+  }
+
+  void AddString(const char * str) {
+    while (*str != '\0') {
+      AddCharacter(*str++);
+    }
+  }
+
+  void AddNumber(size_t value) {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%llu",
+             static_cast<unsigned long long>(value));  // NOLINT(runtime/int)
+    AddString(buffer);
+  }
+
+  // The runtime's strings are UTF-8, the stream only takes ASCII
+  void AddJSONString(const char * str) {
+    AddCharacter('"');
+    const unsigned char * s = reinterpret_cast<const unsigned char *>(str);
+    while (*s != '\0') {
+      unsigned char c = *s++;
+      switch (c) {
+        case '"': AddString("\\\""); continue;
+        case '\\': AddString("\\\\"); continue;
+        case '\b': AddString("\\b"); continue;
+        case '\f': AddString("\\f"); continue;
+        case '\n': AddString("\\n"); continue;
+        case '\r': AddString("\\r"); continue;
+        case '\t': AddString("\\t"); continue;
+      }
+
+      if (c < 0x20) {
+        AddEscape(c);
+      } else if (c < 0x80) {
+        AddCharacter(static_cast<char>(c));
+      } else {
+        AddCodePoint(DecodeUtf8(c, &s));
+      }
+    }
+    AddCharacter('"');
+  }
+
+  void Finalize() {
+    if (aborted) {
+      return;
+    }
+    if (chunkPos != 0) {
+      WriteChunk();
+    }
+    if (!aborted) {
+      stream->EndOfStream();
+    }
+  }
+
+ private:
+  static unsigned int DecodeUtf8(unsigned char lead,
+                                 const unsigned char ** s) {
+    int trailCount = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+    unsigned int codePoint = lead & (0x3F >> trailCount);
+    if (trailCount == 0) {
+      return 0xFFFD;
+    }
+
+    for (int i = 0; i < trailCount; i++) {
+      if (((*s)[0] & 0xC0) != 0x80) {
+        return 0xFFFD;
+      }
+      codePoint = (codePoint << 6) | ((*s)[0] & 0x3F);
+      (*s)++;
+    }
+    return codePoint;
+  }
+
+  void AddCodePoint(unsigned int codePoint) {
+    if (codePoint > 0xFFFF) {
+      codePoint -= 0x10000;
+      AddEscape(0xD800 + (codePoint >> 10));
+      AddEscape(0xDC00 + (codePoint & 0x3FF));
+    } else {
+      AddEscape(codePoint);
+    }
+  }
+
+  void AddEscape(unsigned int codeUnit) {
+    char buffer[8];
+    snprintf(buffer, sizeof(buffer), "\\u%04x", codeUnit);
+    AddString(buffer);
+  }
+
+  void WriteChunk() {
+    if (!aborted && stream->WriteAsciiChunk(chunk.data(),
+        static_cast<int>(chunkPos)) == v8::OutputStream::kAbort) {
+      aborted = true;
+    }
+    chunkPos = 0;
+  }
+
+  v8::OutputStream * stream;
+  std::vector<char> chunk;
+  size_t chunkPos;
+  bool aborted;
+};
+
+}  // namespace
+
+HeapSnapshotShim::~HeapSnapshotShim() {
+  JsReleaseHeapSnapshot(snapshot);
+}
+
+int HeapSnapshotShim::GetNodesCount() const {
+  return static_cast<int>(snapshot->nodeCount);
+}
+
+void HeapSnapshotShim::Serialize(v8::OutputStream * stream) const {
+  HeapSnapshotWriter writer(stream);
+
+  writer.AddString(snapshotMeta);
+  writer.AddString("\"node_count\":");
+  writer.AddNumber(snapshot->nodeCount);
+  writer.AddString(",\"edge_count\":");
+  writer.AddNumber(snapshot->edgeCount);
+  writer.AddString(",\"trace_function_count\":0},\n\"nodes\":[");
+
+  // The runtime's node and edge types have v8's values
+  for (size_t i = 0; i < snapshot->nodeCount && !writer.IsAborted(); i++) {
+    const JsHeapSnapshotNode & node = snapshot->nodes[i];
+    if (i != 0) {
+      writer.AddString(",\n");
+    }
+    writer.AddNumber(node.type);
+    writer.AddCharacter(',');
+    writer.AddNumber(node.name);
+    writer.AddCharacter(',');
+    writer.AddNumber(node.id);
+    writer.AddCharacter(',');
+    writer.AddNumber(node.selfSize);
+    writer.AddCharacter(',');
+    writer.AddNumber(node.edgeCount);
+    writer.AddString(",0");
+  }
+
+  writer.AddString("],\n\"edges\":[");
+  for (size_t i = 0; i < snapshot->edgeCount && !writer.IsAborted(); i++) {
+    const JsHeapSnapshotEdge & edge = snapshot->edges[i];
+    if (i != 0) {
+      writer.AddString(",\n");
+    }
+    writer.AddNumber(edge.type);
+    writer.AddCharacter(',');
+    writer.AddNumber(edge.nameOrIndex);
+    writer.AddCharacter(',');
+    writer.AddNumber(edge.toNode * nodeFieldCount);
+  }
+
+  writer.AddString("],\n\"trace_function_infos\":[],\n\"trace_tree\":[],"
+                   "\n\"samples\":[],\n\"strings\":[");
+  for (size_t i = 0; i < snapshot->stringCount && !writer.IsAborted(); i++) {
+    if (i != 0) {
+      writer.AddString(",\n");
+    }
+    writer.AddJSONString(snapshot->strings[i]);
+  }
+  writer.AddString("]}");
+
+  writer.Finalize();
+}
+
+HeapSnapshotShim * HeapProfilerShim::TakeHeapSnapshot(
+    v8::ActivityControl * control) {
+  // The runtime walks the heap in one go, progress is only reported around it
+  if (control != nullptr &&
+      control->ReportProgressValue(0, 1) == v8::ActivityControl::kAbort) {
+    return nullptr;
+  }
+
+  JsHeapSnapshot * snapshot;
+  if (JsTakeHeapSnapshot(runtime, &snapshot) != JsNoError) {
+    return nullptr;
+  }
+
+  if (control != nullptr) {
+    control->ReportProgressValue(1, 1);
+  }
+  return new HeapSnapshotShim(snapshot);
+}
+
+}  // namespace jsrt
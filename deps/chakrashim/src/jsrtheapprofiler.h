@@ -0,0 +1,74 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "v8-profiler.h"
+#include "ChakraCore.h"
+
+namespace jsrt {
+
+// v8::HeapSnapshot has no data member, each one is a HeapSnapshotShim that
+// owns the snapshot returned by the runtime
+class HeapSnapshotShim {
+ public:
+  explicit HeapSnapshotShim(JsHeapSnapshot * snapshot) : snapshot(snapshot) {}
+  ~HeapSnapshotShim();
+
+  static HeapSnapshotShim * FromHeapSnapshot(
+      const v8::HeapSnapshot * snapshot) {
+    return reinterpret_cast<HeapSnapshotShim *>(
+      const_cast<v8::HeapSnapshot *>(snapshot));
+  }
+  static const v8::HeapSnapshot * ToHeapSnapshot(HeapSnapshotShim * snapshot) {
+    return reinterpret_cast<const v8::HeapSnapshot *>(snapshot);
+  }
+
+  int GetNodesCount() const;
+
+  // The JSON is written chunk by chunk straight from the runtime's snapshot,
+  // it is never held in memory as a whole
+  void Serialize(v8::OutputStream * stream) const;
+
+ private:
+  JsHeapSnapshot * snapshot;
+};
+
+// v8::HeapProfiler has no data member, the isolate's heap profiler is a
+// HeapProfilerShim
+class HeapProfilerShim {
+ public:
+  explicit HeapProfilerShim(JsRuntimeHandle runtime) : runtime(runtime) {}
+
+  static HeapProfilerShim * FromHeapProfiler(v8::HeapProfiler * profiler) {
+    return reinterpret_cast<HeapProfilerShim *>(profiler);
+  }
+  static v8::HeapProfiler * ToHeapProfiler(HeapProfilerShim * profiler) {
+    return reinterpret_cast<v8::HeapProfiler *>(profiler);
+  }
+
+  HeapSnapshotShim * TakeHeapSnapshot(v8::ActivityControl * control);
+
+ private:
+  JsRuntimeHandle runtime;
+};
+
+}  // namespace jsrt
@@ -26,6 +26,9 @@
 #include <algorithm>
 #include "v8-debug.h"
 #include "jsrtinspector.h"
+#include "jsrtcpuprofiler.h"
+#include "jsrtheapprofiler.h"
+#include "jsrtplatform.h"
 
 /////////////////////////////////////////////////
 
@@ -210,6 +213,7 @@ void CALLBACK TTFlushAndCloseStreamCallback(JsTTDStreamHandle handle,
 
 namespace v8 {
 extern bool g_disableIdleGc;
+extern THREAD_LOCAL JsSourceContext currentContext;
 }
 namespace jsrt {
 
@@ -222,12 +226,20 @@ IsolateShim::IsolateShim(JsRuntimeHandle runtime)
     : arrayBufferAllocator(nullptr),
       debugContext(nullptr),
       runtime(runtime),
+      handleArena(runtime),
       symbolPropertyIdRefs(),
       cachedPropertyIdRefs(),
       isDisposing(false),
+      externalMemory(0),
+      isTTDRuntime(false),
       contextScopeStack(nullptr),
       tryCatchStackTop(nullptr),
-      embeddedData() {
+      hasGarbageCollectionCallback(false),
+      cpuProfiler(nullptr),
+      heapProfiler(nullptr),
+      embeddedData(),
+      chakraShimScript(),
+      chakraInspectorShimScript() {
   // CHAKRA-TODO: multithread locking for s_isolateList?
   this->prevnext = &s_isolateList;
   this->next = s_isolateList;
@@ -258,7 +270,8 @@ IsolateShim::~IsolateShim() {
   JsRuntimeHandle runtime;
   JsErrorCode error;
   if (!(doRecord || doReplay)) {
-      error = JsCreateRuntime(attributes, nullptr, &runtime);
+      error = JsCreateRuntime(attributes,
+                              DefaultPlatform::GetThreadService(), &runtime);
   } else {
     if (doRecord) {
       error = JsTTDCreateRecordRuntime(attributes, snapInterval, snapHistoryLength,
@@ -287,6 +300,10 @@ IsolateShim::~IsolateShim() {
   }
 
   IsolateShim* newIsolateshim = new IsolateShim(runtime);
+  newIsolateshim->isTTDRuntime = doRecord || doReplay;
+  if (v8::g_trace_gc) {
+    newIsolateshim->EnsureGarbageCollectionCallback();
+  }
   if (!disableIdleGc) {
     uv_prepare_init(uv_default_loop(), newIsolateshim->idleGc_prepare_handle());
     uv_unref(reinterpret_cast<uv_handle_t*>(
@@ -333,12 +350,50 @@ void IsolateShim::Exit() {
   s_previousIsolate = nullptr;
 }
 
+bool HandleArena::EnsureChunk() {
+  size_t index = top / kChunkSize;
+  if (index == chunks.size()) {
+    // Root blocks are freed along with the runtime
+    JsValueRef* chunk;
+    if (JsAllocRootBlock(runtime, kChunkSize, &chunk) != JsNoError) {
+      return false;
+    }
+    chunks.push_back(chunk);
+  }
+  current = chunks[index];
+  return true;
+}
+
+void HandleArena::PopTo(size_t mark) {
+  CHAKRA_ASSERT(mark <= top);
+
+  // Clear the popped slots so the GC doesn't keep their values alive
+  while (top > mark) {
+    size_t chunkStart = (top - 1) / kChunkSize * kChunkSize;
+    size_t from = mark > chunkStart ? mark : chunkStart;
+    memset(chunks[chunkStart / kChunkSize] + (from - chunkStart), 0,
+           (top - from) * sizeof(JsValueRef));
+    top = from;
+  }
+
+  if (top % kChunkSize != 0) {
+    current = chunks[top / kChunkSize];
+  }
+}
+
 JsRuntimeHandle IsolateShim::GetRuntimeHandle() {
   return runtime;
 }
 
 bool IsolateShim::Dispose() {
   isDisposing = true;
+
+  // The sampler thread has to stop before the runtime goes away
+  delete cpuProfiler;
+  cpuProfiler = nullptr;
+  delete heapProfiler;
+  heapProfiler = nullptr;
+
   {
     // Disposing the runtime may cause finalize call back to run
     // Set the current IsolateShim scope
@@ -350,6 +405,14 @@ bool IsolateShim::Dispose() {
     }
   }
 
+  // The buffers parsed from the shim byte code were finalized with the runtime
+  if (chakraShimScript.byteCode != nullptr) {
+    chakraShimScript.byteCode->Release();
+  }
+  if (chakraInspectorShimScript.byteCode != nullptr) {
+    chakraInspectorShimScript.byteCode->Release();
+  }
+
   // CHAKRA-TODO: multithread locking for s_isolateList?
   if (this->next) {
     this->next->prevnext = this->prevnext;
@@ -420,6 +483,20 @@ bool IsolateShim::GetMemoryUsage(size_t * memoryUsage) {
   return (JsGetRuntimeMemoryUsage(runtime, memoryUsage) == JsNoError);
 }
 
+int64_t IsolateShim::AdjustExternalMemory(int64_t change) {
+  externalMemory += change;
+  if (externalMemory < 0) {
+    externalMemory = 0;
+  }
+
+  // Freed memory stops counting at the next collection, only report growth.
+  // Frees mostly come from finalizers, where the GC can't be called into.
+  if (change > 0 && !isDisposing) {
+    JsAddExternalMemoryUsage(runtime, static_cast<size_t>(change));
+  }
+  return externalMemory;
+}
+
 void IsolateShim::DisposeAll() {
   // CHAKRA-TODO: multithread locking for s_isolateList?
   IsolateShim * curr = s_isolateList;
@@ -565,6 +642,110 @@ bool IsolateShim::IsExeuctionDisabled() {
   return false;
 }
 
+bool IsolateShim::EnsureGarbageCollectionCallback() {
+  if (!hasGarbageCollectionCallback) {
+    if (JsSetRuntimeGarbageCollectionCallback(
+          runtime, this, JsGarbageCollectionCallback) != JsNoError) {
+      return false;
+    }
+    hasGarbageCollectionCallback = true;
+  }
+  return true;
+}
+
+/* static */ bool IsolateShim::AddGCCallback(
+    std::vector<GCCallbackEntry> * list, v8::Isolate::GCCallback callback,
+    v8::GCType filter) {
+  try {
+    list->push_back({ callback, filter });
+    return true;
+  } catch(...) {
+    return false;
+  }
+}
+
+/* static */ void IsolateShim::RemoveGCCallback(
+    std::vector<GCCallbackEntry> * list, v8::Isolate::GCCallback callback) {
+  auto i = std::remove_if(list->begin(), list->end(),
+    [callback](const GCCallbackEntry& entry) {
+      return entry.callback == callback;
+    });
+  list->erase(i, list->end());
+}
+
+CpuProfilerShim * IsolateShim::GetCpuProfiler() {
+  if (cpuProfiler == nullptr) {
+    cpuProfiler = new CpuProfilerShim(runtime);
+  }
+  return cpuProfiler;
+}
+
+HeapProfilerShim * IsolateShim::GetHeapProfiler() {
+  if (heapProfiler == nullptr) {
+    heapProfiler = new HeapProfilerShim(runtime);
+  }
+  return heapProfiler;
+}
+
+bool IsolateShim::AddGCPrologueCallback(v8::Isolate::GCCallback callback,
+                                        v8::GCType filter) {
+  return EnsureGarbageCollectionCallback() &&
+    AddGCCallback(&gcPrologueCallbacks, callback, filter);
+}
+
+void IsolateShim::RemoveGCPrologueCallback(v8::Isolate::GCCallback callback) {
+  RemoveGCCallback(&gcPrologueCallbacks, callback);
+}
+
+bool IsolateShim::AddGCEpilogueCallback(v8::Isolate::GCCallback callback,
+                                        v8::GCType filter) {
+  return EnsureGarbageCollectionCallback() &&
+    AddGCCallback(&gcEpilogueCallbacks, callback, filter);
+}
+
+void IsolateShim::RemoveGCEpilogueCallback(v8::Isolate::GCCallback callback) {
+  RemoveGCCallback(&gcEpilogueCallbacks, callback);
+}
+
+/* static */ void CHAKRA_CALLBACK IsolateShim::JsGarbageCollectionCallback(
+    JsGarbageCollectionEvent event, const JsGarbageCollectionInfo *info,
+    void *callbackState) {
+  IsolateShim * isolateShim = static_cast<IsolateShim *>(callbackState);
+  if (isolateShim->isDisposing) {
+    // The embedder may already be gone for the final collections
+    return;
+  }
+
+  // A partial collection only looks at recently allocated objects, the
+  // closest thing to a scavenge
+  v8::GCType type = (info->flags & JsGarbageCollectionFlags_Partial) ?
+    v8::kGCTypeScavenge : v8::kGCTypeMarkSweepCompact;
+  v8::GCCallbackFlags flags = (info->flags & JsGarbageCollectionFlags_Exhaustive) ?
+    v8::kGCCallbackFlagForced : v8::kNoGCCallbackFlags;
+  v8::Isolate * isolate = ToIsolate(isolateShim);
+
+  const std::vector<GCCallbackEntry>& callbacks =
+    event == JsGarbageCollectionEvent_Begin ?
+      isolateShim->gcPrologueCallbacks : isolateShim->gcEpilogueCallbacks;
+  for (size_t i = 0; i < callbacks.size(); i++) {
+    if (callbacks[i].filter & type) {
+      callbacks[i].callback(isolate, type, flags);
+    }
+  }
+
+  if (v8::g_trace_gc && event == JsGarbageCollectionEvent_End) {
+    const double MB = 1024.0 * 1024.0;
+    fprintf(stderr, "[%p] %s%s%s: %.1f -> %.1f MB, %.1f ms\n",
+            static_cast<void *>(isolate),
+            type == v8::kGCTypeScavenge ? "Partial" : "Full",
+            (info->flags & JsGarbageCollectionFlags_Concurrent) ?
+              " (concurrent)" : "",
+            (flags & v8::kGCCallbackFlagForced) ? " (forced)" : "",
+            info->usedBytesBefore / MB, info->usedBytesAfter / MB,
+            info->duration / 1000.0);
+  }
+}
+
 bool IsolateShim::AddMessageListener(void * that) {
   try {
     messageListeners.push_back(that);
@@ -610,6 +791,48 @@ JsValueRef IsolateShim::GetChakraInspectorShimJsArrayBuffer() {
   return chakraInspectorShimArrayBuffer;
 }
 
+JsErrorCode IsolateShim::ParseShimJs(JsValueRef source, const char * name,
+                                     ShimScriptCache * cache,
+                                     JsValueRef * function) {
+  JsValueRef url;
+  IfJsErrorRet(CreateString(name, &url));
+
+  // Most processes only ever have one context, don't pay for serializing the
+  // shim until a second context is created. If it can't be serialized (e.g.
+  // the runtime is being debugged) every context parses it from source.
+  if (cache->parseCount++ == 1 && !isTTDRuntime) {
+    JsValueRef serialized;
+    BYTE* bytes;
+    unsigned int length;
+    if (JsSerialize(source, &serialized,
+                    JsParseScriptAttributeNone) == JsNoError &&
+        JsGetArrayBufferStorage(serialized, &bytes, &length) == JsNoError) {
+      cache->byteCode = new SerializedScript(bytes, length);
+    }
+  }
+
+  if (cache->byteCode != nullptr) {
+    *function = cache->byteCode->Parse(source, url);
+    if (*function != JS_INVALID_REFERENCE) {
+      return JsNoError;
+    }
+  }
+
+  return JsParse(source, v8::currentContext++, url,
+                 JsParseScriptAttributeNone, function);
+}
+
+JsErrorCode IsolateShim::ParseChakraShimJs(JsValueRef * function) {
+  return ParseShimJs(GetChakraShimJsArrayBuffer(), "chakra_shim.js",
+                     &chakraShimScript, function);
+}
+
+JsErrorCode IsolateShim::ParseChakraInspectorShimJs(JsValueRef * function) {
+  return ParseShimJs(GetChakraInspectorShimJsArrayBuffer(),
+                     "chakra_inspector.js", &chakraInspectorShimScript,
+                     function);
+}
+
 /*static*/
 bool IsolateShim::RunSingleStepOfReverseMoveLoop(v8::Isolate* isolate,
                                                  uint64_t* moveMode,
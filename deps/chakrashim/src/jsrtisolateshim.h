@@ -37,10 +37,15 @@ namespace v8 {
 class Isolate;
 class TryCatch;
 extern bool g_disableIdleGc;
+extern bool g_trace_gc;
 }  // namespace v8
 
 namespace jsrt {
 
+class SerializedScript;
+class CpuProfilerShim;
+class HeapProfilerShim;
+
 enum CachedPropertyIdRef : int {
 #define DEF(x, ...) x,
 #include "jsrtcachedpropertyidref.inc"
@@ -53,12 +58,47 @@ enum CachedSymbolPropertyIdRef {
   SymbolCount
 };
 
+// Backing store for HandleScope locals that don't fit in a scope's on-stack
+// slots. Chunks are root blocks allocated from the runtime, so storing a ref
+// keeps it alive without calling into the engine. Chunks are kept for reuse;
+// scopes only move the top back and forth.
+class HandleArena {
+ public:
+  explicit HandleArena(JsRuntimeHandle runtime)
+      : runtime(runtime), current(nullptr), top(0) {}
+
+  size_t Top() const { return top; }
+
+  bool Push(JsValueRef value) {
+    size_t offset = top % kChunkSize;
+    if (offset == 0 && !EnsureChunk()) {
+      return false;
+    }
+    current[offset] = value;
+    top++;
+    return true;
+  }
+
+  void PopTo(size_t mark);
+
+ private:
+  static const size_t kChunkSize = 1024;
+
+  bool EnsureChunk();
+
+  JsRuntimeHandle runtime;
+  std::vector<JsValueRef*> chunks;
+  JsValueRef* current;  // chunk that holds index top
+  size_t top;
+};
+
 class IsolateShim {
  public:
   v8::ArrayBuffer::Allocator* arrayBufferAllocator;
   bool NewContext(JsContextRef * context, bool exposeGC, bool useGlobalTTState,
                                JsValueRef globalObjectTemplateInstance);
   bool GetMemoryUsage(size_t * memoryUsage);
+  int64_t AdjustExternalMemory(int64_t change);
   bool Dispose();
   bool IsDisposing();
 
@@ -89,6 +129,8 @@ class IsolateShim {
 
   ContextShim * GetCurrentContextShim();
 
+  HandleArena * GetHandleArena() { return &handleArena; }
+
   // Symbols propertyIdRef
   JsPropertyIdRef GetSelfSymbolPropertyIdRef();
   JsPropertyIdRef GetKeepAliveObjectSymbolPropertyIdRef();
@@ -108,6 +150,18 @@ class IsolateShim {
     return !v8::g_disableIdleGc;
   }
 
+  // GC callbacks are called from the engine's garbage collection callback,
+  // which is only set on the runtime once one of them is added
+  bool AddGCPrologueCallback(v8::Isolate::GCCallback callback,
+                             v8::GCType filter);
+  void RemoveGCPrologueCallback(v8::Isolate::GCCallback callback);
+  bool AddGCEpilogueCallback(v8::Isolate::GCCallback callback,
+                             v8::GCType filter);
+  void RemoveGCEpilogueCallback(v8::Isolate::GCCallback callback);
+
+  CpuProfilerShim * GetCpuProfiler();
+  HeapProfilerShim * GetHeapProfiler();
+
   bool AddMessageListener(void * that);
   void RemoveMessageListeners(void * that);
   template <typename Fn>
@@ -120,6 +174,11 @@ class IsolateShim {
   JsValueRef GetChakraShimJsArrayBuffer();
   JsValueRef GetChakraInspectorShimJsArrayBuffer();
 
+  // Parse the shim scripts for a new context. Once a second context needs
+  // one, its byte code is kept and later contexts skip the parser.
+  JsErrorCode ParseChakraShimJs(JsValueRef * function);
+  JsErrorCode ParseChakraInspectorShimJs(JsValueRef * function);
+
   void SetData(unsigned int slot, void* data);
   void* GetData(unsigned int slot);
 
@@ -156,6 +215,25 @@ class IsolateShim {
     return isIdleGcScheduled;
   }
 
+  // Sources of scripts parsed from serialized byte code, by source context.
+  // The engine asks for them the first time a function needs the source text.
+  void SetSerializedScriptSource(JsSourceContext sourceContext, JsValueRef source) {
+    serializedScriptSources[sourceContext] = source;
+  }
+
+  bool GetSerializedScriptSource(JsSourceContext sourceContext, JsValueRef *source) {
+    auto it = serializedScriptSources.find(sourceContext);
+    if (it == serializedScriptSources.end()) {
+      return false;
+    }
+    *source = it->second;
+    return true;
+  }
+
+  void RemoveSerializedScriptSource(JsSourceContext sourceContext) {
+    serializedScriptSources.erase(sourceContext);
+  }
+
  private:
   // Construction/Destruction should go thru New/Dispose
   explicit IsolateShim(JsRuntimeHandle runtime);
@@ -164,10 +242,38 @@ class IsolateShim {
   static void CHAKRA_CALLBACK JsContextBeforeCollectCallback(JsRef contextRef,
                                                              void *data);
 
+  struct GCCallbackEntry {
+    v8::Isolate::GCCallback callback;
+    v8::GCType filter;
+  };
+
+  bool EnsureGarbageCollectionCallback();
+  static bool AddGCCallback(std::vector<GCCallbackEntry> * list,
+                            v8::Isolate::GCCallback callback,
+                            v8::GCType filter);
+  static void RemoveGCCallback(std::vector<GCCallbackEntry> * list,
+                               v8::Isolate::GCCallback callback);
+  static void CHAKRA_CALLBACK JsGarbageCollectionCallback(
+    JsGarbageCollectionEvent event, const JsGarbageCollectionInfo *info,
+    void *callbackState);
+
+  struct ShimScriptCache {
+    SerializedScript * byteCode;
+    unsigned int parseCount;
+  };
+
+  JsErrorCode ParseShimJs(JsValueRef source, const char * name,
+                          ShimScriptCache * cache, JsValueRef * function);
+
   JsRuntimeHandle runtime;
+  HandleArena handleArena;
   JsPropertyIdRef symbolPropertyIdRefs[CachedSymbolPropertyIdRef::SymbolCount];
   JsPropertyIdRef cachedPropertyIdRefs[CachedPropertyIdRef::Count];
   bool isDisposing;
+  // Native memory kept alive by objects, as reported by the embedder
+  int64_t externalMemory;
+  // Time travel debugging doesn't record scripts parsed from byte code
+  bool isTTDRuntime;
 
   ContextShim::Scope * contextScopeStack;
   IsolateShim ** prevnext;
@@ -177,6 +283,11 @@ class IsolateShim {
   v8::TryCatch * tryCatchStackTop;
 
   std::vector<void *> messageListeners;
+  std::vector<GCCallbackEntry> gcPrologueCallbacks;
+  std::vector<GCCallbackEntry> gcEpilogueCallbacks;
+  bool hasGarbageCollectionCallback;
+  CpuProfilerShim * cpuProfiler;
+  HeapProfilerShim * heapProfiler;
 
   // Node only has 4 slots (internals::Internals::kNumIsolateDataSlots = 4)
   void * embeddedData[4];
@@ -191,5 +302,12 @@ class IsolateShim {
   uv_timer_t idleGc_timer_handle_;
   bool jsScriptExecuted = false;
   bool isIdleGcScheduled = false;
+
+  // The sources are kept alive by the serialized script buffers that map to
+  // them, and removed when those buffers are finalized
+  std::unordered_map<JsSourceContext, JsValueRef> serializedScriptSources;
+
+  ShimScriptCache chakraShimScript;
+  ShimScriptCache chakraInspectorShimScript;
 };
 }  // namespace jsrt
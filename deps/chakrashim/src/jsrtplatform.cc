@@ -20,41 +20,144 @@
 
 #include "jsrtplatform.h"
 #include "v8chakra.h"
+#include <algorithm>
 
 namespace jsrt {
 
-  DefaultPlatform::DefaultPlatform() {
+  static const int kMaxThreadPoolSize = 8;
+
+  DefaultPlatform* DefaultPlatform::s_instance = nullptr;
+
+  DefaultPlatform::DefaultPlatform(int thread_pool_size)
+      : m_idleWorkers(0), m_terminated(false) {
     uv_mutex_init(&m_lock);
+    uv_mutex_init(&m_workerLock);
+    uv_cond_init(&m_workerCondition);
+
+    // Like V8, a size of 0 picks one thread less than there are processors
+    if (thread_pool_size <= 0) {
+      uv_cpu_info_t* cpuInfos;
+      int cpuCount = 0;
+      if (uv_cpu_info(&cpuInfos, &cpuCount) == 0) {
+        uv_free_cpu_info(cpuInfos, cpuCount);
+      }
+      thread_pool_size = cpuCount - 1;
+    }
+    thread_pool_size = std::max(1, std::min(thread_pool_size,
+                                            kMaxThreadPoolSize));
+
+    worker_threads_.reserve(thread_pool_size);
+    for (int i = 0; i < thread_pool_size; i++) {
+      uv_thread_t thread;
+      if (uv_thread_create(&thread, WorkerThreadProc, this) != 0) {
+        break;
+      }
+      worker_threads_.push_back(thread);
+    }
+
+    s_instance = this;
   }
 
   DefaultPlatform::~DefaultPlatform() {
+    if (s_instance == this) {
+      s_instance = nullptr;
+    }
+
+    uv_mutex_lock(&m_workerLock);
+    m_terminated = true;
+    uv_cond_broadcast(&m_workerCondition);
+    uv_mutex_unlock(&m_workerLock);
+
+    for (uv_thread_t& thread : worker_threads_) {
+      uv_thread_join(&thread);
+    }
+
+    // Tasks that never got to run are dropped, like V8 does
+    while (!background_queue_.empty()) {
+      delete background_queue_.front();
+      background_queue_.pop();
+    }
+
+    for (auto& entry : main_thread_queue_) {
+      while (!entry.second.empty()) {
+        delete entry.second.front();
+        entry.second.pop();
+      }
+    }
+
+    for (auto& entry : main_thread_delayed_queue_) {
+      while (!entry.second.empty()) {
+        delete entry.second.top().second;
+        entry.second.pop();
+      }
+    }
+
+    uv_cond_destroy(&m_workerCondition);
+    uv_mutex_destroy(&m_workerLock);
     uv_mutex_destroy(&m_lock);
   }
 
   bool DefaultPlatform::PumpMessageLoop(v8::Isolate* isolate) {
-    v8::Task* task = nullptr;
+    // The tasks posted so far, and the delayed ones that are due, are taken
+    // under one lock and run without it. Tasks they post run on the next pump.
+    std::queue<v8::Task*> tasks;
+    double now = MonotonicallyIncreasingTime();
 
     uv_mutex_lock(&m_lock);
 
-    task = PopTaskInMainThreadQueue(isolate);
+    auto it = main_thread_queue_.find(isolate);
+    if (it != main_thread_queue_.end()) {
+      tasks.swap(it->second);
+    }
+
+    auto delayedIt = main_thread_delayed_queue_.find(isolate);
+    if (delayedIt != main_thread_delayed_queue_.end()) {
+      DelayedTaskQueue& delayed = delayedIt->second;
+      while (!delayed.empty() && delayed.top().first <= now) {
+        tasks.push(delayed.top().second);
+        delayed.pop();
+      }
+    }
 
     uv_mutex_unlock(&m_lock);
 
-    if (task != nullptr) {
+    if (tasks.empty()) {
+      return false;
+    }
+
+    while (!tasks.empty()) {
+      v8::Task* task = tasks.front();
+      tasks.pop();
       task->Run();
       delete task;
-
-      return true;
     }
 
-    return false;
+    return true;
+  }
+
+  JsThreadServiceCallback DefaultPlatform::GetThreadService() {
+    return s_instance != nullptr ? ThreadServiceCallback : nullptr;
+  }
+
+  size_t DefaultPlatform::NumberOfAvailableBackgroundThreads() {
+    return worker_threads_.size();
   }
 
   void DefaultPlatform::CallOnBackgroundThread(
       v8::Task* task,
       v8::Platform::ExpectedRuntime expected_runtime) {
-    // CHAKRA-TODO: Figure out what to do here.
-    CHAKRA_ASSERT(false);
+    uv_mutex_lock(&m_workerLock);
+
+    if (m_terminated) {
+      uv_mutex_unlock(&m_workerLock);
+      delete task;
+      return;
+    }
+
+    background_queue_.push(task);
+    uv_cond_signal(&m_workerCondition);
+
+    uv_mutex_unlock(&m_workerLock);
   }
 
   void DefaultPlatform::CallOnForegroundThread(v8::Isolate* isolate,
@@ -66,20 +169,79 @@ namespace jsrt {
     uv_mutex_unlock(&m_lock);
   }
 
+  void DefaultPlatform::CallDelayedOnForegroundThread(v8::Isolate* isolate,
+                                                      v8::Task* task,
+                                                      double delay_in_seconds) {
+    double deadline = MonotonicallyIncreasingTime() + delay_in_seconds;
+
+    uv_mutex_lock(&m_lock);
+
+    main_thread_delayed_queue_[isolate].push(std::make_pair(deadline, task));
+
+    uv_mutex_unlock(&m_lock);
+  }
+
   double DefaultPlatform::MonotonicallyIncreasingTime() {
-    // CHAKRA-TODO: Figure out what to do here.
-    CHAKRA_ASSERT(false);
+    return static_cast<double>(uv_hrtime()) / 1e9;
+  }
 
-    return 0;
+  void DefaultPlatform::WorkerThreadProc(void* arg) {
+    static_cast<DefaultPlatform*>(arg)->RunWorker();
   }
 
-  v8::Task* DefaultPlatform::PopTaskInMainThreadQueue(v8::Isolate* isolate) {
-    auto it = main_thread_queue_.find(isolate);
-    if (it == main_thread_queue_.end() || it->second.empty()) {
-      return nullptr;
+  void DefaultPlatform::RunWorker() {
+    uv_mutex_lock(&m_workerLock);
+
+    while (true) {
+      // The work items of the engine are run even after termination, the
+      // runtime waits for them
+      if (!work_item_queue_.empty()) {
+        BackgroundWorkItem workItem = work_item_queue_.front();
+        work_item_queue_.pop();
+
+        uv_mutex_unlock(&m_workerLock);
+        workItem.first(workItem.second);
+        uv_mutex_lock(&m_workerLock);
+      } else if (m_terminated) {
+        break;
+      } else if (!background_queue_.empty()) {
+        v8::Task* task = background_queue_.front();
+        background_queue_.pop();
+
+        uv_mutex_unlock(&m_workerLock);
+        task->Run();
+        delete task;
+        uv_mutex_lock(&m_workerLock);
+      } else {
+        m_idleWorkers++;
+        uv_cond_wait(&m_workerCondition, &m_workerLock);
+        m_idleWorkers--;
+      }
+    }
+
+    uv_mutex_unlock(&m_workerLock);
+  }
+
+  bool CHAKRA_CALLBACK DefaultPlatform::ThreadServiceCallback(
+      JsBackgroundWorkItemCallback callback, void* callbackState) {
+    // Returning false makes the runtime do the work on its own thread
+    DefaultPlatform* platform = s_instance;
+    if (platform == nullptr) {
+      return false;
+    }
+
+    uv_mutex_lock(&platform->m_workerLock);
+
+    if (platform->m_terminated ||
+        platform->work_item_queue_.size() >= platform->m_idleWorkers) {
+      uv_mutex_unlock(&platform->m_workerLock);
+      return false;
     }
-    v8::Task* task = it->second.front();
-    it->second.pop();
-    return task;
+
+    platform->work_item_queue_.push(std::make_pair(callback, callbackState));
+    uv_cond_signal(&platform->m_workerCondition);
+
+    uv_mutex_unlock(&platform->m_workerLock);
+    return true;
   }
 }  // namespace jsrt
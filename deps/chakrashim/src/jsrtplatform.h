@@ -20,30 +20,70 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include "v8-platform.h"
+#include "ChakraCore.h"
 #include <uv.h>
 
 namespace jsrt {
 
+// Runs background tasks on a pool of worker threads. The pool also serves as
+// the thread service of the runtimes, so the JIT and concurrent GC work of
+// ChakraCore runs on the same threads instead of threads of its own.
 class DefaultPlatform : public v8::Platform {
  public:
-  DefaultPlatform();
+  explicit DefaultPlatform(int thread_pool_size);
   virtual ~DefaultPlatform();
 
   bool PumpMessageLoop(v8::Isolate* isolate);
 
+  // The thread service to create runtimes with, or nullptr if there is no
+  // platform to run the background work on.
+  static JsThreadServiceCallback GetThreadService();
+
+  virtual size_t NumberOfAvailableBackgroundThreads() override;
   virtual void CallOnBackgroundThread(v8::Task* task,
                                       ExpectedRuntime expected_runtime) override;
   virtual void CallOnForegroundThread(v8::Isolate* isolate, v8::Task* task) override;
+  virtual void CallDelayedOnForegroundThread(v8::Isolate* isolate,
+                                             v8::Task* task,
+                                             double delay_in_seconds) override;
   virtual double MonotonicallyIncreasingTime() override;
 
  private:
-  v8::Task* PopTaskInMainThreadQueue(v8::Isolate* isolate);
+  typedef std::pair<double, v8::Task*> DelayedTask;
+  typedef std::priority_queue<DelayedTask, std::vector<DelayedTask>,
+                              std::greater<DelayedTask> > DelayedTaskQueue;
+  typedef std::pair<JsBackgroundWorkItemCallback, void*> BackgroundWorkItem;
+
+  static void WorkerThreadProc(void* arg);
+  static bool CHAKRA_CALLBACK ThreadServiceCallback(
+    JsBackgroundWorkItemCallback callback, void* callbackState);
+  void RunWorker();
+
+  static DefaultPlatform* s_instance;
+
   uv_mutex_t m_lock;
   std::map<v8::Isolate*, std::queue<v8::Task*> > main_thread_queue_;
+  std::map<v8::Isolate*, DelayedTaskQueue> main_thread_delayed_queue_;
+
+  // Work items of the engine go ahead of the tasks, the script thread may be
+  // waiting for them to finish a collection.
+  uv_mutex_t m_workerLock;
+  uv_cond_t m_workerCondition;
+  std::queue<BackgroundWorkItem> work_item_queue_;
+  std::queue<v8::Task*> background_queue_;
+  std::vector<uv_thread_t> worker_threads_;
+  // Workers waiting for something to run. A work item of the engine is only
+  // accepted if a worker is free to take it: a work item may wait for the
+  // ones it queues itself, and tasks may keep the other workers busy.
+  size_t m_idleWorkers;
+  bool m_terminated;
 };
 
 }  // namespace jsrt
@@ -18,10 +18,15 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+#include <limits.h>
 #include <stdarg.h>
 #include "jsrtutils.h"
 #include <string>
 
+namespace v8 {
+  extern THREAD_LOCAL JsSourceContext currentContext;
+}
+
 namespace jsrt {
 
 JsErrorCode UintToValue(uint32_t value, JsValueRef* result) {
@@ -615,19 +620,15 @@ JsErrorCode DefineProperty(JsValueRef object,
 JsErrorCode GetPropertyIdFromName(JsValueRef nameRef,
                                   JsPropertyIdRef *idRef) {
   JsErrorCode error;
-  StringUtf8 str;
 
-  // Expect the name be either a String or a Symbol.
-  error = str.From(nameRef);
-  if (error != JsNoError) {
-    if (error == JsErrorInvalidArgument) {
-      error = JsGetPropertyIdFromSymbol(nameRef, idRef);
-      if (error == JsErrorPropertyNotSymbol) {
-        error = JsErrorInvalidArgument;  // Neither String nor Symbol
-      }
+  // Expect the name be either a String or a Symbol. Interned strings (see
+  // String::NewFromOneByte with kInternalized) resolve without a lookup.
+  error = JsGetPropertyIdFromString(nameRef, idRef);
+  if (error == JsErrorPropertyNotString) {
+    error = JsGetPropertyIdFromSymbol(nameRef, idRef);
+    if (error == JsErrorPropertyNotSymbol) {
+      error = JsErrorInvalidArgument;  // Neither String nor Symbol
     }
-  } else {
-    error = JsCreatePropertyId(str, str.length(), idRef);
   }
 
   return error;
@@ -730,29 +731,29 @@ JsErrorCode HasIndexedProperty(JsValueRef object,
   return error;
 }
 
-JsErrorCode ParseScript(StringUtf8 *script,
-                        JsSourceContext sourceContext,
-                        JsValueRef sourceUrl,
-                        bool isStrictMode,
-                        JsValueRef *result) {
+JsErrorCode CreateScriptSource(StringUtf8 *script,
+                               bool isStrictMode,
+                               JsValueRef *result) {
   if (isStrictMode) {
     // do not append new line so the line numbers on error stack are correct
     std::string useStrictTag("'use strict'; ");
     useStrictTag.append(*script);
-    JsValueRef scriptToParse;
-    CHAKRA_VERIFY(JsCreateString(useStrictTag.c_str(),
-                                 useStrictTag.length(),
-                                 &scriptToParse) == JsNoError);
-    return JsParse(scriptToParse, sourceContext, sourceUrl,
-                   JsParseScriptAttributeNone, result);
-  } else {
-    JsValueRef scriptToParse;
-    CHAKRA_VERIFY(JsCreateString(script->operator*(),
-                                 script->length(),
-                                 &scriptToParse) == JsNoError);
-    return JsParse(scriptToParse, sourceContext, sourceUrl,
-                   JsParseScriptAttributeNone, result);
+    return JsCreateString(useStrictTag.c_str(), useStrictTag.length(), result);
   }
+
+  return JsCreateString(script->operator*(), script->length(), result);
+}
+
+JsErrorCode ParseScript(StringUtf8 *script,
+                        JsSourceContext sourceContext,
+                        JsValueRef sourceUrl,
+                        bool isStrictMode,
+                        JsValueRef *result) {
+  JsValueRef scriptToParse;
+  CHAKRA_VERIFY(CreateScriptSource(script, isStrictMode,
+                                   &scriptToParse) == JsNoError);
+  return JsParse(scriptToParse, sourceContext, sourceUrl,
+                 JsParseScriptAttributeNone, result);
 }
 
 #define RETURN_IF_JSERROR(err, returnValue) \
@@ -956,47 +957,84 @@ JsValueRef CHAKRA_CALLBACK CollectGarbage(
   return GetUndefined();
 }
 
+// nativeCaptureStackTrace(skipUntil, frameLimit) for chakra_shim.js
+JsValueRef CHAKRA_CALLBACK CaptureStackTrace(
+  JsValueRef callee,
+  bool isConstructCall,
+  JsValueRef *arguments,
+  unsigned short argumentCount,
+  void *callbackState) {
+  JsValueRef skipUntil = JS_INVALID_REFERENCE;
+  JsValueType type;
+  if (argumentCount > 1 &&
+      JsGetValueType(arguments[1], &type) == JsNoError && type == JsFunction) {
+    skipUntil = arguments[1];
+  }
+
+  double limit = 0;
+  if (argumentCount > 2) {
+    JsNumberToDouble(arguments[2], &limit);
+  }
+
+  unsigned int frameLimit = 0;
+  if (limit >= static_cast<double>(UINT_MAX)) {
+    frameLimit = UINT_MAX;
+  } else if (limit > 0) {
+    frameLimit = static_cast<unsigned int>(limit);
+  }
+
+  JsValueRef stackTrace;
+  if (JsCaptureStackTrace(skipUntil, frameLimit, &stackTrace) != JsNoError) {
+    return GetUndefined();
+  }
+  return stackTrace;
+}
+
+// nativeGetStackTraceFrames(stackTrace) for chakra_shim.js
+JsValueRef CHAKRA_CALLBACK GetStackTraceFrames(
+  JsValueRef callee,
+  bool isConstructCall,
+  JsValueRef *arguments,
+  unsigned short argumentCount,
+  void *callbackState) {
+  JsValueRef frames;
+  if (argumentCount < 2 ||
+      JsGetStackTraceFrames(arguments[1], &frames) != JsNoError) {
+    return GetUndefined();
+  }
+  return frames;
+}
+
+// Idle work starts once the event loop has gone this long without running
+// script, and is picked up again this often while a concurrent collection
+// finishes in the background.
+static const uint64_t kIdleGcDelayInMilliSeconds = 1000;
+static const unsigned int kIdleGcRetryInMilliSeconds = 100;
+
 void IdleGC(uv_timer_t *timerHandler) {
-#ifdef _WIN32
-  unsigned int nextIdleTicks;
-  CHAKRA_VERIFY(JsIdle(&nextIdleTicks) == JsNoError);
-  DWORD currentTicks = GetTickCount();
-
-  // If idleGc completed, we don't need to schedule anything.
-  // simply reset the script execution flag so that idleGC
-  // is retriggered only when scripts are executed.
-  if (nextIdleTicks == UINT_MAX) {
-    IsolateShim::GetCurrent()->ResetScriptExecuted();
+  bool done;
+
+  // If idle work completed, we don't need to schedule anything. IdleGC is
+  // retriggered only when scripts are executed.
+  if (JsIdleNotification(kIdleGcRetryInMilliSeconds, &done) != JsNoError ||
+      done) {
     IsolateShim::GetCurrent()->ResetIsIdleGcScheduled();
     return;
   }
 
-  // If IdleGC didn't complete, retry doing it after diff.
-  if (nextIdleTicks > currentTicks) {
-    unsigned int diff = nextIdleTicks - currentTicks;
-    ScheduleIdleGcTask(diff);
-  } else {
-    IsolateShim::GetCurrent()->ResetIsIdleGcScheduled();
-  }
-#else
-  // CHAKRA-TODO: implement. No GetTickCount()
-  IsolateShim::GetCurrent()->ResetScriptExecuted();
-  IsolateShim::GetCurrent()->ResetIsIdleGcScheduled();
-#endif
+  ScheduleIdleGcTask(kIdleGcRetryInMilliSeconds);
 }
 
 void PrepareIdleGC(uv_prepare_t* prepareHandler) {
-  // If there were no scripts executed, return
+  // The event loop is about to block. If there were no scripts executed since
+  // the last time, the idle work is already scheduled or done.
   if (!IsolateShim::GetCurrent()->IsJsScriptExecuted()) {
     return;
   }
 
-  // If idleGC task already scheduled, return
-  if (IsolateShim::GetCurrent()->IsIdleGcScheduled()) {
-    return;
-  }
-
-  ScheduleIdleGcTask();
+  // Otherwise restart the wait, so idle work only runs once the loop is quiet
+  IsolateShim::GetCurrent()->ResetScriptExecuted();
+  ScheduleIdleGcTask(kIdleGcDelayInMilliSeconds);
 }
 
 void ScheduleIdleGcTask(uint64_t timeoutInMilliSeconds) {
@@ -1033,4 +1071,63 @@ JsErrorCode StringUtf8::From(JsValueRef strRef) {
   return errorCode;
 }
 
+struct SerializedScriptBuffer {
+  IsolateShim* isolateShim;
+  JsSourceContext sourceContext;
+  SerializedScript* script;
+};
+
+static void CHAKRA_CALLBACK SerializedScriptBufferFinalizeCallback(
+    void* data) {
+  SerializedScriptBuffer* buffer = static_cast<SerializedScriptBuffer*>(data);
+  buffer->isolateShim->RemoveSerializedScriptSource(buffer->sourceContext);
+  buffer->script->Release();
+  delete buffer;
+}
+
+static bool CHAKRA_CALLBACK LoadSerializedScriptSource(
+    JsSourceContext sourceContext, JsValueRef* value,
+    JsParseScriptAttributes* parseAttributes) {
+  *parseAttributes = JsParseScriptAttributeNone;
+  return IsolateShim::GetCurrent()->GetSerializedScriptSource(
+    sourceContext, value);
+}
+
+JsValueRef SerializedScript::Parse(JsValueRef scriptSource,
+                                   JsValueRef filenameRef) {
+  SerializedScriptBuffer* buffer = new SerializedScriptBuffer;
+  buffer->isolateShim = IsolateShim::GetCurrent();
+  buffer->sourceContext = v8::currentContext++;
+  buffer->script = this;
+  AddRef();
+
+  JsValueRef bufferRef;
+  if (JsCreateExternalArrayBuffer(data, length,
+                                  SerializedScriptBufferFinalizeCallback,
+                                  buffer, &bufferRef) != JsNoError) {
+    Release();
+    delete buffer;
+    return JS_INVALID_REFERENCE;
+  }
+
+  // The source is loaded lazily, keep it alive with the buffer. It may come
+  // from another context, so use the copy the buffer holds.
+  if (SetProperty(bufferRef, CachedPropertyIdRef::source,
+                  scriptSource) != JsNoError ||
+      GetProperty(bufferRef, CachedPropertyIdRef::source,
+                  &scriptSource) != JsNoError) {
+    return JS_INVALID_REFERENCE;
+  }
+  buffer->isolateShim->SetSerializedScriptSource(buffer->sourceContext,
+                                                 scriptSource);
+
+  JsValueRef scriptFunction;
+  if (JsParseSerialized(bufferRef, LoadSerializedScriptSource,
+                        buffer->sourceContext, filenameRef,
+                        &scriptFunction) != JsNoError) {
+    return JS_INVALID_REFERENCE;
+  }
+  return scriptFunction;
+}
+
 }  // namespace jsrt
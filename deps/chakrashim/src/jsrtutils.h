@@ -114,6 +114,34 @@ class StringUtf8 {
   int _length;
 };
 
+// Serialized byte code of a script. The engine keeps reading the byte code
+// for as long as functions parsed from it are alive, so every ArrayBuffer it
+// is handed to JsParseSerialized in holds a reference.
+class SerializedScript {
+ public:
+  SerializedScript(const uint8_t* data, unsigned int length)
+    : refCount(1), data(new uint8_t[length]), length(length) {
+    memcpy(this->data, data, length);
+  }
+
+  void AddRef() { refCount++; }
+  void Release() {
+    if (--refCount == 0) {
+      delete this;
+    }
+  }
+
+  // Returns the script function, or JS_INVALID_REFERENCE on failure
+  JsValueRef Parse(JsValueRef scriptSource, JsValueRef filenameRef);
+
+ private:
+  ~SerializedScript() { delete[] data; }
+
+  int refCount;
+  uint8_t* data;
+  unsigned int length;
+};
+
 JsErrorCode InitializePromise();
 
 JsErrorCode UintToValue(uint32_t value, JsValueRef* result);
@@ -281,6 +309,18 @@ JsValueRef CHAKRA_CALLBACK CollectGarbage(JsValueRef callee,
                                           unsigned short argumentCount,
                                           void *callbackState);
 
+JsValueRef CHAKRA_CALLBACK CaptureStackTrace(JsValueRef callee,
+                                             bool isConstructCall,
+                                             JsValueRef *arguments,
+                                             unsigned short argumentCount,
+                                             void *callbackState);
+
+JsValueRef CHAKRA_CALLBACK GetStackTraceFrames(JsValueRef callee,
+                                               bool isConstructCall,
+                                               JsValueRef *arguments,
+                                               unsigned short argumentCount,
+                                               void *callbackState);
+
 // the possible values for the property descriptor options
 enum PropertyDescriptorOptionValues {
   True,
@@ -342,6 +382,10 @@ JsErrorCode GetIndexedProperty(JsValueRef object,
 
 // CHAKRA-TODO : Currently Chakra's ParseScript doesn't support strictMode
 // flag. As a workaround, prepend the script text with 'use strict'.
+JsErrorCode CreateScriptSource(StringUtf8 *script,
+                               bool isStrictMode,
+                               JsValueRef *result);
+
 JsErrorCode ParseScript(StringUtf8 *script,
                         JsSourceContext sourceContext,
                         JsValueRef sourceUrl,
@@ -367,7 +411,7 @@ void Unimplemented(const char * message);
 
 void Fatal(const char * format, ...);
 
-void ScheduleIdleGcTask(uint64_t timeoutInMilliSeconds = 1000);
+void ScheduleIdleGcTask(uint64_t timeoutInMilliSeconds);
 
 void PrepareIdleGC(uv_prepare_t* prepareHandler);
 
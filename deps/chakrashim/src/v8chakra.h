@@ -80,25 +80,6 @@ class ObjectData: public ExternalData {
   static const ExternalDataTypes ExternalDataType =
     ExternalDataTypes::ObjectData;
 
-  struct FieldValue {
-   public:
-    FieldValue() : value(nullptr), isRefValue(false) {}
-    ~FieldValue() { Reset(); }
-
-    void SetRef(JsValueRef ref);
-    JsValueRef GetRef() const;
-    bool IsRef() const;
-
-    void SetPointer(void* ptr);
-    void* GetPointer() const;
-
-   private:
-    void Reset();
-
-    void* value;
-    bool isRefValue;
-  };
-
   JsValueRef objectInstance;
   Persistent<ObjectTemplate> objectTemplate;  // Original ObjectTemplate
   NamedPropertyGetterCallback namedPropertyGetter;
@@ -114,13 +95,13 @@ class ObjectData: public ExternalData {
   IndexedPropertyEnumeratorCallback indexedPropertyEnumerator;
   Persistent<Value> indexedPropertyInterceptorData;
   int internalFieldCount;
-  FieldValue* internalFields;
 
   ObjectData(ObjectTemplate* objectTemplate, ObjectTemplateData *templateData);
   ~ObjectData();
   static void CHAKRA_CALLBACK FinalizeCallback(void *data);
 
-  static FieldValue* GetInternalField(Object* object, int index);
+  static void* GetInternalField(Object* object, int index);
+  static void SetInternalField(Object* object, int index, void* value);
 };
 
 class TemplateData : public ExternalData {
@@ -149,64 +130,36 @@ class Utils {
     unsigned short argumentCount,
     void *callbackState);
 
-  static JsValueRef CHAKRA_CALLBACK GetCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState);
-  static JsValueRef CHAKRA_CALLBACK SetCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState);
-  static JsValueRef CHAKRA_CALLBACK DeletePropertyCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState);
-
-  static JsValueRef HasPropertyHandler(
-    JsValueRef *arguments,
-    unsigned short argumentCount);
-  static JsValueRef CHAKRA_CALLBACK HasCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState);
-
-  static JsValueRef GetPropertiesEnumeratorHandler(
-    JsValueRef* arguments,
-    unsigned int argumentsCount);
-  static JsValueRef CHAKRA_CALLBACK EnumerateCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState);
-
-  static JsValueRef GetPropertiesHandler(
-    JsValueRef* arguments,
-    unsigned int argumentsCount,
-    bool getFromPrototype);
-  static JsValueRef CHAKRA_CALLBACK OwnKeysCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState);
-  static JsValueRef CHAKRA_CALLBACK GetOwnPropertyDescriptorCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState);
+  static bool CHAKRA_CALLBACK NamedGetterInterceptor(
+    JsValueRef object, JsValueRef name, JsValueRef *value);
+  static bool CHAKRA_CALLBACK NamedSetterInterceptor(
+    JsValueRef object, JsValueRef name, JsValueRef value);
+  static bool CHAKRA_CALLBACK NamedQueryInterceptor(
+    JsValueRef object, JsValueRef name,
+    JsInterceptedPropertyAttributes *attributes);
+  static bool CHAKRA_CALLBACK NamedDeleterInterceptor(
+    JsValueRef object, JsValueRef name, bool *result);
+  static JsValueRef CHAKRA_CALLBACK NamedEnumeratorInterceptor(
+    JsValueRef object);
+
+  static bool CHAKRA_CALLBACK IndexedGetterInterceptor(
+    JsValueRef object, unsigned int index, JsValueRef *value);
+  static bool CHAKRA_CALLBACK IndexedSetterInterceptor(
+    JsValueRef object, unsigned int index, JsValueRef value);
+  static bool CHAKRA_CALLBACK IndexedQueryInterceptor(
+    JsValueRef object, unsigned int index,
+    JsInterceptedPropertyAttributes *attributes);
+  static bool CHAKRA_CALLBACK IndexedDeleterInterceptor(
+    JsValueRef object, unsigned int index, bool *result);
+  static JsValueRef CHAKRA_CALLBACK IndexedEnumeratorInterceptor(
+    JsValueRef object);
 
   static void CHAKRA_CALLBACK WeakReferenceCallbackWrapperCallback(
     JsRef ref, void *data);
+  static void CHAKRA_CALLBACK ExternalWeakCallbackInfoCallback(
+    JsValueRef object, void *callback, void *parameters);
+  static void CHAKRA_CALLBACK ExternalWeakCallbackDataCallback(
+    JsValueRef object, void *callback, void *parameters);
 
   static JsValueRef CHAKRA_CALLBACK ObjectPrototypeToStringShim(
     JsValueRef callee,
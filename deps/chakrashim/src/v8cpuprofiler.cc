@@ -0,0 +1,144 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "v8chakra.h"
+#include "v8-profiler.h"
+#include "jsrtutils.h"
+#include "jsrtcpuprofiler.h"
+
+namespace v8 {
+
+using jsrt::IsolateShim;
+using jsrt::CpuProfilerShim;
+using jsrt::CpuProfileShim;
+using jsrt::CpuProfileNodeShim;
+
+static Local<String> CreateString(const char * str) {
+  return String::NewFromUtf8(Isolate::GetCurrent(), str,
+                             NewStringType::kNormal).FromMaybe(Local<String>());
+}
+
+Local<String> CpuProfileNode::GetFunctionName() const {
+  return CreateString(GetFunctionNameStr());
+}
+
+const char* CpuProfileNode::GetFunctionNameStr() const {
+  return CpuProfileNodeShim::FromCpuProfileNode(this)->node->functionName;
+}
+
+int CpuProfileNode::GetScriptId() const {
+  return static_cast<int>(
+    CpuProfileNodeShim::FromCpuProfileNode(this)->node->scriptId);
+}
+
+Local<String> CpuProfileNode::GetScriptResourceName() const {
+  return CreateString(GetScriptResourceNameStr());
+}
+
+const char* CpuProfileNode::GetScriptResourceNameStr() const {
+  return CpuProfileNodeShim::FromCpuProfileNode(this)->node->url;
+}
+
+int CpuProfileNode::GetLineNumber() const {
+  // The runtime's lines and columns are 0 based
+  int line = CpuProfileNodeShim::FromCpuProfileNode(this)->node->lineNumber;
+  return line >= 0 ? line + 1 : kNoLineNumberInfo;
+}
+
+int CpuProfileNode::GetColumnNumber() const {
+  int column = CpuProfileNodeShim::FromCpuProfileNode(this)->node->columnNumber;
+  return column >= 0 ? column + 1 : kNoColumnNumberInfo;
+}
+
+unsigned CpuProfileNode::GetHitCount() const {
+  return CpuProfileNodeShim::FromCpuProfileNode(this)->node->hitCount;
+}
+
+unsigned CpuProfileNode::GetNodeId() const {
+  // Node ids start at 1 in v8
+  return CpuProfileNodeShim::FromCpuProfileNode(this)->node->id + 1;
+}
+
+int CpuProfileNode::GetChildrenCount() const {
+  return static_cast<int>(
+    CpuProfileNodeShim::FromCpuProfileNode(this)->children.size());
+}
+
+const CpuProfileNode* CpuProfileNode::GetChild(int index) const {
+  return CpuProfileNodeShim::ToCpuProfileNode(
+    CpuProfileNodeShim::FromCpuProfileNode(this)->children[index]);
+}
+
+Local<String> CpuProfile::GetTitle() const {
+  return CreateString(CpuProfileShim::FromCpuProfile(this)->GetTitle().c_str());
+}
+
+const CpuProfileNode* CpuProfile::GetTopDownRoot() const {
+  return CpuProfileNodeShim::ToCpuProfileNode(
+    CpuProfileShim::FromCpuProfile(this)->GetRoot());
+}
+
+int CpuProfile::GetSamplesCount() const {
+  return CpuProfileShim::FromCpuProfile(this)->GetSamplesCount();
+}
+
+const CpuProfileNode* CpuProfile::GetSample(int index) const {
+  return CpuProfileNodeShim::ToCpuProfileNode(
+    CpuProfileShim::FromCpuProfile(this)->GetSample(index));
+}
+
+int64_t CpuProfile::GetSampleTimestamp(int index) const {
+  return CpuProfileShim::FromCpuProfile(this)->GetSampleTimestamp(index);
+}
+
+int64_t CpuProfile::GetStartTime() const {
+  return CpuProfileShim::FromCpuProfile(this)->GetStartTime();
+}
+
+int64_t CpuProfile::GetEndTime() const {
+  return CpuProfileShim::FromCpuProfile(this)->GetEndTime();
+}
+
+void CpuProfile::Delete() {
+  delete CpuProfileShim::FromCpuProfile(this);
+}
+
+void CpuProfiler::SetSamplingInterval(int us) {
+  CpuProfilerShim::FromCpuProfiler(this)->SetSamplingInterval(us);
+}
+
+void CpuProfiler::StartProfiling(Local<String> title, bool record_samples) {
+  String::Utf8Value str(title);
+  CpuProfilerShim::FromCpuProfiler(this)->StartProfiling(
+    *str != nullptr ? *str : "", record_samples);
+}
+
+CpuProfile* CpuProfiler::StopProfiling(Local<String> title) {
+  String::Utf8Value str(title);
+  CpuProfileShim * profile = CpuProfilerShim::FromCpuProfiler(this)
+    ->StopProfiling(*str != nullptr ? *str : "");
+  return profile != nullptr ? CpuProfileShim::ToCpuProfile(profile) : nullptr;
+}
+
+void CpuProfiler::SetIdle(bool is_idle) {
+  CpuProfilerShim::FromCpuProfiler(this)->SetIdle(is_idle);
+}
+
+}  // namespace v8
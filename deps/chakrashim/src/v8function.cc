@@ -28,6 +28,9 @@ using jsrt::ContextShim;
 using jsrt::PropertyDescriptorOptionValues;
 using jsrt::DefineProperty;
 
+// Calls with up to this many arguments (including "this") do not allocate
+static const int kMaxStackArguments = 16;
+
 MaybeLocal<Function> Function::New(Local<Context> context,
                                    FunctionCallback callback,
                                    Local<Value> data,
@@ -49,7 +52,7 @@ MaybeLocal<Function> Function::New(Local<Context> context,
 
 MaybeLocal<Object> Function::NewInstance(Local<Context> context,
                                          int argc, Handle<Value> argv[]) const {
-  jsrt::JsArguments<> args(argc + 1);
+  jsrt::JsArguments<kMaxStackArguments> args(argc + 1);
   args[0] = jsrt::GetUndefined();
 
   if (argc > 0) {
@@ -78,24 +81,33 @@ Local<Object> Function::NewInstance() const {
 MaybeLocal<Value> Function::Call(Local<Context> context,
                                  Handle<Value> recv, int argc,
                                  Handle<Value> argv[]) {
-  IsolateShim::GetCurrent()->SetScriptExecuted();
+  return FastCall(IsolateShim::GetCurrentAsIsolate(), recv, argc, argv);
+}
+
+MaybeLocal<Value> Function::FastCall(Isolate* isolate,
+                                     Handle<Value> recv, int argc,
+                                     Handle<Value> argv[]) {
+  IsolateShim::FromIsolate(isolate)->SetScriptExecuted();
 
-  jsrt::JsArguments<> args(argc + 1);
+  jsrt::JsArguments<kMaxStackArguments> args(argc + 1);
   args[0] = *recv;
 
   for (int i = 0; i < argc; i++) {
     args[i + 1] = *argv[i];
   }
 
+  // The TryCatch stays on the stack for the duration of the call so that
+  // nested Function::Calls leave their exceptions to propagate to us.
   JsValueRef result;
   {
-    TryCatch tryCatch;
+    TryCatch tryCatch(isolate);
     tryCatch.SetNonUser();
     if (JsCallFunction((JsValueRef)this, args, argc + 1,
                        &result) != JsNoError) {
       tryCatch.CheckReportExternalException();
       return Local<Value>();
     }
+    tryCatch.SetNoException();
   }
   return Local<Value>::New(result);
 }
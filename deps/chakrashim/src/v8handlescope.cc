@@ -30,14 +30,19 @@ HandleScope::HandleScope(Isolate* isolate)
       _locals(),
       _count(0),
       _contextRef(JS_INVALID_REFERENCE),
+      _arena(nullptr),
+      _arenaMark(0),
       _addRefRecordHead(nullptr) {
-  _locals[0] = JS_INVALID_REFERENCE;
   current = this;
 }
 
 HandleScope::~HandleScope() {
   current = _prev;
 
+  if (_arena != nullptr) {
+    _arena->PopTo(_arenaMark);
+  }
+
   AddRefRecord * currRecord = this->_addRefRecordHead;
   while (currRecord != nullptr) {
     AddRefRecord * nextRecord = currRecord->_next;
@@ -55,26 +60,24 @@ HandleScope *HandleScope::GetCurrent() {
 }
 
 bool HandleScope::AddLocal(JsValueRef value) {
-  // _locals is full, save them in _locals[0]
-  if (_count == kOnStackLocals) {
-    if (_locals[0] == JS_INVALID_REFERENCE) {
-      if (JsCreateArray(0, &_locals[0]) != JsNoError) {
-        return AddLocalAddRef(value);
-      }
-    }
-
-    JsValueRef arrayPushFunction =
-        jsrt::ContextShim::GetCurrent()->GetArrayPushFunction();
-
-    JsValueRef result;
-    if (JsCallFunction(arrayPushFunction, _locals,
-                       _countof(_locals), &result) != JsNoError) {
-      return AddLocalAddRef(value);
-    }
-    _count = 0;
+  if (_count < kOnStackLocals) {
+    _locals[_count++] = value;
+    return true;
   }
-  _locals[1 + _count++] = value;
-  return true;
+
+  // _locals is full, continue in the isolate's handle arena. Only the
+  // innermost scope can push there; a value escaping into an outer scope
+  // (see Close) is kept alive with an AddRef instead.
+  if (this != current) {
+    return AddLocalAddRef(value);
+  }
+
+  if (_arena == nullptr) {
+    _arena = jsrt::IsolateShim::GetCurrent()->GetHandleArena();
+    _arenaMark = _arena->Top();
+  }
+
+  return _arena->Push(value) || AddLocalAddRef(value);
 }
 
 bool HandleScope::AddLocalContext(JsContextRef value) {
@@ -0,0 +1,54 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+
+#include "v8chakra.h"
+#include "v8-profiler.h"
+#include "jsrtutils.h"
+#include "jsrtheapprofiler.h"
+
+namespace v8 {
+
+using jsrt::HeapProfilerShim;
+using jsrt::HeapSnapshotShim;
+
+int HeapSnapshot::GetNodesCount() const {
+  return HeapSnapshotShim::FromHeapSnapshot(this)->GetNodesCount();
+}
+
+void HeapSnapshot::Delete() {
+  delete HeapSnapshotShim::FromHeapSnapshot(this);
+}
+
+void HeapSnapshot::Serialize(OutputStream* stream,
+                             SerializationFormat format) const {
+  HeapSnapshotShim::FromHeapSnapshot(this)->Serialize(stream);
+}
+
+const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
+    ActivityControl* control,
+    ObjectNameResolver* global_object_name_resolver) {
+  HeapSnapshotShim * snapshot =
+    HeapProfilerShim::FromHeapProfiler(this)->TakeHeapSnapshot(control);
+  return snapshot != nullptr ? HeapSnapshotShim::ToHeapSnapshot(snapshot)
+                             : nullptr;
+}
+
+}  // namespace v8
@@ -21,12 +21,11 @@
 #include "v8.h"
 #include "v8-profiler.h"
 #include "jsrtutils.h"
+#include "jsrtcpuprofiler.h"
+#include "jsrtheapprofiler.h"
 
 namespace v8 {
 
-HeapProfiler dummyHeapProfiler;
-CpuProfiler dummyCpuProfiler;
-
 Isolate* Isolate::NewWithTTDSupport(const CreateParams& params, 
                       size_t optReplayUriLength, const char* optReplayUri,
                       bool doRecord, bool doReplay, bool doDebug,
@@ -79,9 +78,8 @@ void Isolate::Dispose() {
 
 int64_t Isolate::AdjustAmountOfExternalAllocatedMemory(
     int64_t change_in_bytes) {
-  // CHAKRA-TODO: We don't support adding external memory pressure at the
-  // moment.
-  return 0;
+  return jsrt::IsolateShim::FromIsolate(this)->AdjustExternalMemory(
+    change_in_bytes);
 }
 
 void Isolate::SetData(uint32_t slot, void* data) {
@@ -159,25 +157,33 @@ Local<Value> Isolate::ThrowException(Local<Value> exception) {
 }
 
 HeapProfiler* Isolate::GetHeapProfiler() {
-  return &dummyHeapProfiler;
+  return jsrt::HeapProfilerShim::ToHeapProfiler(
+    jsrt::IsolateShim::FromIsolate(this)->GetHeapProfiler());
 }
 
 CpuProfiler* Isolate::GetCpuProfiler() {
-  return &dummyCpuProfiler;
+  return jsrt::CpuProfilerShim::ToCpuProfiler(
+    jsrt::IsolateShim::FromIsolate(this)->GetCpuProfiler());
 }
 
 void Isolate::AddGCPrologueCallback(
   GCCallback callback, GCType gc_type_filter) {
+  jsrt::IsolateShim::FromIsolate(this)->AddGCPrologueCallback(
+    callback, gc_type_filter);
 }
 
 void Isolate::RemoveGCPrologueCallback(GCCallback callback) {
+  jsrt::IsolateShim::FromIsolate(this)->RemoveGCPrologueCallback(callback);
 }
 
 void Isolate::AddGCEpilogueCallback(
   GCCallback callback, GCType gc_type_filter) {
+  jsrt::IsolateShim::FromIsolate(this)->AddGCEpilogueCallback(
+    callback, gc_type_filter);
 }
 
 void Isolate::RemoveGCEpilogueCallback(GCCallback callback) {
+  jsrt::IsolateShim::FromIsolate(this)->RemoveGCEpilogueCallback(callback);
 }
 
 void Isolate::CancelTerminateExecution() {
@@ -209,41 +215,105 @@ void Isolate::SetAddHistogramSampleFunction(AddHistogramSampleCallback) {
 }
 
 bool Isolate::IdleNotificationDeadline(double deadline_in_seconds) {
-  CHAKRA_UNIMPLEMENTED();
-  return false;
+  // The deadline is on the platform's clock, which is uv_hrtime
+  double idle_time_in_seconds =
+    deadline_in_seconds - static_cast<double>(uv_hrtime()) / 1e9;
+  return IdleNotification(
+    idle_time_in_seconds > 0 ? static_cast<int>(idle_time_in_seconds * 1000) :
+                               0);
 }
 
 bool Isolate::IdleNotification(int idle_time_in_ms) {
-  CHAKRA_UNIMPLEMENTED();
-  return false;
+  // The idle collection doesn't scan the stack, and Locals are raw pointers
+  // held on it. Only the event loop's idle timer is known to call in with no
+  // Locals alive, so refuse while a HandleScope is open. Script frames are
+  // refused by the engine itself.
+  if (HandleScope::GetCurrent() != nullptr) {
+    return false;
+  }
+
+  bool done;
+  JsErrorCode error = JsIdleNotification(
+    idle_time_in_ms > 0 ? static_cast<unsigned int>(idle_time_in_ms) : 0,
+    &done);
+
+  // Without idle processing (--off-idlegc) there is never idle work to do
+  return error != JsNoError || done;
 }
 
 void Isolate::LowMemoryNotification() {
-  CHAKRA_UNIMPLEMENTED();
+  JsLowMemoryNotification(
+    jsrt::IsolateShim::FromIsolate(this)->GetRuntimeHandle());
 }
 
 int Isolate::ContextDisposedNotification() {
-  CHAKRA_UNIMPLEMENTED();
+  // Let the next idle pass of the event loop clean up after the context
+  jsrt::IsolateShim::FromIsolate(this)->SetScriptExecuted();
   return 0;
 }
 
+static const struct {
+  const char* name;
+  JsHeapSpace space;
+} heapSpaces[] = {
+  { "object_space", JsHeapSpace_Object },
+  { "leaf_space", JsHeapSpace_Leaf },
+  { "large_object_space", JsHeapSpace_LargeObject },
+  { "code_space", JsHeapSpace_Code },
+};
+
 void Isolate::GetHeapStatistics(HeapStatistics *heap_statistics) {
+  jsrt::IsolateShim* isolateShim = jsrt::IsolateShim::FromIsolate(this);
   size_t memoryUsage;
-  if (!jsrt::IsolateShim::FromIsolate(this)->GetMemoryUsage(&memoryUsage)) {
+  if (!isolateShim->GetMemoryUsage(&memoryUsage)) {
     return;
   }
-  // CONSIDER: V8 distinguishes between "total" size and "used" size
   heap_statistics->set_heap_size(memoryUsage);
+
+  // The caller may reuse the same HeapStatistics, so don't add to stale sums
+  heap_statistics->used_heap_size_ = 0;
+  heap_statistics->total_available_size_ = 0;
+  heap_statistics->total_physical_size_ = 0;
+  heap_statistics->total_heap_size_executable_ = 0;
+
+  for (size_t i = 0; i < _countof(heapSpaces); i++) {
+    JsHeapSpaceStatistics statistics;
+    if (JsGetRuntimeHeapSpaceStatistics(isolateShim->GetRuntimeHandle(),
+                                        heapSpaces[i].space,
+                                        &statistics) != JsNoError) {
+      continue;
+    }
+    heap_statistics->used_heap_size_ += statistics.usedBytes;
+    heap_statistics->total_available_size_ += statistics.availableBytes;
+    heap_statistics->total_physical_size_ += statistics.committedBytes;
+    if (heapSpaces[i].space == JsHeapSpace_Code) {
+      heap_statistics->total_heap_size_executable_ += statistics.committedBytes;
+    }
+  }
 }
 
 size_t Isolate::NumberOfHeapSpaces() {
-  // Chakra doesn't expose HEAP space stats
-  return 0;
+  return _countof(heapSpaces);
 }
 
 bool Isolate::GetHeapSpaceStatistics(HeapSpaceStatistics* space_statistics,
                                      size_t index) {
-  // Chakra doesn't expose HEAP space stats
+  if (index >= _countof(heapSpaces)) {
+    return false;
+  }
+
+  JsHeapSpaceStatistics statistics;
+  if (JsGetRuntimeHeapSpaceStatistics(
+        jsrt::IsolateShim::FromIsolate(this)->GetRuntimeHandle(),
+        heapSpaces[index].space, &statistics) != JsNoError) {
+    return false;
+  }
+
+  space_statistics->space_name_ = heapSpaces[index].name;
+  space_statistics->space_size_ = statistics.committedBytes;
+  space_statistics->space_used_size_ = statistics.usedBytes;
+  space_statistics->space_available_size_ = statistics.availableBytes;
+  space_statistics->physical_space_size_ = statistics.committedBytes;
   return true;
 }
 
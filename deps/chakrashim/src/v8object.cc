@@ -20,6 +20,7 @@
 
 #include "v8chakra.h"
 #include <cassert>
+#include <limits.h>
 #include <memory>
 
 namespace v8 {
@@ -716,25 +717,8 @@ JsErrorCode Utils::GetObjectData(Object* object, ObjectData** objectData) {
     return JsNoError;
   }
 
-  JsErrorCode error;
-  JsValueRef self = object;
-  {
-    JsPropertyIdRef selfSymbolIdRef =
-      jsrt::IsolateShim::GetCurrent()->GetSelfSymbolPropertyIdRef();
-    if (selfSymbolIdRef != JS_INVALID_REFERENCE) {
-      JsValueRef result;
-      error = JsGetProperty(object, selfSymbolIdRef, &result);
-      if (error != JsNoError) {
-        return error;
-      }
-
-      if (!Local<Value>(result)->IsUndefined()) {
-        self = result;
-      }
-    }
-  }
-
-  return ExternalData::GetExternalData(self, objectData);
+  // Template instances are the external object itself, interceptors included
+  return ExternalData::GetExternalData(object, objectData);
 }
 
 int Object::InternalFieldCount() {
@@ -747,27 +731,19 @@ int Object::InternalFieldCount() {
 }
 
 Local<Value> Object::GetInternalField(int index) {
-  ObjectData::FieldValue* field = ObjectData::GetInternalField(this, index);
-  return field ? field->GetRef() : nullptr;
+  return static_cast<JsValueRef>(ObjectData::GetInternalField(this, index));
 }
 
 void Object::SetInternalField(int index, Handle<Value> value) {
-  ObjectData::FieldValue* field = ObjectData::GetInternalField(this, index);
-  if (field) {
-    field->SetRef(*value);
-  }
+  ObjectData::SetInternalField(this, index, *value);
 }
 
 void* Object::GetAlignedPointerFromInternalField(int index) {
-  ObjectData::FieldValue* field = ObjectData::GetInternalField(this, index);
-  return field ? field->GetPointer() : nullptr;
+  return ObjectData::GetInternalField(this, index);
 }
 
 void Object::SetAlignedPointerInInternalField(int index, void *value) {
-  ObjectData::FieldValue* field = ObjectData::GetInternalField(this, index);
-  if (field) {
-    field->SetPointer(value);
-  }
+  ObjectData::SetInternalField(this, index, value);
 }
 
 Local<Object> Object::Clone() {
@@ -813,6 +789,46 @@ Local<Object> Object::New(Isolate* isolate) {
   return Local<Object>::New(static_cast<Object*>(newObjectRef));
 }
 
+Local<Object> Object::New(Isolate* isolate,
+                          Local<Value> prototype_or_null,
+                          Local<Name>* names,
+                          Local<Value>* values,
+                          size_t length) {
+  if (length > INT_MAX) {
+    return Local<Object>();
+  }
+
+  jsrt::JsArguments<16> propertyIds(static_cast<int>(length));
+  jsrt::JsArguments<16> propertyValues(static_cast<int>(length));
+  for (size_t i = 0; i < length; i++) {
+    if (jsrt::GetPropertyIdFromName(*names[i], &propertyIds[i]) != JsNoError) {
+      return Local<Object>();
+    }
+    propertyValues[i] = *values[i];
+  }
+
+  JsValueRef newObjectRef;
+  if (JsCreateObjectWithProperties(propertyIds, propertyValues,
+                                   static_cast<unsigned int>(length),
+                                   &newObjectRef) != JsNoError) {
+    return Local<Object>();
+  }
+
+  // Only switch prototypes when asked to, that gives the object a new type
+  if (!prototype_or_null.IsEmpty()) {
+    JsValueRef prototypeRef;
+    if (JsGetPrototype(newObjectRef, &prototypeRef) != JsNoError) {
+      return Local<Object>();
+    }
+    if (prototypeRef != *prototype_or_null &&
+        JsSetPrototype(newObjectRef, *prototype_or_null) != JsNoError) {
+      return Local<Object>();
+    }
+  }
+
+  return Local<Object>::New(static_cast<Object*>(newObjectRef));
+}
+
 Object *Object::Cast(Value *obj) {
   CHAKRA_ASSERT(obj->IsObject());
   return static_cast<Object*>(obj);
@@ -45,6 +45,8 @@ class ObjectTemplateData : public TemplateData {
   FunctionCallback functionCallDelegate;
   Persistent<Value> functionCallDelegateInterceptorData;
   int internalFieldCount;
+  // Handed to the engine for every instance, so it must outlive them all
+  JsPropertyInterceptors interceptors;
 
   ObjectTemplateData()
       : TemplateData(ExternalDataType),
@@ -60,7 +62,8 @@ class ObjectTemplateData : public TemplateData {
         indexedPropertyEnumerator(nullptr),
         functionCallDelegate(nullptr),
         functionCallDelegateInterceptorData(nullptr),
-        internalFieldCount(0) {
+        internalFieldCount(0),
+        interceptors() {
   }
 
   ~ObjectTemplateData() {
@@ -95,6 +98,32 @@ class ObjectTemplateData : public TemplateData {
     */
   }
 
+  // Only hook the kinds of access the template intercepts, the engine keeps
+  // caching the others
+  const JsPropertyInterceptors* GetInterceptors() {
+    interceptors.namedGetter = namedPropertyGetter != nullptr ?
+      Utils::NamedGetterInterceptor : nullptr;
+    interceptors.namedSetter = namedPropertySetter != nullptr ?
+      Utils::NamedSetterInterceptor : nullptr;
+    interceptors.namedQuery = namedPropertyQuery != nullptr ?
+      Utils::NamedQueryInterceptor : nullptr;
+    interceptors.namedDeleter = namedPropertyDeleter != nullptr ?
+      Utils::NamedDeleterInterceptor : nullptr;
+    interceptors.namedEnumerator = namedPropertyEnumerator != nullptr ?
+      Utils::NamedEnumeratorInterceptor : nullptr;
+    interceptors.indexedGetter = indexedPropertyGetter != nullptr ?
+      Utils::IndexedGetterInterceptor : nullptr;
+    interceptors.indexedSetter = indexedPropertySetter != nullptr ?
+      Utils::IndexedSetterInterceptor : nullptr;
+    interceptors.indexedQuery = indexedPropertyQuery != nullptr ?
+      Utils::IndexedQueryInterceptor : nullptr;
+    interceptors.indexedDeleter = indexedPropertyDeleter != nullptr ?
+      Utils::IndexedDeleterInterceptor : nullptr;
+    interceptors.indexedEnumerator = indexedPropertyEnumerator != nullptr ?
+      Utils::IndexedEnumeratorInterceptor : nullptr;
+    return &interceptors;
+  }
+
   virtual JsValueRef NewInstance(JsValueRef templateRef) {
 #ifdef DEBUG
     ObjectTemplateData* data;
@@ -105,47 +134,6 @@ class ObjectTemplateData : public TemplateData {
   }
 };
 
-void ObjectData::FieldValue::SetRef(JsValueRef ref) {
-  Reset();
-
-  if (JsAddRef(ref, nullptr) != JsNoError) {
-    return;  // fail
-  }
-
-  value = reinterpret_cast<void*>(ref);
-  isRefValue = true;
-  CHAKRA_ASSERT(GetRef() == ref);
-}
-
-JsValueRef ObjectData::FieldValue::GetRef() const {
-  CHAKRA_ASSERT(IsRef() || !value);
-  return reinterpret_cast<JsValueRef>(value);
-}
-
-bool ObjectData::FieldValue::IsRef() const {
-  return isRefValue;
-}
-
-void ObjectData::FieldValue::SetPointer(void* ptr) {
-  Reset();
-  value = ptr;
-  isRefValue = false;
-  CHAKRA_ASSERT(GetPointer() == ptr);
-}
-
-void* ObjectData::FieldValue::GetPointer() const {
-  CHAKRA_ASSERT(!IsRef());
-  return value;
-}
-
-void ObjectData::FieldValue::Reset() {
-  if (IsRef()) {
-    JsRelease(GetRef(), nullptr);
-  }
-  isRefValue = false;
-  value = nullptr;
-}
-
 ObjectData::ObjectData(ObjectTemplate* objectTemplate,
                        ObjectTemplateData *templateData)
     : ExternalData(ExternalDataType),
@@ -165,16 +153,9 @@ ObjectData::ObjectData(ObjectTemplate* objectTemplate,
       indexedPropertyInterceptorData(
         nullptr, templateData->indexedPropertyInterceptorData),
       internalFieldCount(templateData->internalFieldCount) {
-  if (internalFieldCount > 0) {
-    internalFields = new FieldValue[internalFieldCount];
-  }
 }
 
 ObjectData::~ObjectData() {
-  if (internalFieldCount > 0) {
-    delete[] internalFields;
-  }
-
   objectTemplate.Reset();
   namedPropertyInterceptorData.Reset();
   indexedPropertyInterceptorData.Reset();
@@ -187,491 +168,235 @@ void CHAKRA_CALLBACK ObjectData::FinalizeCallback(void *data) {
   }
 }
 
-ObjectData::FieldValue* ObjectData::GetInternalField(Object* object,
-                                                     int index) {
-  ObjectData* objectData;
-  if (Utils::GetObjectData(object, &objectData) != JsNoError ||
-      !objectData ||
-      index < 0 ||
-      index >= objectData->internalFieldCount) {
+void* ObjectData::GetInternalField(Object* object, int index) {
+  // Template instances keep their internal fields on the external object
+  void* value;
+  if (index < 0 ||
+      JsGetExternalObjectField(object, index, &value) != JsNoError) {
     return nullptr;
   }
 
-  return &objectData->internalFields[index];
+  return value;
 }
 
-// Callbacks used with proxies:
-JsValueRef CHAKRA_CALLBACK Utils::GetCallback(JsValueRef callee,
-                                       bool isConstructCall,
-                                       JsValueRef *arguments,
-                                       unsigned short argumentCount,
-                                       void *callbackState) {
-  JsValueRef result;
+void ObjectData::SetInternalField(Object* object, int index, void* value) {
+  if (index < 0) {
+    return;
+  }
 
-  JsValueRef object = arguments[1];
-  JsValueRef prop = arguments[2];
+  JsSetExternalObjectField(object, index, value);
+}
 
-  // intercept "__getSelf__" call from Object::InternalFieldHelper
-  JsValueType propValueType;
-  if (JsGetValueType(prop, &propValueType) != JsNoError) {
-    return GetUndefined();
+// Interceptors called by the engine for ObjectTemplate instances. They return
+// false to decline, in which case the engine does the ordinary lookup.
+static bool ToInterceptedAttributes(JsValueRef queryResult,
+                                    JsInterceptedPropertyAttributes *attributes) {
+  if (queryResult == JS_INVALID_REFERENCE) {
+    return false;
   }
-  if (propValueType == JsValueType::JsSymbol) {
-    JsPropertyIdRef selfSymbolPropertyIdRef =
-      jsrt::IsolateShim::GetCurrent()->GetSelfSymbolPropertyIdRef();
-    JsPropertyIdRef idRef;
-    if (JsGetPropertyIdFromSymbol(prop, &idRef) == JsNoError &&
-        selfSymbolPropertyIdRef == idRef) {
-      return object;  // return proxy target
-    }
+
+  int queryResultInt;
+  if (jsrt::ValueToIntLikely(queryResult, &queryResultInt) != JsNoError) {
+    queryResultInt = v8::PropertyAttribute::None;
   }
 
-  ObjectData* objectData = nullptr;
-  if (!ExternalData::TryGet(object, &objectData)) {
-    return GetUndefined();
-  }
-
-  bool isPropIntType = false;
-  unsigned int index;
-  if (propValueType == JsValueType::JsString &&
-      TryParseUInt32(prop, &isPropIntType, &index) != JsNoError) {
-    return GetUndefined();
-  }
-
-  if (isPropIntType) {
-    if (objectData->indexedPropertyGetter) {
-      // indexed array properties were set
-      PropertyCallbackInfo<Value> info(
-        *objectData->indexedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->indexedPropertyGetter(index, info);
-      result = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-      if (result != JS_INVALID_REFERENCE) {
-        return result;
-      }
-    }
+  // v8::PropertyAttribute uses the same bits
+  *attributes = static_cast<JsInterceptedPropertyAttributes>(
+    queryResultInt & (v8::PropertyAttribute::ReadOnly |
+                      v8::PropertyAttribute::DontEnum |
+                      v8::PropertyAttribute::DontDelete));
+  return true;
+}
 
-    if (GetIndexedProperty(object, index, &result) != JsNoError) {
-      return GetUndefined();
-    }
-    return result;
-  } else {
-    if (objectData->namedPropertyGetter) {
-      PropertyCallbackInfo<Value> info(
-        *objectData->namedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->namedPropertyGetter(reinterpret_cast<String*>(prop), info);
-      result = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-      if (result != JS_INVALID_REFERENCE) {
-        return result;
-      }
-    }
+static bool ToDeleteResult(JsValueRef deleteResult, bool *result) {
+  if (deleteResult == JS_INVALID_REFERENCE) {
+    return false;
+  }
 
-    // use default JS behavior, on the prototype..
-    if (jsrt::GetProperty(object, prop, &result) != JsNoError) {
-      return GetUndefined();
-    }
-    return result;
+  if (JsBooleanToBool(deleteResult, result) != JsNoError) {
+    *result = true;
   }
+  return true;
 }
 
-JsValueRef CHAKRA_CALLBACK Utils::SetCallback(JsValueRef callee,
-                                       bool isConstructCall,
-                                       JsValueRef *arguments,
-                                       unsigned short argumentCount,
-                                       void *callbackState) {
-  JsValueRef object = arguments[1];
-  JsValueRef prop = arguments[2];
-  JsValueRef value = arguments[3];
-
+bool CHAKRA_CALLBACK Utils::NamedGetterInterceptor(JsValueRef object,
+                                                   JsValueRef name,
+                                                   JsValueRef *value) {
   ObjectData* objectData = nullptr;
-  if (!ExternalData::TryGet(object, &objectData)) {
-    return GetFalse();
-  }
-
-  bool isPropIntType;
-  unsigned int index;
-  if (TryParseUInt32(prop, &isPropIntType, &index) != JsNoError) {
-    return GetFalse();
-  }
-
-  Local<Value> setCallbackResult;
-  if (isPropIntType) {
-    if (objectData->indexedPropertySetter) {
-      PropertyCallbackInfo<Value> info(
-        *objectData->indexedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->indexedPropertySetter(
-        index, reinterpret_cast<Value*>(value), info);
-      if (info.GetReturnValue().Get() != JS_INVALID_REFERENCE) {
-        return GetTrue();  // intercepted
-      }
-    }
-    // use default JS behavior
-    if (jsrt::SetIndexedProperty(object, index, value) != JsNoError) {
-      return GetFalse();
-    }
-  } else {
-    if (objectData->namedPropertySetter) {
-      PropertyCallbackInfo<Value> info(
-        *objectData->namedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->namedPropertySetter(
-        reinterpret_cast<String*>(prop), reinterpret_cast<Value*>(value), info);
-      if (info.GetReturnValue().Get() != JS_INVALID_REFERENCE) {
-        return GetTrue();  // intercepted
-      }
-    }
-    // use default JS behavior
-    if (jsrt::SetProperty(object, prop, value) != JsNoError) {
-      return GetFalse();
-    }
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->namedPropertyGetter == nullptr) {
+    return false;
   }
 
-  return GetTrue();
+  PropertyCallbackInfo<Value> info(
+    *objectData->namedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->namedPropertyGetter(reinterpret_cast<String*>(name), info);
+  *value = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
+  return *value != JS_INVALID_REFERENCE;
 }
 
-JsValueRef CHAKRA_CALLBACK Utils::DeletePropertyCallback(JsValueRef callee,
-                                                  bool isConstructCall,
-                                                  JsValueRef *arguments,
-                                                  unsigned short argumentCount,
-                                                  void *callbackState) {
-  JsValueRef object = arguments[1];
-  JsValueRef prop = arguments[2];
-  JsValueRef result;
-
+bool CHAKRA_CALLBACK Utils::NamedSetterInterceptor(JsValueRef object,
+                                                   JsValueRef name,
+                                                   JsValueRef value) {
   ObjectData* objectData = nullptr;
-  if (!ExternalData::TryGet(object, &objectData)) {
-    return GetFalse();
-  }
-
-  bool isPropIntType;
-  unsigned int index;
-  if (TryParseUInt32(prop, &isPropIntType, &index) != JsNoError) {
-    return GetFalse();
-  }
-
-  Local<Value> deleteCallbackResult;
-  if (isPropIntType) {
-    if (objectData->indexedPropertyDeleter != nullptr) {
-      PropertyCallbackInfo<Boolean> info(
-        *objectData->indexedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->indexedPropertyDeleter(index, info);
-      result = info.GetReturnValue().Get();
-      if (result != JS_INVALID_REFERENCE) {
-        return result;  // intercepted
-      }
-    }
-    // use default JS behavior
-    if (jsrt::DeleteIndexedProperty(object, index) != JsNoError) {
-      return GetFalse();
-    }
-    return GetTrue();  // no result from JsDeleteIndexedProperty
-  } else {
-    if (objectData->namedPropertyDeleter != nullptr) {
-      PropertyCallbackInfo<Boolean> info(
-        *objectData->namedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->namedPropertyDeleter(reinterpret_cast<String*>(prop), info);
-      result = info.GetReturnValue().Get();
-      if (result != JS_INVALID_REFERENCE) {
-        return result;  // intercepted
-      }
-    }
-    // use default JS behavior
-    if (jsrt::DeleteProperty(object, prop, &result) != JsNoError) {
-      return GetFalse();
-    }
-    return result;
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->namedPropertySetter == nullptr) {
+    return false;
   }
-}
 
-JsValueRef Utils::HasPropertyHandler(JsValueRef *arguments,
-                                     unsigned short argumentCount) {
-  JsValueRef object = arguments[1];
-  JsValueRef prop = arguments[2];
+  PropertyCallbackInfo<Value> info(
+    *objectData->namedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->namedPropertySetter(
+    reinterpret_cast<String*>(name), reinterpret_cast<Value*>(value), info);
+  return info.GetReturnValue().Get() != JS_INVALID_REFERENCE;
+}
 
+bool CHAKRA_CALLBACK Utils::NamedQueryInterceptor(
+    JsValueRef object,
+    JsValueRef name,
+    JsInterceptedPropertyAttributes *attributes) {
   ObjectData* objectData = nullptr;
-  if (!ExternalData::TryGet(object, &objectData)) {
-    return GetFalse();
-  }
-
-  bool isPropIntType;
-  unsigned int index;
-  if (TryParseUInt32(prop, &isPropIntType, &index) != JsNoError) {
-    return GetFalse();
-  }
-
-  if (isPropIntType) {
-    if (objectData->indexedPropertyQuery != nullptr) {
-      HandleScope scope(nullptr);
-      PropertyCallbackInfo<Integer> info(
-        *objectData->indexedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->indexedPropertyQuery(index, info);
-      if (info.GetReturnValue().Get() != JS_INVALID_REFERENCE) {
-        return GetTrue();  // intercepted
-      }
-    }
-
-    if (objectData->indexedPropertyGetter) {
-      // indexed array properties were set
-      PropertyCallbackInfo<Value> info(
-        *objectData->indexedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->indexedPropertyGetter(index, info);
-      if (info.GetReturnValue().Get() != JS_INVALID_REFERENCE) {
-        return GetTrue();  // intercepted
-      }
-    }
-
-    // fallback to default JS behavior
-    bool hasProperty;
-    if (jsrt::HasIndexedProperty(object, index, &hasProperty) != JsNoError) {
-      return GetFalse();
-    }
-    return hasProperty ? GetTrue() : GetFalse();
-  } else {  // named property...
-    if (objectData->namedPropertyQuery != nullptr) {
-      HandleScope scope(nullptr);
-      PropertyCallbackInfo<Integer> info(
-        *objectData->namedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->namedPropertyQuery(reinterpret_cast<String*>(prop), info);
-      if (info.GetReturnValue().Get() != JS_INVALID_REFERENCE) {
-        return GetTrue();  // intercepted
-      }
-    }
-
-    if (objectData->namedPropertyGetter) {
-      PropertyCallbackInfo<Value> info(
-        *objectData->namedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->namedPropertyGetter(reinterpret_cast<String*>(prop), info);
-      if (info.GetReturnValue().Get() != JS_INVALID_REFERENCE) {
-        return GetTrue();  // intercepted
-      }
-    }
-
-    // fallback to default JS behavior
-    bool hasProperty;
-    if (jsrt::HasProperty(object, prop, &hasProperty) != JsNoError) {
-      return GetFalse();
-    }
-    return hasProperty ? GetTrue() : GetFalse();
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->namedPropertyQuery == nullptr) {
+    return false;
   }
-}
-
-JsValueRef CHAKRA_CALLBACK Utils::HasCallback(JsValueRef callee,
-                                       bool isConstructCall,
-                                       JsValueRef *arguments,
-                                       unsigned short argumentCount,
-                                       void *callbackState) {
-  return HasPropertyHandler(arguments, argumentCount);
-}
 
-JsValueRef Utils::GetPropertiesHandler(JsValueRef* arguments,
-                                       unsigned int argumentsCount,
-                                       bool getFromPrototype) {
   HandleScope scope(nullptr);
-  JsValueRef object = arguments[1];
-
+  PropertyCallbackInfo<Integer> info(
+    *objectData->namedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->namedPropertyQuery(reinterpret_cast<String*>(name), info);
+  return ToInterceptedAttributes(
+    reinterpret_cast<JsValueRef>(info.GetReturnValue().Get()), attributes);
+}
+
+bool CHAKRA_CALLBACK Utils::NamedDeleterInterceptor(JsValueRef object,
+                                                    JsValueRef name,
+                                                    bool *result) {
   ObjectData* objectData = nullptr;
-  if (!ExternalData::TryGet(object, &objectData)) {
-    return GetUndefined();
-  }
-
-  JsValueRef indexedProperties;
-  if (objectData->indexedPropertyEnumerator != nullptr) {
-    PropertyCallbackInfo<Array> info(
-      *objectData->indexedPropertyInterceptorData,
-      reinterpret_cast<Object*>(object),
-      /*holder*/reinterpret_cast<Object*>(object));
-    objectData->indexedPropertyEnumerator(info);
-    indexedProperties =
-      reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-  } else if (getFromPrototype) {  // get indexed properties from object
-    if (GetEnumerableIndexedProperties(object,
-                                       &indexedProperties) != JsNoError) {
-      return GetUndefined();
-    }
-  } else {
-    if (GetIndexedOwnKeys(object, &indexedProperties) != JsNoError) {
-      return GetUndefined();
-    }
-  }
-
-  JsValueRef namedProperties;
-  if (objectData->namedPropertyEnumerator != nullptr) {
-    PropertyCallbackInfo<Array> info(
-      *objectData->namedPropertyInterceptorData,
-      reinterpret_cast<Object*>(object),
-      /*holder*/reinterpret_cast<Object*>(object));
-    objectData->namedPropertyEnumerator(info);
-    namedProperties = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-  } else if (getFromPrototype) {  // get named properties from object
-    if (GetEnumerableNamedProperties(object, &namedProperties) != JsNoError) {
-      return GetUndefined();
-    }
-  } else {
-    if (GetNamedOwnKeys(object, &namedProperties) != JsNoError) {
-      return GetUndefined();
-    }
-  }
-
-  JsValueRef concatenatedArray;
-  if (ConcatArray(indexedProperties,
-                  namedProperties, &concatenatedArray) != JsNoError) {
-    return GetUndefined();
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->namedPropertyDeleter == nullptr) {
+    return false;
   }
 
-  return concatenatedArray;
+  PropertyCallbackInfo<Boolean> info(
+    *objectData->namedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->namedPropertyDeleter(reinterpret_cast<String*>(name), info);
+  return ToDeleteResult(
+    reinterpret_cast<JsValueRef>(info.GetReturnValue().Get()), result);
 }
 
-JsValueRef Utils::GetPropertiesEnumeratorHandler(JsValueRef* arguments,
-                                                 unsigned int argumentsCount) {
-  JsValueRef properties =
-    GetPropertiesHandler(arguments, argumentsCount, /*getFromPrototype*/true);
-
-  JsValueRef result;
-  if (CreateEnumerationIterator(properties, &result) != JsNoError) {
-    return GetUndefined();
+JsValueRef CHAKRA_CALLBACK Utils::NamedEnumeratorInterceptor(
+    JsValueRef object) {
+  ObjectData* objectData = nullptr;
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->namedPropertyEnumerator == nullptr) {
+    return JS_INVALID_REFERENCE;
   }
 
-  return result;
+  PropertyCallbackInfo<Array> info(
+    *objectData->namedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->namedPropertyEnumerator(info);
+  return reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
 }
 
-JsValueRef CHAKRA_CALLBACK Utils::EnumerateCallback(JsValueRef callee,
-                                             bool isConstructCall,
-                                             JsValueRef *arguments,
-                                             unsigned short argumentCount,
-                                             void *callbackState) {
-  return GetPropertiesEnumeratorHandler(arguments, argumentCount);
-}
+bool CHAKRA_CALLBACK Utils::IndexedGetterInterceptor(JsValueRef object,
+                                                     unsigned int index,
+                                                     JsValueRef *value) {
+  ObjectData* objectData = nullptr;
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->indexedPropertyGetter == nullptr) {
+    return false;
+  }
 
-JsValueRef CHAKRA_CALLBACK Utils::OwnKeysCallback(JsValueRef callee,
-                                           bool isConstructCall,
-                                           JsValueRef *arguments,
-                                           unsigned short argumentCount,
-                                           void *callbackState) {
-  return GetPropertiesHandler(arguments, argumentCount, false);
+  PropertyCallbackInfo<Value> info(
+    *objectData->indexedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->indexedPropertyGetter(index, info);
+  *value = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
+  return *value != JS_INVALID_REFERENCE;
 }
 
-JsValueRef CHAKRA_CALLBACK Utils::GetOwnPropertyDescriptorCallback(
-    JsValueRef callee,
-    bool isConstructCall,
-    JsValueRef *arguments,
-    unsigned short argumentCount,
-    void *callbackState) {
-  JsValueRef object = arguments[1];
-  JsValueRef prop = arguments[2];
-  JsValueRef descriptor;
-
+bool CHAKRA_CALLBACK Utils::IndexedSetterInterceptor(JsValueRef object,
+                                                     unsigned int index,
+                                                     JsValueRef value) {
   ObjectData* objectData = nullptr;
-  if (!ExternalData::TryGet(object, &objectData)) {
-    return GetUndefined();
-  }
-
-  bool isPropIntType;
-  unsigned int index;
-  if (TryParseUInt32(prop, &isPropIntType, &index) != JsNoError) {
-    return GetUndefined();
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->indexedPropertySetter == nullptr) {
+    return false;
   }
 
-  JsValueRef queryResult = JS_INVALID_REFERENCE;
-  JsValueRef value = JS_INVALID_REFERENCE;
-
-  if (isPropIntType) {
-    if (objectData->indexedPropertyQuery != nullptr) {
-      HandleScope scope(nullptr);
-      PropertyCallbackInfo<Integer> info(
-        *objectData->indexedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->indexedPropertyQuery(index, info);
-      queryResult = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-    }
-
-    if (objectData->indexedPropertyGetter != nullptr) {
-      PropertyCallbackInfo<Value> info(
-        *objectData->indexedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->indexedPropertyGetter(index, info);
-      value = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-    }
-
-    // if queryResult valid, ensure value available
-    if (queryResult != JS_INVALID_REFERENCE && value == JS_INVALID_REFERENCE) {
-      if (GetIndexedProperty(object, index, &value) != JsNoError) {
-        return GetUndefined();
-      }
-    }
-  } else {  // named property...
-    // query the property descriptor if there is such, and then get the value
-    // from the proxy in order to go through the interceptor
-    if (objectData->namedPropertyQuery != nullptr) {
-      HandleScope scope(nullptr);
-      PropertyCallbackInfo<Integer> info(
-        *objectData->namedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->namedPropertyQuery(reinterpret_cast<String*>(prop), info);
-      queryResult = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-    }
-
-    if (objectData->namedPropertyGetter != nullptr) {
-      PropertyCallbackInfo<Value> info(
-        *objectData->namedPropertyInterceptorData,
-        reinterpret_cast<Object*>(object),
-        /*holder*/reinterpret_cast<Object*>(object));
-      objectData->namedPropertyGetter(reinterpret_cast<String*>(prop), info);
-      value = reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
-    }
+  PropertyCallbackInfo<Value> info(
+    *objectData->indexedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->indexedPropertySetter(
+    index, reinterpret_cast<Value*>(value), info);
+  return info.GetReturnValue().Get() != JS_INVALID_REFERENCE;
+}
 
-    // if queryResult valid, ensure value available
-    if (queryResult != JS_INVALID_REFERENCE && value == JS_INVALID_REFERENCE) {
-      if (GetProperty(object, prop, &value) != JsNoError) {
-        return GetUndefined();
-      }
-    }
+bool CHAKRA_CALLBACK Utils::IndexedQueryInterceptor(
+    JsValueRef object,
+    unsigned int index,
+    JsInterceptedPropertyAttributes *attributes) {
+  ObjectData* objectData = nullptr;
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->indexedPropertyQuery == nullptr) {
+    return false;
   }
 
-  // if neither is intercepted, fallback to default
-  if (queryResult == JS_INVALID_REFERENCE && value == JS_INVALID_REFERENCE) {
-    if (GetOwnPropertyDescriptor(object, prop, &descriptor) != JsNoError) {
-      return GetUndefined();
-    }
-    return descriptor;
+  HandleScope scope(nullptr);
+  PropertyCallbackInfo<Integer> info(
+    *objectData->indexedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->indexedPropertyQuery(index, info);
+  return ToInterceptedAttributes(
+    reinterpret_cast<JsValueRef>(info.GetReturnValue().Get()), attributes);
+}
+
+bool CHAKRA_CALLBACK Utils::IndexedDeleterInterceptor(JsValueRef object,
+                                                      unsigned int index,
+                                                      bool *result) {
+  ObjectData* objectData = nullptr;
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->indexedPropertyDeleter == nullptr) {
+    return false;
   }
 
-  int queryResultInt = v8::PropertyAttribute::DontEnum;
-  if (queryResult != JS_INVALID_REFERENCE) {
-    if (jsrt::ValueToIntLikely(queryResult, &queryResultInt) != JsNoError) {
-      return GetUndefined();
-    }
-  }
+  PropertyCallbackInfo<Boolean> info(
+    *objectData->indexedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->indexedPropertyDeleter(index, info);
+  return ToDeleteResult(
+    reinterpret_cast<JsValueRef>(info.GetReturnValue().Get()), result);
+}
 
-  v8::PropertyAttribute attributes =
-    static_cast<v8::PropertyAttribute>(queryResultInt);
-  if (CreatePropertyDescriptor(attributes, value,
-                               JS_INVALID_REFERENCE, JS_INVALID_REFERENCE,
-                               &descriptor) != JsNoError) {
-    return GetUndefined();
+JsValueRef CHAKRA_CALLBACK Utils::IndexedEnumeratorInterceptor(
+    JsValueRef object) {
+  ObjectData* objectData = nullptr;
+  if (!ExternalData::TryGet(object, &objectData) ||
+      objectData->indexedPropertyEnumerator == nullptr) {
+    return JS_INVALID_REFERENCE;
   }
 
-  return descriptor;
+  PropertyCallbackInfo<Array> info(
+    *objectData->indexedPropertyInterceptorData,
+    reinterpret_cast<Object*>(object),
+    /*holder*/reinterpret_cast<Object*>(object));
+  objectData->indexedPropertyEnumerator(info);
+  return reinterpret_cast<JsValueRef>(info.GetReturnValue().Get());
 }
 
 Local<ObjectTemplate> ObjectTemplate::New(Isolate* isolate) {
@@ -712,9 +437,25 @@ Local<Object> ObjectTemplate::NewInstance(Handle<Object> prototype) {
 
   ObjectData *objectData = new ObjectData(this, objectTemplateData);
   JsValueRef newInstanceRef = JS_INVALID_REFERENCE;
-  if (JsCreateExternalObject(objectData,
-                             ObjectData::FinalizeCallback,
-                             &newInstanceRef) != JsNoError) {
+  JsErrorCode error;
+
+  // Instances that intercept property access are host objects of their own,
+  // the engine calls the interceptors before its ordinary lookup
+  if (objectTemplateData->AreInterceptorsRequired()) {
+    error = JsCreateExternalObjectWithInterceptors(
+      objectData,
+      ObjectData::FinalizeCallback,
+      objectData->internalFieldCount,
+      objectTemplateData->GetInterceptors(),
+      &newInstanceRef);
+  } else {
+    error = JsCreateExternalObjectWithFields(objectData,
+                                             ObjectData::FinalizeCallback,
+                                             objectData->internalFieldCount,
+                                             &newInstanceRef);
+  }
+
+  if (error != JsNoError) {
     delete objectData;
     return Local<Object>();
   }
@@ -726,62 +467,6 @@ Local<Object> ObjectTemplate::NewInstance(Handle<Object> prototype) {
     }
   }
 
-
-  // In case the object should support index or named properties interceptors,
-  // we will use Proxies We will also support in case there is an overrdien
-  // toString method on the intercepted object (like Buffer), by returning an
-  // object which has the proxy as it prorotype - This is needed due to the fact
-  // that proxy implements comparison to other by reference in case the proxy is
-  // in the left side of the comparison, and does not call a toString method
-  // (like different objects) when compared to string For Node, such comparision
-  // is used for Buffers.
-
-  if (objectTemplateData->AreInterceptorsRequired()) {
-    JsValueRef newInstanceTargetRef = newInstanceRef;
-
-    JsNativeFunction proxyConf[ProxyTraps::TrapCount] = {};
-
-    if (objectTemplateData->indexedPropertyGetter != nullptr ||
-        objectTemplateData->namedPropertyGetter != nullptr)
-      proxyConf[ProxyTraps::GetTrap] = Utils::GetCallback;
-
-    if (objectTemplateData->indexedPropertySetter != nullptr ||
-        objectTemplateData->namedPropertySetter != nullptr)
-      proxyConf[ProxyTraps::SetTrap] = Utils::SetCallback;
-
-    if (objectTemplateData->indexedPropertyDeleter != nullptr ||
-        objectTemplateData->namedPropertyDeleter != nullptr)
-      proxyConf[ProxyTraps::DeletePropertyTrap] = Utils::DeletePropertyCallback;
-
-    if (objectTemplateData->indexedPropertyEnumerator != nullptr ||
-        objectTemplateData->namedPropertyEnumerator != nullptr) {
-      proxyConf[ProxyTraps::EnumerateTrap] = Utils::EnumerateCallback;
-      proxyConf[ProxyTraps::OwnKeysTrap] = Utils::OwnKeysCallback;
-    }
-
-    if (objectTemplateData->indexedPropertyQuery != nullptr ||
-        objectTemplateData->namedPropertyQuery != nullptr ||
-        objectTemplateData->indexedPropertyGetter != nullptr ||
-        objectTemplateData->namedPropertyGetter != nullptr) {
-      proxyConf[ProxyTraps::HasTrap] = Utils::HasCallback;
-    }
-
-    if (objectTemplateData->indexedPropertyQuery != nullptr ||
-        objectTemplateData->namedPropertyQuery != nullptr ||
-        objectTemplateData->indexedPropertyGetter != nullptr ||
-        objectTemplateData->namedPropertyGetter != nullptr) {
-      proxyConf[ProxyTraps::GetOwnPropertyDescriptorTrap] =
-        Utils::GetOwnPropertyDescriptorCallback;
-    }
-
-    JsErrorCode error =
-      jsrt::CreateProxy(newInstanceTargetRef, proxyConf, &newInstanceRef);
-
-    if (error != JsNoError) {
-      return Local<Object>();
-    }
-  }
-
   // clone the object template into the new instance
   if (objectTemplateData->CopyPropertiesTo(newInstanceRef) != JsNoError) {
     return Local<Object>();
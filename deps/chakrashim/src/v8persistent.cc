@@ -22,6 +22,15 @@
 
 namespace v8 {
 
+static void InvokeWeakCallbackInfo(WeakCallbackInfo<void>::Callback callback,
+                                   void *parameters) {
+  WeakCallbackInfo<void>::Callback secondPassCallback;
+  void* fields[kInternalFieldsInWeakCallback] = {};
+  WeakCallbackInfo<void> info(Isolate::GetCurrent(), parameters,
+                              fields, &secondPassCallback);
+  callback(info);
+}
+
 void CHAKRA_CALLBACK Utils::WeakReferenceCallbackWrapperCallback(JsRef ref,
                                                                  void *data) {
   if (jsrt::IsolateShim::GetCurrent()->IsDisposing()) {
@@ -31,12 +40,8 @@ void CHAKRA_CALLBACK Utils::WeakReferenceCallbackWrapperCallback(JsRef ref,
   const chakrashim::WeakReferenceCallbackWrapper *callbackWrapper =
     reinterpret_cast<const chakrashim::WeakReferenceCallbackWrapper*>(data);
   if (callbackWrapper->isWeakCallbackInfo) {
-    WeakCallbackInfo<void>::Callback callback;
-    void* fields[kInternalFieldsInWeakCallback] = {};
-    WeakCallbackInfo<void> info(Isolate::GetCurrent(),
-                                callbackWrapper->parameters,
-                                fields, &callback);
-    callbackWrapper->infoCallback(info);
+    InvokeWeakCallbackInfo(callbackWrapper->infoCallback,
+                           callbackWrapper->parameters);
   } else {
     WeakCallbackData<Value, void> data(Isolate::GetCurrent(),
                                        callbackWrapper->parameters,
@@ -45,6 +50,27 @@ void CHAKRA_CALLBACK Utils::WeakReferenceCallbackWrapperCallback(JsRef ref,
   }
 }
 
+void CHAKRA_CALLBACK Utils::ExternalWeakCallbackInfoCallback(
+    JsValueRef object, void *callback, void *parameters) {
+  if (jsrt::IsolateShim::GetCurrent()->IsDisposing()) {
+    return;
+  }
+
+  InvokeWeakCallbackInfo(
+    reinterpret_cast<WeakCallbackInfo<void>::Callback>(callback), parameters);
+}
+
+void CHAKRA_CALLBACK Utils::ExternalWeakCallbackDataCallback(
+    JsValueRef object, void *callback, void *parameters) {
+  if (jsrt::IsolateShim::GetCurrent()->IsDisposing()) {
+    return;
+  }
+
+  WeakCallbackData<Value, void> data(Isolate::GetCurrent(), parameters,
+                                     static_cast<Value*>(object));
+  reinterpret_cast<WeakCallbackData<Value, void>::Callback>(callback)(data);
+}
+
 namespace chakrashim {
 
 static void CHAKRA_CALLBACK DummyObjectBeforeCollectCallback(JsRef ref,
@@ -52,65 +78,87 @@ static void CHAKRA_CALLBACK DummyObjectBeforeCollectCallback(JsRef ref,
   // Do nothing, only used to revive an object temporarily
 }
 
+static void CHAKRA_CALLBACK DummyExternalWeakCallback(JsValueRef object,
+                                                      void *callback,
+                                                      void *parameters) {
+  // Do nothing, only used to revive an object temporarily
+}
+
 void ClearObjectWeakReferenceCallback(JsValueRef object, bool revive) {
   if (jsrt::IsolateShim::GetCurrent()->IsDisposing()) {
     return;
   }
 
+  if (JsSetExternalObjectWeakCallback(
+        object, revive ? DummyExternalWeakCallback : nullptr,
+        nullptr, nullptr) == JsNoError) {
+    return;
+  }
+
   JsSetObjectBeforeCollectCallback(
     object, nullptr, revive ? DummyObjectBeforeCollectCallback : nullptr);
 }
 
 template <class Callback, class Func>
-void SetObjectWeakReferenceCallbackCommon(
+bool SetObjectWeakReferenceCallbackCommon(
     JsValueRef object,
     Callback callback,
+    JsExternalObjectWeakCallback externalCallback,
+    void* parameters,
     WeakReferenceCallbackWrapper** weakWrapper,
     const Func& initWrapper) {
   if (callback == nullptr || object == JS_INVALID_REFERENCE) {
-    return;
+    return false;
   }
 
-  // This will be called once per instance
-  // We do not share the _weakWrapper.
-  // The memory is allocated per request and released similarly.
-  // previous shared_ptr interface was actually doing the same.
-  // however in case the instance was shared(which is not in motion)
-  // it was keeping the callback until the shared counter reaches to unique state.
-  assert(!*weakWrapper && "This should be nullptr.");
-  *weakWrapper = new WeakReferenceCallbackWrapper();
+  // External objects, which is what node makes weak (ObjectWrap and
+  // BaseObject), hold the callback themselves, so nothing is allocated.
+  if (*weakWrapper == nullptr &&
+      JsSetExternalObjectWeakCallback(
+        object, externalCallback, reinterpret_cast<void*>(callback),
+        parameters) == JsNoError) {
+    return true;
+  }
+
+  // Other objects go through the runtime's callback map with a wrapper
+  // allocated per handle, which is reused if the handle is made weak again.
+  if (*weakWrapper == nullptr) {
+    *weakWrapper = new WeakReferenceCallbackWrapper();
+  }
 
   WeakReferenceCallbackWrapper *callbackWrapper = (*weakWrapper);
+  callbackWrapper->parameters = parameters;
   initWrapper(callbackWrapper);
 
   JsSetObjectBeforeCollectCallback(
     object, callbackWrapper,
     v8::Utils::WeakReferenceCallbackWrapperCallback);
+  return true;
 }
 
-void SetObjectWeakReferenceCallback(
+bool SetObjectWeakReferenceCallback(
     JsValueRef object,
     WeakCallbackInfo<void>::Callback callback,
     void* parameters,
     WeakReferenceCallbackWrapper** weakWrapper) {
-  SetObjectWeakReferenceCallbackCommon(
-    object, callback, weakWrapper,
+  return SetObjectWeakReferenceCallbackCommon(
+    object, callback, v8::Utils::ExternalWeakCallbackInfoCallback,
+    parameters, weakWrapper,
     [=](WeakReferenceCallbackWrapper *callbackWrapper) {
-      callbackWrapper->parameters = parameters;
       callbackWrapper->infoCallback = callback;
       callbackWrapper->isWeakCallbackInfo = true;
   });
 }
 
-void SetObjectWeakReferenceCallback(
+bool SetObjectWeakReferenceCallback(
     JsValueRef object,
     WeakCallbackData<Value, void>::Callback callback,
     void* parameters,
     WeakReferenceCallbackWrapper** weakWrapper) {
-  SetObjectWeakReferenceCallbackCommon(
-    object, callback, weakWrapper,
+  return SetObjectWeakReferenceCallbackCommon(
+    object, callback, v8::Utils::ExternalWeakCallbackDataCallback,
+    parameters, weakWrapper,
     [=](WeakReferenceCallbackWrapper *callbackWrapper) {
-      callbackWrapper->parameters = parameters;
       callbackWrapper->dataCallback = callback;
       callbackWrapper->isWeakCallbackInfo = false;
   });
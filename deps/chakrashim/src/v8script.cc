@@ -24,6 +24,7 @@
 namespace v8 {
 
 using CachedPropertyIdRef = jsrt::CachedPropertyIdRef;
+using jsrt::SerializedScript;
 
 THREAD_LOCAL JsSourceContext currentContext;
 extern bool g_useStrict;
@@ -59,16 +60,118 @@ static JsErrorCode CreateScriptObject(JsValueRef sourceRef,
                            scriptFunction);
 }
 
-// Compiled script object, bound to the context that was active when this
-// function was called. When run it will always use this context.
-MaybeLocal<Script> Script::Compile(Local<Context> context,
-                                   Handle<String> source,
-                                   ScriptOrigin* origin) {
+// Code cache data handed out by ScriptCompiler: this header followed by the
+// engine's serialized byte code. The engine trusts the byte code it is given,
+// so a cache is only consumed if all of the header matches.
+struct CodeCacheHeader {
+  uint32_t magic;
+  uint32_t versionTag;
+  uint32_t sourceLength;
+  uint32_t payloadLength;
+  uint32_t payloadHash;
+};
+
+static const uint32_t kCodeCacheMagic = 0x43484343;  // 'CHCC'
+static const uint32_t kCodeCacheFormatVersion = 1;
+
+static uint32_t HashCodeCachePayload(const uint8_t* data, size_t length) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static JsErrorCode ProduceCodeCache(JsValueRef scriptSource,
+                                    ScriptCompiler::CachedData** cachedData) {
+  JsValueRef serialized;
+  JsErrorCode error = JsSerialize(scriptSource, &serialized,
+                                  JsParseScriptAttributeNone);
+  if (error != JsNoError) {
+    return error;
+  }
+
+  BYTE* payload;
+  unsigned int payloadLength;
+  error = JsGetArrayBufferStorage(serialized, &payload, &payloadLength);
+  if (error != JsNoError) {
+    return error;
+  }
+
+  int sourceLength;
+  error = JsGetStringLength(scriptSource, &sourceLength);
+  if (error != JsNoError) {
+    return error;
+  }
+
+  CodeCacheHeader header;
+  header.magic = kCodeCacheMagic;
+  header.versionTag = ScriptCompiler::CachedDataVersionTag();
+  header.sourceLength = sourceLength;
+  header.payloadLength = payloadLength;
+  header.payloadHash = HashCodeCachePayload(payload, payloadLength);
+
+  uint8_t* data = new uint8_t[sizeof(header) + payloadLength];
+  memcpy(data, &header, sizeof(header));
+  memcpy(data + sizeof(header), payload, payloadLength);
+
+  delete *cachedData;
+  *cachedData = new ScriptCompiler::CachedData(
+    data, static_cast<int>(sizeof(header) + payloadLength),
+    ScriptCompiler::CachedData::BufferOwned);
+  return JsNoError;
+}
+
+// Parses the script from the code cache. Returns JS_INVALID_REFERENCE and
+// marks the cache rejected if it doesn't belong to this engine and source.
+static JsValueRef ConsumeCodeCache(JsValueRef scriptSource,
+                                   JsValueRef filenameRef,
+                                   ScriptCompiler::CachedData* cachedData) {
+  cachedData->rejected = true;
+
+  CodeCacheHeader header;
+  if (cachedData->data == nullptr || cachedData->length < 0 ||
+      static_cast<size_t>(cachedData->length) < sizeof(header)) {
+    return JS_INVALID_REFERENCE;
+  }
+  memcpy(&header, cachedData->data, sizeof(header));
+
+  const uint8_t* payload = cachedData->data + sizeof(header);
+  int sourceLength;
+  if (header.magic != kCodeCacheMagic ||
+      header.versionTag != ScriptCompiler::CachedDataVersionTag() ||
+      header.payloadLength != cachedData->length - sizeof(header) ||
+      JsGetStringLength(scriptSource, &sourceLength) != JsNoError ||
+      header.sourceLength != static_cast<uint32_t>(sourceLength) ||
+      header.payloadHash != HashCodeCachePayload(payload,
+                                                 header.payloadLength)) {
+    return JS_INVALID_REFERENCE;
+  }
+
+  SerializedScript* serializedScript =
+    new SerializedScript(payload, header.payloadLength);
+  JsValueRef scriptFunction = serializedScript->Parse(scriptSource,
+                                                      filenameRef);
+  serializedScript->Release();
+  if (scriptFunction == JS_INVALID_REFERENCE) {
+    return JS_INVALID_REFERENCE;
+  }
+
+  cachedData->rejected = false;
+  return scriptFunction;
+}
+
+static JsErrorCode CompileScript(Handle<String> source,
+                                 ScriptOrigin* origin,
+                                 ScriptCompiler::CompileOptions options,
+                                 ScriptCompiler::CachedData** cachedData,
+                                 JsValueRef* scriptObject) {
   JsErrorCode error = JsNoError;
   JsValueRef filenameRef;
   const char* filename = "";
 
-  if (origin != nullptr) {
+  if (origin != nullptr && !origin->ResourceName().IsEmpty()) {
     filenameRef = *origin->ResourceName();
   } else {
     error = JsCreateString(filename,
@@ -78,26 +181,51 @@ MaybeLocal<Script> Script::Compile(Local<Context> context,
 
   if (error == JsNoError) {
     JsValueRef sourceRef;
+    JsValueRef scriptSource;
     jsrt::StringUtf8 script;
     error = jsrt::ToString(*source, &sourceRef, &script);
     if (error == JsNoError) {
-      JsValueRef scriptFunction;
-      error = jsrt::ParseScript(&script,
-                                currentContext++,
-                                filenameRef,
-                                g_useStrict,
-                                &scriptFunction);
+      error = jsrt::CreateScriptSource(&script, g_useStrict, &scriptSource);
+    }
+    if (error == JsNoError) {
+      JsValueRef scriptFunction = JS_INVALID_REFERENCE;
+      if (options == ScriptCompiler::kConsumeCodeCache &&
+          *cachedData != nullptr) {
+        scriptFunction = ConsumeCodeCache(scriptSource, filenameRef,
+                                          *cachedData);
+      }
+      if (scriptFunction == JS_INVALID_REFERENCE) {
+        error = JsParse(scriptSource,
+                        currentContext++,
+                        filenameRef,
+                        JsParseScriptAttributeNone,
+                        &scriptFunction);
+      }
+      if (error == JsNoError &&
+          options == ScriptCompiler::kProduceCodeCache) {
+        // Failing to produce the cache doesn't fail the compile
+        ProduceCodeCache(scriptSource, cachedData);
+      }
       if (error == JsNoError) {
-        JsValueRef scriptObject;
-        error = CreateScriptObject(sourceRef, filenameRef, scriptFunction,
-                                   &scriptObject);
-        if (error == JsNoError) {
-          return Local<Script>::New(scriptObject);
-        }
+        error = CreateScriptObject(scriptSource, filenameRef, scriptFunction,
+                                   scriptObject);
       }
     }
   }
-  return Local<Script>();
+  return error;
+}
+
+// Compiled script object, bound to the context that was active when this
+// function was called. When run it will always use this context.
+MaybeLocal<Script> Script::Compile(Local<Context> context,
+                                   Handle<String> source,
+                                   ScriptOrigin* origin) {
+  JsValueRef scriptObject;
+  if (CompileScript(source, origin, ScriptCompiler::kNoCompileOptions,
+                    nullptr, &scriptObject) != JsNoError) {
+    return Local<Script>();
+  }
+  return Local<Script>::New(scriptObject);
 }
 
 Local<Script> Script::Compile(Handle<String> source,
@@ -127,32 +255,60 @@ Local<Value> Script::Run() {
   return FromMaybe(Run(Local<Context>()));
 }
 
+// The external data of an unbound script is its SerializedScript, created the
+// first time it is bound to another context
 static void CHAKRA_CALLBACK UnboundScriptFinalizeCallback(void * data) {
-  JsValueRef * unboundScriptData = static_cast<JsValueRef *>(data);
-  delete unboundScriptData;
+  if (data != nullptr) {
+    static_cast<SerializedScript *>(data)->Release();
+  }
 }
+
 Local<UnboundScript> Script::GetUnboundScript() {
   // Chakra doesn't support unbound script, the script object contains all the
   // information to recompile
-
-  JsValueRef * unboundScriptData = new JsValueRef;
   JsValueRef unboundScriptRef;
-  if (JsCreateExternalObject(unboundScriptData,
+  if (JsCreateExternalObject(nullptr,
                              UnboundScriptFinalizeCallback,
                              &unboundScriptRef) != JsNoError) {
-    delete unboundScriptData;
     return Local<UnboundScript>();
   }
 
   if (jsrt::SetProperty(unboundScriptRef, CachedPropertyIdRef::script,
                         this) != JsNoError) {
-    delete unboundScriptData;
     return Local<UnboundScript>();
   }
-  *unboundScriptData = unboundScriptRef;
   return Local<UnboundScript>::New(unboundScriptRef);
 }
 
+// Serializes the script the first time it is needed, so that binding it to
+// further contexts only deserializes the byte code instead of parsing again
+static SerializedScript* GetSerializedScript(JsValueRef unboundScript,
+                                             JsValueRef scriptSource) {
+  void* data;
+  if (JsGetExternalData(unboundScript, &data) != JsNoError) {
+    return nullptr;
+  }
+  if (data != nullptr) {
+    return static_cast<SerializedScript*>(data);
+  }
+
+  JsValueRef serialized;
+  BYTE* bytes;
+  unsigned int length;
+  if (JsSerialize(scriptSource, &serialized,
+                  JsParseScriptAttributeNone) != JsNoError ||
+      JsGetArrayBufferStorage(serialized, &bytes, &length) != JsNoError) {
+    return nullptr;
+  }
+
+  SerializedScript* serializedScript = new SerializedScript(bytes, length);
+  if (JsSetExternalData(unboundScript, serializedScript) != JsNoError) {
+    serializedScript->Release();
+    return nullptr;
+  }
+  return serializedScript;
+}
+
 Local<Script> UnboundScript::BindToCurrentContext() {
   jsrt::ContextShim * contextShim =
     jsrt::IsolateShim::GetContextShimOfObject(this);
@@ -166,10 +322,11 @@ Local<Script> UnboundScript::BindToCurrentContext() {
     return Local<Script>::New(scriptRef);
   }
 
-  // Create a script object in another context
-  jsrt::StringUtf8 source;
-  jsrt::StringUtf8 filename;
-  JsValueRef originalFilenameRef;
+  // Create a script object in another context. The source and filename are
+  // strings, which the engine copies into this context when they are used.
+  JsValueRef sourceRef;
+  JsValueRef filenameRef;
+  SerializedScript* serializedScript;
   {
     jsrt::ContextShim::Scope scope(contextShim);
     JsValueRef scriptRef;
@@ -178,39 +335,25 @@ Local<Script> UnboundScript::BindToCurrentContext() {
       return Local<Script>();
     }
 
-    JsValueRef originalSourceRef;
     if (jsrt::GetProperty(scriptRef, CachedPropertyIdRef::source,
-                          &originalSourceRef) != JsNoError) {
+                          &sourceRef) != JsNoError) {
       return Local<Script>();
     }
     if (jsrt::GetProperty(scriptRef, CachedPropertyIdRef::filename,
-                          &originalFilenameRef) != JsNoError) {
-      return Local<Script>();
-    }
-    if (source.From(originalSourceRef) != JsNoError) {
-      return Local<Script>();
-    }
-    if (filename.From(originalFilenameRef) != JsNoError) {
+                          &filenameRef) != JsNoError) {
       return Local<Script>();
     }
-  }
 
-  JsValueRef scriptFunction;
-  if (jsrt::ParseScript(&source, currentContext++, originalFilenameRef,
-                        g_useStrict, &scriptFunction) != JsNoError) {
-    return Local<Script>();
+    serializedScript = GetSerializedScript(this, sourceRef);
   }
 
-  JsValueRef sourceRef;
-
-  if (JsCreateString(*source, source.length(),
-                     &sourceRef) != JsNoError) {
-    return Local<Script>();
+  JsValueRef scriptFunction = JS_INVALID_REFERENCE;
+  if (serializedScript != nullptr) {
+    scriptFunction = serializedScript->Parse(sourceRef, filenameRef);
   }
-
-  JsValueRef filenameRef;
-  if (JsCreateString(*filename, filename.length(),
-                     &filenameRef) != JsNoError) {
+  if (scriptFunction == JS_INVALID_REFERENCE &&
+      JsParse(sourceRef, currentContext++, filenameRef,
+              JsParseScriptAttributeNone, &scriptFunction) != JsNoError) {
     return Local<Script>();
   }
 
@@ -249,7 +392,12 @@ MaybeLocal<Script> ScriptCompiler::Compile(Local<Context> context,
                                            Source* source,
                                            CompileOptions options) {
   ScriptOrigin origin(source->resource_name);
-  return Script::Compile(context, source->source_string, &origin);
+  JsValueRef scriptObject;
+  if (CompileScript(source->source_string, &origin, options,
+                    &source->cached_data, &scriptObject) != JsNoError) {
+    return Local<Script>();
+  }
+  return Local<Script>::New(scriptObject);
 }
 
 Local<Script> ScriptCompiler::Compile(Isolate* isolate,
@@ -259,6 +407,8 @@ Local<Script> ScriptCompiler::Compile(Isolate* isolate,
 }
 
 uint32_t ScriptCompiler::CachedDataVersionTag() {
-  return 0;
+  unsigned int version = 0;
+  CHAKRA_VERIFY(JsGetSerializedScriptVersion(&version) == JsNoError);
+  return version * 31 + kCodeCacheFormatVersion;
 }
 }  // namespace v8
@@ -23,8 +23,8 @@
 namespace v8 {
 
 SharedArrayBuffer* SharedArrayBuffer::Cast(Value* obj) {
-  CHAKRA_UNIMPLEMENTED();
-  return nullptr;
+  CHAKRA_ASSERT(obj->IsSharedArrayBuffer());
+  return static_cast<SharedArrayBuffer*>(obj);
 }
 
 }  // namespace v8
@@ -34,8 +34,10 @@ Local<StackTrace> StackTrace::CurrentStackTrace(Isolate* isolate,
   ContextShim* contextShim = iso->GetCurrentContextShim();
 
   JsValueRef getStackTrace = contextShim->GetgetStackTraceFunction();
+  JsValueRef frameLimit;
   JsValueRef stackTrace;
-  if (jsrt::CallFunction(getStackTrace, &stackTrace) != JsNoError) {
+  if (JsIntToNumber(frame_limit, &frameLimit) != JsNoError ||
+      jsrt::CallFunction(getStackTrace, frameLimit, &stackTrace) != JsNoError) {
     return Local<StackTrace>();
   }
 
@@ -78,13 +78,13 @@ int String::Length() const {
 }
 
 int String::Utf8Length() const {
-  jsrt::StringUtf8 str;
-  if (str.From((JsValueRef)this) != JsNoError) {
+  size_t length = 0;
+  if (JsGetStringUtf8Length((JsValueRef)this, &length) != JsNoError) {
     // error
     return 0;
   }
 
-  return str.length();
+  return static_cast<int>(length);
 }
 
 int String::Write(uint16_t *buffer, int start, int length, int options) const {
@@ -92,7 +92,7 @@ int String::Write(uint16_t *buffer, int start, int length, int options) const {
   if (JsCopyStringUtf16((JsValueRef)this, start, length,
                          buffer, &count) == JsNoError) {
     if (!(options & String::NO_NULL_TERMINATION) &&
-        (length == -1 || count < length)) {
+        (length == -1 || count < static_cast<size_t>(length))) {
       buffer[count] = '\0';
     }
   }
@@ -101,44 +101,40 @@ int String::Write(uint16_t *buffer, int start, int length, int options) const {
 
 int String::WriteOneByte(
     uint8_t* buffer, int start, int length, int options) const {
-  // The JSRT API only supports utf8 and utf16 encoded strings. In order to get
-  // 8 bit bytes from the string (i.e. Latin1) we can get the utf16 string and
-  // cast each character down to a uint8_t. This will only work for characters
-  // between U+0000 and U+00FF in the source string.
-  uint16_t* tmpBuffer = new uint16_t[length];
+  // Characters are narrowed to their low byte, which is only lossless for
+  // U+0000 to U+00FF (i.e. Latin1).
   size_t count = 0;
-  if (JsCopyStringUtf16((JsValueRef)this, start, length,
-                        tmpBuffer, &count) == JsNoError) {
-    for (size_t i = 0; i < count; i++) {
-      buffer[i] = (uint8_t)tmpBuffer[i];
-    }
-    
-    if (!(options & String::NO_NULL_TERMINATION)) {
+  if (JsCopyStringOneByte((JsValueRef)this, start, length,
+                          reinterpret_cast<char*>(buffer),
+                          &count) == JsNoError) {
+    if (!(options & String::NO_NULL_TERMINATION) &&
+        (length == -1 || count < static_cast<size_t>(length))) {
       buffer[count] = 0;
     }
   }
-  delete[] tmpBuffer;
   return count;
 }
 
 int String::WriteUtf8(
     char *buffer, int length, int *nchars_ref, int options) const {
-  if (length < 0) {
-    // in case length was not provided we want to copy the whole string
-    length = String::kMaxLength;
-  }
+  // A negative length means the buffer is large enough for the whole string
+  size_t capacity = length < 0 ? SIZE_MAX : static_cast<size_t>(length);
+  JsCopyStringUtf8Flags flags = (options & String::REPLACE_INVALID_UTF8) ?
+    JsCopyStringUtf8Flags_ReplaceInvalid : JsCopyStringUtf8Flags_None;
 
   size_t count = 0;
-  if (JsCopyString((JsValueRef)this,
-                   buffer, length, &count) == JsNoError) {
-    if (count < (unsigned)length && !(options & String::NO_NULL_TERMINATION)) {
-      // Utf8 version count includes null terminator
+  size_t chars = 0;
+  if (JsCopyStringUtf8Partial((JsValueRef)this, buffer, capacity, flags,
+                              &count, &chars) == JsNoError) {
+    // Like v8, only terminate if the whole string was written and fits
+    if (!(options & String::NO_NULL_TERMINATION) &&
+        chars == static_cast<size_t>(Length()) && count < capacity) {
       buffer[count++] = 0;
     }
   }
 
   if (nchars_ref) {
-    *nchars_ref = count;
+    *nchars_ref = static_cast<int>(chars);
   }
 
   return static_cast<int>(count);
@@ -166,6 +162,20 @@ MaybeLocal<String> Utils::NewString(const char *data, int length) {
   return Local<String>::New(strRef);
 }
 
+// Replaces a string with the engine's interned string for the same property ID.
+// The interned string carries its property ID, so using it as a key later skips
+// the lookup entirely. The engine holds it weakly; callers keep it alive.
+static JsValueRef InternalizeString(JsValueRef strRef) {
+  JsPropertyIdRef idRef;
+  JsValueRef internalizedRef;
+  if (JsGetPropertyIdFromString(strRef, &idRef) != JsNoError ||
+      JsGetPropertyIdString(idRef, &internalizedRef) != JsNoError) {
+    return strRef;
+  }
+
+  return internalizedRef;
+}
+
 MaybeLocal<String> String::NewFromUtf8(Isolate* isolate,
                                        const char* data,
                                        v8::NewStringType type,
@@ -179,6 +189,10 @@ MaybeLocal<String> String::NewFromUtf8(Isolate* isolate,
     return Local<String>();
   }
 
+  if (type == v8::NewStringType::kInternalized) {
+    strRef = InternalizeString(strRef);
+  }
+
   return Local<String>::New(strRef);
 }
 
@@ -198,31 +212,18 @@ MaybeLocal<String> String::NewFromOneByte(Isolate* isolate,
     length = strlen((const char*)data);
   }
 
-  // convert latin-1 to utf8 for JsCreateString
-  uint8_t* utf8 = new uint8_t[length*2];
-  uint8_t* p = utf8;
-
-  for (size_t i = 0; i < length; i++) {
-    uint8_t ch = data[i];
-    if (ch < 0x80) {
-      *p++ = ch;
-    } else {
-      *p++ = 0xc0 | ch >> 6;
-      *p++ = 0x80 | (ch & 0x3f);
-    }
-  }
-
-  size_t utf8length = p - utf8;
-
   JsValueRef strRef;
-  JsErrorCode ret = JsCreateString((const char*)utf8, utf8length, &strRef);
-
-  delete[] utf8;
+  JsErrorCode ret = JsCreateStringLatin1(reinterpret_cast<const char*>(data),
+                                         length, &strRef);
 
   if (ret != JsNoError) {
     return Local<String>();
   }
 
+  if (type == v8::NewStringType::kInternalized) {
+    strRef = InternalizeString(strRef);
+  }
+
   return Local<String>::New(strRef);
 }
 
@@ -256,6 +257,10 @@ MaybeLocal<String> String::NewFromTwoByte(Isolate* isolate,
     return Local<String>();
   }
 
+  if (type == v8::NewStringType::kInternalized) {
+    strRef = InternalizeString(strRef);
+  }
+
   return Local<String>::New(strRef);
 }
 
@@ -283,14 +288,26 @@ Local<String> String::Concat(Handle<String> left, Handle<String> right) {
   return Local<String>::New(result);
 }
 
+template <class Resource>
+static void CHAKRA_CALLBACK DisposeExternalStringResource(void *data) {
+  static_cast<Resource*>(data)->Dispose();
+}
+
 MaybeLocal<String> String::NewExternalTwoByte(
     Isolate* isolate, ExternalStringResource* resource) {
   if (resource->data() != nullptr) {
-    auto newStr = NewFromTwoByte(nullptr, resource->data(),
-                                 v8::NewStringType::kNormal,
-                                 static_cast<int>(resource->length()));
-    resource->Dispose();
-    return newStr;
+    // The string references the resource memory directly, the resource is
+    // disposed once the string is collected.
+    JsValueRef strRef;
+    if (JsCreateExternalStringUtf16(
+          resource->data(), resource->length(),
+          DisposeExternalStringResource<ExternalStringResource>,
+          resource, &strRef) != JsNoError) {
+      resource->Dispose();
+      return Local<String>();
+    }
+
+    return Local<String>::New(strRef);
   }
 
   // otherwise the resource is empty just delete it and return an empty string
@@ -306,14 +323,19 @@ Local<String> String::NewExternal(Isolate* isolate,
 MaybeLocal<String> String::NewExternalOneByte(
     Isolate* isolate, ExternalOneByteStringResource* resource) {
   if (resource->data() != nullptr) {
-    auto newStr = NewFromOneByte(
-      nullptr,
-      reinterpret_cast<const uint8_t*>(resource->data()),
-      v8::NewStringType::kNormal,
-      static_cast<int>(resource->length()));
-
-    resource->Dispose();
-    return newStr;
+    // Latin-1 content is referenced as is and only widened by the engine if
+    // it ever needs the UTF-16 form. The resource is disposed once the string
+    // is collected.
+    JsValueRef strRef;
+    if (JsCreateExternalStringLatin1(
+          resource->data(), resource->length(),
+          DisposeExternalStringResource<ExternalOneByteStringResource>,
+          resource, &strRef) != JsNoError) {
+      resource->Dispose();
+      return Local<String>();
+    }
+
+    return Local<String>::New(strRef);
   }
 
   // otherwise the resource is empty just delete it and return an empty string
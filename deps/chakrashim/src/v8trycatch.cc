@@ -24,21 +24,24 @@
 namespace v8 {
 
 TryCatch::TryCatch(Isolate* isolate)
-    : error(JS_INVALID_REFERENCE),
+    : isolate_(isolate != nullptr ?
+               isolate : jsrt::IsolateShim::GetCurrentAsIsolate()),
+      error(JS_INVALID_REFERENCE),
       rethrow(false),
+      noException(false),
       user(true),
       verbose(false) {
-  jsrt::IsolateShim * isolateShim = jsrt::IsolateShim::GetCurrent();
+  jsrt::IsolateShim * isolateShim = jsrt::IsolateShim::FromIsolate(isolate_);
   prev = isolateShim->tryCatchStackTop;
   isolateShim->tryCatchStackTop = this;
 }
 
 TryCatch::~TryCatch() {
-  if (!rethrow) {
+  if (!rethrow && !noException) {
     GetAndClearException();
   }
 
-  jsrt::IsolateShim::GetCurrent()->tryCatchStackTop = prev;
+  jsrt::IsolateShim::FromIsolate(isolate_)->tryCatchStackTop = prev;
 }
 
 bool TryCatch::HasCaught() const {
@@ -37,6 +37,7 @@ bool g_exposeGC = false;
 bool g_useStrict = false;
 bool g_disableIdleGc = false;
 bool g_trace_debug_json = false;
+bool g_trace_gc = false;
 
 HeapStatistics::HeapStatistics()
     : total_heap_size_(0),
@@ -131,6 +132,11 @@ void V8::SetFlagsFromCommandLine(int *argc, char **argv, bool remove_flags) {
       if (remove_flags) {
         argv[i] = nullptr;
       }
+    } else if (equals("--trace-gc", arg) || equals("--trace_gc", arg)) {
+      g_trace_gc = true;
+      if (remove_flags) {
+        argv[i] = nullptr;
+      }
     } else if (equals("--trace-debug-json", arg) ||
       equals("--trace_debug_json", arg)) {
       g_trace_debug_json = true;
@@ -152,6 +158,9 @@ void V8::SetFlagsFromCommandLine(int *argc, char **argv, bool remove_flags) {
           " --expose_gc (expose gc extension)\n"
           "     type: bool  default: false\n"
           " --off_idlegc (turn off idle GC)\n"
+          " --trace_gc (print one trace line following each garbage "
+          "collection)\n"
+          "     type: bool  default: false\n"
           " --harmony_simd (enable \"harmony simd\" (in progress))\n"
           " --harmony (Other flags are ignored in node running with "
           "chakracore)\n"
@@ -211,7 +220,7 @@ void V8::ToLocalEmpty() {
 
 namespace platform {
   v8::Platform* CreateDefaultPlatform(int thread_pool_size) {
-    jsrt::DefaultPlatform* platform = new jsrt::DefaultPlatform();
+    jsrt::DefaultPlatform* platform = new jsrt::DefaultPlatform(thread_pool_size);
     return platform;
   }
 
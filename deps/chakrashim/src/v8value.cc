@@ -196,6 +196,7 @@ IS_TYPE_FUNCTION(IsStringObject, isStringObject)
 IS_TYPE_FUNCTION(IsNumberObject, isNumberObject)
 IS_TYPE_FUNCTION(IsMapIterator, isMapIterator)
 IS_TYPE_FUNCTION(IsSetIterator, isSetIterator)
+IS_TYPE_FUNCTION(IsSharedArrayBuffer, isSharedArrayBuffer)
 IS_TYPE_FUNCTION(IsArgumentsObject, isArgumentsObject)
 IS_TYPE_FUNCTION(IsGeneratorObject, isGeneratorObject)
 IS_TYPE_FUNCTION(IsWeakMap, isWeakMap)
@@ -22,65 +22,95 @@
 
 namespace v8 {
 
+// Called by the engine while it is out of script, see v8valueserializer.cc
+JsValueRef CHAKRA_CALLBACK ValueDeserializer::ReadHostObjectCallback(
+    void* callbackState) {
+  ValueDeserializer::Delegate* delegate =
+    static_cast<ValueDeserializer::Delegate*>(callbackState);
+  Isolate* isolate = Isolate::GetCurrent();
+  TryCatch tryCatch(isolate);
+  Local<Object> result;
+  if (!delegate->ReadHostObject(isolate).ToLocal(&result)) {
+    tryCatch.ReThrow();
+    return JS_INVALID_REFERENCE;
+  }
+  return *result;
+}
+
+// Without a delegate the engine reports the data as invalid, like V8 does
 MaybeLocal<Object> ValueDeserializer::Delegate::ReadHostObject(
     Isolate* isolate) {
-  CHAKRA_UNIMPLEMENTED();
   return Local<Object>();
 }
 
 ValueDeserializer::ValueDeserializer(Isolate* isolate, const uint8_t* data,
-                                     size_t size, Delegate* delegate) {
-  CHAKRA_UNIMPLEMENTED();
+                                     size_t size, Delegate* delegate)
+    : handle_(nullptr) {
+  JsErrorCode error = JsCreateValueDeserializer(
+    data, size, delegate != nullptr ? ReadHostObjectCallback : nullptr,
+    delegate, &handle_);
+  CHAKRA_VERIFY_NOERROR(error);
 }
 
 ValueDeserializer::~ValueDeserializer() {
-  // Intentionally left empty to suppress warning C4722.
+  if (handle_ != nullptr) {
+    JsDisposeValueDeserializer(handle_);
+  }
 }
 
 Maybe<bool> ValueDeserializer::ReadHeader(Local<Context> context) {
-  CHAKRA_UNIMPLEMENTED();
-  return Nothing<bool>();
+  if (JsValueDeserializerReadHeader(handle_) != JsNoError) {
+    return Nothing<bool>();
+  }
+
+  return Just(true);
 }
 
 MaybeLocal<Value> ValueDeserializer::ReadValue(Local<Context> context) {
-  CHAKRA_UNIMPLEMENTED();
-  return Local<Value>();
-}
+  JsValueRef value;
+  if (JsValueDeserializerReadValue(handle_, &value) != JsNoError) {
+    return Local<Value>();
+  }
 
+  return Local<Value>::New(value);
+}
 
 void ValueDeserializer::TransferArrayBuffer(uint32_t transfer_id,
                                             Local<ArrayBuffer> array_buffer) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueDeserializerTransferArrayBuffer(handle_, transfer_id, *array_buffer);
 }
 
 void ValueDeserializer::TransferSharedArrayBuffer(
     uint32_t id, Local<SharedArrayBuffer> shared_array_buffer) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueDeserializerTransferArrayBuffer(handle_, id, *shared_array_buffer);
 }
 
 uint32_t ValueDeserializer::GetWireFormatVersion() const {
-  CHAKRA_UNIMPLEMENTED();
-  return 0;
+  unsigned int version = 0;
+  JsValueDeserializerGetWireFormatVersion(handle_, &version);
+  return version;
 }
 
 bool ValueDeserializer::ReadUint32(uint32_t* value) {
-  CHAKRA_UNIMPLEMENTED();
-  return false;
+  uint64_t result;
+  if (JsValueDeserializerReadVarint(handle_, &result) != JsNoError) {
+    return false;
+  }
+
+  *value = static_cast<uint32_t>(result);
+  return true;
 }
 
 bool ValueDeserializer::ReadUint64(uint64_t* value) {
-  CHAKRA_UNIMPLEMENTED();
-  return false;
+  return JsValueDeserializerReadVarint(handle_, value) == JsNoError;
 }
 
 bool ValueDeserializer::ReadDouble(double* value) {
-  CHAKRA_UNIMPLEMENTED();
-  return false;
+  return JsValueDeserializerReadDouble(handle_, value) == JsNoError;
 }
 
 bool ValueDeserializer::ReadRawBytes(size_t length, const void** data) {
-  CHAKRA_UNIMPLEMENTED();
-  return false;
+  return JsValueDeserializerReadRawBytes(handle_, length, data) == JsNoError;
 }
 
 }  // namespace v8
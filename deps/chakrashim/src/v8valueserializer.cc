@@ -19,82 +19,170 @@
 // IN THE SOFTWARE.
 
 #include "v8chakra.h"
+#include <stdlib.h>
 
 namespace v8 {
 
+// The engine calls back into the delegate, passed as the callback state, while
+// it is out of script. Exceptions thrown by the delegate are caught here and
+// set on the engine again, which throws them once it is back in script.
+void CHAKRA_CALLBACK ValueSerializer::DataCloneErrorCallback(
+    JsValueRef message, void* callbackState) {
+  ValueSerializer::Delegate* delegate =
+    static_cast<ValueSerializer::Delegate*>(callbackState);
+  TryCatch tryCatch(Isolate::GetCurrent());
+  delegate->ThrowDataCloneError(
+    Local<String>::New(static_cast<String*>(message)));
+  tryCatch.ReThrow();
+}
+
+bool CHAKRA_CALLBACK ValueSerializer::WriteHostObjectCallback(
+    JsValueRef object, void* callbackState) {
+  ValueSerializer::Delegate* delegate =
+    static_cast<ValueSerializer::Delegate*>(callbackState);
+  Isolate* isolate = Isolate::GetCurrent();
+  TryCatch tryCatch(isolate);
+  Maybe<bool> result = delegate->WriteHostObject(
+    isolate, Local<Object>::New(static_cast<Object*>(object)));
+  tryCatch.ReThrow();
+  return result.IsJust() && result.FromJust();
+}
+
+bool CHAKRA_CALLBACK ValueSerializer::GetSharedArrayBufferIdCallback(
+    JsValueRef shared_array_buffer, unsigned int* id, void* callbackState) {
+  ValueSerializer::Delegate* delegate =
+    static_cast<ValueSerializer::Delegate*>(callbackState);
+  Isolate* isolate = Isolate::GetCurrent();
+  TryCatch tryCatch(isolate);
+  Maybe<uint32_t> result = delegate->GetSharedArrayBufferId(
+    isolate, Local<SharedArrayBuffer>::New(
+      static_cast<SharedArrayBuffer*>(shared_array_buffer)));
+  tryCatch.ReThrow();
+  if (result.IsNothing()) {
+    return false;
+  }
+
+  *id = result.FromJust();
+  return true;
+}
+
+static void* CHAKRA_CALLBACK ReallocateBufferCallback(void* buffer,
+                                                     size_t size,
+                                                     size_t* allocatedSize,
+                                                     void* callbackState) {
+  if (callbackState != nullptr) {
+    return static_cast<ValueSerializer::Delegate*>(callbackState)
+      ->ReallocateBufferMemory(buffer, size, allocatedSize);
+  }
+
+  void* result = realloc(buffer, size);
+  *allocatedSize = result != nullptr ? size : 0;
+  return result;
+}
+
+static void CHAKRA_CALLBACK FreeBufferCallback(void* buffer,
+                                               void* callbackState) {
+  if (callbackState != nullptr) {
+    static_cast<ValueSerializer::Delegate*>(callbackState)
+      ->FreeBufferMemory(buffer);
+    return;
+  }
+
+  free(buffer);
+}
+
+// Without a delegate the engine reports host objects and SharedArrayBuffers
+// as not cloneable and throws the error itself, like V8 does.
 Maybe<bool> ValueSerializer::Delegate::WriteHostObject(Isolate* isolate,
                                                        Local<Object> object) {
-  CHAKRA_UNIMPLEMENTED();
   return Nothing<bool>();
 }
 
 Maybe<uint32_t> ValueSerializer::Delegate::GetSharedArrayBufferId(
     Isolate* isolate, Local<SharedArrayBuffer> shared_array_buffer) {
-  CHAKRA_UNIMPLEMENTED();
-  return Nothing<unsigned int>();
+  return Nothing<uint32_t>();
 }
 
 void* ValueSerializer::Delegate::ReallocateBufferMemory(void* old_buffer,
                                                         size_t size,
                                                         size_t* actual_size) {
-  CHAKRA_UNIMPLEMENTED();
-  return nullptr;
+  void* result = realloc(old_buffer, size);
+  *actual_size = result != nullptr ? size : 0;
+  return result;
 }
 
 void ValueSerializer::Delegate::FreeBufferMemory(void* buffer) {
-  CHAKRA_UNIMPLEMENTED();
+  free(buffer);
 }
 
-ValueSerializer::ValueSerializer(Isolate* isolate) {
-  CHAKRA_UNIMPLEMENTED();
+ValueSerializer::ValueSerializer(Isolate* isolate)
+    : ValueSerializer(isolate, nullptr) {
 }
 
-ValueSerializer::ValueSerializer(Isolate* isolate, Delegate* delegate) {
-  CHAKRA_UNIMPLEMENTED();
+ValueSerializer::ValueSerializer(Isolate* isolate, Delegate* delegate)
+    : handle_(nullptr) {
+  JsValueSerializerCallbacks callbacks = {};
+  if (delegate != nullptr) {
+    callbacks.dataCloneError = DataCloneErrorCallback;
+    callbacks.writeHostObject = WriteHostObjectCallback;
+    callbacks.getSharedArrayBufferId = GetSharedArrayBufferIdCallback;
+  }
+  callbacks.reallocateBuffer = ReallocateBufferCallback;
+  callbacks.freeBuffer = FreeBufferCallback;
+
+  JsErrorCode error = JsCreateValueSerializer(&callbacks, delegate, &handle_);
+  CHAKRA_VERIFY_NOERROR(error);
 }
 
 ValueSerializer::~ValueSerializer() {
-  // Intentionally left empty to suppress warning C4722.
+  if (handle_ != nullptr) {
+    JsDisposeValueSerializer(handle_);
+  }
 }
 
 void ValueSerializer::WriteHeader() {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueSerializerWriteHeader(handle_);
 }
 
 Maybe<bool> ValueSerializer::WriteValue(Local<Context> context,
                                         Local<Value> value) {
-  CHAKRA_UNIMPLEMENTED();
-  return Nothing<bool>();
+  if (JsValueSerializerWriteValue(handle_, *value) != JsNoError) {
+    return Nothing<bool>();
+  }
+
+  return Just(true);
 }
 
 std::pair<uint8_t*, size_t> ValueSerializer::Release() {
-  CHAKRA_UNIMPLEMENTED();
-  return std::pair<uint8_t*, size_t>();
+  void* buffer = nullptr;
+  size_t size = 0;
+  JsValueSerializerReleaseBuffer(handle_, &buffer, &size);
+  return std::make_pair(static_cast<uint8_t*>(buffer), size);
 }
 
 void ValueSerializer::TransferArrayBuffer(uint32_t transfer_id,
                                           Local<ArrayBuffer> array_buffer) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueSerializerTransferArrayBuffer(handle_, transfer_id, *array_buffer);
 }
 
 void ValueSerializer::SetTreatArrayBufferViewsAsHostObjects(bool mode) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueSerializerSetTreatArrayBufferViewsAsHostObjects(handle_, mode);
 }
 
 void ValueSerializer::WriteUint32(uint32_t value) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueSerializerWriteVarint(handle_, value);
 }
 
 void ValueSerializer::WriteUint64(uint64_t value) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueSerializerWriteVarint(handle_, value);
 }
 
 void ValueSerializer::WriteDouble(double value) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueSerializerWriteDouble(handle_, value);
 }
 
 void ValueSerializer::WriteRawBytes(const void* source, size_t length) {
-  CHAKRA_UNIMPLEMENTED();
+  JsValueSerializerWriteRawBytes(handle_, source, length);
 }
 
 }  // namespace v8
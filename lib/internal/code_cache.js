@@ -0,0 +1,147 @@
+'use strict';
+
+// On-disk cache of compiled module wrappers, enabled by NODE_CODE_CACHE_DIR.
+//
+// Every module gets one entry in the cache directory, named after a hash of
+// its path. An entry holds the vm.Script cached data together with the path,
+// mtime and a hash of the source it was produced from, and is only used when
+// all of them match the module being loaded. Entries that don't match are
+// replaced by the next compile. The cache is best effort: any error reading
+// or writing it falls back to compiling the module from source.
+
+const Buffer = require('buffer').Buffer;
+const fs = require('fs');
+const path = require('path');
+const util = require('util');
+const vm = require('vm');
+const debug = util.debuglog('codecache');
+
+const kMagic = 0x4e434331;  // 'NCC1'
+
+// magic, source hash, source length, path length, mtime
+const kHeaderSize = 24;
+
+// FNV-1a over the UTF-16 code units of a string
+function hashString(string) {
+  var hash = 0x811c9dc5;
+  for (var i = 0; i < string.length; i++) {
+    hash ^= string.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return hash >>> 0;
+}
+
+function CodeCache(dir) {
+  this.dir = path.resolve(dir);
+  try {
+    fs.mkdirSync(this.dir);
+  } catch (e) {
+    // Either it already exists, or every write will fail and be ignored
+  }
+}
+
+CodeCache.prototype.entryPath = function(filename) {
+  return path.join(this.dir, hashString(filename).toString(16) + '.jscache');
+};
+
+// Returns the cached data stored for this source, or undefined.
+CodeCache.prototype.read = function(entry, filename, mtime, source,
+                                    sourceHash) {
+  var buf;
+  try {
+    buf = fs.readFileSync(entry);
+  } catch (e) {
+    return undefined;
+  }
+
+  if (buf.length < kHeaderSize ||
+      buf.readUInt32LE(0) !== kMagic ||
+      buf.readUInt32LE(4) !== sourceHash ||
+      buf.readUInt32LE(8) !== source.length ||
+      buf.readDoubleLE(16) !== mtime) {
+    return undefined;
+  }
+
+  // The path guards against two modules whose paths share a hash
+  const pathEnd = kHeaderSize + buf.readUInt32LE(12);
+  if (pathEnd > buf.length ||
+      buf.toString('utf8', kHeaderSize, pathEnd) !== filename) {
+    return undefined;
+  }
+
+  return buf.slice(pathEnd);
+};
+
+CodeCache.prototype.write = function(entry, filename, mtime, source,
+                                     sourceHash, cachedData) {
+  const pathLength = Buffer.byteLength(filename);
+  const buf = Buffer.allocUnsafe(kHeaderSize + pathLength + cachedData.length);
+  buf.writeUInt32LE(kMagic, 0);
+  buf.writeUInt32LE(sourceHash, 4);
+  buf.writeUInt32LE(source.length, 8);
+  buf.writeUInt32LE(pathLength, 12);
+  buf.writeDoubleLE(mtime, 16);
+  buf.write(filename, kHeaderSize, pathLength, 'utf8');
+  cachedData.copy(buf, kHeaderSize + pathLength);
+
+  // Write to a temporary file first so that concurrent processes never see a
+  // partially written entry
+  const temp = `${entry}.${process.pid}.tmp`;
+  try {
+    fs.writeFileSync(temp, buf);
+    fs.renameSync(temp, entry);
+  } catch (e) {
+    try {
+      fs.unlinkSync(temp);
+    } catch (e) {
+      // Nothing was written
+    }
+  }
+};
+
+// Compiles the module wrapper for |filename|, consuming its cache entry if it
+// has a valid one and producing one otherwise.
+CodeCache.prototype.compile = function(wrapper, filename) {
+  var mtime;
+  try {
+    mtime = fs.statSync(filename).mtime.getTime();
+  } catch (e) {
+    return vm.runInThisContext(wrapper, {
+      filename: filename,
+      lineOffset: 0,
+      displayErrors: true
+    });
+  }
+
+  const entry = this.entryPath(filename);
+  const sourceHash = hashString(wrapper);
+  const cachedData = this.read(entry, filename, mtime, wrapper, sourceHash);
+  const script = new vm.Script(wrapper, {
+    filename: filename,
+    lineOffset: 0,
+    displayErrors: true,
+    cachedData: cachedData,
+    produceCachedData: cachedData === undefined
+  });
+
+  if (cachedData !== undefined) {
+    debug('%s %s', script.cachedDataRejected ? 'rejected' : 'accepted', entry);
+    if (script.cachedDataRejected) {
+      // Produced by a different engine version; the next compile replaces it
+      try {
+        fs.unlinkSync(entry);
+      } catch (e) {
+        // Another process already replaced it
+      }
+    }
+  } else if (script.cachedDataProduced) {
+    debug('produced %s', entry);
+    this.write(entry, filename, mtime, wrapper, sourceHash, script.cachedData);
+  }
+
+  return script.runInThisContext({ displayErrors: true });
+};
+
+module.exports = {
+  CodeCache
+};
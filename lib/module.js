@@ -32,6 +32,8 @@ const path = require('path');
 const internalModuleReadFile = process.binding('fs').internalModuleReadFile;
 const internalModuleStat = process.binding('fs').internalModuleStat;
 const preserveSymlinks = !!process.binding('config').preserveSymlinks;
+const codeCacheDir = process.binding('config').codeCacheDir;
+var codeCache = null;
 
 function stat(filename) {
   filename = path._makeLong(filename);
@@ -530,11 +532,20 @@ Module.prototype._compile = function(content, filename) {
   // create wrapper function
   var wrapper = Module.wrap(content);
 
-  var compiledWrapper = vm.runInThisContext(wrapper, {
-    filename: filename,
-    lineOffset: 0,
-    displayErrors: true
-  });
+  var compiledWrapper;
+  if (codeCacheDir !== undefined) {
+    if (codeCache === null) {
+      const CodeCache = require('internal/code_cache').CodeCache;
+      codeCache = new CodeCache(codeCacheDir);
+    }
+    compiledWrapper = codeCache.compile(wrapper, filename);
+  } else {
+    compiledWrapper = vm.runInThisContext(wrapper, {
+      filename: filename,
+      lineOffset: 0,
+      displayErrors: true
+    });
+  }
 
   var inspectorWrapper = null;
   if (process._debugWaitConnect && process._eval == null) {
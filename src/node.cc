@@ -232,6 +232,11 @@ bool config_pending_deprecation = false;
 // Set in node.cc by ParseArgs when --redirect-warnings= is used.
 std::string config_warning_file;  // NOLINT(runtime/string)
 
+// Set from NODE_CODE_CACHE_DIR.
+// Used in node_config.cc to set a constant on process.binding('config')
+// that is used by lib/module.js
+std::string config_code_cache_dir;  // NOLINT(runtime/string)
+
 // Set in node.cc by ParseArgs when --expose-internals or --expose_internals is
 // used.
 // Used in node_config.cc to set a constant on process.binding('config')
@@ -1334,7 +1339,12 @@ Local<Value> MakeCallback(Environment* env,
   // propagate through to the fatalException after hook calls.
   AsyncHooks::ExecScope exec_scope(env, 0, 0);
 
+#ifdef NODE_ENGINE_CHAKRACORE
+  Local<Value> ret = callback->FastCall(env->isolate(), recv, argc, argv)
+      .FromMaybe(Local<Value>());
+#else
   Local<Value> ret = callback->Call(recv, argc, argv);
+#endif
 
   if (ret.IsEmpty()) {
     // NOTE: For backwards compatibility with public API we return Undefined()
@@ -4396,6 +4406,8 @@ void Init(int* argc,
   if (config_warning_file.empty())
     SafeGetenv("NODE_REDIRECT_WARNINGS", &config_warning_file);
 
+  SafeGetenv("NODE_CODE_CACHE_DIR", &config_code_cache_dir);
+
 #if HAVE_OPENSSL
   if (openssl_config.empty())
     SafeGetenv("OPENSSL_CONF", &openssl_config);
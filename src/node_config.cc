@@ -62,6 +62,16 @@ static void InitConfig(Local<Object> target,
     target->DefineOwnProperty(env->context(), name, value).FromJust();
   }
 
+  if (!config_code_cache_dir.empty()) {
+    Local<String> name = OneByteString(env->isolate(), "codeCacheDir");
+    Local<String> value = String::NewFromUtf8(env->isolate(),
+                                              config_code_cache_dir.data(),
+                                              v8::NewStringType::kNormal,
+                                              config_code_cache_dir.size())
+                                                .ToLocalChecked();
+    target->DefineOwnProperty(env->context(), name, value).FromJust();
+  }
+
   if (config_expose_internals)
     READONLY_BOOLEAN_PROPERTY("exposeInternals");
 }  // InitConfig
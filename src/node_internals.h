@@ -76,6 +76,11 @@ extern bool config_expose_internals;
 // it to stderr.
 extern std::string config_warning_file;  // NOLINT(runtime/string)
 
+// Set in node.cc from NODE_CODE_CACHE_DIR.
+// Used in node_config.cc to set a constant on process.binding('config')
+// that is used by lib/module.js to cache compiled modules on disk.
+extern std::string config_code_cache_dir;  // NOLINT(runtime/string)
+
 // Set in node.cc by ParseArgs when --pending-deprecation or
 // NODE_PENDING_DEPRECATION is used
 extern bool config_pending_deprecation;
@@ -287,33 +287,55 @@ int StreamBase::WriteString(const FunctionCallbackInfo<Value>& args) {
 
   int err;
 
-  // Compute the size of the storage that the string will be flattened into.
-  // For UTF8 strings that are very long, go ahead and take the hit for
-  // computing their actual size, rather than tripling the storage.
-  size_t storage_size;
-  if (enc == UTF8 && string->Length() > 65535)
-    storage_size = StringBytes::Size(env->isolate(), string, enc);
-  else
-    storage_size = StringBytes::StorageSize(env->isolate(), string, enc);
-
-  if (storage_size > INT_MAX)
-    return UV_ENOBUFS;
-
-  // Try writing immediately if write size isn't too big
   WriteWrap* req_wrap;
   char* data;
   char stack_storage[16384];  // 16kb
-  size_t data_size;
+  size_t storage_size = 0;
+  size_t data_size = 0;
   uv_buf_t buf;
 
-  bool try_write = storage_size <= sizeof(stack_storage) &&
-                   (!IsIPCPipe() || send_handle_obj.IsEmpty());
+  bool try_write = !IsIPCPipe() || send_handle_obj.IsEmpty();
+  bool encoded = false;
+
+  // UTF8 strings that may fit the stack storage are encoded straight into it
+  // in a single pass, without sizing them first. If the string turns out not
+  // to fit, fall back to computing the storage size below.
+  if (enc == UTF8 && try_write &&
+      static_cast<size_t>(string->Length()) <= sizeof(stack_storage)) {
+    int nchars = 0;
+    data_size = string->WriteUtf8(stack_storage,
+                                  sizeof(stack_storage),
+                                  &nchars,
+                                  String::NO_NULL_TERMINATION |
+                                  String::REPLACE_INVALID_UTF8);
+    encoded = nchars == string->Length();
+    storage_size = data_size;
+  }
+
+  if (!encoded) {
+    // Compute the size of the storage that the string will be flattened into.
+    // For UTF8 strings that are very long, go ahead and take the hit for
+    // computing their actual size, rather than tripling the storage.
+    if (enc == UTF8 && string->Length() > 65535)
+      storage_size = StringBytes::Size(env->isolate(), string, enc);
+    else
+      storage_size = StringBytes::StorageSize(env->isolate(), string, enc);
+
+    if (storage_size > INT_MAX)
+      return UV_ENOBUFS;
+
+    // Try writing immediately if write size isn't too big
+    try_write = try_write && storage_size <= sizeof(stack_storage);
+    if (try_write) {
+      data_size = StringBytes::Write(env->isolate(),
+                                     stack_storage,
+                                     storage_size,
+                                     string,
+                                     enc);
+    }
+  }
+
   if (try_write) {
-    data_size = StringBytes::Write(env->isolate(),
-                                   stack_storage,
-                                   storage_size,
-                                   string,
-                                   enc);
     buf = uv_buf_init(stack_storage, data_size);
 
     uv_buf_t* bufs = &buf;
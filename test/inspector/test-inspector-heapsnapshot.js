@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+common.skipIfInspectorDisabled();
+const assert = require('assert');
+const inspector = require('inspector');
+
+class RetainedByTest {
+  constructor() {
+    this.payload = 'retained by test-inspector-heapsnapshot';
+  }
+}
+global.retained = [new RetainedByTest()];
+
+const session = new inspector.Session();
+session.connect();
+
+const chunks = [];
+session.on('HeapProfiler.addHeapSnapshotChunk', (message) => {
+  chunks.push(message.params.chunk);
+});
+
+let finished = false;
+session.on('HeapProfiler.reportHeapSnapshotProgress', (message) => {
+  assert.ok(message.params.done <= message.params.total);
+  finished = finished || message.params.finished === true;
+});
+
+session.post('HeapProfiler.enable');
+session.post('HeapProfiler.collectGarbage');
+session.post('HeapProfiler.takeHeapSnapshot', { reportProgress: true },
+             common.mustCall((error) => {
+               assert.ifError(error);
+               assert.ok(finished, 'progress should report the end');
+
+               const snapshot = JSON.parse(chunks.join(''));
+               const meta = snapshot.snapshot.meta;
+               const nodeFields = meta.node_fields.length;
+               const edgeFields = meta.edge_fields.length;
+               assert.strictEqual(snapshot.nodes.length,
+                                  snapshot.snapshot.node_count * nodeFields);
+               assert.strictEqual(snapshot.edges.length,
+                                  snapshot.snapshot.edge_count * edgeFields);
+
+               // Edge counts add up and every edge points at a node
+               let edgeCount = 0;
+               for (let i = 0; i < snapshot.nodes.length; i += nodeFields) {
+                 edgeCount += snapshot.nodes[i + 4];
+               }
+               assert.strictEqual(edgeCount, snapshot.snapshot.edge_count);
+               for (let i = 0; i < snapshot.edges.length; i += edgeFields) {
+                 const toNode = snapshot.edges[i + 2];
+                 assert.strictEqual(toNode % nodeFields, 0);
+                 assert.ok(toNode < snapshot.nodes.length);
+               }
+
+               const objectType = meta.node_types[0].indexOf('object');
+               const stringType = meta.node_types[0].indexOf('string');
+               const names = [];
+               for (let i = 0; i < snapshot.nodes.length; i += nodeFields) {
+                 names.push([snapshot.nodes[i],
+                             snapshot.strings[snapshot.nodes[i + 1]]]);
+               }
+               assert.ok(names.some(([type, name]) => {
+                 return type === objectType && name === 'RetainedByTest';
+               }));
+               assert.ok(names.some(([type, name]) => {
+                 return type === stringType &&
+                        name === 'retained by test-inspector-heapsnapshot';
+               }));
+             }));
+session.post('HeapProfiler.disable');
+session.disconnect();
@@ -0,0 +1,52 @@
+'use strict';
+const common = require('../common');
+common.skipIfInspectorDisabled();
+const assert = require('assert');
+const inspector = require('inspector');
+
+// A loop without calls is only interrupted by the loop probe of its jitted
+// code. A sample request must be taken there without aborting the script.
+function hot(iterations) {
+  let accum = 0;
+  for (let i = 0; i < iterations; i++) {
+    accum = (accum + i * 3) % 1000003;
+  }
+  return accum;
+}
+
+function expected(iterations) {
+  let accum = 0;
+  for (let i = 0; i < iterations; i++) {
+    accum = (accum + (i % 1000003) * 3) % 1000003;
+  }
+  return accum;
+}
+
+const session = new inspector.Session();
+session.connect();
+session.post('Profiler.enable');
+session.post('Profiler.setSamplingInterval', { interval: 100 });
+session.post('Profiler.start', common.mustCall((error) => {
+  assert.ifError(error);
+}));
+
+const iterations = 5e7;
+let completed = 0;
+for (let run = 0; run < 4; run++) {
+  hot(iterations);
+  completed++;
+}
+assert.strictEqual(completed, 4);
+assert.strictEqual(hot(1e6), expected(1e6));
+
+session.post('Profiler.stop', common.mustCall((error, result) => {
+  assert.ifError(error);
+  const profile = result.profile;
+  assert.ok(profile.samples.length > 0);
+  const hotNode = profile.nodes.find((node) => {
+    return node.callFrame.functionName === 'hot';
+  });
+  assert.ok(hotNode, 'hot() should have been sampled in its loop');
+}));
+session.post('Profiler.disable');
+session.disconnect();
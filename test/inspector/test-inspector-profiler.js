@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common');
+common.skipIfInspectorDisabled();
+const assert = require('assert');
+const inspector = require('inspector');
+
+function leaf(i) {
+  return i * 2;
+}
+
+function busy() {
+  let accum = 0;
+  for (let i = 0; i < 1000; i++) {
+    accum += leaf(i);
+  }
+  return accum;
+}
+
+const session = new inspector.Session();
+session.connect();
+
+session.post('Profiler.start', common.mustCall((error) => {
+  assert.ok(error, 'Profiler.start should fail until Profiler.enable');
+}));
+session.post('Profiler.enable');
+session.post('Profiler.setSamplingInterval', { interval: 100 });
+session.post('Profiler.start', common.mustCall((error) => {
+  assert.ifError(error);
+}));
+
+const end = Date.now() + 200;
+while (Date.now() < end) {
+  busy();
+}
+
+session.post('Profiler.stop', common.mustCall((error, result) => {
+  assert.ifError(error);
+  const profile = result.profile;
+  assert.ok(profile.endTime >= profile.startTime);
+  assert.strictEqual(profile.nodes[0].callFrame.functionName, '(root)');
+  assert.strictEqual(profile.samples.length, profile.timeDeltas.length);
+
+  const ids = new Set(profile.nodes.map((node) => node.id));
+  for (const id of profile.samples) {
+    assert.ok(ids.has(id));
+  }
+
+  const busyNode = profile.nodes.find((node) => {
+    return node.callFrame.functionName === 'busy';
+  });
+  assert.ok(busyNode, 'busy() should have been sampled');
+  assert.strictEqual(busyNode.callFrame.lineNumber, 10);
+  assert.ok(busyNode.callFrame.url.endsWith('test-inspector-profiler.js'));
+}));
+
+session.post('Profiler.stop', common.mustCall((error) => {
+  assert.ok(error, 'there is no profile to stop');
+}));
+session.post('Profiler.disable');
+session.disconnect();
@@ -0,0 +1,90 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+function getCallSites(fn) {
+  const prepareStackTrace = Error.prepareStackTrace;
+  Error.prepareStackTrace = (err, frames) => frames;
+  const obj = {};
+  Error.captureStackTrace(obj, fn);
+  const frames = obj.stack;
+  Error.prepareStackTrace = prepareStackTrace;
+  return frames;
+}
+
+function inner(fn) {
+  return getCallSites(fn);
+}
+
+function outer(fn) {
+  return inner(fn);
+}
+
+// Frames start at the caller of Error.captureStackTrace
+{
+  const frames = outer();
+  assert.strictEqual(frames[0].getFunctionName(), 'getCallSites');
+  assert.strictEqual(frames[1].getFunctionName(), 'inner');
+  assert.strictEqual(frames[2].getFunctionName(), 'outer');
+  for (let i = 0; i < 3; i++) {
+    assert.strictEqual(frames[i].getFileName(), __filename);
+    assert.strictEqual(typeof frames[i].getLineNumber(), 'number');
+    assert.strictEqual(typeof frames[i].getColumnNumber(), 'number');
+    assert.ok(frames[i].getLineNumber() > 0);
+  }
+  assert.ok(frames[1].getLineNumber() < frames[2].getLineNumber());
+}
+
+// Frames above the function passed to Error.captureStackTrace are left out
+{
+  const frames = outer(inner);
+  assert.strictEqual(frames[0].getFunctionName(), 'outer');
+}
+
+// Nothing is captured if that function isn't on the stack
+{
+  const frames = outer(function notOnStack() {});
+  assert.strictEqual(frames.length, 0);
+}
+
+// Error.stackTraceLimit caps the number of frames
+{
+  const stackTraceLimit = Error.stackTraceLimit;
+  Error.stackTraceLimit = 1;
+  const frames = outer();
+  Error.stackTraceLimit = stackTraceLimit;
+  assert.strictEqual(frames.length, 1);
+}
+
+// prepareStackTrace is only called when the stack is read, and only once
+{
+  const prepareStackTrace = Error.prepareStackTrace;
+  let calls = 0;
+  Error.prepareStackTrace = (err, frames) => {
+    calls++;
+    return `${err.message} with ${frames.length > 0 ? 'frames' : 'none'}`;
+  };
+  const err = new Error('lazy');
+  assert.strictEqual(calls, 0);
+  assert.strictEqual(err.stack, 'lazy with frames');
+  assert.strictEqual(err.stack, 'lazy with frames');
+  assert.strictEqual(calls, 1);
+  Error.prepareStackTrace = prepareStackTrace;
+}
+
+// A thrown error keeps the stack of where it was created
+{
+  function createError() {
+    return new TypeError('created');
+  }
+  function throwError(err) {
+    throw err;
+  }
+  try {
+    throwError(createError());
+  } catch (err) {
+    assert.ok(/^TypeError: created\n/.test(err.stack));
+    assert.ok(/createError/.test(err.stack));
+    assert.ok(!/throwError/.test(err.stack));
+  }
+}
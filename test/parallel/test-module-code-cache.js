@@ -0,0 +1,85 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const spawnSync = require('child_process').spawnSync;
+
+common.refreshTmpDir();
+
+const cacheDir = path.join(common.tmpDir, 'code-cache');
+const modulePath = path.join(common.tmpDir, 'cached-module.js');
+const env = Object.assign({}, process.env, {
+  NODE_CODE_CACHE_DIR: cacheDir,
+  NODE_DEBUG: 'codecache'
+});
+
+// What the cache did for the module in the last run: produced, accepted or
+// rejected, as logged with NODE_DEBUG=codecache
+let lastCacheAction;
+
+function run() {
+  const out = spawnSync(process.execPath,
+                        [ '-p', `require(${JSON.stringify(modulePath)})` ],
+                        { env: env });
+  assert.strictEqual(out.status, 0, String(out.stderr));
+  const match = /^CODECACHE \d+: (\w+) .*cached-module/m.exec(out.stderr);
+  lastCacheAction = match ? match[1] : undefined;
+  return out.stdout.toString().trim();
+}
+
+function cacheEntries() {
+  return fs.readdirSync(cacheDir).filter((name) => /\.jscache$/.test(name));
+}
+
+fs.writeFileSync(modulePath, 'module.exports = "first";');
+
+// The first load compiles the module, creates the cache directory and writes
+// the module's entry
+assert.strictEqual(run(), 'first');
+assert.strictEqual(lastCacheAction, 'produced');
+const entries = cacheEntries();
+assert.strictEqual(entries.length, 1);
+const entry = path.join(cacheDir, entries[0]);
+const produced = fs.readFileSync(entry);
+assert(produced.length > 0);
+
+// Later loads consume the entry, which the engine accepts, and leave it as it
+// is
+assert.strictEqual(run(), 'first');
+assert.strictEqual(lastCacheAction, 'accepted');
+assert.deepStrictEqual(fs.readFileSync(entry), produced);
+
+// A changed module is never run from the stale entry, which is replaced
+fs.writeFileSync(modulePath, 'module.exports = "second";');
+assert.strictEqual(run(), 'second');
+assert.strictEqual(lastCacheAction, 'produced');
+assert.deepStrictEqual(cacheEntries(), entries);
+const replaced = fs.readFileSync(entry);
+assert.notDeepStrictEqual(replaced, produced);
+assert.strictEqual(run(), 'second');
+assert.strictEqual(lastCacheAction, 'accepted');
+
+// An entry whose cached data the engine rejects is removed, and the next load
+// produces a new one
+const pathEnd = 24 + replaced.readUInt32LE(12);
+const garbage = Buffer.alloc(replaced.length - pathEnd, 0xa5);
+fs.writeFileSync(entry, Buffer.concat([replaced.slice(0, pathEnd), garbage]));
+assert.strictEqual(run(), 'second');
+assert.strictEqual(lastCacheAction, 'rejected');
+assert(!fs.existsSync(entry));
+assert.strictEqual(run(), 'second');
+assert.strictEqual(lastCacheAction, 'produced');
+assert.deepStrictEqual(cacheEntries(), entries);
+
+// Entries that are corrupt are ignored
+fs.writeFileSync(entry, 'not a cache entry');
+assert.strictEqual(run(), 'second');
+assert.strictEqual(lastCacheAction, 'produced');
+
+// Without the variable no cache is used
+common.refreshTmpDir();
+fs.writeFileSync(modulePath, 'module.exports = "third";');
+delete env.NODE_CODE_CACHE_DIR;
+assert.strictEqual(run(), 'third');
+assert(!fs.existsSync(cacheDir));
@@ -0,0 +1,23 @@
+// Flags: --v8-pool-size=1 --expose-gc
+'use strict';
+require('../common');
+const assert = require('assert');
+
+// With a single worker thread the background collections of the engine must
+// not wait on work queued behind themselves.
+let retained = [];
+let total = 0;
+for (let round = 0; round < 20; round++) {
+  for (let i = 0; i < 50000; i++) {
+    const object = { round, i, payload: `payload ${i}` };
+    retained.push(object);
+    total += object.payload.length;
+  }
+  if (round % 5 === 4) {
+    retained = [];
+    global.gc();
+  }
+}
+
+assert.ok(total > 0);
+assert.strictEqual(retained.length, 0);
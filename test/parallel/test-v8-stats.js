@@ -19,13 +19,12 @@ keys.forEach(function(key) {
   assert.strictEqual(typeof s[key], 'number');
 });
 
-// chakra doesn't expose heapSpace names, so skip
-// the test for getHeapSpaceStatistics
-if (common.isChakraEngine) {
-  return;
-}
-
-const expectedHeapSpaces = [
+const expectedHeapSpaces = common.isChakraEngine ? [
+  'object_space',
+  'leaf_space',
+  'large_object_space',
+  'code_space'
+] : [
   'new_space',
   'old_space',
   'code_space',
@@ -41,4 +40,5 @@ heapSpaceStatistics.forEach((heapSpace) => {
   assert.strictEqual(typeof heapSpace.space_used_size, 'number');
   assert.strictEqual(typeof heapSpace.space_available_size, 'number');
   assert.strictEqual(typeof heapSpace.physical_space_size, 'number');
+  assert(heapSpace.space_used_size <= heapSpace.space_size);
 });
@@ -0,0 +1,19 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const vm = require('vm');
+
+// Every context after the first is initialized from cached byte code, make
+// sure they all end up with a working shim.
+for (let i = 0; i < 5; i++) {
+  const context = vm.createContext({ i });
+  const result = vm.runInContext(`
+    const err = {};
+    Error.captureStackTrace(err);
+    const entries = [...new Map([[i, 'value']]).entries()];
+    ({ hasStack: typeof err.stack === 'string', entries });
+  `, context);
+
+  assert.strictEqual(result.hasStack, true);
+  assert.strictEqual(JSON.stringify(result.entries), `[[${i},"value"]]`);
+}